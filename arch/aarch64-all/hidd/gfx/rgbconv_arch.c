@@ -0,0 +1,64 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#define DEBUG 0
+#include <aros/debug.h>
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_simdparams.h"
+
+SIMDCONVERTFUNCP(Shuffle32to32, NEON)
+SIMDCONVERTFUNCP(Shuffle24to32, NEON)
+SIMDCONVERTFUNCP(Shuffle32to24, NEON)
+SIMDCONVERTFUNCP(Shuffle24to24, NEON)
+SIMDCONVERTFUNCP(Shift32to16, NEON)
+SIMDCONVERTFUNCP(Shift16to32, NEON)
+
+/*
+ * Advanced SIMD is a mandatory part of AArch64, so there is nothing to
+ * check for.
+ */
+void SetArchRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+    ULONG src, dst;
+
+    D(bug("[GFX:AArch64] %s()\n", __func__);)
+
+    SetSIMDRGBConversionParams(rgbconvertfuncs);
+
+    for (src = 0; src < NUM_RGB_STDPIXFMT; src++)
+    {
+        for (dst = 0; dst < NUM_RGB_STDPIXFMT; dst++)
+        {
+            HIDDT_RGBConversionFunction f = NULL;
+            struct RGBConvParams *rcp;
+
+            if (!rgbconv_paramindex[src][dst])
+                continue;
+            rcp = &rgbconv_params[rgbconv_paramindex[src][dst] - 1];
+
+            if ((rcp->rcp_SrcBpp == 4) && (rcp->rcp_DstBpp == 4))
+            {
+                if (rcp->rcp_Flags & RCPF_SHUFFLE)
+                    f = convert_Shuffle32to32_NEON;
+            }
+            else if ((rcp->rcp_SrcBpp == 3) && (rcp->rcp_DstBpp == 4))
+                f = convert_Shuffle24to32_NEON;
+            else if ((rcp->rcp_SrcBpp == 4) && (rcp->rcp_DstBpp == 3))
+                f = convert_Shuffle32to24_NEON;
+            else if ((rcp->rcp_SrcBpp == 3) && (rcp->rcp_DstBpp == 3))
+                f = convert_Shuffle24to24_NEON;
+            else if (rcp->rcp_DstBpp == 2)
+                f = convert_Shift32to16_NEON;
+            else
+                f = convert_Shift16to32_NEON;
+
+            if (f)
+                rgbconvertfuncs[src][dst] = f;
+        }
+    }
+}
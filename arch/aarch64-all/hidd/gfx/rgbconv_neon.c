@@ -0,0 +1,238 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: NEON RGB conversion routines.
+*/
+
+#define DEBUG 0
+#include <aros/debug.h>
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include <arm_neon.h>
+
+#include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_simd.h"
+
+/*
+ * The byte moving conversions use vqtbl1q_u8() with the byte order found
+ * by SetSIMDRGBConversionParams(). Unused destination bytes have an index
+ * of 0x80, which vqtbl1q_u8() turns into zero like _mm_shuffle_epi8() does.
+ */
+
+SIMDCONVERTFUNC(Shuffle32to32, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    const uint8x16_t mask = vld1q_u8(rcp->rcp_Shuffle);
+    UBYTE *src = (UBYTE *)srcPixels;
+    UBYTE *dst = (UBYTE *)dstPixels;
+    ULONG vwidth = width & ~15;
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 16)
+        {
+            uint8x16_t p0 = vld1q_u8(&src[x * 4]);
+            uint8x16_t p1 = vld1q_u8(&src[x * 4 + 16]);
+            uint8x16_t p2 = vld1q_u8(&src[x * 4 + 32]);
+            uint8x16_t p3 = vld1q_u8(&src[x * 4 + 48]);
+
+            vst1q_u8(&dst[x * 4], vqtbl1q_u8(p0, mask));
+            vst1q_u8(&dst[x * 4 + 16], vqtbl1q_u8(p1, mask));
+            vst1q_u8(&dst[x * 4 + 32], vqtbl1q_u8(p2, mask));
+            vst1q_u8(&dst[x * 4 + 48], vqtbl1q_u8(p3, mask));
+        }
+        src = src + srcMod;
+        dst = dst + dstMod;
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+/*
+ * Four 24 bit pixels are 12 bytes, but a load reads 16. Only do so while
+ * at least six pixels are left, to never read past the end of a row.
+ */
+#define WIDTH24(width) (((width) >= 6) ? (((width) - 2) & ~3) : 0)
+
+/* Store the first 12 bytes of a vector */
+static inline void neon_store24(UBYTE *dst, uint8x16_t p)
+{
+    vst1_u8(dst, vget_low_u8(p));
+    vst1q_lane_u32((uint32_t *)(dst + 8), vreinterpretq_u32_u8(p), 2);
+}
+
+SIMDCONVERTFUNC(Shuffle24to32, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    const uint8x16_t mask = vld1q_u8(rcp->rcp_Shuffle);
+    UBYTE *src = (UBYTE *)srcPixels;
+    UBYTE *dst = (UBYTE *)dstPixels;
+    ULONG vwidth = WIDTH24(width);
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 4)
+            vst1q_u8(&dst[x * 4], vqtbl1q_u8(vld1q_u8(&src[x * 3]), mask));
+        src = src + srcMod;
+        dst = dst + dstMod;
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+SIMDCONVERTFUNC(Shuffle32to24, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    const uint8x16_t mask = vld1q_u8(rcp->rcp_Shuffle);
+    UBYTE *src = (UBYTE *)srcPixels;
+    UBYTE *dst = (UBYTE *)dstPixels;
+    ULONG vwidth = width & ~3;
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 4)
+            neon_store24(&dst[x * 3], vqtbl1q_u8(vld1q_u8(&src[x * 4]), mask));
+        src = src + srcMod;
+        dst = dst + dstMod;
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+SIMDCONVERTFUNC(Shuffle24to24, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    const uint8x16_t mask = vld1q_u8(rcp->rcp_Shuffle);
+    UBYTE *src = (UBYTE *)srcPixels;
+    UBYTE *dst = (UBYTE *)dstPixels;
+    ULONG vwidth = WIDTH24(width);
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 4)
+            neon_store24(&dst[x * 3], vqtbl1q_u8(vld1q_u8(&src[x * 3]), mask));
+        src = src + srcMod;
+        dst = dst + dstMod;
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+/*
+ * The masked shifts found by SetSIMDRGBConversionParams(). vshlq_u32()
+ * shifts right for negative counts, so every group is one and and one
+ * shift. Unused groups get an empty mask, so that the loops can be
+ * unrolled.
+ */
+struct NEONShifts
+{
+    uint32x4_t mask[4];
+    int32x4_t  shift[4];
+};
+
+static inline void neon_setupshifts(struct NEONShifts *shifts, struct RGBConvParams *rcp)
+{
+    ULONG i;
+
+    for (i = 0; i < 4; i++)
+    {
+        BOOL used = (i < rcp->rcp_NumShifts);
+
+        shifts->mask[i]  = vdupq_n_u32(used ? rcp->rcp_ShiftMask[i] : 0);
+        shifts->shift[i] = vdupq_n_s32(used ? -rcp->rcp_Shift[i] : 0);
+    }
+}
+
+#define NEON_SHIFT(shifts, p, i) \
+    vshlq_u32(vandq_u32(p, (shifts)->mask[i]), (shifts)->shift[i])
+
+static inline uint32x4_t neon_shift(struct NEONShifts *shifts, uint32x4_t p)
+{
+    return vorrq_u32(vorrq_u32(NEON_SHIFT(shifts, p, 0), NEON_SHIFT(shifts, p, 1)),
+                     vorrq_u32(NEON_SHIFT(shifts, p, 2), NEON_SHIFT(shifts, p, 3)));
+}
+
+SIMDCONVERTFUNC(Shift32to16, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    ULONG *src = (ULONG *)srcPixels;
+    UWORD *dst = (UWORD *)dstPixels;
+    ULONG vwidth = width & ~7;
+    struct NEONShifts shifts;
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    neon_setupshifts(&shifts, rcp);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 8)
+        {
+            uint32x4_t p0 = neon_shift(&shifts, vld1q_u32((const uint32_t *)&src[x]));
+            uint32x4_t p1 = neon_shift(&shifts, vld1q_u32((const uint32_t *)&src[x + 4]));
+
+            /* Every lane holds at most 16 bits, so narrowing loses nothing */
+            vst1q_u16((uint16_t *)&dst[x], vcombine_u16(vmovn_u32(p0), vmovn_u32(p1)));
+        }
+        src = (ULONG *)(((UBYTE *)src) + srcMod);
+        dst = (UWORD *)(((UBYTE *)dst) + dstMod);
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+SIMDCONVERTFUNC(Shift16to32, NEON)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    UWORD *src = (UWORD *)srcPixels;
+    ULONG *dst = (ULONG *)dstPixels;
+    ULONG vwidth = width & ~7;
+    struct NEONShifts shifts;
+    ULONG x, y;
+
+    D(bug("[GFX:NEON] %s()\n", __func__);)
+
+    neon_setupshifts(&shifts, rcp);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 8)
+        {
+            uint16x8_t p = vld1q_u16((const uint16_t *)&src[x]);
+
+            vst1q_u32((uint32_t *)&dst[x], neon_shift(&shifts, vmovl_u16(vget_low_u16(p))));
+            vst1q_u32((uint32_t *)&dst[x + 4], neon_shift(&shifts, vmovl_u16(vget_high_u16(p))));
+        }
+        src = (UWORD *)(((UBYTE *)src) + srcMod);
+        dst = (ULONG *)(((UBYTE *)dst) + dstMod);
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
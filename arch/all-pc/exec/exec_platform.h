@@ -65,6 +65,9 @@ extern void Kernel_53_KrnSpinUnLock(spinlock_t *, void *);
 #define EXEC_SPINLOCK_LOCK(a,b,c) Kernel_52_KrnSpinLock((a), (b), (c), NULL)
 #define EXEC_SPINLOCK_UNLOCK(a) Kernel_53_KrnSpinUnLock((a), NULL)
 
+/* Keep the per-core run queues in step with SetTaskPri() */
+#define READYQUEUE_REPRIORITISE(task) core_RunQueueRequeue(task)
+
 #if defined(AROS_NO_ATOMIC_OPERATIONS)
 #define IDNESTCOUNT_INC \
     do { \
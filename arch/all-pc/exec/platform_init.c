@@ -250,6 +250,9 @@ void X86_SetTaskState(struct Task *changeTask, ULONG newState, BOOL dolock)
 #endif
         Enqueue(task_list, &changeTask->tc_Node);
 #if defined(__AROSEXEC_SMP__)
+        /* let the scheduler index the task in its cores run queue */
+        if (newState == TS_READY)
+            core_RunQueueAdd(changeTask);
         if (dolock && task_listlock) EXEC_SPINLOCK_UNLOCK(task_listlock);
 #endif
     }
@@ -288,6 +291,9 @@ void X86_HandleReschedTask(struct ExceptionContext *regs)
     if (task_listlock)
         EXEC_SPINLOCK_LOCK(task_listlock, NULL, SPINLOCK_MODE_WRITE);
 
+    if (reschTask->tc_State == TS_READY)
+        core_RunQueueRemove(reschTask);
+
     if ((reschTask->tc_State != TS_INVALID) && (reschTask->tc_State != TS_TOMBSTONED))
 #else
     if ((reschTask->tc_State != TS_INVALID) && (reschTask->tc_State != TS_RUN))
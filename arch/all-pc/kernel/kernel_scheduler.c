@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2017-2023, The AROS Development Team. All rights reserved.
+    Copyright (C) 2017-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <exec/alerts.h>
@@ -22,11 +22,14 @@
 
 #include <etask.h>
 
+#include <stddef.h>
+
 #define __AROS_KERNEL__
 
 #include "exec_intern.h"
 
 #include "apic.h"
+#include "kernel_ipi.h"
 
 #define LOWSTACKWARN
 #define SCHEDULERASCII_DEBUG
@@ -55,9 +58,335 @@
 #if defined(__AROSEXEC_SMP__)
 void core_InitScheduleData(struct X86SchedulerPrivate *schedData)
 {
+    int level;
+
     DSCHED(bug("[Kernel]" DEBUGFUNCCOLOR_SET " %s(0x%p)" DEBUGCOLOR_RESET "\n", __func__, schedData);)
     schedData->Granularity = SCHEDGRAN_VALUE;
     schedData->Quantum = SCHEDQUANTUM_VALUE;
+
+    KrnSpinInit(&schedData->RunQueueLock);
+    schedData->RunQueueCount = 0;
+    schedData->RunQueueSteals = 0;
+    schedData->RunQueueMigrations = 0;
+    for (level = 0; level < SCHED_RUNQ_WORDS; level++)
+        schedData->RunQueueMask[level] = 0;
+    for (level = 0; level < SCHED_RUNQ_LEVELS; level++)
+        NEWLIST((struct List *)&schedData->RunQueue[level]);
+}
+
+/*
+ * Run queue handling.
+ *
+ * The run queues are only modified while TaskReadySpinLock is held for
+ * writing, so membership of TaskReady and of the run queues stays in step.
+ * The per-core RunQueueLock allows core_Schedule() to look at the local
+ * queue without touching the global lock.
+ *
+ * Tasks leaving TaskReady are dropped from their run queue lazily, so a
+ * queue may still hold tasks that are no longer ready. core_Schedule() may
+ * therefore see a queued level that has nothing runnable behind it - this
+ * only costs a needless trip through core_Dispatch(), which pops the queue
+ * with TaskReadySpinLock held and throws such stale entries away.
+ */
+
+static inline struct X86SchedulerPrivate *core_GetScheduleData(cpuid_t cpuNo)
+{
+    struct APICData *apicData = KernelBase->kb_PlatformData->kb_APIC;
+    tls_t *apicTLS;
+
+    if ((!apicData) || (cpuNo >= apicData->apic_count))
+        return NULL;
+
+    if ((apicTLS = apicData->cores[cpuNo].cpu_TLS) == NULL)
+        return NULL;
+
+    return apicTLS->ScheduleData;
+}
+
+static inline BOOL core_TaskRunsOn(struct Task *task, cpuid_t cpuNo)
+{
+    struct IntETask *taskIET;
+
+    if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity))
+        return TRUE;
+    if ((taskIET = GetIntETask(task)) == NULL)
+        return FALSE;
+    return core_APIC_CPUInMask(cpuNo, taskIET->iet_CpuAffinity);
+}
+
+/* Returns the highest non-empty level, or -1 if the queue is empty */
+static inline LONG core_RunQueueTopLevel(struct X86SchedulerPrivate *schedData)
+{
+    LONG word;
+
+    for (word = SCHED_RUNQ_WORDS - 1; word >= 0; word--)
+    {
+        if (schedData->RunQueueMask[word])
+            return (word << 5) + (31 - __builtin_clz(schedData->RunQueueMask[word]));
+    }
+    return -1;
+}
+
+static void core_RunQueueLink(struct X86SchedulerPrivate *schedData, struct Task *task)
+{
+    struct IntETask *taskIET = GetIntETask(task);
+    ULONG level = SCHED_RUNQ_LEVEL(task->tc_Node.ln_Pri);
+
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+    /* Same order as Enqueue() - behind all tasks of equal priority */
+    ADDTAIL(&schedData->RunQueue[level], &taskIET->iet_RunQueueNode);
+    schedData->RunQueueMask[level >> 5] |= (1 << (level & 31));
+    schedData->RunQueueCount++;
+    taskIET->iet_RunQueueTask = task;
+    taskIET->iet_RunQueue = schedData;
+    taskIET->iet_RunQueueLevel = level;
+    KrnSpinUnLock(&schedData->RunQueueLock);
+}
+
+static void core_RunQueueUnlink(struct X86SchedulerPrivate *schedData, struct IntETask *taskIET)
+{
+    ULONG level = taskIET->iet_RunQueueLevel;
+
+    REMOVE((struct Node *)&taskIET->iet_RunQueueNode);
+    if (IsListEmpty(&schedData->RunQueue[level]))
+        schedData->RunQueueMask[level >> 5] &= ~(1 << (level & 31));
+    schedData->RunQueueCount--;
+    taskIET->iet_RunQueue = NULL;
+}
+
+void core_RunQueueAdd(struct Task *task)
+{
+    struct X86SchedulerPrivate *schedData = NULL;
+    struct IntETask *taskIET = GetIntETask(task);
+    cpuid_t cpuNo, targetCPU;
+
+    if (!taskIET)
+        return;
+
+    if (taskIET->iet_RunQueue)
+        core_RunQueueRemove(task);
+
+    cpuNo = KrnGetCPUNumber();
+
+    /* Prefer the core the task last ran on, to keep its caches warm .. */
+    targetCPU = (cpuid_t)taskIET->iet_CpuNumber;
+    if (!core_TaskRunsOn(task, targetCPU))
+    {
+        /* .. then the current core, then any core in its affinity mask */
+        if (core_TaskRunsOn(task, cpuNo))
+            targetCPU = cpuNo;
+        else
+        {
+            struct APICData *apicData = KernelBase->kb_PlatformData->kb_APIC;
+            cpuid_t cpuCount = apicData ? apicData->apic_count : 1;
+
+            for (targetCPU = 0; targetCPU < cpuCount; targetCPU++)
+            {
+                if (core_TaskRunsOn(task, targetCPU))
+                    break;
+            }
+            if (targetCPU == cpuCount)
+                targetCPU = cpuNo;
+        }
+    }
+
+    if ((schedData = core_GetScheduleData(targetCPU)) == NULL)
+        schedData = TLS_GET(ScheduleData);
+    if (!schedData)
+        return;
+
+    DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: queueing '%s' @ 0x%p on CPU #%03u" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task, targetCPU);)
+
+    core_RunQueueLink(schedData, task);
+}
+
+void core_RunQueueRemove(struct Task *task)
+{
+    struct X86SchedulerPrivate *schedData;
+    struct IntETask *taskIET = GetIntETask(task);
+
+    if ((!taskIET) || ((schedData = taskIET->iet_RunQueue) == NULL))
+        return;
+
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+    core_RunQueueUnlink(schedData, taskIET);
+    KrnSpinUnLock(&schedData->RunQueueLock);
+}
+
+/*
+ * A ready task's priority has been changed (SetTaskPri()). Requeue it at its
+ * new level straight away, rather than leaving it to be found by
+ * core_RunQueuePop() behind everything queued above its old level, and make
+ * the core it is queued on reschedule if it now beats the task running
+ * there. Must be called with TaskReadySpinLock held for writing.
+ */
+void core_RunQueueRequeue(struct Task *task)
+{
+    struct APICData *apicData = KernelBase->kb_PlatformData->kb_APIC;
+    struct X86SchedulerPrivate *schedData;
+    struct IntETask *taskIET = GetIntETask(task);
+    struct Task *running;
+    cpuid_t cpuNo, cpuCount, targetCPU;
+
+    if ((!taskIET) || (!taskIET->iet_RunQueue))
+        return;
+
+    core_RunQueueAdd(task);
+    if ((schedData = taskIET->iet_RunQueue) == NULL)
+        return;
+
+    cpuNo = KrnGetCPUNumber();
+    cpuCount = apicData ? apicData->apic_count : 1;
+    for (targetCPU = 0; targetCPU < cpuCount; targetCPU++)
+    {
+        if (core_GetScheduleData(targetCPU) == schedData)
+            break;
+    }
+    /* SetTaskPri() reschedules this core itself, if the task last ran here */
+    if ((targetCPU == cpuCount) || ((targetCPU == cpuNo) && (taskIET->iet_CpuNumber == cpuNo)))
+        return;
+
+    running = schedData->RunningTask;
+    if ((!running) || (task->tc_Node.ln_Pri > running->tc_Node.ln_Pri))
+    {
+        ULONG cpuMask[(cpuCount + 31) >> 5];
+        int word;
+
+        for (word = 0; word < ((cpuCount + 31) >> 5); word++)
+            cpuMask[word] = 0;
+        core_APIC_GetMask(apicData, targetCPU, (cpumask_t *)cpuMask);
+
+        DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: '%s' @ 0x%p now beats the task on CPU #%03u" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task, targetCPU);)
+        core_DoIPI(IPI_RESCHEDULE, cpuMask, KernelBase);
+    }
+}
+
+/*
+ * Take the best task from this core's run queue. Called from
+ * core_RunQueuePick() with TaskReadySpinLock held for writing, so the
+ * tc_State of the queued tasks cannot change while we look at them.
+ */
+static struct Task *core_RunQueuePop(struct X86SchedulerPrivate *schedData, cpuid_t cpuNo)
+{
+    struct IntETask *taskIET;
+    struct Task *task;
+    LONG level;
+
+    for (;;)
+    {
+        KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+        if ((level = core_RunQueueTopLevel(schedData)) < 0)
+        {
+            KrnSpinUnLock(&schedData->RunQueueLock);
+            return NULL;
+        }
+        taskIET = (struct IntETask *)((IPTR)GetHead(&schedData->RunQueue[level]) - offsetof(struct IntETask, iet_RunQueueNode));
+        task = taskIET->iet_RunQueueTask;
+        core_RunQueueUnlink(schedData, taskIET);
+        KrnSpinUnLock(&schedData->RunQueueLock);
+
+        /* The task has been taken off TaskReady behind our back - forget it */
+        if (task->tc_State != TS_READY)
+            continue;
+
+        /*
+         * Its affinity changed - move it to a core that may run it, and make
+         * those cores reschedule. This core is not in its affinity mask, so
+         * it does not signal itself.
+         */
+        if (!core_TaskRunsOn(task, cpuNo))
+        {
+            schedData->RunQueueMigrations++;
+            core_RunQueueAdd(task);
+            core_DoIPI(IPI_RESCHEDULE, taskIET->iet_CpuAffinity, KernelBase);
+            continue;
+        }
+
+        /* Its priority changed without it being requeued - fix that now */
+        if (SCHED_RUNQ_LEVEL(task->tc_Node.ln_Pri) != (ULONG)level)
+        {
+            core_RunQueueLink(schedData, task);
+            continue;
+        }
+
+        return task;
+    }
+}
+
+/* Take a task, that may run on this core, from another core's run queue */
+static struct Task *core_RunQueueSteal(struct X86SchedulerPrivate *schedData, cpuid_t cpuNo, LONG minLevel)
+{
+    struct APICData *apicData = KernelBase->kb_PlatformData->kb_APIC;
+    struct X86SchedulerPrivate *victimData;
+    struct MinNode *node;
+    cpuid_t cpuCount, victim, i;
+    LONG level;
+
+    if (!apicData || ((cpuCount = apicData->apic_count) < 2))
+        return NULL;
+
+    for (i = 1; i < cpuCount; i++)
+    {
+        victim = (cpuNo + i) % cpuCount;
+        victimData = core_GetScheduleData(victim);
+        if ((!victimData) || (victimData->RunQueueCount == 0))
+            continue;
+
+        KrnSpinLock(&victimData->RunQueueLock, NULL, SPINLOCK_MODE_WRITE);
+        for (level = core_RunQueueTopLevel(victimData); level > minLevel; level--)
+        {
+            if (!(victimData->RunQueueMask[level >> 5] & (1 << (level & 31))))
+                continue;
+
+            ForeachNode(&victimData->RunQueue[level], node)
+            {
+                struct IntETask *taskIET = (struct IntETask *)((IPTR)node - offsetof(struct IntETask, iet_RunQueueNode));
+                struct Task *task = taskIET->iet_RunQueueTask;
+
+                if ((task->tc_State == TS_READY) &&
+                    (SCHED_RUNQ_LEVEL(task->tc_Node.ln_Pri) == (ULONG)level) &&
+                    core_TaskRunsOn(task, cpuNo))
+                {
+                    core_RunQueueUnlink(victimData, taskIET);
+                    KrnSpinUnLock(&victimData->RunQueueLock);
+
+                    schedData->RunQueueSteals++;
+                    DSCHED(bug("[Kernel:%03u]" DEBUGCOLOR_SET " %s: took '%s' @ 0x%p from CPU #%03u" DEBUGCOLOR_RESET "\n", cpuNo, __func__, task->tc_Node.ln_Name, task, victim);)
+                    return task;
+                }
+            }
+        }
+        KrnSpinUnLock(&victimData->RunQueueLock);
+    }
+
+    return NULL;
+}
+
+/*
+ * Pick the next task for this core. Must be called with TaskReadySpinLock
+ * held for writing. Only when this core has nothing better than its idle
+ * task queued, will it look at the other cores' queues.
+ */
+static struct Task *core_RunQueuePick(cpuid_t cpuNo)
+{
+    struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+    struct Task *task;
+    LONG level;
+
+    if (!schedData)
+        return NULL;
+
+    KrnSpinLock(&schedData->RunQueueLock, NULL, SPINLOCK_MODE_READ);
+    level = core_RunQueueTopLevel(schedData);
+    KrnSpinUnLock(&schedData->RunQueueLock);
+
+    if (level <= (LONG)SCHED_RUNQ_IDLELEVEL)
+    {
+        if ((task = core_RunQueueSteal(schedData, cpuNo, level)) != NULL)
+            return task;
+    }
+
+    return core_RunQueuePop(schedData, cpuNo);
 }
 #endif
 
@@ -101,44 +430,62 @@ BOOL core_Schedule(void)
         else if (!(task->tc_Flags & TF_EXCEPT))
         {
 #if defined(__AROSEXEC_SMP__)
-            KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
-                        SPINLOCK_MODE_READ);
-#endif
+            struct X86SchedulerPrivate *schedData = TLS_GET(ScheduleData);
+            LONG level = -1;
+
+            if (schedData)
+            {
+                KrnSpinLock(&schedData->RunQueueLock, NULL,
+                            SPINLOCK_MODE_READ);
+                level = core_RunQueueTopLevel(schedData);
+                KrnSpinUnLock(&schedData->RunQueueLock);
+            }
+
+            if (level < 0)
+            {
+                /*
+                    Nothing is queued for this cpu. Unless the running task has used its
+                    quantum and other cpus have queued tasks we might take, let it work
+                */
+                if (!FLAG_SCHEDQUANTUM_ISSET)
+                    corereschedule = FALSE;
+                else
+                {
+                    KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
+                                SPINLOCK_MODE_READ);
+                    if (IsListEmpty(&SysBase->TaskReady))
+                        corereschedule = FALSE;
+                    KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
+                }
+            }
+            else if ((task->tc_State != TS_SPIN) &&
+                     ((ULONG)level <= SCHED_RUNQ_LEVEL(task->tc_Node.ln_Pri)))
+            {
+                /*
+                    The best task ready for this cpu has equal or lower priority.
+                    If the running task did not used it's whole quantum yet, let it work
+                */
+                if (!FLAG_SCHEDQUANTUM_ISSET)
+                    corereschedule = FALSE;
+            }
+#else
             /* Is the TaskReady empty? If yes, then the running task is the only one. Let it work */
             if (IsListEmpty(&SysBase->TaskReady))
                 corereschedule = FALSE;
             else
             {
-                struct Task *nexttask;
+                struct Task *nexttask = (struct Task *)GetHead(&SysBase->TaskReady);
                 /*
-                        If there are tasks ready for this cpu that have equal or lower priority,
+                        If there are tasks ready that have equal or lower priority,
                         and the current task has used its alloted time - reschedule so they can run
                     */
-                for (nexttask = (struct Task *)GetHead(&SysBase->TaskReady); nexttask != NULL; nexttask = (struct Task *)GetSucc(nexttask))
+                if (nexttask->tc_Node.ln_Pri <= task->tc_Node.ln_Pri)
                 {
-#if defined(__AROSEXEC_SMP__)
-                    if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity) || (GetIntETask(nexttask) && core_APIC_CPUInMask(cpuNo, GetIntETask(nexttask)->iet_CpuAffinity)))
-                    {
-#endif
-                     if (
-#if defined(__AROSEXEC_SMP__)
-                            (task->tc_State != TS_SPIN) &&
-
-#endif
-                            (nexttask->tc_Node.ln_Pri <= task->tc_Node.ln_Pri))
-                        {
-                            /* If the running task did not used it's whole quantum yet, let it work */
-                            if (!FLAG_SCHEDQUANTUM_ISSET)
-                                corereschedule = FALSE;
-                        }
-                        break;
-#if defined(__AROSEXEC_SMP__)
-                    }
-#endif
+                    /* If the running task did not used it's whole quantum yet, let it work */
+                    if (!FLAG_SCHEDQUANTUM_ISSET)
+                        corereschedule = FALSE;
                 }
             }
-#if defined(__AROSEXEC_SMP__)
-            KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
 #endif
         }
 
@@ -257,6 +604,7 @@ void core_Switch(void)
 #endif
         Enqueue(&SysBase->TaskReady, &task->tc_Node);
 #if defined(__AROSEXEC_SMP__)
+        core_RunQueueAdd(task);
         KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
 #endif
     }
@@ -304,12 +652,21 @@ struct Task *core_Dispatch(void)
 #if defined(__AROSEXEC_SMP__)
     KrnSpinLock(&PrivExecBase(SysBase)->TaskReadySpinLock, NULL,
                 SPINLOCK_MODE_WRITE);
+    if ((newtask = core_RunQueuePick(cpuNo)) != NULL)
+        REMOVE(&newtask->tc_Node);
+    else
+    {
+        /*
+         * Tasks readied before the run queues were set up, or without an ETask,
+         * are not indexed - fall back to looking through TaskReady for them.
+         */
 #endif
     for (newtask = (struct Task *)GetHead(&SysBase->TaskReady); newtask != NULL; newtask = (struct Task *)GetSucc(newtask))
     {
 #if defined(__AROSEXEC_SMP__)
         if (!(PrivExecBase(SysBase)->IntFlags & EXECF_CPUAffinity) || (GetIntETask(newtask) && core_APIC_CPUInMask(cpuNo, GetIntETask(newtask)->iet_CpuAffinity)))
         {
+            core_RunQueueRemove(newtask);
 #endif
             REMOVE(&newtask->tc_Node);
             break;
@@ -318,6 +675,7 @@ struct Task *core_Dispatch(void)
 #endif
     }
 #if defined(__AROSEXEC_SMP__)
+    }
     KrnSpinUnLock(&PrivExecBase(SysBase)->TaskReadySpinLock);
 #endif
 
@@ -433,3 +791,14 @@ bug("----> such unspinning should not take place!" DEBUGCOLOR_RESET "\n");
 
     return newtask;
 }
+
+/* This scheduler keeps its own ready queues, so only the default list handling is offered */
+BOOL core_SetScheduler(KRN_SchedType sched)
+{
+    return (sched == SCHED_RR);
+}
+
+KRN_SchedType core_GetScheduler(void)
+{
+    return SCHED_RR;
+}
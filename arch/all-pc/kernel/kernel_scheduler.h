@@ -8,9 +8,23 @@
 */
 
 #include <aros/config.h>
+#include <aros/kernel.h>
 
 #if defined(__AROSEXEC_SMP__)
 #include <exec/tasks.h>
+#include <exec/lists.h>
+#include <aros/types/spinlock_s.h>
+
+/*
+ * Each core keeps its own run queue of ready tasks, indexed by priority.
+ * Tasks remain on SysBase->TaskReady (so exec and tools that inspect it keep
+ * working), the run queue is only used to pick the next task without
+ * walking TaskReady and checking every task's affinity.
+ */
+#define SCHED_RUNQ_LEVELS       256
+#define SCHED_RUNQ_WORDS        (SCHED_RUNQ_LEVELS / 32)
+#define SCHED_RUNQ_LEVEL(pri)   ((ULONG)((LONG)(pri) + 128))
+#define SCHED_RUNQ_IDLELEVEL    SCHED_RUNQ_LEVEL(-128)
 
 struct X86SchedulerPrivate
 {
@@ -22,13 +36,25 @@ struct X86SchedulerPrivate
     UWORD               Elapsed;        /* # of heartbeat ticks, the current task has run       */
     BYTE                IDNestCnt;
     BYTE                TDNestCnt;
+
+    spinlock_t          RunQueueLock;   /* Protects this core's run queue                       */
+    ULONG               RunQueueCount;  /* # of tasks queued on this core                       */
+    ULONG               RunQueueSteals; /* # of tasks this core has taken from other cores      */
+    ULONG               RunQueueMigrations; /* # of tasks moved due to their affinity           */
+    ULONG               RunQueueMask[SCHED_RUNQ_WORDS]; /* bit set for each non-empty level     */
+    struct MinList      RunQueue[SCHED_RUNQ_LEVELS];    /* FIFO of ready tasks per priority     */
 };
 #endif
 
 BOOL core_Schedule(void);			/* Reschedule the current task if needed */
 void core_Switch(void);				/* Switch away from the current task     */
 struct Task *core_Dispatch(void);		/* Select the new task for execution     */
+BOOL core_SetScheduler(KRN_SchedType);		/* Select the ready list handling        */
+KRN_SchedType core_GetScheduler(void);
 #if defined(__AROSEXEC_SMP__)
 void core_InitScheduleData(struct X86SchedulerPrivate *);
+void core_RunQueueAdd(struct Task *);           /* Index a task added to TaskReady       */
+void core_RunQueueRemove(struct Task *);        /* Drop a task removed from TaskReady    */
+void core_RunQueueRequeue(struct Task *);       /* Requeue a task whose priority changed */
 #endif
 #endif /* !KERNEL_SCHEDULER_H */
\ No newline at end of file
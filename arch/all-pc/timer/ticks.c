@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2022, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Hardware management routines for IBM PC-AT timer
 */
@@ -140,7 +140,7 @@ void Timer0Setup(struct TimerBase *TimerBase)
     if (ExecLockBase)
         ObtainLock(TimerBase->tb_ListLock, SPINLOCK_MODE_READ, 0);
 #endif
-    if ((tr = (struct timerequest *)GetHead(&TimerBase->tb_Lists[TL_MICROHZ])) != NULL)
+    if ((tr = (struct timerequest *)GetHead(&TimerBase->tb_Queues[TL_MICROHZ].tq_Due)) != NULL)
     {
         time.tv_micro = tr->tr_time.tv_micro;
         time.tv_secs  = tr->tr_time.tv_secs;
@@ -269,3 +269,14 @@ struct Task *core_Dispatch(void)
 
     return newtask;
 }
+
+/* This scheduler keeps its own ready queues, so only the default list handling is offered */
+BOOL core_SetScheduler(KRN_SchedType sched)
+{
+    return (sched == SCHED_RR);
+}
+
+KRN_SchedType core_GetScheduler(void)
+{
+    return SCHED_RR;
+}
@@ -0,0 +1,348 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: AVX2 memory blit routines.
+*/
+
+#if defined(__AVX2__)
+#include <exec/types.h>
+
+#include <immintrin.h>
+
+#include "memblit.h"
+
+/* The same as in memblit_sse2.c, with twice as wide registers */
+
+/*
+ * Fill bytes bytes with a pattern that repeats every 2 or 4 bytes. At
+ * least 32 bytes have to be filled.
+ */
+static inline VOID avx2_fillrow(UBYTE *p, ULONG bytes, __m256i v, ULONG bpp)
+{
+    UBYTE *end = p + bytes;
+    ULONG skip = 32 - ((IPTR)p & 31);
+
+    _mm256_storeu_si256((__m256i *)p, v);
+    p += (skip % bpp) ? 32 : skip;
+
+    while (p + 128 <= end)
+    {
+        _mm256_storeu_si256((__m256i *)p, v);
+        _mm256_storeu_si256((__m256i *)(p + 32), v);
+        _mm256_storeu_si256((__m256i *)(p + 64), v);
+        _mm256_storeu_si256((__m256i *)(p + 96), v);
+        p += 128;
+    }
+    while (p + 32 <= end)
+    {
+        _mm256_storeu_si256((__m256i *)p, v);
+        p += 32;
+    }
+    if (p < end)
+        _mm256_storeu_si256((__m256i *)(end - 32), v);
+}
+
+VOID memblit_Fill16_AVX2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    const __m256i v = _mm256_set1_epi16(fill);
+
+    while (height--)
+    {
+        if (width >= 16)
+            avx2_fillrow(dst, width * 2, v, 2);
+        else
+        {
+            UWORD *p = (UWORD *)dst;
+            ULONG w;
+
+            for (w = 0; w < width; w++)
+                p[w] = fill;
+        }
+        dst += dstMod;
+    }
+}
+
+VOID memblit_Fill32_AVX2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    const __m256i v = _mm256_set1_epi32(fill);
+
+    while (height--)
+    {
+        if (width >= 8)
+            avx2_fillrow(dst, width * 4, v, 4);
+        else
+        {
+            ULONG *p = (ULONG *)dst;
+            ULONG w;
+
+            for (w = 0; w < width; w++)
+                p[w] = fill;
+        }
+        dst += dstMod;
+    }
+}
+
+/* 96 bytes hold 32 whole 24 bit pixels */
+VOID memblit_Fill24_AVX2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    UBYTE pattern[96];
+    __m256i v0, v1, v2;
+    ULONG i;
+
+    for (i = 0; i < 96; i += 3)
+    {
+        pattern[i]     =  fill & 0xFF;
+        pattern[i + 1] = (fill >> 8) & 0xFF;
+        pattern[i + 2] = (fill >> 16) & 0xFF;
+    }
+    v0 = _mm256_loadu_si256((const __m256i *)pattern);
+    v1 = _mm256_loadu_si256((const __m256i *)(pattern + 32));
+    v2 = _mm256_loadu_si256((const __m256i *)(pattern + 64));
+
+    while (height--)
+    {
+        UBYTE *p = dst;
+        ULONG bytes = width * 3;
+
+        while (bytes >= 96)
+        {
+            _mm256_storeu_si256((__m256i *)p, v0);
+            _mm256_storeu_si256((__m256i *)(p + 32), v1);
+            _mm256_storeu_si256((__m256i *)(p + 64), v2);
+            p += 96; bytes -= 96;
+        }
+
+        /* Carry on with the pattern where a 96 byte block starts */
+        for (i = 0; bytes >= 32; i += 32, p += 32, bytes -= 32)
+            _mm256_storeu_si256((__m256i *)p, (i == 0) ? v0 : v1);
+        if (bytes >= 16)
+        {
+            _mm_storeu_si128((__m128i *)p, _mm_loadu_si128((const __m128i *)(pattern + i)));
+            i += 16; p += 16; bytes -= 16;
+        }
+        while (bytes--)
+            *p++ = pattern[i++];
+
+        dst += dstMod;
+    }
+}
+
+/****************************************************************************************/
+
+static inline VOID avx2_copyforward(UBYTE *d, UBYTE *s, ULONG n)
+{
+    /* All loads come before the stores, so an overlap never loses data */
+    while (n >= 128)
+    {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)s);
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)(s + 32));
+        __m256i v2 = _mm256_loadu_si256((const __m256i *)(s + 64));
+        __m256i v3 = _mm256_loadu_si256((const __m256i *)(s + 96));
+
+        _mm256_storeu_si256((__m256i *)d, v0);
+        _mm256_storeu_si256((__m256i *)(d + 32), v1);
+        _mm256_storeu_si256((__m256i *)(d + 64), v2);
+        _mm256_storeu_si256((__m256i *)(d + 96), v3);
+        d += 128; s += 128; n -= 128;
+    }
+    while (n >= 32)
+    {
+        _mm256_storeu_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+        d += 32; s += 32; n -= 32;
+    }
+    if (n >= 16)
+    {
+        _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+        d += 16; s += 16; n -= 16;
+    }
+    while (n >= 4)
+    {
+        *(ULONG *)d = *(ULONG *)s;
+        d += 4; s += 4; n -= 4;
+    }
+    while (n--)
+        *d++ = *s++;
+}
+
+/* d and s point behind the bytes to copy */
+static inline VOID avx2_copybackward(UBYTE *d, UBYTE *s, ULONG n)
+{
+    while (n >= 128)
+    {
+        __m256i v0, v1, v2, v3;
+
+        d -= 128; s -= 128; n -= 128;
+        v0 = _mm256_loadu_si256((const __m256i *)s);
+        v1 = _mm256_loadu_si256((const __m256i *)(s + 32));
+        v2 = _mm256_loadu_si256((const __m256i *)(s + 64));
+        v3 = _mm256_loadu_si256((const __m256i *)(s + 96));
+
+        _mm256_storeu_si256((__m256i *)d, v0);
+        _mm256_storeu_si256((__m256i *)(d + 32), v1);
+        _mm256_storeu_si256((__m256i *)(d + 64), v2);
+        _mm256_storeu_si256((__m256i *)(d + 96), v3);
+    }
+    while (n >= 32)
+    {
+        d -= 32; s -= 32; n -= 32;
+        _mm256_storeu_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+    }
+    if (n >= 16)
+    {
+        d -= 16; s -= 16; n -= 16;
+        _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+    }
+    while (n >= 4)
+    {
+        d -= 4; s -= 4; n -= 4;
+        *(ULONG *)d = *(ULONG *)s;
+    }
+    while (n--)
+        *--d = *--s;
+}
+
+VOID memblit_Copy_AVX2(UBYTE *src, ULONG srcMod, UBYTE *dst, ULONG dstMod, ULONG bytes, ULONG height)
+{
+    if ((IPTR)src > (IPTR)dst)
+    {
+        while (height--)
+        {
+            avx2_copyforward(dst, src, bytes);
+            src += srcMod;
+            dst += dstMod;
+        }
+    }
+    else
+    {
+        /* The destination is behind the source, so start at the end */
+        src += (height - 1) * srcMod + bytes;
+        dst += (height - 1) * dstMod + bytes;
+
+        while (height--)
+        {
+            avx2_copybackward(dst, src, bytes);
+            src -= srcMod;
+            dst -= dstMod;
+        }
+    }
+}
+
+/****************************************************************************************/
+
+VOID memblit_Expand16_AVX2(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    const __m256i sel = _mm256_setr_epi16((WORD)0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100,
+                                          0x0080, 0x0040, 0x0020, 0x0010, 0x0008, 0x0004, 0x0002, 0x0001);
+    const __m256i vfg = _mm256_set1_epi16(fg);
+    const __m256i vbg = _mm256_set1_epi16(bg);
+    UWORD *p = (UWORD *)dst;
+
+    for (; count >= 16; count -= 16, p += 16, bits <<= 16, write <<= 16)
+    {
+        __m256i b, pix;
+
+        if (!(write >> 16))
+            continue;
+
+        b = _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(bits >> 16), sel), sel);
+        pix = _mm256_blendv_epi8(vbg, vfg, b);
+
+        if ((write >> 16) != 0xFFFF)
+        {
+            __m256i w = _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(write >> 16), sel), sel);
+
+            pix = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i *)p), pix, w);
+        }
+        _mm256_storeu_si256((__m256i *)p, pix);
+    }
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+VOID memblit_Expand32_AVX2(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    const __m256i sel = _mm256_setr_epi32((LONG)0x80000000, 0x40000000, 0x20000000, 0x10000000,
+                                          0x08000000, 0x04000000, 0x02000000, 0x01000000);
+    const __m256i vfg = _mm256_set1_epi32(fg);
+    const __m256i vbg = _mm256_set1_epi32(bg);
+    ULONG *p = (ULONG *)dst;
+
+    for (; count >= 8; count -= 8, p += 8, bits <<= 8, write <<= 8)
+    {
+        __m256i b, pix;
+
+        if (!(write >> 24))
+            continue;
+
+        b = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), sel), sel);
+        pix = _mm256_blendv_epi8(vbg, vfg, b);
+
+        if ((write >> 24) != 0xFF)
+        {
+            __m256i w = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(write), sel), sel);
+
+            pix = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i *)p), pix, w);
+        }
+        _mm256_storeu_si256((__m256i *)p, pix);
+    }
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+VOID memblit_Invert16_AVX2(UBYTE *dst, ULONG write, ULONG count)
+{
+    const __m256i sel = _mm256_setr_epi16((WORD)0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100,
+                                          0x0080, 0x0040, 0x0020, 0x0010, 0x0008, 0x0004, 0x0002, 0x0001);
+    UWORD *p = (UWORD *)dst;
+
+    for (; count >= 16; count -= 16, p += 16, write <<= 16)
+    {
+        __m256i w;
+
+        if (!(write >> 16))
+            continue;
+
+        w = _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16(write >> 16), sel), sel);
+        _mm256_storeu_si256((__m256i *)p, _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)p), w));
+    }
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+VOID memblit_Invert32_AVX2(UBYTE *dst, ULONG write, ULONG count)
+{
+    const __m256i sel = _mm256_setr_epi32((LONG)0x80000000, 0x40000000, 0x20000000, 0x10000000,
+                                          0x08000000, 0x04000000, 0x02000000, 0x01000000);
+    ULONG *p = (ULONG *)dst;
+
+    for (; count >= 8; count -= 8, p += 8, write <<= 8)
+    {
+        __m256i w;
+
+        if (!(write >> 24))
+            continue;
+
+        w = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(write), sel), sel);
+        _mm256_storeu_si256((__m256i *)p, _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)p), w));
+    }
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+#endif /* __AVX2__ */
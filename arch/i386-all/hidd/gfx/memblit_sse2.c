@@ -0,0 +1,336 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: SSE2 memory blit routines.
+*/
+
+#if defined(__SSE2__)
+#include <exec/types.h>
+
+#include <emmintrin.h>
+
+#include "memblit.h"
+
+/*
+ * Fill bytes bytes with a pattern that repeats every 2 or 4 bytes. At
+ * least 16 bytes have to be filled. The first and last stores may overlap
+ * the others, which is fine as long as they are a whole number of pixels
+ * apart.
+ */
+static inline VOID sse2_fillrow(UBYTE *p, ULONG bytes, __m128i v, ULONG bpp)
+{
+    UBYTE *end = p + bytes;
+    ULONG skip = 16 - ((IPTR)p & 15);
+
+    _mm_storeu_si128((__m128i *)p, v);
+    p += (skip % bpp) ? 16 : skip;
+
+    while (p + 64 <= end)
+    {
+        _mm_storeu_si128((__m128i *)p, v);
+        _mm_storeu_si128((__m128i *)(p + 16), v);
+        _mm_storeu_si128((__m128i *)(p + 32), v);
+        _mm_storeu_si128((__m128i *)(p + 48), v);
+        p += 64;
+    }
+    while (p + 16 <= end)
+    {
+        _mm_storeu_si128((__m128i *)p, v);
+        p += 16;
+    }
+    if (p < end)
+        _mm_storeu_si128((__m128i *)(end - 16), v);
+}
+
+VOID memblit_Fill16_SSE2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    const __m128i v = _mm_set1_epi16(fill);
+
+    while (height--)
+    {
+        if (width >= 8)
+            sse2_fillrow(dst, width * 2, v, 2);
+        else
+        {
+            UWORD *p = (UWORD *)dst;
+            ULONG w;
+
+            for (w = 0; w < width; w++)
+                p[w] = fill;
+        }
+        dst += dstMod;
+    }
+}
+
+VOID memblit_Fill32_SSE2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    const __m128i v = _mm_set1_epi32(fill);
+
+    while (height--)
+    {
+        if (width >= 4)
+            sse2_fillrow(dst, width * 4, v, 4);
+        else
+        {
+            ULONG *p = (ULONG *)dst;
+            ULONG w;
+
+            for (w = 0; w < width; w++)
+                p[w] = fill;
+        }
+        dst += dstMod;
+    }
+}
+
+/* 48 bytes hold 16 whole 24 bit pixels */
+VOID memblit_Fill24_SSE2(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    UBYTE pattern[48];
+    __m128i v0, v1, v2;
+    ULONG i;
+
+    for (i = 0; i < 48; i += 3)
+    {
+        /* Little endian, as on every CPU with SSE2 */
+        pattern[i]     =  fill & 0xFF;
+        pattern[i + 1] = (fill >> 8) & 0xFF;
+        pattern[i + 2] = (fill >> 16) & 0xFF;
+    }
+    v0 = _mm_loadu_si128((const __m128i *)pattern);
+    v1 = _mm_loadu_si128((const __m128i *)(pattern + 16));
+    v2 = _mm_loadu_si128((const __m128i *)(pattern + 32));
+
+    while (height--)
+    {
+        UBYTE *p = dst;
+        ULONG bytes = width * 3;
+
+        while (bytes >= 48)
+        {
+            _mm_storeu_si128((__m128i *)p, v0);
+            _mm_storeu_si128((__m128i *)(p + 16), v1);
+            _mm_storeu_si128((__m128i *)(p + 32), v2);
+            p += 48; bytes -= 48;
+        }
+
+        /* Carry on with the pattern where a 48 byte block starts */
+        for (i = 0; bytes >= 16; i += 16, p += 16, bytes -= 16)
+            _mm_storeu_si128((__m128i *)p, (i == 0) ? v0 : v1);
+        while (bytes--)
+            *p++ = pattern[i++];
+
+        dst += dstMod;
+    }
+}
+
+/****************************************************************************************/
+
+static inline VOID sse2_copyforward(UBYTE *d, UBYTE *s, ULONG n)
+{
+    /* All loads come before the stores, so an overlap never loses data */
+    while (n >= 64)
+    {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)s);
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i *)(s + 48));
+
+        _mm_storeu_si128((__m128i *)d, v0);
+        _mm_storeu_si128((__m128i *)(d + 16), v1);
+        _mm_storeu_si128((__m128i *)(d + 32), v2);
+        _mm_storeu_si128((__m128i *)(d + 48), v3);
+        d += 64; s += 64; n -= 64;
+    }
+    while (n >= 16)
+    {
+        _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+        d += 16; s += 16; n -= 16;
+    }
+    while (n >= 4)
+    {
+        *(ULONG *)d = *(ULONG *)s;
+        d += 4; s += 4; n -= 4;
+    }
+    while (n--)
+        *d++ = *s++;
+}
+
+/* d and s point behind the bytes to copy */
+static inline VOID sse2_copybackward(UBYTE *d, UBYTE *s, ULONG n)
+{
+    while (n >= 64)
+    {
+        __m128i v0, v1, v2, v3;
+
+        d -= 64; s -= 64; n -= 64;
+        v0 = _mm_loadu_si128((const __m128i *)s);
+        v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        v2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        v3 = _mm_loadu_si128((const __m128i *)(s + 48));
+
+        _mm_storeu_si128((__m128i *)d, v0);
+        _mm_storeu_si128((__m128i *)(d + 16), v1);
+        _mm_storeu_si128((__m128i *)(d + 32), v2);
+        _mm_storeu_si128((__m128i *)(d + 48), v3);
+    }
+    while (n >= 16)
+    {
+        d -= 16; s -= 16; n -= 16;
+        _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+    }
+    while (n >= 4)
+    {
+        d -= 4; s -= 4; n -= 4;
+        *(ULONG *)d = *(ULONG *)s;
+    }
+    while (n--)
+        *--d = *--s;
+}
+
+VOID memblit_Copy_SSE2(UBYTE *src, ULONG srcMod, UBYTE *dst, ULONG dstMod, ULONG bytes, ULONG height)
+{
+    if ((IPTR)src > (IPTR)dst)
+    {
+        while (height--)
+        {
+            sse2_copyforward(dst, src, bytes);
+            src += srcMod;
+            dst += dstMod;
+        }
+    }
+    else
+    {
+        /* The destination is behind the source, so start at the end */
+        src += (height - 1) * srcMod + bytes;
+        dst += (height - 1) * dstMod + bytes;
+
+        while (height--)
+        {
+            sse2_copybackward(dst, src, bytes);
+            src -= srcMod;
+            dst -= dstMod;
+        }
+    }
+}
+
+/****************************************************************************************/
+
+/*
+ * Template expansion. The chunk's bits are spread over the lanes with a
+ * compare against one bit per lane. Pixels that all get written are
+ * stored directly, others are merged with what is there.
+ */
+
+VOID memblit_Expand16_SSE2(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    const __m128i sel = _mm_setr_epi16((WORD)0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100);
+    const __m128i vfg = _mm_set1_epi16(fg);
+    const __m128i vbg = _mm_set1_epi16(bg);
+    UWORD *p = (UWORD *)dst;
+
+    for (; count >= 8; count -= 8, p += 8, bits <<= 8, write <<= 8)
+    {
+        __m128i b, pix;
+
+        if (!(write >> 24))
+            continue;
+
+        b = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(bits >> 16), sel), sel);
+        pix = _mm_or_si128(_mm_and_si128(b, vfg), _mm_andnot_si128(b, vbg));
+
+        if ((write >> 24) != 0xFF)
+        {
+            __m128i w = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(write >> 16), sel), sel);
+
+            pix = _mm_or_si128(_mm_and_si128(w, pix), _mm_andnot_si128(w, _mm_loadu_si128((const __m128i *)p)));
+        }
+        _mm_storeu_si128((__m128i *)p, pix);
+    }
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+VOID memblit_Expand32_SSE2(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    const __m128i sel = _mm_setr_epi32((LONG)0x80000000, 0x40000000, 0x20000000, 0x10000000);
+    const __m128i vfg = _mm_set1_epi32(fg);
+    const __m128i vbg = _mm_set1_epi32(bg);
+    ULONG *p = (ULONG *)dst;
+
+    for (; count >= 4; count -= 4, p += 4, bits <<= 4, write <<= 4)
+    {
+        __m128i b, pix;
+
+        if (!(write >> 28))
+            continue;
+
+        b = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), sel), sel);
+        pix = _mm_or_si128(_mm_and_si128(b, vfg), _mm_andnot_si128(b, vbg));
+
+        if ((write >> 28) != 0xF)
+        {
+            __m128i w = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(write), sel), sel);
+
+            pix = _mm_or_si128(_mm_and_si128(w, pix), _mm_andnot_si128(w, _mm_loadu_si128((const __m128i *)p)));
+        }
+        _mm_storeu_si128((__m128i *)p, pix);
+    }
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+VOID memblit_Invert16_SSE2(UBYTE *dst, ULONG write, ULONG count)
+{
+    const __m128i sel = _mm_setr_epi16((WORD)0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0400, 0x0200, 0x0100);
+    UWORD *p = (UWORD *)dst;
+
+    for (; count >= 8; count -= 8, p += 8, write <<= 8)
+    {
+        __m128i w;
+
+        if (!(write >> 24))
+            continue;
+
+        w = _mm_cmpeq_epi16(_mm_and_si128(_mm_set1_epi16(write >> 16), sel), sel);
+        _mm_storeu_si128((__m128i *)p, _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), w));
+    }
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+VOID memblit_Invert32_SSE2(UBYTE *dst, ULONG write, ULONG count)
+{
+    const __m128i sel = _mm_setr_epi32((LONG)0x80000000, 0x40000000, 0x20000000, 0x10000000);
+    ULONG *p = (ULONG *)dst;
+
+    for (; count >= 4; count -= 4, p += 4, write <<= 4)
+    {
+        __m128i w;
+
+        if (!(write >> 28))
+            continue;
+
+        w = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(write), sel), sel);
+        _mm_storeu_si128((__m128i *)p, _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), w));
+    }
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+#endif /* __SSE2__ */
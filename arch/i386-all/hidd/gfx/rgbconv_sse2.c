@@ -0,0 +1,131 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: SSE2 RGB conversion routines.
+*/
+
+#if defined(__SSE2__)
+#define DEBUG 0
+#include <aros/debug.h>
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include <emmintrin.h>
+
+#include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_simd.h"
+
+/*
+ * Without a byte shuffle instruction, pixels are converted with the
+ * masked shifts found by SetSIMDRGBConversionParams(). The shift counts
+ * only become known at runtime, so they are kept in registers.
+ */
+struct SSE2Shifts
+{
+    __m128i mask[4];
+    __m128i left[4];
+    __m128i right[4];
+};
+
+static inline void sse2_setupshifts(struct SSE2Shifts *shifts, struct RGBConvParams *rcp)
+{
+    ULONG i;
+
+    /* Unused shifts get an empty mask, so that the loops can be unrolled */
+    for (i = 0; i < 4; i++)
+    {
+        LONG shift = (i < rcp->rcp_NumShifts) ? rcp->rcp_Shift[i] : 0;
+
+        shifts->mask[i]  = _mm_set1_epi32((i < rcp->rcp_NumShifts) ? rcp->rcp_ShiftMask[i] : 0);
+        shifts->left[i]  = _mm_cvtsi32_si128((shift < 0) ? -shift : 0);
+        shifts->right[i] = _mm_cvtsi32_si128((shift > 0) ? shift : 0);
+    }
+}
+
+#define SSE2_SHIFT(shifts, p, i) \
+    _mm_srl_epi32(_mm_sll_epi32(_mm_and_si128(p, (shifts)->mask[i]), (shifts)->left[i]), (shifts)->right[i])
+
+static inline __m128i sse2_shift(struct SSE2Shifts *shifts, __m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(SSE2_SHIFT(shifts, p, 0), SSE2_SHIFT(shifts, p, 1)),
+                        _mm_or_si128(SSE2_SHIFT(shifts, p, 2), SSE2_SHIFT(shifts, p, 3)));
+}
+
+/* Pack 32 bit lanes to 16 bits. _mm_packs_epi32() saturates, so sign extend first. */
+static inline __m128i sse2_pack16(__m128i lo, __m128i hi)
+{
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+
+    return _mm_packs_epi32(lo, hi);
+}
+
+SIMDCONVERTFUNC(Shift32to16, SSE2)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    ULONG *src = (ULONG *)srcPixels;
+    UWORD *dst = (UWORD *)dstPixels;
+    ULONG vwidth = width & ~7;
+    struct SSE2Shifts shifts;
+    ULONG x, y;
+
+    D(bug("[GFX:SSE2] %s()\n", __func__);)
+
+    sse2_setupshifts(&shifts, rcp);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 8)
+        {
+            __m128i p0 = _mm_loadu_si128((const __m128i *)&src[x]);
+            __m128i p1 = _mm_loadu_si128((const __m128i *)&src[x + 4]);
+
+            p0 = sse2_shift(&shifts, p0);
+            p1 = sse2_shift(&shifts, p1);
+            _mm_storeu_si128((__m128i *)&dst[x], sse2_pack16(p0, p1));
+        }
+        src = (ULONG *)(((UBYTE *)src) + srcMod);
+        dst = (UWORD *)(((UBYTE *)dst) + dstMod);
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+SIMDCONVERTFUNC(Shift16to32, SSE2)
+{
+    struct RGBConvParams *rcp = RGBCONVPARAMS(srcPixFmt, dstPixFmt);
+    UWORD *src = (UWORD *)srcPixels;
+    ULONG *dst = (ULONG *)dstPixels;
+    ULONG vwidth = width & ~7;
+    const __m128i zero = _mm_setzero_si128();
+    struct SSE2Shifts shifts;
+    ULONG x, y;
+
+    D(bug("[GFX:SSE2] %s()\n", __func__);)
+
+    sse2_setupshifts(&shifts, rcp);
+
+    for (y = 0; y < height; y++)
+    {
+        for (x = 0; x < vwidth; x += 8)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i *)&src[x]);
+            __m128i p0 = _mm_unpacklo_epi16(p, zero);
+            __m128i p1 = _mm_unpackhi_epi16(p, zero);
+
+            _mm_storeu_si128((__m128i *)&dst[x], sse2_shift(&shifts, p0));
+            _mm_storeu_si128((__m128i *)&dst[x + 4], sse2_shift(&shifts, p1));
+        }
+        src = (UWORD *)(((UBYTE *)src) + srcMod);
+        dst = (ULONG *)(((UBYTE *)dst) + dstMod);
+    }
+
+    RGBCONV_TAIL(rcp, vwidth)
+
+    return 1;
+}
+
+#endif /* __SSE2__ */
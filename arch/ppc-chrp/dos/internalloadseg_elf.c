@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Code to dynamically load ELF executables
 
@@ -539,6 +539,7 @@ BPTR InternalLoadSeg_ELF
     BPTR               table __unused,
     SIPTR             *funcarray,
     LONG              *stack __unused,
+    ULONG              flags __unused,
     struct DosLibrary *DOSBase
 )
 {
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2013, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: BeginIO - Start up a timer.device request.
 */
@@ -131,7 +131,7 @@ AROS_LH1(void, BeginIO,
                     else
                     {
                         /* Ok, we add this to the list */
-                        if (timer_addToWaitList(TimerBase, &TimerBase->tb_Lists[TL_WAITVBL], timereq))
+                        if (timer_addToWaitList(TimerBase, &TimerBase->tb_Queues[TL_WAITVBL].tq_Due, timereq))
                         {
                             TimerSetup(TimerBase, initial_time);
                         }
@@ -146,7 +146,7 @@ AROS_LH1(void, BeginIO,
                     Disable();
                     AddTime(&timereq->tr_time, &TimerBase->tb_Elapsed);
                     /* Slot it into the list */
-                    if (timer_addToWaitList(TimerBase, &TimerBase->tb_Lists[TL_VBLANK], timereq))
+                    if (timer_addToWaitList(TimerBase, &TimerBase->tb_Queues[TL_VBLANK].tq_Due, timereq))
                     {
                         TimerSetup(TimerBase, initial_time);
                     }
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #define DEBUG 1
@@ -70,7 +70,7 @@ void SliceHandler(struct TimerBase *TimerBase, struct ExecBase *SysBase)
             that have completed. A completed request is one whose time
             is less than that of the elapsed time.
         */
-        ForeachNodeSafe(&TimerBase->tb_Lists[TL_VBLANK], tr, next)
+        ForeachNodeSafe(&TimerBase->tb_Queues[TL_VBLANK].tq_Due, tr, next)
         {
             if(CmpTime(&TimerBase->tb_Elapsed, &tr->tr_time) <= 0)
             {
@@ -92,7 +92,7 @@ void SliceHandler(struct TimerBase *TimerBase, struct ExecBase *SysBase)
                     tr->tr_time.tv_micro = 1000000 / SysBase->VBlankFrequency;
                     AddTime(&tr->tr_time, &TimerBase->tb_Elapsed);
 
-                    timer_addToWaitList(TimerBase, &TimerBase->tb_Lists[TL_VBLANK], tr);
+                    timer_addToWaitList(TimerBase, &TimerBase->tb_Queues[TL_VBLANK].tq_Due, tr);
                 }
                 else
                 {
@@ -117,7 +117,7 @@ void SliceHandler(struct TimerBase *TimerBase, struct ExecBase *SysBase)
             The other this is the "wait until a specified time". Here a request
             is complete if the time we are waiting for is before the current time.
         */
-        ForeachNodeSafe(&TimerBase->tb_Lists[TL_WAITVBL], tr, next)
+        ForeachNodeSafe(&TimerBase->tb_Queues[TL_WAITVBL].tq_Due, tr, next)
         {
             if(CmpTime(&TimerBase->tb_CurrentTime, &tr->tr_time) <= 0)
             {
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -92,7 +92,7 @@ void TimerSetup(struct TimerBase *TimerBase, uint32_t waste)
     struct timerequest *tr;
     uint32_t current_time;
 
-    tr = (struct timerequest *)GetHead(&TimerBase->tb_Lists[TL_WAITVBL]);
+    tr = (struct timerequest *)GetHead(&TimerBase->tb_Queues[TL_WAITVBL].tq_Due);
 
     if (tr)
     {
@@ -115,7 +115,7 @@ void TimerSetup(struct TimerBase *TimerBase, uint32_t waste)
         }
     }
 
-    tr = (struct timerequest *)GetHead(&TimerBase->tb_Lists[TL_VBLANK]);
+    tr = (struct timerequest *)GetHead(&TimerBase->tb_Queues[TL_VBLANK].tq_Due);
 
     if (tr)
     {
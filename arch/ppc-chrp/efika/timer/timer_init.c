@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2010, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Timer startup and device commands
 */
@@ -47,6 +47,7 @@ static int GM_UNIQUENAME(Init)(LIBBASETYPEPTR LIBBASE)
 {
     struct ExecBase *SysBase = getSysBase();
     void *KernelBase = getKernelBase();
+    ULONG i, j, l;
 
     TimerBase->tb_prev_tick = mftbl();
 
@@ -61,12 +62,24 @@ static int GM_UNIQUENAME(Init)(LIBBASETYPEPTR LIBBASE)
     D(bug("Timer period: %ld secs, %ld micros\n",
         LIBBASE->tb_VBlankTime.tv_secs, LIBBASE->tb_VBlankTime.tv_micro));
 
-    /* Initialise the lists */
-    NEWLIST( &LIBBASE->tb_Lists[0] );
-    NEWLIST( &LIBBASE->tb_Lists[1] );
-    NEWLIST( &LIBBASE->tb_Lists[2] );
-    NEWLIST( &LIBBASE->tb_Lists[3] );
-    NEWLIST( &LIBBASE->tb_Lists[4] );
+    /*
+     * Initialise the queues. Requests are kept sorted in tq_Due here, the
+     * timing wheel of the generic code is not used, but set up anyway.
+     */
+    for (i = 0; i < NUM_LISTS; i++)
+    {
+        NEWLIST(&LIBBASE->tb_Queues[i].tq_Due);
+        NEWLIST(&LIBBASE->tb_Queues[i].tq_Far);
+        for (l = 0; l < TIMER_LEVELS; l++)
+        {
+            for (j = 0; j < TIMER_WHEELSIZE; j++)
+                NEWLIST(&LIBBASE->tb_Queues[i].tq_Wheel[l][j]);
+            for (j = 0; j < TIMER_WHEELSIZE / 32; j++)
+                LIBBASE->tb_Queues[i].tq_Mask[l][j] = 0;
+        }
+        LIBBASE->tb_Queues[i].tq_Slot = 0;
+        LIBBASE->tb_Queues[i].tq_FarSlot = ~0ULL;
+    }
 
     void *OpenFirmwareBase = OpenResource("openfirmware.resource");
     void *key = OF_OpenKey("/builtin");
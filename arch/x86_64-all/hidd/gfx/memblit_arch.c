@@ -0,0 +1,64 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#define DEBUG 0
+#include <aros/debug.h>
+
+#include <exec/types.h>
+
+#include "memblit.h"
+
+#include "x86_cpu.h"
+
+extern VOID memblit_Fill16_SSE2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Fill24_SSE2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Fill32_SSE2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Copy_SSE2(UBYTE *, ULONG, UBYTE *, ULONG, ULONG, ULONG);
+extern VOID memblit_Expand16_SSE2(UBYTE *, ULONG, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Expand32_SSE2(UBYTE *, ULONG, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Invert16_SSE2(UBYTE *, ULONG, ULONG);
+extern VOID memblit_Invert32_SSE2(UBYTE *, ULONG, ULONG);
+
+extern VOID memblit_Fill16_AVX2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Fill24_AVX2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Fill32_AVX2(UBYTE *, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Copy_AVX2(UBYTE *, ULONG, UBYTE *, ULONG, ULONG, ULONG);
+extern VOID memblit_Expand16_AVX2(UBYTE *, ULONG, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Expand32_AVX2(UBYTE *, ULONG, ULONG, ULONG, ULONG, ULONG);
+extern VOID memblit_Invert16_AVX2(UBYTE *, ULONG, ULONG);
+extern VOID memblit_Invert32_AVX2(UBYTE *, ULONG, ULONG);
+
+void SetArchMemBlitFunctions(struct MemBlitFuncs *funcs)
+{
+    BOOL useAVX2 = has_avx2();
+
+    D(bug("[GFX:x86_64] %s: AVX2 %d\n", __func__, useAVX2);)
+
+    /*
+     * SSE2 is always there on x86_64. 24 bit templates and patterns keep
+     * the portable routines, as their pixels do not fit the lanes.
+     */
+    if (useAVX2)
+    {
+        funcs->mbf_Fill16   = memblit_Fill16_AVX2;
+        funcs->mbf_Fill24   = memblit_Fill24_AVX2;
+        funcs->mbf_Fill32   = memblit_Fill32_AVX2;
+        funcs->mbf_Copy     = memblit_Copy_AVX2;
+        funcs->mbf_Expand16 = memblit_Expand16_AVX2;
+        funcs->mbf_Expand32 = memblit_Expand32_AVX2;
+        funcs->mbf_Invert16 = memblit_Invert16_AVX2;
+        funcs->mbf_Invert32 = memblit_Invert32_AVX2;
+    }
+    else
+    {
+        funcs->mbf_Fill16   = memblit_Fill16_SSE2;
+        funcs->mbf_Fill24   = memblit_Fill24_SSE2;
+        funcs->mbf_Fill32   = memblit_Fill32_SSE2;
+        funcs->mbf_Copy     = memblit_Copy_SSE2;
+        funcs->mbf_Expand16 = memblit_Expand16_SSE2;
+        funcs->mbf_Expand32 = memblit_Expand32_SSE2;
+        funcs->mbf_Invert16 = memblit_Invert16_SSE2;
+        funcs->mbf_Invert32 = memblit_Invert32_SSE2;
+    }
+}
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2025, The AROS Development Team. All rights reserved.
+    Copyright (C) 2025-2026, The AROS Development Team. All rights reserved.
 */
 
 #define DEBUG 0
@@ -9,148 +9,82 @@
 #include <hidd/gfx.h>
 
 #include "colorconv/rgbconv_macros.h"
+#include "colorconv/rgbconv_simdparams.h"
 
-#undef ARCHCONVERTFUNCP
-#define ARCHCONVERTFUNCP(arch, a, b) \
-extern ULONG convert_ ## a ## _ ## b ## _ ## arch \
-    (APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt, \
-    APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt, \
-    UWORD width, UWORD height);
+#include "x86_cpu.h"
 
-#define SCCFSSE2(SRCPIXFMT, DSTPIXFMT) \
-    rgbconvertfuncs[FMT_##SRCPIXFMT - FIRST_RGB_STDPIXFMT][FMT_##DSTPIXFMT - FIRST_RGB_STDPIXFMT] = convert_##SRCPIXFMT##_##DSTPIXFMT##_SSE2;
+SIMDCONVERTFUNCP(Shift32to16, SSE2)
+SIMDCONVERTFUNCP(Shift16to32, SSE2)
 
-#define SCCFSSE3(SRCPIXFMT, DSTPIXFMT) \
-    rgbconvertfuncs[FMT_##SRCPIXFMT - FIRST_RGB_STDPIXFMT][FMT_##DSTPIXFMT - FIRST_RGB_STDPIXFMT] = convert_##SRCPIXFMT##_##DSTPIXFMT##_SSE3;
+SIMDCONVERTFUNCP(Shuffle32to32, SSSE3)
+SIMDCONVERTFUNCP(Shuffle24to32, SSSE3)
+SIMDCONVERTFUNCP(Shuffle32to24, SSSE3)
+SIMDCONVERTFUNCP(Shuffle24to24, SSSE3)
 
-#define SCCFAVX(SRCPIXFMT, DSTPIXFMT) \
-    rgbconvertfuncs[FMT_##SRCPIXFMT - FIRST_RGB_STDPIXFMT][FMT_##DSTPIXFMT - FIRST_RGB_STDPIXFMT] = convert_##SRCPIXFMT##_##DSTPIXFMT##_AVX;
-
-#if defined(__SSE__)
-ARCHCONVERTFUNCP(SSE2,BGRA32,XRGB32)
-ARCHCONVERTFUNCP(SSE2,XRGB32,BGRA32)
-#if defined(__SSSE3__)
-ARCHCONVERTFUNCP(SSE3,BGRA32,XRGB32)
-ARCHCONVERTFUNCP(SSE3,XRGB32,BGRA32)
-ARCHCONVERTFUNCP(SSE3,RGB24,XRGB32)
-ARCHCONVERTFUNCP(SSE3,BGR24,XRGB32)
-#endif
-#endif
-#if defined(__AVX__)
-ARCHCONVERTFUNCP(AVX,XRGB32,BGRA32)
-ARCHCONVERTFUNCP(AVX,BGRA32,XRGB32)
-
-ARCHCONVERTFUNCP(AVX,RGB24,XRGB32)
-ARCHCONVERTFUNCP(AVX,BGR24,XRGB32)
-ARCHCONVERTFUNCP(AVX,ARGB32,RGB24)
-ARCHCONVERTFUNCP(AVX,BGRA32,RGB24)
-
-ARCHCONVERTFUNCP(AVX,BGRA32,RGB15)
-ARCHCONVERTFUNCP(AVX,BGRA32,BGR15)
-ARCHCONVERTFUNCP(AVX,ARGB32,RGB15)
-ARCHCONVERTFUNCP(AVX,ARGB32,BGR15)
-
-ARCHCONVERTFUNCP(AVX,BGR15,ARGB32)
-ARCHCONVERTFUNCP(AVX,RGB15,ARGB32)
-
-#endif
-
-#define cpuid(num) \
-    do { asm volatile("cpuid":"=a"(eax),"=b"(ebx),"=c"(ecx),"=d"(edx):"a"(num)); } while(0)
-
-static int has_ssse3() {
-    ULONG eax, ebx, ecx, edx;
-    cpuid(0x00000001);
-    return (ecx & (1 << 9)) != 0; // Bit 9 of ECX = SSSE3
-}
-
-static int has_avx() {
-    ULONG eax, ebx, ecx, edx;
-    cpuid(0x00000001);
-    return (ecx & (1 << 28)) != 0; // Bit 28 of ECX = AVX
-}
+SIMDCONVERTFUNCP(Shuffle32to32, AVX2)
+SIMDCONVERTFUNCP(Shuffle24to32, AVX2)
+SIMDCONVERTFUNCP(Shuffle32to24, AVX2)
+SIMDCONVERTFUNCP(Shift32to16, AVX2)
+SIMDCONVERTFUNCP(Shift16to32, AVX2)
 
 void SetArchRGBConversionFunctions(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
 {
-    BOOL useSSE3 = FALSE, useAVX = FALSE;
+    BOOL useSSSE3 = has_ssse3(), useAVX2 = has_avx2();
+    ULONG src, dst;
 
-    D(bug("[GFX:x86_64] %s()\n", __func__);)
+    D(bug("[GFX:x86_64] %s: SSSE3 %d AVX2 %d\n", __func__, useSSSE3, useAVX2);)
+
+    SetSIMDRGBConversionParams(rgbconvertfuncs);
 
     /*
-     * Following color conversion routines are most used on 32bit displays
-     * (VESA, X11, Nouveau)
-     *
-     * XRGB32 -> BGRA32
-     * BGRA32 -> XRGB32
-     * BGR24  -> XRGB32
-     * BGRX32 -> XRGB32
-     * ARGB32 -> BGRA32
-     *
-     * (See rgbconv_macros.h for definitions of XRGB32,... etc)
+     * SSE2 is always there on x86_64, but without a byte shuffle the
+     * 32 bit to 32 bit conversions are no faster than the scalar ones,
+     * so those keep their scalar routine.
      */
-
-    if (has_ssse3())
-        useSSE3 = TRUE;
-
-    if (has_avx())
-        useAVX = TRUE;
-
-    SCCFSSE2(XRGB32,BGRA32)
-    SCCFSSE2(BGRA32,XRGB32)
-#if defined(__SSSE3__)
-    if (useSSE3)
+    for (src = 0; src < NUM_RGB_STDPIXFMT; src++)
     {
-        D(bug("[GFX:x86_64] %s: using SSSE3 based operations\n", __func__);)
-        SCCFSSE3(XRGB32,BGRA32)
-        SCCFSSE3(BGRA32,XRGB32)
-        SCCFSSE3(BGR24,XRGB32) 
-        SCCFSSE3(RGB24,XRGB32)
+        for (dst = 0; dst < NUM_RGB_STDPIXFMT; dst++)
+        {
+            HIDDT_RGBConversionFunction f = NULL;
+            struct RGBConvParams *rcp;
+
+            if (!rgbconv_paramindex[src][dst])
+                continue;
+            rcp = &rgbconv_params[rgbconv_paramindex[src][dst] - 1];
+
+            if ((rcp->rcp_SrcBpp == 4) && (rcp->rcp_DstBpp == 4))
+            {
+                if (useAVX2 && (rcp->rcp_Flags & RCPF_SHUFFLE))
+                    f = convert_Shuffle32to32_AVX2;
+                else if (useSSSE3 && (rcp->rcp_Flags & RCPF_SHUFFLE))
+                    f = convert_Shuffle32to32_SSSE3;
+            }
+            else if ((rcp->rcp_SrcBpp == 3) && (rcp->rcp_DstBpp == 4))
+            {
+                if (useAVX2)
+                    f = convert_Shuffle24to32_AVX2;
+                else if (useSSSE3)
+                    f = convert_Shuffle24to32_SSSE3;
+            }
+            else if ((rcp->rcp_SrcBpp == 4) && (rcp->rcp_DstBpp == 3))
+            {
+                if (useAVX2)
+                    f = convert_Shuffle32to24_AVX2;
+                else if (useSSSE3)
+                    f = convert_Shuffle32to24_SSSE3;
+            }
+            else if ((rcp->rcp_SrcBpp == 3) && (rcp->rcp_DstBpp == 3))
+            {
+                if (useSSSE3)
+                    f = convert_Shuffle24to24_SSSE3;
+            }
+            else if (rcp->rcp_DstBpp == 2)
+                f = useAVX2 ? convert_Shift32to16_AVX2 : convert_Shift32to16_SSE2;
+            else
+                f = useAVX2 ? convert_Shift16to32_AVX2 : convert_Shift16to32_SSE2;
+
+            if (f)
+                rgbconvertfuncs[src][dst] = f;
+        }
     }
-#endif
-#if defined(__AVX__)
-    if (useAVX)
-    {
-        D(bug("[GFX:x86_64] %s: using AVX based operations\n", __func__);)
-        SCCFAVX(XRGB32,BGRA32)
-        SCCFAVX(BGRA32,XRGB32)
-
-        SCCFAVX(BGR24,XRGB32)
-        SCCFAVX(RGB24,XRGB32)
-        SCCFAVX(ARGB32,RGB24)
-        SCCFAVX(BGRA32,RGB24)
-
-        SCCFAVX(BGRA32,RGB15)
-        SCCFAVX(BGRA32,BGR15)
-        SCCFAVX(ARGB32,RGB15)
-        SCCFAVX(ARGB32,BGR15)
-        SCCFAVX(BGR15,ARGB32)
-        SCCFAVX(RGB15,ARGB32)
-    }
-#endif
-
-    rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_BGRX32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_BGRA32 - FIRST_RGB_STDPIXFMT];
-    rgbconvertfuncs[FMT_BGRX32 - FIRST_RGB_STDPIXFMT][FMT_XRGB32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGRA32 - FIRST_RGB_STDPIXFMT][FMT_XRGB32 - FIRST_RGB_STDPIXFMT];
-    rgbconvertfuncs[FMT_ARGB32 - FIRST_RGB_STDPIXFMT][FMT_BGRA32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_BGRA32 - FIRST_RGB_STDPIXFMT];
-    rgbconvertfuncs[FMT_BGRA32 - FIRST_RGB_STDPIXFMT][FMT_ARGB32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGRX32 - FIRST_RGB_STDPIXFMT][FMT_XRGB32 - FIRST_RGB_STDPIXFMT];
-
-#if defined(__SSSE3__) || defined(__AVX__)
-    if ((useSSE3) || (useAVX))
-    {
-        rgbconvertfuncs[FMT_RGB24 - FIRST_RGB_STDPIXFMT][FMT_ARGB32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_RGB24 - FIRST_RGB_STDPIXFMT][FMT_XRGB32 - FIRST_RGB_STDPIXFMT];
-        rgbconvertfuncs[FMT_BGR24 - FIRST_RGB_STDPIXFMT][FMT_ARGB32 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGR24 - FIRST_RGB_STDPIXFMT][FMT_XRGB32 - FIRST_RGB_STDPIXFMT];
-    }
-#endif
-#if defined(__AVX__)
-    if (useAVX)
-    {
-        rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_RGB24 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_ARGB32- FIRST_RGB_STDPIXFMT][FMT_RGB24 - FIRST_RGB_STDPIXFMT];
-        rgbconvertfuncs[FMT_BGRX32 - FIRST_RGB_STDPIXFMT][FMT_RGB24 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGRA32- FIRST_RGB_STDPIXFMT][FMT_RGB24 - FIRST_RGB_STDPIXFMT];
-
-        rgbconvertfuncs[FMT_BGRX32 - FIRST_RGB_STDPIXFMT][FMT_RGB15 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGRA32- FIRST_RGB_STDPIXFMT][FMT_RGB15 - FIRST_RGB_STDPIXFMT];
-        rgbconvertfuncs[FMT_BGRX32 - FIRST_RGB_STDPIXFMT][FMT_BGR15 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_BGRA32 - FIRST_RGB_STDPIXFMT][FMT_BGR15- FIRST_RGB_STDPIXFMT];
-        rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_RGB15 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_ARGB32- FIRST_RGB_STDPIXFMT][FMT_RGB15 - FIRST_RGB_STDPIXFMT];
-        rgbconvertfuncs[FMT_XRGB32 - FIRST_RGB_STDPIXFMT][FMT_BGR15 - FIRST_RGB_STDPIXFMT] = rgbconvertfuncs[FMT_ARGB32 - FIRST_RGB_STDPIXFMT][FMT_BGR15- FIRST_RGB_STDPIXFMT];
-    }
-#endif
-
 }
@@ -0,0 +1,46 @@
+#ifndef X86_CPU_H
+#define X86_CPU_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: CPU feature checks for choosing the gfx hidd's vector routines.
+*/
+
+#define cpuid(num, sub) \
+    do { asm volatile("cpuid":"=a"(eax),"=b"(ebx),"=c"(ecx),"=d"(edx):"a"(num),"c"(sub)); } while(0)
+
+static inline BOOL has_ssse3(void)
+{
+    ULONG eax, ebx, ecx, edx;
+
+    cpuid(0x00000001, 0);
+    return (ecx & (1 << 9)) != 0; // Bit 9 of ECX = SSSE3
+}
+
+/*
+ * AVX2 needs the CPU to support it, and the kernel to save the
+ * upper halves of the ymm registers on task switches.
+ */
+static inline BOOL has_avx2(void)
+{
+    ULONG eax, ebx, ecx, edx;
+    ULONG xcr0;
+
+    cpuid(0x00000000, 0);
+    if (eax < 7)
+        return FALSE;
+
+    cpuid(0x00000001, 0);
+    if (!(ecx & (1 << 27)) || !(ecx & (1 << 28)))  // OSXSAVE and AVX
+        return FALSE;
+
+    asm volatile("xgetbv":"=a"(xcr0),"=d"(edx):"c"(0));
+    if ((xcr0 & 6) != 6)                            // xmm and ymm state enabled
+        return FALSE;
+
+    cpuid(0x00000007, 0);
+    return (ebx & (1 << 5)) != 0; // Bit 5 of EBX = AVX2
+}
+
+#endif /* X86_CPU_H */
@@ -0,0 +1,232 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Per task caches of free memory blocks for malloc() and free().
+*/
+
+#include "__stdc_intbase.h"
+#include "__malloc.h"
+
+#include <exec/memory.h>
+#include <proto/exec.h>
+#include <proto/task.h>
+#include <resources/task.h>
+#include <aros/debug.h>
+
+#include "debug.h"
+
+/*
+ * Pool block sizes of the cached size classes, including the header. They
+ * match the slab classes of exec's MEMF_SLAB pools, so that every block
+ * fills a slab object exactly.
+ */
+static const UWORD mcache_blocks[MALLOC_CLASSES] =
+{
+    16, 32, 48, 64, 96, 128, 192, MALLOC_SLAB_MAX
+};
+
+int __stdc_mcache_class(size_t size)
+{
+    int mclass;
+
+    for (mclass = 0; mclass < MALLOC_CLASSES; mclass++)
+    {
+        if (size + MALLOC_HEADER <= mcache_blocks[mclass])
+            return mclass;
+    }
+    return -1;
+}
+
+void *__stdc_pool_alloc(struct StdCIntBase *StdCBase, size_t size)
+{
+    void *mem;
+
+    ObtainSemaphore(&StdCBase->memlock);
+    mem = AllocPooled(StdCBase->mempool, size);
+    ReleaseSemaphore(&StdCBase->memlock);
+
+    return mem;
+}
+
+void __stdc_pool_free(struct StdCIntBase *StdCBase, void *mem, size_t size)
+{
+    ObtainSemaphore(&StdCBase->memlock);
+    FreePooled(StdCBase->mempool, mem, size);
+    ReleaseSemaphore(&StdCBase->memlock);
+}
+
+/* Give all blocks of a cache back to the pool. Called with memlock held. */
+static void mcache_flush(struct StdCIntBase *StdCBase, struct MallocCache *mc)
+{
+    int mclass;
+
+    for (mclass = 0; mclass < MALLOC_CLASSES; mclass++)
+    {
+        size_t size = mcache_blocks[mclass];
+
+        while (mc->mc_Free[mclass])
+        {
+            void *mem = mc->mc_Free[mclass];
+
+            mc->mc_Free[mclass] = *((void **)mem);
+            FreePooled(StdCBase->mempool, mem, size);
+        }
+        mc->mc_Count[mclass] = 0;
+    }
+}
+
+/*
+ * Find a cache whose task has gone away, empty it and hand it out again.
+ * Tasks do not tell us when they exit, so the list of running tasks is
+ * checked whenever a new task needs a cache. Called with memlock held.
+ */
+static struct MallocCache *mcache_reclaim(struct StdCIntBase *StdCBase)
+{
+    struct MallocCache *mc;
+    struct TaskList *tl;
+    struct Task *task;
+
+    if (IsListEmpty((struct List *)&StdCBase->mcache_list))
+        return NULL;
+
+    ForeachNode(&StdCBase->mcache_list, mc)
+        mc->mc_Alive = FALSE;
+
+    tl = LockTaskList(LTF_ALL);
+    while ((task = NextTaskEntry(tl, LTF_ALL)) != NULL)
+    {
+        ForeachNode(&StdCBase->mcache_list, mc)
+        {
+            if (mc->mc_Task == task)
+                mc->mc_Alive = TRUE;
+        }
+    }
+    UnLockTaskList(tl, LTF_ALL);
+
+    ForeachNode(&StdCBase->mcache_list, mc)
+    {
+        if (!mc->mc_Alive)
+        {
+            D(bug("[%s] %s: reusing cache 0x%p of task 0x%p\n", STDCNAME, __func__, mc, mc->mc_Task));
+            mcache_flush(StdCBase, mc);
+            return mc;
+        }
+    }
+
+    return NULL;
+}
+
+/* Return the calling task's cache, setting one up if needed */
+static struct MallocCache *mcache_get(struct StdCIntBase *StdCBase)
+{
+    struct Task *me = FindTask(NULL);
+    struct MallocCache *mc;
+    int mclass;
+
+    if (!StdCBase->mcache_slot)
+        return NULL;
+
+    /* A child task may have inherited its parent's slot value, so check the owner */
+    mc = (struct MallocCache *)GetTaskStorageSlot(StdCBase->mcache_slot);
+    if (mc && (mc->mc_Task == me))
+        return mc;
+
+    ObtainSemaphore(&StdCBase->memlock);
+    if ((mc = mcache_reclaim(StdCBase)) == NULL)
+    {
+        if ((mc = AllocPooled(StdCBase->mempool, sizeof(struct MallocCache))) != NULL)
+        {
+            for (mclass = 0; mclass < MALLOC_CLASSES; mclass++)
+            {
+                mc->mc_Free[mclass] = NULL;
+                mc->mc_Count[mclass] = 0;
+            }
+            AddTail((struct List *)&StdCBase->mcache_list, (struct Node *)&mc->mc_Node);
+        }
+    }
+    if (mc)
+    {
+        mc->mc_Task = me;
+
+        /* Plain tasks without an ETask have no storage slots */
+        if (!SetTaskStorageSlot(StdCBase->mcache_slot, (IPTR)mc))
+        {
+            mc->mc_Task = NULL;
+            mc = NULL;
+        }
+    }
+    ReleaseSemaphore(&StdCBase->memlock);
+
+    D(bug("[%s] %s: task 0x%p uses cache 0x%p\n", STDCNAME, __func__, me, mc));
+
+    return mc;
+}
+
+/* Get a block of the given class, returns the start of its header */
+void *__stdc_mcache_alloc(struct StdCIntBase *StdCBase, int mclass)
+{
+    struct MallocCache *mc = mcache_get(StdCBase);
+    size_t size = mcache_blocks[mclass];
+    void *mem;
+
+    if (!mc)
+        return __stdc_pool_alloc(StdCBase, size);
+
+    if (!mc->mc_Free[mclass])
+    {
+        int i;
+
+        /* Refill with a batch of blocks, taking the pool lock only once */
+        ObtainSemaphore(&StdCBase->memlock);
+        for (i = 0; i < MALLOC_BATCH; i++)
+        {
+            if ((mem = AllocPooled(StdCBase->mempool, size)) == NULL)
+                break;
+            *((void **)mem) = mc->mc_Free[mclass];
+            mc->mc_Free[mclass] = mem;
+            mc->mc_Count[mclass]++;
+        }
+        ReleaseSemaphore(&StdCBase->memlock);
+
+        if (!mc->mc_Free[mclass])
+            return NULL;
+    }
+
+    mem = mc->mc_Free[mclass];
+    mc->mc_Free[mclass] = *((void **)mem);
+    mc->mc_Count[mclass]--;
+
+    return mem;
+}
+
+/* Put a block of the given class, starting at its header, into the cache */
+void __stdc_mcache_free(struct StdCIntBase *StdCBase, void *mem, int mclass)
+{
+    struct MallocCache *mc = mcache_get(StdCBase);
+    size_t size = mcache_blocks[mclass];
+
+    if (!mc)
+    {
+        __stdc_pool_free(StdCBase, mem, size);
+        return;
+    }
+
+    *((void **)mem) = mc->mc_Free[mclass];
+    mc->mc_Free[mclass] = mem;
+
+    if (++mc->mc_Count[mclass] > MALLOC_CACHE_DEPTH)
+    {
+        int i;
+
+        /* Give a batch back, so that other tasks can use the memory */
+        ObtainSemaphore(&StdCBase->memlock);
+        for (i = 0; i < MALLOC_BATCH; i++)
+        {
+            mem = mc->mc_Free[mclass];
+            mc->mc_Free[mclass] = *((void **)mem);
+            FreePooled(StdCBase->mempool, mem, size);
+        }
+        mc->mc_Count[mclass] -= MALLOC_BATCH;
+        ReleaseSemaphore(&StdCBase->memlock);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef ___MALLOC_H
+#define ___MALLOC_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Per task caches of free memory blocks for malloc() and free().
+*/
+
+#include <exec/types.h>
+#include <exec/lists.h>
+#include <exec/tasks.h>
+
+/*
+ * Every task that calls malloc() or free() gets a small cache of free
+ * blocks for each size class. Most calls are served from it without
+ * touching the pool, which is shared by all tasks using this StdCBase
+ * and therefore locked. Blocks move between a cache and the pool in
+ * batches of MALLOC_BATCH, taking the pool lock once per batch.
+ */
+#define MALLOC_CLASSES          8
+#define MALLOC_CACHE_DEPTH      32      /* Max. free blocks kept per class         */
+#define MALLOC_BATCH            16      /* Blocks moved to or from the pool at once */
+
+/* Size of the header in front of every malloc()ed block */
+#define MALLOC_HEADER           AROS_ALIGN(sizeof(size_t))
+
+/*
+ * Largest cached block, header included. This is the largest slab class
+ * of exec pools (POOLSLAB_MAXSIZE), so the header must fit in it too.
+ */
+#define MALLOC_SLAB_MAX         256
+#define MALLOC_CACHE_MAX        (MALLOC_SLAB_MAX - MALLOC_HEADER) /* Largest request served from the caches */
+
+struct MallocCache
+{
+    struct MinNode      mc_Node;
+    struct Task         *mc_Task;                       /* Only this task uses the cache */
+    BOOL                mc_Alive;                       /* Used while looking for unused caches */
+    APTR                mc_Free[MALLOC_CLASSES];        /* Free blocks, linked through their header */
+    ULONG               mc_Count[MALLOC_CLASSES];
+};
+
+struct StdCIntBase;
+
+int __stdc_mcache_class(size_t size);
+void *__stdc_mcache_alloc(struct StdCIntBase *StdCBase, int mclass);
+void __stdc_mcache_free(struct StdCIntBase *StdCBase, void *mem, int mclass);
+void *__stdc_pool_alloc(struct StdCIntBase *StdCBase, size_t size);
+void __stdc_pool_free(struct StdCIntBase *StdCBase, void *mem, size_t size);
+
+#endif /* ___MALLOC_H */
@@ -15,6 +15,7 @@
 #include <devices/timer.h>
 #include <dos/bptr.h>
 #include <dos/dos.h>
+#include <exec/semaphores.h>
 
 #include <aros/types/wchar_t.h>
 #include <aros/types/wctype_t.h>
@@ -42,6 +43,9 @@ struct StdCIntBase
 
     /* stdlib.h */
     APTR                        mempool;
+    struct SignalSemaphore      memlock;                // Protects mempool and mcache_list
+    LONG                        mcache_slot;            // Task storage slot of the malloc caches
+    struct MinList              mcache_list;
     unsigned int                srand_seed;
 
     /* time.h and it's functions */
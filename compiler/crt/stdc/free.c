@@ -6,6 +6,7 @@
 
 #include "__stdc_intbase.h"
 #include "__memalign.h"
+#include "__malloc.h"
 
 #include <exec/memory.h>
 #include <proto/exec.h>
@@ -50,17 +51,22 @@
 
         unsigned char *mem;
         size_t         size;
+        int            mclass;
 
-        mem = ((UBYTE *)memory) - AROS_ALIGN(sizeof(size_t));
+        mem = ((UBYTE *)memory) - MALLOC_HEADER;
 
         size = *((size_t *) mem);
         if (size == MEMALIGN_MAGIC) {
             mem -= AROS_ALIGN(sizeof(void *));
             free(((void **) mem)[0]);
         }
+        else if ((size <= MALLOC_CACHE_MAX) && ((mclass = __stdc_mcache_class(size)) >= 0)) {
+            /* Same size class as malloc() used for it */
+            __stdc_mcache_free(StdCBase, mem, mclass);
+        }
         else {
-            size += AROS_ALIGN(sizeof(size_t));
-            FreePooled (StdCBase->mempool, mem, size);
+            size += MALLOC_HEADER;
+            __stdc_pool_free(StdCBase, mem, size);
         }
     }
 
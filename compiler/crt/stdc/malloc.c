@@ -5,11 +5,13 @@
 */
 
 #include "__stdc_intbase.h"
+#include "__malloc.h"
 
 #include <errno.h>
 #include <dos/dos.h>
 #include <exec/memory.h>
 #include <proto/exec.h>
+#include <proto/task.h>
 #include <aros/symbolsets.h>
 #include <aros/debug.h>
 
@@ -47,18 +49,27 @@
         free()
 
     INTERNALS
+        Requests of up to 256 bytes are rounded up to a size class and
+        served from a per task cache of free blocks. The caches exchange
+        blocks with the shared memory pool in batches, so tasks rarely
+        contend for the pool's lock.
 
 ******************************************************************************/
 {
     struct StdCIntBase *StdCBase = (struct StdCIntBase *)__aros_getbase_StdCBase();
     UBYTE *mem = NULL;
+    int mclass;
 
     /* Allocate the memory */
-    mem = AllocPooled (StdCBase->mempool, size + AROS_ALIGN(sizeof(size_t)));
+    if ((size <= MALLOC_CACHE_MAX) && ((mclass = __stdc_mcache_class(size)) >= 0))
+        mem = __stdc_mcache_alloc(StdCBase, mclass);
+    else
+        mem = __stdc_pool_alloc(StdCBase, size + MALLOC_HEADER);
+
     if (mem)
     {
         *((size_t *)mem) = size;
-        mem += AROS_ALIGN(sizeof(size_t));
+        mem += MALLOC_HEADER;
     }
     else
         errno = ENOMEM;
@@ -74,7 +85,13 @@ int __init_memstuff(struct StdCIntBase *StdCBase)
           FindTask(NULL), StdCBase
     ));
 
-    StdCBase->mempool = CreatePool(MEMF_ANY | MEMF_SEM_PROTECTED, 65536L, 4096L);
+    /*
+     * The pool is locked by memlock rather than MEMF_SEM_PROTECTED, so the
+     * malloc caches can move a whole batch of blocks under one lock.
+     */
+    InitSemaphore(&StdCBase->memlock);
+    NEWLIST((struct List *)&StdCBase->mcache_list);
+    StdCBase->mempool = CreatePool(MEMF_ANY | MEMF_SLAB, 65536L, 4096L);
 
     D(bug("[%s] %s: StdCBase->mempool(0x%p)\n", STDCNAME, __func__, StdCBase->mempool));
 
@@ -83,6 +100,9 @@ int __init_memstuff(struct StdCIntBase *StdCBase)
         return 0;
     }
 
+    /* Without a slot malloc() simply goes to the pool every time */
+    StdCBase->mcache_slot = AllocTaskStorageSlot();
+
     return 1;
 }
 
@@ -93,6 +113,13 @@ void __exit_memstuff(struct StdCIntBase *StdCBase)
           FindTask(NULL), StdCBase, StdCBase->mempool
     ));
 
+    if (StdCBase->mcache_slot)
+    {
+        FreeTaskStorageSlot(StdCBase->mcache_slot);
+        StdCBase->mcache_slot = 0;
+    }
+
+    /* This also frees the caches and the blocks in them */
     if (StdCBase->mempool)
     {
         DeletePool(StdCBase->mempool);
@@ -15,7 +15,8 @@
 /* Type of scheduler. See KrnGetScheduler()/KrnSetScheduler() functions. */
 typedef enum
 {
-    SCHED_RR = 1	/* Old good round robin scheduler */
+    SCHED_RR = 1,	/* Old good round robin scheduler */
+    SCHED_PRI = 2	/* Round robin, ready list indexed by a priority bitmap */
 } KRN_SchedType;
 
 /* Flags for KrnMapGlobal */
@@ -2,7 +2,7 @@
 #define DATATYPES_PICTURECLASS_H
 
 /*
-    Copyright  1995-2018, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Includes for pictureclass
@@ -127,11 +127,23 @@ struct ColorRegister
 #define PDTA_DelayRead		(DTA_Dummy + 225)
 #define PDTA_DelayedRead	(DTA_Dummy + 226)
 
+/* PDTA_ScaleQuality values, used when scaling to a truecolor destination */
+#define PDTSCALE_Fast           (0)     /* Nearest neighbour */
+#define PDTSCALE_Smooth         (1)     /* Area averaging when shrinking,
+                                           linear interpolation when enlarging */
+#define PDTSCALE_Lanczos        (2)     /* Lanczos3 filter, AROS extension */
+
 #define PDTA_SourceMode         (DTA_Dummy + 250)
 #define PDTA_DestMode           (DTA_Dummy + 251)
 #define PDTA_UseFriendBitMap    (DTA_Dummy + 255)
 #define PDTA_MaskPlane          (DTA_Dummy + 258)
 
+/* AROS extensions, OM_NEW only: the largest size the picture is going to be
+   shown at. Sub datatypes which can decode at a reduced size (like JPEG) may
+   then load it smaller, but not smaller than this. */
+#define PDTA_MaxDecodeWidth     (DTA_Dummy + 270)
+#define PDTA_MaxDecodeHeight    (DTA_Dummy + 271)
+
 #define PDTM_Dummy              (DTM_Dummy + 0x60)
 #define PDTM_WRITEPIXELARRAY    (PDTM_Dummy + 0)
 #define PDTM_READPIXELARRAY     (PDTM_Dummy + 1)
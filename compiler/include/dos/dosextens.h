@@ -622,6 +622,19 @@ struct StandardPacket
     struct DosPacket sp_Pkt;
 };
 
+/* A set of packets that can be in flight at the same time, as returned by
+   CreateAsyncPktPool(). All fields are READ-ONLY. The structure is larger
+   than shown here. */
+struct AsyncPktPool
+{
+    struct MsgPort * app_Port;    /* Replies arrive here. Wait() on its
+                                     signal bit to overlap with other
+                                     events. */
+    ULONG            app_Size;    /* Number of packets in the pool. */
+    ULONG            app_Pending; /* Packets sent whose replies haven't been
+                                     collected yet. */
+};
+
 
 /* NOTE: AROS doesn't use startup packets. This will ONLY make a difference
          for shell writers... */
@@ -91,6 +91,8 @@ struct MemList
 #define MEMF_HWALIGNED     (1L << MEMB_HWALIGNED)
 #define MEMB_SEM_PROTECTED 20           /* For CreatePool() - add semaphore protection to the pool */
 #define MEMF_SEM_PROTECTED (1L << MEMB_SEM_PROTECTED)
+#define MEMB_SLAB          21           /* For CreatePool() - serve small allocations from size class slabs */
+#define MEMF_SLAB          (1L << MEMB_SLAB)
 #define MEMB_NO_EXPUNGE    31
 #define MEMF_NO_EXPUNGE    (1L << MEMB_NO_EXPUNGE)
 
@@ -27,6 +27,10 @@
 #include <proto/exec.h>
 #include <proto/dos.h>
 #include <proto/timer.h>
+#ifdef __AROS__
+#include <proto/processor.h>
+#include <resources/processor.h>
+#endif
 
 #include <string.h>
 #include <stdio.h>
@@ -43,6 +47,7 @@ ThreadInfo threads[PTHREAD_THREADS_MAX];
 struct SignalSemaphore thread_sem;
 TLSKey tlskeys[PTHREAD_KEYS_MAX];
 struct SignalSemaphore tls_sem;
+int _pthread_cpucount = 1;
 
 //
 // Helper functions
@@ -94,34 +99,13 @@ pthread_t GetThreadId(struct Task *task)
 }
 
 #if defined __mc68000__
-/* No CAS instruction on m68k */
-static int __m68k_sync_val_compare_and_swap(int *v, int o, int n)
-{
-    int ret;
-
-    Disable();
-    if ((*v) == (o))
-        (*v) = (n);
-    ret = (*v);
-    Enable();
-
-    return ret;
-}
+/* No CAS instruction on m68k, use the helpers which return the old value */
 #undef __sync_val_compare_and_swap
-#define __sync_val_compare_and_swap(v, o, n) __m68k_sync_val_compare_and_swap(v, o, n)
-
-static int __m68k_sync_lock_test_and_set(int *v, int n)
-{
-    Disable();
-    (*v) = (n);
-    Enable();
-
-    return n;
-}
+#define __sync_val_compare_and_swap(v, o, n) _pthread_cas((volatile int *)(v), o, n)
 #undef __sync_lock_test_and_set
-#define __sync_lock_test_and_set(v, n) __m68k_sync_lock_test_and_set(v, n)
+#define __sync_lock_test_and_set(v, n) _pthread_swap((volatile int *)(v), n)
 #undef __sync_lock_release
-#define __sync_lock_release(v) __m68k_sync_lock_test_and_set(v, 0)
+#define __sync_lock_release(v) _pthread_swap((volatile int *)(v), 0)
 #endif
 
 BOOL OpenTimerDevice(struct IORequest *io, struct MsgPort *mp, struct Task *task)
@@ -321,8 +305,6 @@ static int _obtain_sema_timed(struct SignalSemaphore *sema, const struct timespe
 
 int pthread_mutex_timedlock(pthread_mutex_t *mutex, const struct timespec *abstime)
 {
-    int result;
-
     D(bug("%s(%p, %p)\n", __FUNCTION__, mutex, abstime));
 
     if (mutex == NULL)
@@ -333,17 +315,10 @@ int pthread_mutex_timedlock(pthread_mutex_t *mutex, const struct timespec *absti
     else if (abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
         return EINVAL;
 
-    result = pthread_mutex_trylock(mutex);
-    if (result != 0)
-    {
-        // pthread_mutex_trylock returns EBUSY when a deadlock would occur
-        if (result != EBUSY)
-            return result;
-        else if (mutex->kind != PTHREAD_MUTEX_RECURSIVE && SemaphoreIsMine(&mutex->semaphore))
-            return EDEADLK;
-    }
+    if (pthread_mutex_trylock(mutex) == 0)
+        return 0;
 
-    return _obtain_sema_timed(&mutex->semaphore, abstime, SM_EXCLUSIVE);
+    return _pthread_mutex_lock(mutex, abstime);
 }
 
 //
@@ -1187,6 +1162,28 @@ int __pthread_Init_Func(void)
     inf->task = GET_THIS_TASK;
 
     NEWLIST((struct List *)&inf->cleanup);
+
+#ifdef __AROS__
+    // mutexes only spin before sleeping when another CPU can release them
+    {
+        APTR ProcessorBase = OpenResource(PROCESSORNAME);
+
+        if (ProcessorBase)
+        {
+            IPTR count = 1;
+            struct TagItem tags[] =
+            {
+                { GCIT_NumberOfProcessors, (IPTR)&count },
+                { TAG_DONE, 0 }
+            };
+
+            GetCPUInfo(tags);
+            if (count > 1)
+                _pthread_cpucount = count;
+        }
+    }
+#endif
+
     return TRUE;
 }
 
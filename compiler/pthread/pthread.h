@@ -153,8 +153,13 @@ typedef struct pthread_mutexattr pthread_mutexattr_t;
 struct pthread_mutex
 {
     int kind;
-    struct SignalSemaphore semaphore;
+    struct SignalSemaphore semaphore;   // protects the list of waiters
     int incond;
+    volatile int state;                 // 0 = unlocked, 1 = locked, 2 = locked with waiters
+    struct Task *owner;                 // only recorded for recursive and error checking mutexes
+    int count;                          // recursion count
+    int spins;                          // average number of spins needed to get the lock
+    struct MinList waiters;
 };
 
 typedef struct pthread_mutex pthread_mutex_t;
@@ -169,9 +174,9 @@ typedef struct pthread_mutex pthread_mutex_t;
 #define NULL_SEMAPHOREREQUEST {NULL_MINNODE, 0}
 #define NULL_SEMAPHORE {NULL_NODE, 0, NULL_MINLIST, NULL_SEMAPHOREREQUEST, 0, 0}
 
-#define PTHREAD_MUTEX_INITIALIZER {PTHREAD_MUTEX_NORMAL, NULL_SEMAPHORE, 0}
-#define PTHREAD_RECURSIVE_MUTEX_INITIALIZER {PTHREAD_MUTEX_RECURSIVE, NULL_SEMAPHORE, 0}
-#define PTHREAD_ERRORCHECK_MUTEX_INITIALIZER {PTHREAD_MUTEX_ERRORCHECK, NULL_SEMAPHORE, 0}
+#define PTHREAD_MUTEX_INITIALIZER {PTHREAD_MUTEX_NORMAL, NULL_SEMAPHORE, 0, 0, 0, 0, 0, NULL_MINLIST}
+#define PTHREAD_RECURSIVE_MUTEX_INITIALIZER {PTHREAD_MUTEX_RECURSIVE, NULL_SEMAPHORE, 0, 0, 0, 0, 0, NULL_MINLIST}
+#define PTHREAD_ERRORCHECK_MUTEX_INITIALIZER {PTHREAD_MUTEX_ERRORCHECK, NULL_SEMAPHORE, 0, 0, 0, 0, 0, NULL_MINLIST}
 
 //
 // Condition variables
@@ -32,14 +32,25 @@ int _pthread_cond_broadcast(pthread_cond_t *cond, BOOL onlyfirst)
     if (cond == NULL)
         return EINVAL;
 
-    // initialize static conditions
+    // nobody can wait on a static condition that was never used
     if (SemaphoreIsInvalid(&cond->semaphore))
-        pthread_cond_init(cond, NULL);
+        return 0;
 
-    // signal the waiting threads 
+    // waiters add themselves before they release the mutex, so there's
+    // no need to lock the list just to find it empty
+#ifdef __AROS__
+    if (IsMinListEmpty(&cond->waiters))
+#else
+    if (IsListEmpty((struct List *)&cond->waiters))
+#endif
+        return 0;
+
+    // signal the waiting threads, removing them so that
+    // the next signal goes to a different thread
     ObtainSemaphore(&cond->semaphore);
-    ForeachNode(&cond->waiters, waiter)
+    while ((waiter = (CondWaiter *)RemHead((struct List *)&cond->waiters)) != NULL)
     {
+        waiter->node.mln_Pred = NULL;
         Signal(waiter->task, 1 << waiter->sigbit);
         if (onlyfirst) break;
     }
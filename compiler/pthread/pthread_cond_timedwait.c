@@ -102,9 +102,12 @@ int _pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex, const
     pthread_mutex_lock(mutex);
     mutex->incond--;
 
-    // remove the node from the list
+    // remove the node from the list, unless a signal already did it
     ObtainSemaphore(&cond->semaphore);
-    Remove((struct Node *)&waiter);
+    if (waiter.node.mln_Pred)
+        Remove((struct Node *)&waiter);
+    else
+        sigs |= 1 << waiter.sigbit;
     ReleaseSemaphore(&cond->semaphore);
 
     if (waiter.sigbit != SIGB_COND_FALLBACK)
@@ -115,8 +118,8 @@ int _pthread_cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *mutex, const
         // clean up the timerequest
         CloseTimerDevice((struct IORequest *)&timerio);
 
-        // did we timeout?
-        if (sigs & (1 << timermp.mp_SigBit))
+        // did we timeout? a signal that arrived at the same time wins
+        if ((sigs & (1 << timermp.mp_SigBit)) && !(sigs & (1 << waiter.sigbit)))
             return ETIMEDOUT;
         else if (sigs & SIGBREAKF_CTRL_C)
             pthread_testcancel();
@@ -79,6 +79,81 @@
 #define SIGB_TIMER_FALLBACK SIGBREAKB_CTRL_D
 #define SIGF_TIMER_FALLBACK (1 << SIGB_TIMER_FALLBACK)
 
+//
+// Atomic operations used by the mutex and semaphore fast paths
+//
+
+#if defined __mc68000__
+// No CAS instruction on m68k, and no other CPU to race with
+static inline int _pthread_cas(volatile int *v, int o, int n)
+{
+    int ret;
+
+    Disable();
+    ret = *v;
+    if (ret == o)
+        *v = n;
+    Enable();
+
+    return ret;
+}
+
+static inline int _pthread_swap(volatile int *v, int n)
+{
+    int ret;
+
+    Disable();
+    ret = *v;
+    *v = n;
+    Enable();
+
+    return ret;
+}
+
+static inline int _pthread_add(volatile int *v, int d)
+{
+    int ret;
+
+    Disable();
+    ret = (*v += d);
+    Enable();
+
+    return ret;
+}
+
+#define _pthread_relax()
+#else
+// returns the old value, the store only happens if it was o
+#define _pthread_cas(v, o, n) __sync_val_compare_and_swap((v), (o), (n))
+
+static inline int _pthread_swap(volatile int *v, int n)
+{
+    int ret;
+
+    do
+        ret = *v;
+    while (__sync_val_compare_and_swap(v, ret, n) != ret);
+
+    return ret;
+}
+
+// returns the new value
+#define _pthread_add(v, d) __sync_add_and_fetch((v), (d))
+
+#if defined(__i386__) || defined(__x86_64__)
+#define _pthread_relax() __asm__ __volatile__("pause" ::: "memory")
+#else
+#define _pthread_relax() __asm__ __volatile__("" ::: "memory")
+#endif
+#endif
+
+#define MUTEX_UNLOCKED 0
+#define MUTEX_LOCKED 1
+#define MUTEX_CONTENDED 2
+
+// upper limit for spinning on a locked mutex before going to sleep
+#define MUTEX_SPIN_MAX 200
+
 #define NAMELEN 32
 #define PTHREAD_FIRST_THREAD_ID (1)
 #define PTHREAD_BARRIER_FLAG (1UL << 31)
@@ -126,6 +201,7 @@ extern ThreadInfo threads[PTHREAD_THREADS_MAX];
 extern struct SignalSemaphore thread_sem;
 extern TLSKey tlskeys[PTHREAD_KEYS_MAX];
 extern struct SignalSemaphore tls_sem;
+extern int _pthread_cpucount;
 
 /* .c */
 extern int SemaphoreIsInvalid(struct SignalSemaphore *sem);
@@ -141,6 +217,10 @@ extern int _pthread_cond_broadcast(pthread_cond_t *cond, BOOL onlyfirst);
 
 /* .c */
 extern int _pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr, BOOL staticinit);
+extern void _pthread_mutex_initwaiters(pthread_mutex_t *mutex);
+
+/* .c */
+extern int _pthread_mutex_lock(pthread_mutex_t *mutex, const struct timespec *abstime);
 
 /* .c */
 extern BOOL OpenTimerDevice(struct IORequest *io, struct MsgPort *mp, struct Task *task);
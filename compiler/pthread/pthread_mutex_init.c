@@ -35,11 +35,31 @@ int _pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr,
     else if (!staticinit)
         mutex->kind = PTHREAD_MUTEX_DEFAULT;
     InitSemaphore(&mutex->semaphore);
+    NEWLIST((struct List *)&mutex->waiters);
     mutex->incond = 0;
+    mutex->state = MUTEX_UNLOCKED;
+    mutex->owner = NULL;
+    mutex->count = 0;
+    mutex->spins = 0;
 
     return 0;
 }
 
+void _pthread_mutex_initwaiters(pthread_mutex_t *mutex)
+{
+    DB2(bug("%s(%p)\n", __FUNCTION__, mutex));
+
+    // statically initialized mutexes get their waiter list on first contention,
+    // which may happen in several threads at once
+    Forbid();
+    if (SemaphoreIsInvalid(&mutex->semaphore))
+    {
+        InitSemaphore(&mutex->semaphore);
+        NEWLIST((struct List *)&mutex->waiters);
+    }
+    Permit();
+}
+
 int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr)
 {
     D(bug("%s(%p, %p)\n", __FUNCTION__, mutex, attr));
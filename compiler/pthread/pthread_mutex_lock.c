@@ -20,37 +20,175 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 
+#include <proto/timer.h>
+
 #include "pthread_intern.h"
 #include "debug.h"
 
-int pthread_mutex_lock(pthread_mutex_t *mutex)
+static int _pthread_mutex_sleep(pthread_mutex_t *mutex, struct Task *task, const struct timespec *abstime)
 {
-    struct SignalSemaphore *sem;
+    CondWaiter waiter;
+    BYTE signal;
+    ULONG sigs, timermask = 0;
+    struct MsgPort timermp;
+    struct timerequest timerio;
+    int result = 0;
 
-    D(bug("%s(%p)\n", __FUNCTION__, mutex));
+    DB2(bug("%s(%p, %p, %p)\n", __FUNCTION__, mutex, task, abstime));
 
-    if (mutex == NULL)
-        return EINVAL;
+    // initialize static mutexes
+    if (SemaphoreIsInvalid(&mutex->semaphore))
+        _pthread_mutex_initwaiters(mutex);
 
-    sem = &mutex->semaphore;
+    if (abstime)
+    {
+        struct timeval tvabstime, starttime;
 
-    // initialize static mutexes
-    if (SemaphoreIsInvalid(sem))
-        _pthread_mutex_init(mutex, NULL, TRUE);
+        // open timer.device
+        if (!OpenTimerDevice((struct IORequest *)&timerio, &timermp, task))
+        {
+            CloseTimerDevice((struct IORequest *)&timerio);
+            return EINVAL;
+        }
 
-    // normal mutexes would simply deadlock here
-    if (mutex->kind == PTHREAD_MUTEX_ERRORCHECK && SemaphoreIsMine(sem))
-        return EDEADLK;
+        // absolute time has to be converted to relative
+        // GetSysTime can't be used due to the timezone offset in abstime
+        TIMESPEC_TO_TIMEVAL(&tvabstime, abstime);
+        gettimeofday(&starttime, NULL);
+        timersub(&tvabstime, &starttime, &tvabstime);
+        if (!timerisset(&tvabstime) || tvabstime.tv_sec < 0)
+        {
+            CloseTimerDevice((struct IORequest *)&timerio);
+            return ETIMEDOUT;
+        }
+        timerio.tr_node.io_Command = TR_ADDREQUEST;
+        timerio.tr_node.io_Flags = 0;
+        timerio.tr_time.tv_secs = tvabstime.tv_sec;
+        timerio.tr_time.tv_micro = tvabstime.tv_usec;
+        timermask = 1 << timermp.mp_SigBit;
+        SendIO((struct IORequest *)&timerio);
+    }
+
+    // prepare a waiter node
+    waiter.task = task;
+    signal = AllocSignal(-1);
+    if (signal == -1)
+        signal = SIGB_COND_FALLBACK;
+    waiter.sigbit = signal;
 
-    ObtainSemaphore(sem);
+    // marking the mutex as contended makes the owner wake us up on unlock
+    while (_pthread_swap(&mutex->state, MUTEX_CONTENDED) != MUTEX_UNLOCKED)
+    {
+        ObtainSemaphore(&mutex->semaphore);
+        // the owner might have released the mutex in the meantime
+        if (_pthread_swap(&mutex->state, MUTEX_CONTENDED) == MUTEX_UNLOCKED)
+        {
+            ReleaseSemaphore(&mutex->semaphore);
+            break;
+        }
+        SetSignal(0, 1 << waiter.sigbit);
+        AddTail((struct List *)&mutex->waiters, (struct Node *)&waiter);
+        ReleaseSemaphore(&mutex->semaphore);
+
+        sigs = Wait((1 << waiter.sigbit) | timermask);
+
+        // the unlocking thread removes the node before signalling us
+        ObtainSemaphore(&mutex->semaphore);
+        if (waiter.node.mln_Pred)
+            Remove((struct Node *)&waiter);
+        ReleaseSemaphore(&mutex->semaphore);
+
+        if (sigs & timermask)
+        {
+            // a wakeup we got at the same time must not get lost, so take the
+            // mutex if it's free, the next unlock will wake the other waiters
+            if (_pthread_swap(&mutex->state, MUTEX_CONTENDED) != MUTEX_UNLOCKED)
+                result = ETIMEDOUT;
+            break;
+        }
+    }
+
+    if (waiter.sigbit != SIGB_COND_FALLBACK)
+        FreeSignal(waiter.sigbit);
+
+    if (abstime)
+        CloseTimerDevice((struct IORequest *)&timerio);
+
+    return result;
+}
+
+int _pthread_mutex_lock(pthread_mutex_t *mutex, const struct timespec *abstime)
+{
+    struct Task *task;
+    int result;
 
-#if 0 // let's just deadlock here, to be compatible with normal mutexes on other platforms
-    if (mutex->kind == PTHREAD_MUTEX_NORMAL && sem->ss_NestCount > 1) {
-        // should have blocked - fix this
-        ReleaseSemaphore(sem);
+    DB2(bug("%s(%p, %p)\n", __FUNCTION__, mutex, abstime));
+
+    task = GET_THIS_TASK;
+
+    if (mutex->kind != PTHREAD_MUTEX_NORMAL && mutex->state != MUTEX_UNLOCKED && mutex->owner == task)
+    {
+        if (mutex->kind == PTHREAD_MUTEX_RECURSIVE)
+        {
+            mutex->count++;
+            return 0;
+        }
+        // normal mutexes don't know their owner, they simply deadlock below
         return EDEADLK;
     }
-#endif
+
+    // the owner is likely running on another CPU and about to release the
+    // mutex, spinning for a while is cheaper than sleeping and waking up
+    if (_pthread_cpucount > 1)
+    {
+        int spins, max;
+
+        max = mutex->spins * 2 + 10;
+        if (max > MUTEX_SPIN_MAX)
+            max = MUTEX_SPIN_MAX;
+        for (spins = 0; spins < max; spins++)
+        {
+            if (mutex->state == MUTEX_UNLOCKED && _pthread_cas(&mutex->state, MUTEX_UNLOCKED, MUTEX_LOCKED) == MUTEX_UNLOCKED)
+                break;
+            _pthread_relax();
+        }
+        // keep a running average, so that hopeless spinning fades out
+        mutex->spins += (spins - mutex->spins) / 8;
+        if (spins < max)
+            goto locked;
+    }
+
+    result = _pthread_mutex_sleep(mutex, task, abstime);
+    if (result != 0)
+        return result;
+
+locked:
+    if (mutex->kind != PTHREAD_MUTEX_NORMAL)
+    {
+        mutex->owner = task;
+        mutex->count = 1;
+    }
 
     return 0;
 }
+
+int pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+    D(bug("%s(%p)\n", __FUNCTION__, mutex));
+
+    if (mutex == NULL)
+        return EINVAL;
+
+    // uncontended case, the waiter list isn't touched at all
+    if (_pthread_cas(&mutex->state, MUTEX_UNLOCKED, MUTEX_LOCKED) == MUTEX_UNLOCKED)
+    {
+        if (mutex->kind != PTHREAD_MUTEX_NORMAL)
+        {
+            mutex->owner = GET_THIS_TASK;
+            mutex->count = 1;
+        }
+        return 0;
+    }
+
+    return _pthread_mutex_lock(mutex, NULL);
+}
@@ -25,21 +25,29 @@
 
 int pthread_mutex_trylock(pthread_mutex_t *mutex)
 {
-    ULONG ret;
+    struct Task *task;
 
     D(bug("%s(%p)\n", __FUNCTION__, mutex));
 
     if (mutex == NULL)
         return EINVAL;
 
-    // initialize static mutexes
-    if (SemaphoreIsInvalid(&mutex->semaphore))
-        _pthread_mutex_init(mutex, NULL, TRUE);
-
-    if (mutex->kind != PTHREAD_MUTEX_RECURSIVE && SemaphoreIsMine(&mutex->semaphore))
-        return EBUSY;
-
-    ret = AttemptSemaphore(&mutex->semaphore);
-
-    return (ret == TRUE) ? 0 : EBUSY;
+    if (_pthread_cas(&mutex->state, MUTEX_UNLOCKED, MUTEX_LOCKED) == MUTEX_UNLOCKED)
+    {
+        if (mutex->kind != PTHREAD_MUTEX_NORMAL)
+        {
+            mutex->owner = GET_THIS_TASK;
+            mutex->count = 1;
+        }
+        return 0;
+    }
+
+    task = GET_THIS_TASK;
+    if (mutex->kind == PTHREAD_MUTEX_RECURSIVE && mutex->owner == task)
+    {
+        mutex->count++;
+        return 0;
+    }
+
+    return EBUSY;
 }
@@ -25,18 +25,34 @@
 
 int pthread_mutex_unlock(pthread_mutex_t *mutex)
 {
+    CondWaiter *waiter;
+
     D(bug("%s(%p)\n", __FUNCTION__, mutex));
 
     if (mutex == NULL)
         return EINVAL;
 
-    // initialize static mutexes
-    if (SemaphoreIsInvalid(&mutex->semaphore))
-        _pthread_mutex_init(mutex, NULL, TRUE);
-
-    if (mutex->kind != PTHREAD_MUTEX_NORMAL && !SemaphoreIsMine(&mutex->semaphore))
-        return EPERM;
-
+    if (mutex->kind != PTHREAD_MUTEX_NORMAL)
+    {
+        if (mutex->state == MUTEX_UNLOCKED || mutex->owner != GET_THIS_TASK)
+            return EPERM;
+        if (--mutex->count > 0)
+            return 0;
+        mutex->owner = NULL;
+    }
+
+    // nobody is sleeping on the mutex
+    if (_pthread_swap(&mutex->state, MUTEX_UNLOCKED) != MUTEX_CONTENDED)
+        return 0;
+
+    // wake up the first waiter, it will mark the mutex contended again
+    ObtainSemaphore(&mutex->semaphore);
+    waiter = (CondWaiter *)RemHead((struct List *)&mutex->waiters);
+    if (waiter)
+    {
+        waiter->node.mln_Pred = NULL;
+        Signal(waiter->task, 1 << waiter->sigbit);
+    }
     ReleaseSemaphore(&mutex->semaphore);
 
     return 0;
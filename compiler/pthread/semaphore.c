@@ -26,6 +26,7 @@
 #include <fcntl.h>
 
 #include "semaphore.h"
+#include "pthread_intern.h"
 #include "debug.h"
 
 #if defined(__AMIGA__)
@@ -42,6 +43,20 @@ static struct List semaphores;
 static struct SignalSemaphore sema_sem;
 static pthread_once_t once_control = PTHREAD_ONCE_INIT;
 
+// take one from the count without locking, fails if it is zero
+static int _sem_trydec(sem_t *sem)
+{
+    int value;
+
+    while ((value = *(volatile int *)&sem->value) > 0)
+    {
+        if (_pthread_cas(&sem->value, value, value - 1) == value)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
 static void _Init_Semaphore(void)
 {
     DB2(bug("%s()\n", __FUNCTION__));
@@ -195,8 +210,6 @@ int sem_destroy(sem_t *sem)
 
 int sem_trywait(sem_t *sem)
 {
-    int result = 0;
-
     D(bug("%s(%p)\n", __FUNCTION__, sem));
 
     if (sem == NULL)
@@ -205,18 +218,9 @@ int sem_trywait(sem_t *sem)
         return -1;
     }
 
-    pthread_mutex_lock(&sem->lock);
-
-    if (sem->value > 0)
-        sem->value--;
-    else
-        result = EAGAIN;
-
-    pthread_mutex_unlock(&sem->lock);
-
-    if (result != 0)
+    if (!_sem_trydec(sem))
     {
-        errno = result;
+        errno = EAGAIN;
         return -1;
     }
 
@@ -235,26 +239,28 @@ int sem_timedwait(sem_t *sem, const struct timespec *abstime)
         return -1;
     }
 
+    if (_sem_trydec(sem))
+        return 0;
+
     pthread_mutex_lock(&sem->lock);
 
-    sem->waiters_count++;
+    // sem_post only takes the lock when it sees a waiter, so announce
+    // ourselves before checking the count again
+    _pthread_add(&sem->waiters_count, 1);
 
-    while (sem->value == 0 && result == 0)
+    while (result == 0 && !_sem_trydec(sem))
         result = pthread_cond_timedwait(&sem->count_nonzero, &sem->lock, abstime);
 
-    sem->waiters_count--;
+    _pthread_add(&sem->waiters_count, -1);
+
+    pthread_mutex_unlock(&sem->lock);
 
     if (result != 0)
     {
-        pthread_mutex_unlock(&sem->lock);
         errno = result;
         return -1;
     }
 
-    sem->value--;
-
-    pthread_mutex_unlock(&sem->lock);
-
     return 0;
 }
 
@@ -267,6 +273,8 @@ int sem_wait(sem_t *sem)
 
 int sem_post(sem_t *sem)
 {
+    int value;
+
     D(bug("%s(%p)\n", __FUNCTION__, sem));
 
     if (sem == NULL)
@@ -275,21 +283,25 @@ int sem_post(sem_t *sem)
         return -1;
     }
 
-    pthread_mutex_lock(&sem->lock);
-
-    if (sem->value >= SEM_VALUE_MAX)
+    do
     {
-        pthread_mutex_unlock(&sem->lock);
-        errno = EOVERFLOW;
-        return -1;
+        value = *(volatile int *)&sem->value;
+        if (value >= SEM_VALUE_MAX)
+        {
+            errno = EOVERFLOW;
+            return -1;
+        }
     }
+    while (_pthread_cas(&sem->value, value, value + 1) != value);
 
-    sem->value++;
-
-    if (sem->waiters_count > 0)
+    // the lock makes sure a waiter that missed the new count is
+    // already waiting on the condition when we signal it
+    if (*(volatile int *)&sem->waiters_count > 0)
+    {
+        pthread_mutex_lock(&sem->lock);
         pthread_cond_signal(&sem->count_nonzero);
-
-    pthread_mutex_unlock(&sem->lock);
+        pthread_mutex_unlock(&sem->lock);
+    }
 
     return 0;
 }
@@ -0,0 +1,23 @@
+#ifndef BENCHMARKS_BENCHTIME_H
+#define BENCHMARKS_BENCHTIME_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Timing helper shared by the benchmarks
+*/
+
+#include <sys/time.h>
+
+/* Seconds passed since tv_start, which was set with gettimeofday() */
+static inline double elapsed(struct timeval *tv_start)
+{
+    struct timeval tv_end;
+
+    gettimeofday(&tv_end, NULL);
+
+    return ((double)(((tv_end.tv_sec * 1000000) + tv_end.tv_usec)
+            - ((tv_start->tv_sec * 1000000) + tv_start->tv_usec))) / 1000000.0;
+}
+
+#endif /* BENCHMARKS_BENCHTIME_H */
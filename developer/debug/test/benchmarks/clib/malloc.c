@@ -0,0 +1,106 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: malloc()/free() throughput with one and with several threads.
+*/
+
+#include <pthread.h>
+#include <sys/time.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define MAX_THREADS     16
+#define LIVE_BLOCKS     64
+#define ITERATIONS      2000000
+
+struct ThreadData
+{
+    pthread_t       thread;
+    unsigned int    seed;
+    long            ops;
+};
+
+static struct ThreadData threads[MAX_THREADS];
+
+/* Keep a small window of blocks alive, replacing them in random order */
+static void *worker(void *arg)
+{
+    struct ThreadData *td = arg;
+    void *live[LIVE_BLOCKS] = { NULL };
+    unsigned int seed = td->seed;
+    long i;
+
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        int slot;
+        size_t size;
+
+        seed = seed * 1103515245 + 12345;
+        slot = (seed >> 8) % LIVE_BLOCKS;
+        size = 8 + ((seed >> 16) % 248);
+
+        free(live[slot]);
+        live[slot] = malloc(size);
+        if (live[slot])
+            *(char *)live[slot] = 0;
+    }
+
+    for (i = 0; i < LIVE_BLOCKS; i++)
+        free(live[i]);
+
+    td->ops = ITERATIONS;
+
+    return NULL;
+}
+
+static double run(int count)
+{
+    struct timeval tv_start, tv_end;
+    long ops = 0;
+    int i;
+
+    gettimeofday(&tv_start, NULL);
+
+    for (i = 0; i < count; i++)
+    {
+        threads[i].seed = 12345 + i;
+        threads[i].ops = 0;
+        pthread_create(&threads[i].thread, NULL, worker, &threads[i]);
+    }
+    for (i = 0; i < count; i++)
+    {
+        pthread_join(threads[i].thread, NULL);
+        ops += threads[i].ops;
+    }
+
+    gettimeofday(&tv_end, NULL);
+
+    return (double)ops / (((double)(((tv_end.tv_sec * 1000000) + tv_end.tv_usec)
+            - ((tv_start.tv_sec * 1000000) + tv_start.tv_usec)))/1000000.0);
+}
+
+int main(int argc, char **argv)
+{
+    int maxthreads = 4, count;
+    double single = 0.0;
+
+    if (argc > 1)
+        maxthreads = atoi(argv[1]);
+    if (maxthreads < 1)
+        maxthreads = 1;
+    if (maxthreads > MAX_THREADS)
+        maxthreads = MAX_THREADS;
+
+    for (count = 1; count <= maxthreads; count *= 2)
+    {
+        double rate = run(count);
+
+        if (count == 1)
+            single = rate;
+
+        printf("malloc/free %2d thread(s): %.2lf operations/s (%.2lfx single threaded)\n",
+            count, rate, rate / single);
+    }
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Times LoadSeg() and UnLoadSeg() of an executable, repeated COUNT times.
+ * If CACHE is given, and LOADSEGCACHE: isn't assigned already, the same
+ * is done with LOADSEGCACHE: assigned to that directory afterwards, to
+ * compare loading from the ELF relocated image cache with loading the
+ * file itself. The first load with the cache, which also fills it, is
+ * reported on its own.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+#include <dos/dosextens.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "FILE/A,COUNT/N,CACHE/K"
+
+enum
+{
+    ARG_FILE,
+    ARG_COUNT,
+    ARG_CACHE,
+    NUM_ARGS
+};
+
+#define CACHE_ASSIGN    "LOADSEGCACHE"
+
+static BOOL cache_assigned(void)
+{
+    struct DosList *dl;
+
+    dl = LockDosList(LDF_ASSIGNS | LDF_READ);
+    dl = FindDosEntry(dl, CACHE_ASSIGN, LDF_ASSIGNS);
+    UnLockDosList(LDF_ASSIGNS | LDF_READ);
+
+    return dl != NULL;
+}
+
+/* Returns the average time of a LoadSeg()/UnLoadSeg() pair in ms, or -1 */
+static double run(CONST_STRPTR file, ULONG count)
+{
+    struct timeval tv_start;
+    BPTR seg;
+    ULONG i;
+    double t;
+
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < count; i++)
+    {
+        if ((seg = LoadSeg(file)) == BNULL)
+        {
+            PrintFault(IoErr(), file);
+            return -1;
+        }
+        UnLoadSeg(seg);
+
+        if (SetSignal(0, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C)
+        {
+            printf("***Break\n");
+            return -1;
+        }
+    }
+    t = elapsed(&tv_start);
+
+    return t * 1000.0 / count;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    CONST_STRPTR file, cachedir;
+    ULONG count;
+    BPTR lock;
+    BOOL assigned;
+    double plain = -1, first = -1, cached = -1;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "LoadSeg");
+        return RETURN_FAIL;
+    }
+
+    file = (CONST_STRPTR)args[ARG_FILE];
+    count = args[ARG_COUNT] ? *(ULONG *)args[ARG_COUNT] : 200;
+    cachedir = (CONST_STRPTR)args[ARG_CACHE];
+
+    if (count < 1)
+        count = 1;
+
+    assigned = cache_assigned();
+
+    printf("LoadSeg: %s, %lu times\n\n", file, (unsigned long)count);
+
+    if (assigned)
+    {
+        printf("  " CACHE_ASSIGN ": is assigned, all loads use the cache\n\n");
+        cachedir = NULL;
+    }
+
+    /* Load it once first, so that all of the runs find it in the buffers */
+    if ((plain = run(file, 1)) < 0)
+    {
+        result = RETURN_FAIL;
+        goto done;
+    }
+
+    if ((plain = run(file, count)) < 0)
+    {
+        result = RETURN_FAIL;
+        goto done;
+    }
+    printf("  %-24s %10.3f ms\n", assigned ? "With cache" : "Without cache", plain);
+
+    if (cachedir)
+    {
+        if ((lock = Lock(cachedir, SHARED_LOCK)) == BNULL)
+        {
+            PrintFault(IoErr(), cachedir);
+            result = RETURN_FAIL;
+            goto done;
+        }
+
+        if (!AssignLock(CACHE_ASSIGN, lock))
+        {
+            PrintFault(IoErr(), CACHE_ASSIGN);
+            UnLock(lock);
+            result = RETURN_FAIL;
+            goto done;
+        }
+
+        if ((first = run(file, 1)) >= 0)
+            printf("  %-24s %10.3f ms\n", "Filling the cache", first);
+        if (first >= 0 && (cached = run(file, count)) >= 0)
+        {
+            printf("  %-24s %10.3f ms\n", "With cache", cached);
+            if (cached > 0)
+                printf("  %-24s %10.2f x\n", "Speedup", plain / cached);
+        }
+        else
+            result = RETURN_FAIL;
+
+        AssignLock(CACHE_ASSIGN, BNULL);
+    }
+
+done:
+    FreeArgs(rda);
+
+    return result;
+}
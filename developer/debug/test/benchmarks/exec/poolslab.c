@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Small block pool allocations, with and without MEMF_SLAB.
+*/
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <proto/exec.h>
+
+#define LIVE_BLOCKS     20000
+#define ROUNDS          50
+
+static APTR blocks[LIVE_BLOCKS];
+static IPTR sizes[LIVE_BLOCKS];
+
+static double RunPool(ULONG requirements, ULONG *allocs)
+{
+    struct timeval  tv_start,
+                    tv_end;
+    APTR            pool;
+    ULONG           seed = 12345;
+    int             i, round;
+
+    *allocs = 0;
+
+    pool = CreatePool(requirements, 8192, 8192);
+    if (!pool)
+        return 0.0;
+
+    gettimeofday(&tv_start, NULL);
+
+    /* Keep many blocks of mixed sizes alive, and keep replacing them */
+    for (i = 0; i < LIVE_BLOCKS; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        sizes[i] = 8 + ((seed >> 16) % 240);
+        blocks[i] = AllocPooled(pool, sizes[i]);
+        (*allocs)++;
+    }
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        for (i = 0; i < LIVE_BLOCKS; i += 2)
+        {
+            if (blocks[i])
+                FreePooled(pool, blocks[i], sizes[i]);
+        }
+        for (i = 0; i < LIVE_BLOCKS; i += 2)
+        {
+            seed = seed * 1103515245 + 12345;
+            sizes[i] = 8 + ((seed >> 16) % 240);
+            blocks[i] = AllocPooled(pool, sizes[i]);
+            (*allocs)++;
+        }
+    }
+
+    gettimeofday(&tv_end, NULL);
+
+    printf
+    (
+        "  Pool size:                 %lu bytes\n"
+        "  Free in pool:              %lu bytes\n"
+        "  Held in slabs:             %lu bytes (%lu free)\n",
+        (unsigned long)AvailPool(pool, MEMF_TOTAL),
+        (unsigned long)AvailPool(pool, 0),
+        (unsigned long)AvailPool(pool, MEMF_SLAB | MEMF_TOTAL),
+        (unsigned long)AvailPool(pool, MEMF_SLAB)
+    );
+
+    DeletePool(pool);
+
+    return ((double)(((tv_end.tv_sec * 1000000) + tv_end.tv_usec)
+            - ((tv_start.tv_sec * 1000000) + tv_start.tv_usec)))/1000000.0;
+}
+
+int main()
+{
+    static const struct
+    {
+        const char *name;
+        ULONG       requirements;
+    } modes[] =
+    {
+        { "Puddles only", MEMF_ANY               },
+        { "MEMF_SLAB",    MEMF_ANY | MEMF_SLAB   }
+    };
+    double          elapsed;
+    ULONG           allocs;
+    int             i;
+
+    for (i = 0; i < 2; i++)
+    {
+        printf("%s:\n", modes[i].name);
+
+        elapsed = RunPool(modes[i].requirements, &allocs);
+
+        printf
+        (
+            "  Elapsed time:              %f seconds\n"
+            "  Number of allocations:     %lu\n"
+            "  Allocations per second:    %f\n",
+            elapsed, (unsigned long)allocs, (double)allocs / elapsed
+        );
+    }
+
+    return 0;
+}
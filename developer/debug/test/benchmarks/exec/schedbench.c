@@ -0,0 +1,234 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Scheduler benchmark - context switches per second against the
+          number of cores used and the number of ready tasks.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <exec/tasks.h>
+#include <exec/execbase.h>
+#include <aros/atomic.h>
+#include <dos/dos.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/kernel.h>
+
+#define ARG_TEMPLATE    "PAIRS/N,BUSY/N,CPUS/N,SECONDS/N,PIN/S,SCHED/K"
+#define ARG_PAIRS       0
+#define ARG_BUSY        1
+#define ARG_CPUS        2
+#define ARG_SECONDS     3
+#define ARG_PIN         4
+#define ARG_SCHED       5
+#define ARG_COUNT       6
+
+#define MAX_PAIRS       64
+#define MAX_BUSY        512
+
+#define SIGF_HELLO      SIGBREAKF_CTRL_D
+#define SIGF_STOP       SIGBREAKF_CTRL_C
+#define SIGF_START      SIGBREAKF_CTRL_E
+
+APTR KernelBase;
+
+struct BenchPair
+{
+    struct Task         *bp_Ping;
+    struct Task         *bp_Pong;
+    volatile ULONG      bp_Count;
+};
+
+static struct BenchPair pairs[MAX_PAIRS];
+static struct Task *busy[MAX_BUSY];
+static volatile BOOL stopBusy;
+static volatile ULONG finished;
+
+static void PongEntry(void)
+{
+    struct BenchPair *pair = FindTask(NULL)->tc_UserData;
+
+    for (;;)
+    {
+        if (Wait(SIGF_HELLO | SIGF_STOP) & SIGF_STOP)
+            break;
+        Signal(pair->bp_Ping, SIGF_HELLO);
+    }
+    AROS_ATOMIC_INC(finished);
+}
+
+static void PingEntry(void)
+{
+    struct BenchPair *pair = FindTask(NULL)->tc_UserData;
+
+    /* Wait until both halves of the pair are known */
+    if (!(Wait(SIGF_START | SIGF_STOP) & SIGF_STOP))
+    {
+        for (;;)
+        {
+            Signal(pair->bp_Pong, SIGF_HELLO);
+            if (Wait(SIGF_HELLO | SIGF_STOP) & SIGF_STOP)
+                break;
+            pair->bp_Count++;
+        }
+    }
+    AROS_ATOMIC_INC(finished);
+}
+
+static void BusyEntry(void)
+{
+    volatile ULONG spin = 0;
+
+    while (!stopBusy)
+        spin++;
+    AROS_ATOMIC_INC(finished);
+}
+
+static struct Task *StartTask(CONST_STRPTR name, APTR entry, ULONG cpu, BOOL pin, APTR userData)
+{
+    struct Task *task;
+    void *affinity = NULL;
+
+    if (pin)
+    {
+        affinity = KrnAllocCPUMask();
+        KrnGetCPUMask(cpu, affinity);
+    }
+
+    task = NewCreateTask(TASKTAG_NAME       , name,
+                         TASKTAG_PRI        , 0,
+                         TASKTAG_PC         , entry,
+                         TASKTAG_USERDATA   , userData,
+                         pin ? TASKTAG_AFFINITY : TAG_IGNORE, affinity,
+                         TAG_DONE);
+
+    return task;
+}
+
+int main(void)
+{
+    IPTR args[ARG_COUNT] = { 0 };
+    struct RDArgs *rda;
+    struct timeval tv_start, tv_end;
+    ULONG pairCount = 4, busyCount = 0, cpuCount = 1, seconds = 5;
+    ULONG i, started = 0, dispStart, dispEnd;
+    UQUAD roundTrips = 0;
+    BOOL pin = FALSE;
+    KRN_SchedType oldSched, sched;
+    double elapsed;
+
+    if ((KernelBase = OpenResource("kernel.resource")) == NULL)
+        return RETURN_FAIL;
+
+    cpuCount = KrnGetCPUCount();
+
+    if ((rda = ReadArgs(ARG_TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "schedbench");
+        return RETURN_FAIL;
+    }
+    if (args[ARG_PAIRS])
+        pairCount = *(LONG *)args[ARG_PAIRS];
+    if (args[ARG_BUSY])
+        busyCount = *(LONG *)args[ARG_BUSY];
+    if (args[ARG_CPUS] && (*(LONG *)args[ARG_CPUS] < cpuCount))
+        cpuCount = *(LONG *)args[ARG_CPUS];
+    if (args[ARG_SECONDS])
+        seconds = *(LONG *)args[ARG_SECONDS];
+    pin = args[ARG_PIN] ? TRUE : FALSE;
+
+    /* Optionally switch the ready list handling for the duration of the run */
+    oldSched = sched = KrnGetScheduler();
+    if (args[ARG_SCHED])
+    {
+        if (!strcasecmp((char *)args[ARG_SCHED], "PRI"))
+            sched = SCHED_PRI;
+        else if (!strcasecmp((char *)args[ARG_SCHED], "RR"))
+            sched = SCHED_RR;
+        KrnSetScheduler(sched);
+        sched = KrnGetScheduler();
+    }
+    FreeArgs(rda);
+
+    if (pairCount < 1)
+        pairCount = 1;
+    if (pairCount > MAX_PAIRS)
+        pairCount = MAX_PAIRS;
+    if (busyCount > MAX_BUSY)
+        busyCount = MAX_BUSY;
+    if (cpuCount < 1)
+        cpuCount = 1;
+
+    stopBusy = FALSE;
+    finished = 0;
+
+    printf("Cores: %lu, ping-pong pairs: %lu, busy tasks: %lu, %s, ready list: %s\n",
+        (unsigned long)cpuCount, (unsigned long)pairCount, (unsigned long)busyCount,
+        pin ? "pinned" : "free to migrate", (sched == SCHED_PRI) ? "priority bitmap" : "sorted");
+
+    /* The busy tasks keep the ready queues filled */
+    for (i = 0; i < busyCount; i++)
+    {
+        if ((busy[i] = StartTask("schedbench busy", BusyEntry, i % cpuCount, TRUE, NULL)) != NULL)
+            started++;
+    }
+
+    gettimeofday(&tv_start, NULL);
+    dispStart = SysBase->DispCount;
+
+    for (i = 0; i < pairCount; i++)
+    {
+        pairs[i].bp_Count = 0;
+        pairs[i].bp_Pong = StartTask("schedbench pong", PongEntry, i % cpuCount, pin, &pairs[i]);
+        pairs[i].bp_Ping = StartTask("schedbench ping", PingEntry, i % cpuCount, pin, &pairs[i]);
+        if (pairs[i].bp_Pong)
+            started++;
+        if (pairs[i].bp_Ping)
+        {
+            started++;
+            if (pairs[i].bp_Pong)
+                Signal(pairs[i].bp_Ping, SIGF_START);
+        }
+    }
+
+    Delay(seconds * 50);
+
+    for (i = 0; i < pairCount; i++)
+        roundTrips += pairs[i].bp_Count;
+    dispEnd = SysBase->DispCount;
+    gettimeofday(&tv_end, NULL);
+
+    /* Tear everything down and wait for all the tasks to leave */
+    stopBusy = TRUE;
+    for (i = 0; i < pairCount; i++)
+    {
+        if (pairs[i].bp_Ping)
+            Signal(pairs[i].bp_Ping, SIGF_STOP);
+        if (pairs[i].bp_Pong)
+            Signal(pairs[i].bp_Pong, SIGF_STOP);
+    }
+    while (finished < started)
+        Delay(1);
+
+    if (sched != oldSched)
+        KrnSetScheduler(oldSched);
+
+    elapsed = ((double)(((tv_end.tv_sec * 1000000) + tv_end.tv_usec)
+            - ((tv_start.tv_sec * 1000000) + tv_start.tv_usec)))/1000000.0;
+
+    printf
+    (
+        "Elapsed time:                %f seconds\n"
+        "Signal roundtrips:           %llu\n"
+        "Roundtrips per second:       %f\n"
+        "Dispatches:                  %lu\n"
+        "Context switches per second: %f\n",
+        elapsed, (unsigned long long)roundTrips, (double)roundTrips / elapsed,
+        (unsigned long)(dispEnd - dispStart), (double)(dispEnd - dispStart) / elapsed
+    );
+
+    return RETURN_OK;
+}
@@ -0,0 +1,148 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures how long it takes to look up names in a big directory. The
+ * directory is filled with empty files, which are then locked by name in
+ * a shuffled order, and a number of names that don't exist are looked up
+ * as well. Lookups are timed at several directory sizes, so it shows
+ * whether they get slower as the directory grows.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <exec/types.h>
+#include <dos/dos.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "DIR/A,FILES/N,LOOKUPS/N,KEEP/S"
+
+enum
+{
+    ARG_DIR,
+    ARG_FILES,
+    ARG_LOOKUPS,
+    ARG_KEEP,
+    NUM_ARGS
+};
+
+/* Long enough to need a long name on FAT */
+static void makename(char *name, ULONG size, CONST_STRPTR dir, ULONG n)
+{
+    snprintf(name, size, "%s/DirBench file number %lu.dat", dir, (unsigned long)n);
+}
+
+/* Looks up random names among the first 'files' ones. Returns lookups per second */
+static double lookups(CONST_STRPTR dir, ULONG files, ULONG count, BOOL missing)
+{
+    struct timeval tv_start;
+    char name[256];
+    ULONG i, seed = files;
+    double t;
+    BPTR lock;
+
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < count; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        makename(name, sizeof(name), dir, (seed >> 8) % files + (missing ? files : 0));
+        if ((lock = Lock(name, SHARED_LOCK)) != BNULL)
+            UnLock(lock);
+        else if (!missing)
+        {
+            printf("Couldn't lock '%s' (%ld)\n", name, (long)IoErr());
+            return 0.0;
+        }
+    }
+    t = elapsed(&tv_start);
+
+    return (t > 0) ? count / t : 0.0;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct timeval tv_start;
+    CONST_STRPTR dir;
+    char name[256];
+    ULONG files, count, made = 0, next = 100, i;
+    double t = 0;
+    BPTR lock, fh;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "DirBench");
+        return RETURN_FAIL;
+    }
+
+    dir = (CONST_STRPTR)args[ARG_DIR];
+    files = args[ARG_FILES] ? *(ULONG *)args[ARG_FILES] : 10000;
+    count = args[ARG_LOOKUPS] ? *(ULONG *)args[ARG_LOOKUPS] : 1000;
+
+    /* Start with an empty directory of our own */
+    if ((lock = CreateDir(dir)) == BNULL)
+    {
+        printf("Couldn't create '%s' (%ld)\n", dir, (long)IoErr());
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+    UnLock(lock);
+
+    printf("DirBench: up to %lu files in '%s', %lu lookups per test\n\n",
+           (unsigned long)files, dir, (unsigned long)count);
+    printf("  %8s %12s %14s %14s\n", "Files", "Create/s", "Lookup/s", "Missing/s");
+
+    gettimeofday(&tv_start, NULL);
+    while (made < files)
+    {
+        makename(name, sizeof(name), dir, made);
+        if ((fh = Open(name, MODE_NEWFILE)) == BNULL)
+        {
+            printf("Couldn't create '%s' (%ld)\n", name, (long)IoErr());
+            result = RETURN_ERROR;
+            break;
+        }
+        Close(fh);
+        made++;
+
+        if (made == next || made == files)
+        {
+            /* Only count the time spent creating files */
+            t += elapsed(&tv_start);
+
+            printf("  %8lu %12.1f %14.1f %14.1f\n", (unsigned long)made,
+                   (t > 0) ? made / t : 0.0,
+                   lookups(dir, made, count, FALSE), lookups(dir, made, count, TRUE));
+            next *= 10;
+            gettimeofday(&tv_start, NULL);
+        }
+
+        if (CheckSignal(SIGBREAKF_CTRL_C))
+        {
+            printf("***Break\n");
+            break;
+        }
+    }
+
+    if (!args[ARG_KEEP])
+    {
+        for (i = 0; i < made; i++)
+        {
+            makename(name, sizeof(name), dir, i);
+            DeleteFile(name);
+        }
+        DeleteFile(dir);
+    }
+
+    FreeArgs(rda);
+
+    return result;
+}
@@ -0,0 +1,185 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Fills a volume with files until it is full, and reports how quickly
+ * space is allocated as the volume fills up. Meant for big FAT images on
+ * a hostdisk, where finding free clusters used to get slower the fuller
+ * the volume was. Two files are written at once, so that their clusters
+ * have to interleave unless the filesystem keeps them apart.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "DIR/A,FILESIZE/N,CHUNK/N,MAX/N"
+
+enum
+{
+    ARG_DIR,
+    ARG_FILESIZE,
+    ARG_CHUNK,
+    ARG_MAX,
+    NUM_ARGS
+};
+
+/* Progress is reported every time this much more of the volume is used */
+#define STEPS       10
+
+static void makename(char *name, ULONG size, CONST_STRPTR dir, ULONG n)
+{
+    snprintf(name, size, "%s%sfatbench.%lu", dir,
+             (dir[0] != '\0' && dir[strlen(dir) - 1] != ':' && dir[strlen(dir) - 1] != '/') ? "/" : "",
+             (unsigned long)n);
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct InfoData *id;
+    struct timeval tv_start, tv_step;
+    CONST_STRPTR dir;
+    char name[2][256];
+    BPTR lock, fh[2];
+    UBYTE *buffer;
+    ULONG filesize, chunk, max, files = 0, step = 1, i, n;
+    UQUAD total, written = 0, stepwritten = 0;
+    BOOL full = FALSE;
+    double t;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "FATBench");
+        return RETURN_FAIL;
+    }
+
+    dir = (CONST_STRPTR)args[ARG_DIR];
+    filesize = (args[ARG_FILESIZE] ? *(ULONG *)args[ARG_FILESIZE] : 1024) * 1024;
+    chunk = args[ARG_CHUNK] ? *(ULONG *)args[ARG_CHUNK] : 16384;
+    max = args[ARG_MAX] ? *(ULONG *)args[ARG_MAX] : 0xffffffff;
+    if (chunk == 0 || chunk > filesize)
+        chunk = filesize;
+
+    id = AllocMem(sizeof(struct InfoData), MEMF_ANY | MEMF_CLEAR);
+    buffer = AllocMem(chunk, MEMF_ANY | MEMF_CLEAR);
+    if (id == NULL || buffer == NULL)
+    {
+        printf("Failed to allocate buffers\n");
+        if (buffer)
+            FreeMem(buffer, chunk);
+        if (id)
+            FreeMem(id, sizeof(struct InfoData));
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    if ((lock = Lock(dir, SHARED_LOCK)) == BNULL)
+    {
+        printf("Couldn't lock '%s' (%ld)\n", dir, (long)IoErr());
+        FreeMem(buffer, chunk);
+        FreeMem(id, sizeof(struct InfoData));
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    /* The first Info() may have to count the free clusters */
+    gettimeofday(&tv_start, NULL);
+    Info(lock, id);
+    t = elapsed(&tv_start);
+
+    total = (UQUAD)(id->id_NumBlocks - id->id_NumBlocksUsed) * id->id_BytesPerBlock;
+    printf("FATBench: %lu KB files in %lu byte chunks in '%s'\n",
+           (unsigned long)(filesize / 1024), (unsigned long)chunk, dir);
+    printf("  %lu MB free, Info() took %.3f s\n\n",
+           (unsigned long)(total >> 20), t);
+    printf("  %6s %8s %10s %12s\n", "Used", "Files", "MB/s", "ms/file");
+
+    gettimeofday(&tv_start, NULL);
+    tv_step = tv_start;
+    while (!full && files < max)
+    {
+        ULONG stepfiles = files;
+
+        /* Write two files side by side */
+        for (n = 0; n < 2; n++)
+        {
+            makename(name[n], sizeof(name[n]), dir, files + n);
+            fh[n] = Open(name[n], MODE_NEWFILE);
+            if (fh[n] == BNULL)
+                full = TRUE;
+        }
+
+        for (i = 0; !full && i < filesize; i += chunk)
+        {
+            for (n = 0; n < 2; n++)
+            {
+                if (Write(fh[n], buffer, chunk) != chunk)
+                    full = TRUE;
+                else
+                    written += chunk;
+            }
+        }
+
+        for (n = 0; n < 2; n++)
+        {
+            if (fh[n] != BNULL)
+                Close(fh[n]);
+        }
+        files += 2;
+
+        if (CheckSignal(SIGBREAKF_CTRL_C))
+        {
+            printf("***Break\n");
+            break;
+        }
+
+        /* Report every time another tenth of the free space has been used */
+        if (full || written >= total / STEPS * step)
+        {
+            t = elapsed(&tv_step);
+            printf("  %5lu%% %8lu %10.2f %12.2f\n",
+                   (unsigned long)(total ? written * 100 / total : 0), (unsigned long)files,
+                   (t > 0) ? (double)(written - stepwritten) / t / (1024 * 1024) : 0.0,
+                   (files > stepfiles) ? t * 1000.0 / (files - stepfiles) : 0.0);
+            gettimeofday(&tv_step, NULL);
+            stepwritten = written;
+            while (step < STEPS && written >= total / STEPS * step)
+                step++;
+        }
+    }
+
+    t = elapsed(&tv_start);
+    printf("\n  Wrote %lu MB in %lu files, %.2f MB/s overall\n",
+           (unsigned long)(written >> 20), (unsigned long)files,
+           (t > 0) ? (double)written / t / (1024 * 1024) : 0.0);
+
+    /* Deleting everything shows how quickly clusters are given back */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < files; i++)
+    {
+        makename(name[0], sizeof(name[0]), dir, i);
+        DeleteFile(name[0]);
+    }
+    Info(lock, id);
+    printf("  Deleted them in %.3f s, %lu MB free again\n", elapsed(&tv_start),
+           (unsigned long)(((UQUAD)(id->id_NumBlocks - id->id_NumBlocksUsed)
+           * id->id_BytesPerBlock) >> 20));
+
+    UnLock(lock);
+    FreeMem(buffer, chunk);
+    FreeMem(id, sizeof(struct InfoData));
+    FreeArgs(rda);
+
+    return RETURN_OK;
+}
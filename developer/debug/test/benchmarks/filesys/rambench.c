@@ -0,0 +1,209 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures the operations that get slow on RAM: when directories and
+ * files get big: creating files in one directory, looking them up by
+ * name, and seeking to random places in a large file.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "DIR,FILES/N,SIZE/N,SEEKS/N"
+
+enum
+{
+    ARG_DIR,
+    ARG_FILES,
+    ARG_SIZE,
+    ARG_SEEKS,
+    NUM_ARGS
+};
+
+#define CHUNK       4096
+
+static void report(CONST_STRPTR test, ULONG count, CONST_STRPTR unit, double seconds)
+{
+    printf("  %-24s %12.1f %s/s  (%.3f s)\n", test,
+           (seconds > 0) ? count / seconds : 0.0, unit, seconds);
+}
+
+static void makename(char *name, ULONG size, CONST_STRPTR dir, ULONG n)
+{
+    char file[32];
+
+    snprintf(file, sizeof(file), "RAMBench.%lu", (unsigned long)n);
+    snprintf(name, size, "%s", dir);
+    AddPart(name, file, size);
+}
+
+static BOOL testdir(CONST_STRPTR dir, ULONG files)
+{
+    struct timeval tv_start;
+    char name[256];
+    ULONG i, seed = 1;
+    BPTR fh, lock;
+    BOOL success = TRUE;
+
+    /* Create */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < files; i++)
+    {
+        makename(name, sizeof(name), dir, i);
+        if ((fh = Open(name, MODE_NEWFILE)) == BNULL)
+        {
+            printf("Couldn't create '%s' (%ld)\n", name, (long)IoErr());
+            success = FALSE;
+            break;
+        }
+        Close(fh);
+    }
+    files = i;
+    report("Create", files, "files", elapsed(&tv_start));
+
+    /* Look up existing names in random order */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; success && i < files; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        makename(name, sizeof(name), dir, (seed >> 8) % files);
+        if ((lock = Lock(name, SHARED_LOCK)) == BNULL)
+        {
+            printf("Couldn't lock '%s' (%ld)\n", name, (long)IoErr());
+            success = FALSE;
+        }
+        else
+            UnLock(lock);
+    }
+    report("Lookup", i, "locks", elapsed(&tv_start));
+
+    /* Look up names that don't exist */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; success && i < files; i++)
+    {
+        makename(name, sizeof(name), dir, files + i);
+        if ((lock = Lock(name, SHARED_LOCK)) != BNULL)
+            UnLock(lock);
+    }
+    report("Lookup missing", i, "locks", elapsed(&tv_start));
+
+    /* Delete */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < files; i++)
+    {
+        makename(name, sizeof(name), dir, i);
+        DeleteFile(name);
+    }
+    report("Delete", files, "files", elapsed(&tv_start));
+
+    return success;
+}
+
+static BOOL testseek(CONST_STRPTR dir, UBYTE *buffer, ULONG size, ULONG seeks)
+{
+    struct timeval tv_start;
+    char name[256];
+    ULONG i, chunks = size / CHUNK, seed = 1;
+    BPTR fh;
+    BOOL success = TRUE;
+
+    makename(name, sizeof(name), dir, 0xffffffff);
+    if ((fh = Open(name, MODE_NEWFILE)) == BNULL)
+    {
+        printf("Couldn't create '%s' (%ld)\n", name, (long)IoErr());
+        return FALSE;
+    }
+
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < chunks; i++)
+    {
+        if (Write(fh, buffer, CHUNK) != CHUNK)
+        {
+            printf("Write failed (%ld)\n", (long)IoErr());
+            success = FALSE;
+            break;
+        }
+    }
+    report("Sequential write", i * (CHUNK / 1024), "KB", elapsed(&tv_start));
+
+    /* Seek to random places, and read a little from each */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; success && i < seeks; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        Seek(fh, (seed >> 4) % (size - 16), OFFSET_BEGINNING);
+        if (Read(fh, buffer, 16) != 16)
+        {
+            printf("Read failed (%ld)\n", (long)IoErr());
+            success = FALSE;
+        }
+    }
+    report("Random seek and read", i, "seeks", elapsed(&tv_start));
+
+    /* Seek from the end, which walks backwards through the file */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; success && i < seeks; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        Seek(fh, -(LONG)((seed >> 4) % size), OFFSET_END);
+    }
+    report("Seek from end", i, "seeks", elapsed(&tv_start));
+
+    Close(fh);
+    DeleteFile(name);
+
+    return success;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    CONST_STRPTR dir;
+    UBYTE *buffer;
+    ULONG files, size, seeks;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "RAMBench");
+        return RETURN_FAIL;
+    }
+
+    dir = args[ARG_DIR] ? (CONST_STRPTR)args[ARG_DIR] : (CONST_STRPTR)"RAM:";
+    files = args[ARG_FILES] ? *(ULONG *)args[ARG_FILES] : 10000;
+    size = (args[ARG_SIZE] ? *(ULONG *)args[ARG_SIZE] : 64) * 1024 * 1024;
+    seeks = args[ARG_SEEKS] ? *(ULONG *)args[ARG_SEEKS] : 100000;
+    if (size < CHUNK)
+        size = CHUNK;
+
+    if ((buffer = AllocMem(CHUNK, MEMF_ANY | MEMF_CLEAR)) == NULL)
+    {
+        printf("Failed to allocate a %d byte buffer\n", CHUNK);
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    printf("RAMBench: %lu files and a %lu MB file in '%s'\n\n",
+           (unsigned long)files, (unsigned long)(size / (1024 * 1024)), dir);
+
+    if (!testdir(dir, files))
+        result = RETURN_ERROR;
+    if (!testseek(dir, buffer, size, seeks))
+        result = RETURN_ERROR;
+
+    FreeMem(buffer, CHUNK);
+    FreeArgs(rda);
+
+    return result;
+}
@@ -0,0 +1,188 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures sequential and random file throughput on a volume, for
+ * example a ramdrive or a hostdisk formatted with SFS. On SFS volumes
+ * each test is run with synchronous cache transfers (Async=0) and with
+ * the asynchronous read-ahead and write-behind, and the cache settings
+ * are restored afterwards.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <dos/dosextens.h>
+#include <utility/tagitem.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include "packets.h"
+#include "query.h"
+#include "../benchtime.h"
+
+#define TEMPLATE    "FILE/A,SIZE/N,CHUNK/N,ASYNC/N"
+
+enum
+{
+    ARG_FILE,
+    ARG_SIZE,
+    ARG_CHUNK,
+    ARG_ASYNC,
+    NUM_ARGS
+};
+
+static void report(CONST_STRPTR test, ULONG bytes, double seconds)
+{
+    printf("  %-18s %8.2f MB/s  (%.3f s)\n", test,
+           (seconds > 0) ? (double)bytes / seconds / (1024 * 1024) : 0.0, seconds);
+}
+
+static BOOL runtests(CONST_STRPTR filename, UBYTE *buffer, ULONG size, ULONG chunk)
+{
+    struct timeval tv_start;
+    ULONG chunks = size / chunk;
+    ULONG i, seed = 1;
+    BPTR fh;
+
+    /* Sequential write, in chunks small enough to go through the cache */
+    if ((fh = Open(filename, MODE_NEWFILE)) == BNULL)
+    {
+        printf("Couldn't create '%s' (%ld)\n", filename, (long)IoErr());
+        return FALSE;
+    }
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < chunks; i++)
+    {
+        buffer[0] = i;
+        if (Write(fh, buffer, chunk) != chunk)
+            break;
+    }
+    Close(fh);
+    report("Sequential write", i * chunk, elapsed(&tv_start));
+    if (i != chunks)
+    {
+        printf("Write failed (%ld)\n", (long)IoErr());
+        return FALSE;
+    }
+
+    if ((fh = Open(filename, MODE_OLDFILE)) == BNULL)
+    {
+        printf("Couldn't open '%s' (%ld)\n", filename, (long)IoErr());
+        return FALSE;
+    }
+
+    /* Sequential read */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < chunks; i++)
+    {
+        if (Read(fh, buffer, chunk) != chunk)
+            break;
+    }
+    report("Sequential read", i * chunk, elapsed(&tv_start));
+
+    /* Random reads; read-ahead shouldn't make these any slower */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < chunks; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        Seek(fh, ((seed >> 8) % chunks) * chunk, OFFSET_BEGINNING);
+        if (Read(fh, buffer, chunk) != chunk)
+            break;
+    }
+    report("Random read", i * chunk, elapsed(&tv_start));
+
+    Close(fh);
+
+    return TRUE;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct DevProc *dvp = NULL;
+    struct TagItem tags[] =
+    {
+        { ASQ_CACHE_LINES,          0 },
+        { ASQ_CACHE_READAHEADSIZE,  0 },
+        { ASQ_CACHE_MODE,           0 },
+        { ASQ_CACHE_ASYNC,          0 },
+        { TAG_END,                  0 }
+    };
+    CONST_STRPTR filename;
+    UBYTE *buffer;
+    ULONG size, chunk, async;
+    BOOL issfs;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "SFSBench");
+        return RETURN_FAIL;
+    }
+
+    filename = (CONST_STRPTR)args[ARG_FILE];
+    size = (args[ARG_SIZE] ? *(ULONG *)args[ARG_SIZE] : 16) * 1024 * 1024;
+    chunk = args[ARG_CHUNK] ? *(ULONG *)args[ARG_CHUNK] : 2048;
+    if (chunk == 0 || chunk > size)
+        chunk = size;
+
+    if ((buffer = AllocMem(chunk, MEMF_ANY | MEMF_CLEAR)) == NULL)
+    {
+        printf("Failed to allocate a %lu byte buffer\n", (unsigned long)chunk);
+        FreeArgs(rda);
+        return RETURN_FAIL;
+    }
+
+    /* Only SFS knows ASQ_CACHE_ASYNC; other filesystems fail the packet */
+    dvp = GetDeviceProc(filename, NULL);
+    issfs = dvp != NULL && DoPkt(dvp->dvp_Port, ACTION_SFS_QUERY, (SIPTR)tags, 0, 0, 0, 0) != DOSFALSE;
+
+    printf("SFSBench: %lu MB in %lu byte chunks on '%s'\n",
+           (unsigned long)(size / (1024 * 1024)), (unsigned long)chunk, filename);
+
+    if (issfs)
+    {
+        ULONG mode = (tags[2].ti_Data ? SCF_COPYBACK : 0) | SCF_ASYNC;
+
+        async = args[ARG_ASYNC] ? *(ULONG *)args[ARG_ASYNC] : tags[3].ti_Data;
+        if (async == 0)
+            async = 4;
+
+        printf("\nSynchronous cache transfers:\n");
+        DoPkt(dvp->dvp_Port, ACTION_SET_CACHE, tags[0].ti_Data, tags[1].ti_Data, mode, 0, 0);
+        if (!runtests(filename, buffer, size, chunk))
+            result = RETURN_ERROR;
+
+        if (result == RETURN_OK)
+        {
+            printf("\nUp to %lu asynchronous cache transfers:\n", (unsigned long)async);
+            DoPkt(dvp->dvp_Port, ACTION_SET_CACHE, tags[0].ti_Data, tags[1].ti_Data, mode, async, 0);
+            if (!runtests(filename, buffer, size, chunk))
+                result = RETURN_ERROR;
+        }
+
+        DoPkt(dvp->dvp_Port, ACTION_SET_CACHE, tags[0].ti_Data, tags[1].ti_Data, mode, tags[3].ti_Data, 0);
+    }
+    else
+    {
+        printf("\nNot an SFS volume, running the tests once:\n");
+        if (!runtests(filename, buffer, size, chunk))
+            result = RETURN_ERROR;
+    }
+
+    DeleteFile(filename);
+
+    if (dvp)
+        FreeDeviceProc(dvp);
+    FreeMem(buffer, chunk);
+    FreeArgs(rda);
+
+    return result;
+}
@@ -0,0 +1,254 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures region operations the way layers uses them, on random window
+ * layouts: adding up damage, working out the visible part of every
+ * window from the windows in front of it, and combining the results.
+ * Adding and clearing rectangles one at a time is compared with
+ * OrRectsRegion() and ClearRectsRegion(), which take them all at once,
+ * and both are checked to give the same regions.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <graphics/regions.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "WINDOWS/N,LAYOUTS/N,WIDTH/N,HEIGHT/N,SEED/N"
+
+enum
+{
+    ARG_WINDOWS,
+    ARG_LAYOUTS,
+    ARG_WIDTH,
+    ARG_HEIGHT,
+    ARG_SEED,
+    NUM_ARGS
+};
+
+enum
+{
+    TEST_DAMAGE,
+    TEST_DAMAGE_BATCH,
+    TEST_VISIBLE,
+    TEST_VISIBLE_BATCH,
+    TEST_AND,
+    TEST_XOR,
+    TEST_CLEAR,
+    NUM_TESTS
+};
+
+static const char *testnames[NUM_TESTS] =
+{
+    "OrRectRegion",
+    "OrRectsRegion",
+    "ClearRectRegion",
+    "ClearRectsRegion",
+    "AndRegionRegion",
+    "XorRegionRegion",
+    "ClearRegionRegion"
+};
+
+static ULONG seed;
+
+static ULONG rnd(ULONG range)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return (seed >> 8) % range;
+}
+
+/* Windows of all sizes, some of them partly off screen */
+static void makelayout(struct Rectangle *windows, ULONG count, ULONG width, ULONG height)
+{
+    ULONG i;
+
+    for (i = 0; i < count; i++)
+    {
+        windows[i].MinX = rnd(width) - width / 8;
+        windows[i].MinY = rnd(height) - height / 8;
+        windows[i].MaxX = windows[i].MinX + 40 + rnd(width / 2);
+        windows[i].MaxY = windows[i].MinY + 20 + rnd(height / 2);
+    }
+}
+
+static ULONG countrects(struct Region *r)
+{
+    struct RegionRectangle *rr;
+    ULONG n = 0;
+
+    for (rr = r->RegionRectangle; rr; rr = rr->Next)
+        n++;
+
+    return n;
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct timeval tv_start;
+    struct Rectangle *windows;
+    struct Region **visible, **visiblebatch, *damage, *damagebatch, *r;
+    double times[NUM_TESTS] = { 0 };
+    ULONG ops[NUM_TESTS] = { 0 };
+    ULONG count, layouts, width, height, layout, i, j, rects = 0;
+    BOOL ok = TRUE;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "Regions");
+        return RETURN_FAIL;
+    }
+
+    count = args[ARG_WINDOWS] ? *(ULONG *)args[ARG_WINDOWS] : 100;
+    layouts = args[ARG_LAYOUTS] ? *(ULONG *)args[ARG_LAYOUTS] : 20;
+    width = args[ARG_WIDTH] ? *(ULONG *)args[ARG_WIDTH] : 1920;
+    height = args[ARG_HEIGHT] ? *(ULONG *)args[ARG_HEIGHT] : 1080;
+    seed = args[ARG_SEED] ? *(ULONG *)args[ARG_SEED] : 1;
+    FreeArgs(rda);
+
+    if (count < 2)
+        count = 2;
+
+    windows = AllocVec(count * sizeof(struct Rectangle), MEMF_ANY);
+    visible = AllocVec(count * sizeof(struct Region *), MEMF_ANY | MEMF_CLEAR);
+    visiblebatch = AllocVec(count * sizeof(struct Region *), MEMF_ANY | MEMF_CLEAR);
+    if (!windows || !visible || !visiblebatch)
+    {
+        printf("Failed to allocate buffers\n");
+        FreeVec(visiblebatch);
+        FreeVec(visible);
+        FreeVec(windows);
+        return RETURN_FAIL;
+    }
+
+    printf("Regions: %lu layouts of %lu windows on a %lux%lu screen\n\n",
+           (unsigned long)layouts, (unsigned long)count,
+           (unsigned long)width, (unsigned long)height);
+
+    for (layout = 0; ok && layout < layouts; layout++)
+    {
+        makelayout(windows, count, width, height);
+
+        /* All the damage when every window is refreshed */
+        damage = NewRegion();
+        damagebatch = NewRegion();
+
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+            OrRectRegion(damage, &windows[i]);
+        times[TEST_DAMAGE] += elapsed(&tv_start);
+        ops[TEST_DAMAGE] += count;
+
+        gettimeofday(&tv_start, NULL);
+        OrRectsRegion(damagebatch, windows, count);
+        times[TEST_DAMAGE_BATCH] += elapsed(&tv_start);
+        ops[TEST_DAMAGE_BATCH] += count;
+
+        if (!AreRegionsEqual(damage, damagebatch))
+        {
+            printf("Layout %lu: damage regions differ\n", (unsigned long)layout);
+            ok = FALSE;
+        }
+
+        /* The visible part of each window, the first window is in front */
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+        {
+            visible[i] = NewRegion();
+            OrRectRegion(visible[i], &windows[i]);
+            for (j = 0; j < i; j++)
+                ClearRectRegion(visible[i], &windows[j]);
+        }
+        times[TEST_VISIBLE] += elapsed(&tv_start);
+        ops[TEST_VISIBLE] += count * (count - 1) / 2;
+
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+        {
+            visiblebatch[i] = NewRegion();
+            OrRectRegion(visiblebatch[i], &windows[i]);
+            ClearRectsRegion(visiblebatch[i], windows, i);
+        }
+        times[TEST_VISIBLE_BATCH] += elapsed(&tv_start);
+        ops[TEST_VISIBLE_BATCH] += count * (count - 1) / 2;
+
+        for (i = 0; i < count; i++)
+        {
+            rects += countrects(visible[i]);
+            if (ok && !AreRegionsEqual(visible[i], visiblebatch[i]))
+            {
+                printf("Layout %lu: visible regions of window %lu differ\n",
+                       (unsigned long)layout, (unsigned long)i);
+                ok = FALSE;
+            }
+        }
+
+        /* Combine the visible regions with the damage, as a refresh would */
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+        {
+            if ((r = AndRegionRegionND(damage, visible[i])) != NULL)
+                DisposeRegion(r);
+        }
+        times[TEST_AND] += elapsed(&tv_start);
+        ops[TEST_AND] += count;
+
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+        {
+            if ((r = XorRegionRegionND(damage, visible[i])) != NULL)
+                DisposeRegion(r);
+        }
+        times[TEST_XOR] += elapsed(&tv_start);
+        ops[TEST_XOR] += count;
+
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < count; i++)
+        {
+            if ((r = ClearRegionRegionND(visible[i], damage)) != NULL)
+                DisposeRegion(r);
+        }
+        times[TEST_CLEAR] += elapsed(&tv_start);
+        ops[TEST_CLEAR] += count;
+
+        for (i = 0; i < count; i++)
+        {
+            DisposeRegion(visible[i]);
+            DisposeRegion(visiblebatch[i]);
+        }
+        DisposeRegion(damagebatch);
+        DisposeRegion(damage);
+
+        if (CheckSignal(SIGBREAKF_CTRL_C))
+        {
+            printf("***Break\n");
+            break;
+        }
+    }
+
+    printf("  %-20s %14s %10s\n", "Operation", "Rects/ops/s", "Seconds");
+    for (i = 0; i < NUM_TESTS; i++)
+    {
+        printf("  %-20s %14.1f %10.3f\n", testnames[i],
+               (times[i] > 0) ? ops[i] / times[i] : 0.0, times[i]);
+    }
+    printf("\n  Visible regions had %.1f rectangles on average\n",
+           (layout && count) ? (double)rects / (layout * count) : 0.0);
+
+    FreeVec(visiblebatch);
+    FreeVec(visible);
+    FreeVec(windows);
+
+    return ok ? RETURN_OK : RETURN_ERROR;
+}
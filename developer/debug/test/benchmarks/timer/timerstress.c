@@ -0,0 +1,295 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Puts timer.device under load with a large number of pending requests.
+ * All requests are sent with random timeouts, some of them are aborted
+ * again, and the rest are waited for. Reported are the time SendIO() and
+ * AbortIO() take with that many requests pending, and how late the
+ * requests were replied, measured from the time they were sent plus
+ * their timeout. The send time is taken with GetUpTime() right before
+ * each SendIO(), so it is included in the time of the latter.
+ *
+ * Next to those, FAR requests with timeouts of one minute to two hours
+ * are kept pending, like the timeouts of a busy network stack, and are
+ * aborted at the end. While waiting, a probe request of PROBE
+ * microseconds is sent over and over. How late it comes back at worst
+ * shows how long the timer interrupt was held up by moving requests
+ * around, e.g. at the turns of the timing wheel every ~4.2 s, so the
+ * default MAXDELAY covers a few of those.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+#include <exec/memory.h>
+#include <devices/timer.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/timer.h>
+
+#include "../benchtime.h"
+
+#define TEMPLATE    "REQUESTS/N,MAXDELAY/N,ABORT/N,SEED/N,FAR/N,PROBE/N,VBLANK/S"
+
+#define FAR_MINDELAY    60              /* s */
+#define FAR_MAXDELAY    (2 * 60 * 60)   /* s */
+
+enum
+{
+    ARG_REQUESTS,
+    ARG_MAXDELAY,
+    ARG_ABORT,
+    ARG_SEED,
+    ARG_FAR,
+    ARG_PROBE,
+    ARG_VBLANK,
+    NUM_ARGS
+};
+
+struct Device *TimerBase;
+
+static ULONG seed;
+
+static ULONG rnd(ULONG range)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return (seed >> 8) % range;
+}
+
+/* Difference between two timer.device times in microseconds, may be negative */
+static double difftime_us(struct timeval *a, struct timeval *b)
+{
+    return ((double)a->tv_secs - (double)b->tv_secs) * 1000000.0
+           + ((double)a->tv_micro - (double)b->tv_micro);
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct MsgPort *port;
+    struct timerequest *master, *reqs = NULL, *farreqs = NULL, *probe = NULL, *tr;
+    struct timeval tv_start, now, probedue, *due = NULL;
+    UBYTE *pending = NULL;
+    ULONG count, maxdelay, abortpct, farcount, probedelay, unit, delay, i;
+    ULONG outstanding = 0, aborted = 0, replied = 0, early = 0, farsent = 0, probes = 0;
+    double send_t = 0, abort_t = 0, late, late_sum = 0, late_min = 1e12, late_max = 0;
+    double probe_sum = 0, probe_max = 0;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "TimerStress");
+        return RETURN_FAIL;
+    }
+
+    count = args[ARG_REQUESTS] ? *(ULONG *)args[ARG_REQUESTS] : 10000;
+    maxdelay = args[ARG_MAXDELAY] ? *(ULONG *)args[ARG_MAXDELAY] : 20000;
+    abortpct = args[ARG_ABORT] ? *(ULONG *)args[ARG_ABORT] : 10;
+    seed = args[ARG_SEED] ? *(ULONG *)args[ARG_SEED] : 1;
+    farcount = args[ARG_FAR] ? *(ULONG *)args[ARG_FAR] : 10000;
+    probedelay = args[ARG_PROBE] ? *(ULONG *)args[ARG_PROBE] : 1000;
+    unit = args[ARG_VBLANK] ? UNIT_VBLANK : UNIT_MICROHZ;
+    FreeArgs(rda);
+
+    if (count < 1)
+        count = 1;
+    if (maxdelay < 1)
+        maxdelay = 1;
+    if (abortpct > 100)
+        abortpct = 100;
+    if (probedelay < 1)
+        probedelay = 1;
+
+    if ((port = CreateMsgPort()) == NULL)
+        return RETURN_FAIL;
+
+    master = (struct timerequest *)CreateIORequest(port, sizeof(struct timerequest));
+    if (master == NULL || OpenDevice(TIMERNAME, unit, (struct IORequest *)master, 0) != 0)
+    {
+        printf("Couldn't open %s\n", TIMERNAME);
+        DeleteIORequest((struct IORequest *)master);
+        DeleteMsgPort(port);
+        return RETURN_FAIL;
+    }
+    TimerBase = master->tr_node.io_Device;
+
+    reqs = AllocVec(count * sizeof(struct timerequest), MEMF_ANY);
+    due = AllocVec(count * sizeof(struct timeval), MEMF_ANY);
+    pending = AllocVec(count, MEMF_ANY | MEMF_CLEAR);
+    probe = AllocVec(sizeof(struct timerequest), MEMF_ANY);
+    if (farcount)
+        farreqs = AllocVec(farcount * sizeof(struct timerequest), MEMF_ANY);
+    if (!reqs || !due || !pending || !probe || (farcount && !farreqs))
+    {
+        printf("Failed to allocate buffers\n");
+        result = RETURN_FAIL;
+        goto cleanup;
+    }
+
+    printf("TimerStress: %lu %s requests of up to %lu ms, %lu%% aborted\n",
+           (unsigned long)count, (unit == UNIT_VBLANK) ? "VBLANK" : "MICROHZ",
+           (unsigned long)maxdelay, (unsigned long)abortpct);
+    printf("             %lu requests of %u to %u min pending, %lu us probe\n\n",
+           (unsigned long)farcount, FAR_MINDELAY / 60, FAR_MAXDELAY / 60,
+           (unsigned long)probedelay);
+
+    /* The far requests are only there to be carried along */
+    for (i = 0; i < farcount; i++)
+    {
+        tr = &farreqs[i];
+        CopyMem(master, tr, sizeof(struct timerequest));
+        tr->tr_node.io_Command = TR_ADDREQUEST;
+        tr->tr_time.tv_secs = FAR_MINDELAY + rnd(FAR_MAXDELAY - FAR_MINDELAY);
+        tr->tr_time.tv_micro = rnd(1000000);
+        SendIO((struct IORequest *)tr);
+        farsent++;
+    }
+
+    /* Send them all, the later ones go in with the most requests pending */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < count; i++)
+    {
+        tr = &reqs[i];
+        CopyMem(master, tr, sizeof(struct timerequest));
+        tr->tr_node.io_Command = TR_ADDREQUEST;
+
+        delay = rnd(maxdelay * 1000);
+        tr->tr_time.tv_secs = delay / 1000000;
+        tr->tr_time.tv_micro = delay % 1000000;
+
+        GetUpTime(&due[i]);
+        AddTime(&due[i], &tr->tr_time);
+
+        SendIO((struct IORequest *)tr);
+        pending[i] = TRUE;
+        outstanding++;
+    }
+    send_t = elapsed(&tv_start);
+
+    /* Abort some of them, at random places in the queues */
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < count; i++)
+    {
+        if (rnd(100) < abortpct)
+        {
+            AbortIO((struct IORequest *)&reqs[i]);
+            aborted++;
+        }
+    }
+    abort_t = elapsed(&tv_start);
+
+    CopyMem(master, probe, sizeof(struct timerequest));
+    probe->tr_node.io_Command = TR_ADDREQUEST;
+    probe->tr_time.tv_secs = 0;
+    probe->tr_time.tv_micro = probedelay;
+    GetUpTime(&probedue);
+    AddTime(&probedue, &probe->tr_time);
+    SendIO((struct IORequest *)probe);
+
+    /* Wait for all the rest to come back */
+    while (outstanding)
+    {
+        ULONG sigs = Wait((1L << port->mp_SigBit) | SIGBREAKF_CTRL_C);
+
+        GetUpTime(&now);
+
+        while ((tr = (struct timerequest *)GetMsg(port)) != NULL)
+        {
+            if (tr == probe)
+            {
+                late = difftime_us(&now, &probedue);
+                if (late < 0)
+                    early++;
+                probe_sum += late;
+                if (late > probe_max)
+                    probe_max = late;
+                probes++;
+
+                probe->tr_time.tv_secs = 0;
+                probe->tr_time.tv_micro = probedelay;
+                GetUpTime(&probedue);
+                AddTime(&probedue, &probe->tr_time);
+                SendIO((struct IORequest *)probe);
+                continue;
+            }
+
+            /* Only with a very long MAXDELAY */
+            if (farreqs && tr >= farreqs && tr < farreqs + farsent)
+                continue;
+
+            i = tr - reqs;
+            pending[i] = FALSE;
+            outstanding--;
+
+            if (tr->tr_node.io_Error != 0)
+                continue;
+
+            late = difftime_us(&now, &due[i]);
+            if (late < 0)
+                early++;
+
+            late_sum += late;
+            if (late < late_min)
+                late_min = late;
+            if (late > late_max)
+                late_max = late;
+            replied++;
+        }
+
+        if (sigs & SIGBREAKF_CTRL_C)
+        {
+            printf("***Break\n");
+            for (i = 0; i < count; i++)
+            {
+                if (pending[i])
+                {
+                    AbortIO((struct IORequest *)&reqs[i]);
+                    WaitIO((struct IORequest *)&reqs[i]);
+                }
+            }
+            break;
+        }
+    }
+
+    AbortIO((struct IORequest *)probe);
+    WaitIO((struct IORequest *)probe);
+    for (i = 0; i < farsent; i++)
+    {
+        AbortIO((struct IORequest *)&farreqs[i]);
+        WaitIO((struct IORequest *)&farreqs[i]);
+    }
+
+    printf("  %-24s %10.3f us\n", "SendIO()", send_t * 1000000.0 / count);
+    printf("  %-24s %10.3f us\n", "AbortIO()", aborted ? abort_t * 1000000.0 / aborted : 0.0);
+    printf("  %-24s %10lu\n", "Requests completed", (unsigned long)replied);
+    printf("  %-24s %10lu\n", "Requests aborted", (unsigned long)aborted);
+    printf("  %-24s %10.3f ms\n", "Average latency", replied ? late_sum / replied / 1000.0 : 0.0);
+    printf("  %-24s %10.3f ms\n", "Lowest latency", replied ? late_min / 1000.0 : 0.0);
+    printf("  %-24s %10.3f ms\n", "Highest latency", late_max / 1000.0);
+    printf("  %-24s %10lu\n", "Probes", (unsigned long)probes);
+    printf("  %-24s %10.3f ms\n", "Average probe latency", probes ? probe_sum / probes / 1000.0 : 0.0);
+    printf("  %-24s %10.3f ms\n", "Worst probe latency", probe_max / 1000.0);
+
+    if (early)
+    {
+        printf("\n  %lu requests were replied before they were due\n", (unsigned long)early);
+        result = RETURN_ERROR;
+    }
+
+cleanup:
+    FreeVec(farreqs);
+    FreeVec(probe);
+    FreeVec(pending);
+    FreeVec(due);
+    FreeVec(reqs);
+    CloseDevice((struct IORequest *)master);
+    DeleteIORequest((struct IORequest *)master);
+    DeleteMsgPort(port);
+
+    return result;
+}
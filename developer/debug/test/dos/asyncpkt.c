@@ -0,0 +1,166 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Writes a file with several packets in flight, then reads it back the
+ * same way and checks the contents. Handlers serve their packets in the
+ * order they arrive, so consecutive packets on one handle cover
+ * consecutive parts of the file.
+ */
+
+#include <exec/types.h>
+#include <dos/dosextens.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <stdio.h>
+
+#define BUFSIZE  1024
+#define NUMBUFS  4
+#define CHUNKS   256
+
+static UBYTE buf[NUMBUFS][BUFSIZE];
+
+static void fill(UBYTE *b, int n)
+{
+    int i;
+
+    for (i = 0; i < BUFSIZE; i++)
+        b[i] = (i + n) & 0xff;
+}
+
+static int check(UBYTE *b, int n)
+{
+    int i;
+
+    for (i = 0; i < BUFSIZE; i++)
+        if (b[i] != ((i + n) & 0xff))
+            return 0;
+    return 1;
+}
+
+/* Index of the buffer a packet was sent with */
+static int bufof(struct DosPacket *dp)
+{
+    return ((UBYTE *)dp->dp_Arg2 - buf[0]) / BUFSIZE;
+}
+
+static int transfer(struct AsyncPktPool *pool, BPTR file, LONG action)
+{
+    struct FileHandle *fh = BADDR(file);
+    struct DosPacket *dp;
+    int chunk[NUMBUFS];
+    int sent = 0, done = 0, b, errors = 0;
+
+    for (b = 0; b < NUMBUFS && sent < CHUNKS; b++, sent++)
+    {
+        chunk[b] = sent;
+        if (action == ACTION_WRITE)
+            fill(buf[b], sent);
+        SendAsyncPkt(pool, fh->fh_Type, action, fh->fh_Arg1, (SIPTR)buf[b], BUFSIZE, 0, 0);
+    }
+
+    while ((dp = WaitAsyncPkt(pool)) != NULL)
+    {
+        b = bufof(dp);
+        if (dp->dp_Res1 != BUFSIZE)
+        {
+            printf("chunk %d: got %ld, error %ld\n", chunk[b], (long)dp->dp_Res1, (long)dp->dp_Res2);
+            errors++;
+        }
+        else if (action == ACTION_READ && !check(buf[b], chunk[b]))
+        {
+            printf("chunk %d: wrong data\n", chunk[b]);
+            errors++;
+        }
+        ReleaseAsyncPkt(pool, dp);
+        done++;
+
+        if (sent < CHUNKS)
+        {
+            chunk[b] = sent;
+            if (action == ACTION_WRITE)
+                fill(buf[b], sent);
+            if (SendAsyncPkt(pool, fh->fh_Type, action, fh->fh_Arg1, (SIPTR)buf[b], BUFSIZE, 0, 0) == NULL)
+            {
+                printf("no free packet after a release\n");
+                errors++;
+            }
+            sent++;
+        }
+    }
+
+    if (done != CHUNKS)
+    {
+        printf("%d of %d packets came back\n", done, CHUNKS);
+        errors++;
+    }
+
+    return errors;
+}
+
+int main(int argc, char **argv)
+{
+    struct AsyncPktPool *pool;
+    struct DosPacket *dp;
+    char *filename = (argc > 1) ? argv[1] : "T:asyncpkt.test";
+    BPTR fh;
+    int b, errors = 0;
+
+    if ((pool = CreateAsyncPktPool(NUMBUFS)) == NULL)
+    {
+        printf("couldn't create pool (%ld)\n", (long)IoErr());
+        return RETURN_FAIL;
+    }
+
+    /* The pool is empty once all packets are in flight */
+    for (b = 0; b < NUMBUFS; b++)
+        SendAsyncPkt(pool, NULL, ACTION_INFO, 0, 0, 0, 0, 0);
+    if (SendAsyncPkt(pool, NULL, ACTION_INFO, 0, 0, 0, 0, 0) != NULL)
+    {
+        printf("pool of %d sent more packets\n", NUMBUFS);
+        errors++;
+    }
+
+    /* Aborted packets are never returned */
+    if ((dp = CheckAsyncPkt(pool)) != NULL)
+        ReleaseAsyncPkt(pool, dp);
+    else
+        errors++;
+    while ((dp = CheckAsyncPkt(pool)) != NULL)
+        AbortAsyncPkt(pool, dp);
+    dp = SendAsyncPkt(pool, NULL, ACTION_INFO, 0, 0, 0, 0, 0);
+    AbortAsyncPkt(pool, dp);
+    if (WaitAsyncPkt(pool) != NULL || pool->app_Pending != 0)
+    {
+        printf("aborted packet came back\n");
+        errors++;
+    }
+
+    printf("writing '%s'\n", filename);
+    if ((fh = Open(filename, MODE_NEWFILE)) == BNULL)
+    {
+        printf("couldn't open '%s' for write (%ld)\n", filename, (long)IoErr());
+        DeleteAsyncPktPool(pool);
+        return RETURN_FAIL;
+    }
+    errors += transfer(pool, fh, ACTION_WRITE);
+    Close(fh);
+
+    printf("reading '%s'\n", filename);
+    if ((fh = Open(filename, MODE_OLDFILE)) == BNULL)
+    {
+        printf("couldn't open '%s' for read (%ld)\n", filename, (long)IoErr());
+        DeleteAsyncPktPool(pool);
+        return RETURN_FAIL;
+    }
+    errors += transfer(pool, fh, ACTION_READ);
+    Close(fh);
+
+    DeleteFile(filename);
+    DeleteAsyncPktPool(pool);
+
+    printf("%s\n", errors ? "FAILED" : "OK");
+
+    return errors ? RETURN_ERROR : RETURN_OK;
+}
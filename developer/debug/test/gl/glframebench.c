@@ -0,0 +1,244 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures how long it takes the GL driver to render and show frames.
+ * A scene of overlapping, blended and depth tested quads is drawn for a
+ * given number of frames, and the time spent rendering (up to glFinish())
+ * is reported apart from the time spent in glASwapBuffers(), which copies
+ * the frame out to the bitmap. The fastest and slowest swaps are shown
+ * as well. By default the window is opened on a screen that stays behind
+ * the others, so nothing has to be looked at and the display doesn't
+ * matter; PUBSCREEN renders on the default public screen instead.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#include <exec/types.h>
+#include <intuition/intuition.h>
+#include <intuition/screens.h>
+#include <cybergraphx/cybergraphics.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/intuition.h>
+#include <proto/cybergraphics.h>
+
+#include <GL/gla.h>
+
+#include "../benchmarks/benchtime.h"
+
+#define TEMPLATE    "WIDTH/N,HEIGHT/N,FRAMES/N,QUADS/N,PUBSCREEN/S"
+
+enum
+{
+    ARG_WIDTH,
+    ARG_HEIGHT,
+    ARG_FRAMES,
+    ARG_QUADS,
+    ARG_PUBSCREEN,
+    NUM_ARGS
+};
+
+struct Library *CyberGfxBase;
+
+static void render(ULONG frame, ULONG quads)
+{
+    ULONG i;
+
+    glClearColor(0.3, 0.3, 0.3, 1.0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_BLEND);
+
+    glLoadIdentity();
+    glRotatef((GLfloat)frame, 0.0, 0.0, 1.0);
+
+    /* Screen filling quads, each a little further away and turned a little more */
+    glBegin(GL_QUADS);
+    for (i = 0; i < quads; i++)
+    {
+        GLfloat z = -(GLfloat)i / quads;
+        GLfloat s = 1.0 - 0.5 * (GLfloat)i / quads;
+
+        glColor4f(1.0, 0.0, (GLfloat)(i & 1), 0.5);
+        glVertex3f(-s, -s, z);
+        glColor4f(0.0, 1.0, 0.0, 0.5);
+        glVertex3f(s, -s, z);
+        glColor4f(0.0, 0.0, 1.0, 0.5);
+        glVertex3f(s, s, z);
+        glColor4f(1.0, 1.0, (GLfloat)(i & 2), 0.5);
+        glVertex3f(-s, s, z);
+    }
+    glEnd();
+
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+}
+
+int main(void)
+{
+    IPTR args[NUM_ARGS] = { 0 };
+    struct RDArgs *rda;
+    struct Screen *screen = NULL;
+    struct Window *win = NULL;
+    struct timeval tv_start, tv_frame;
+    GLAContext glcont = NULL;
+    ULONG width, height, frames, quads, i, modeid;
+    double t, render_t = 0, swap_t = 0, frame_t, min_t = 1e9, max_t = 0;
+    double swap, minswap_t = 1e9, maxswap_t = 0;
+    int result = RETURN_OK;
+
+    if ((rda = ReadArgs(TEMPLATE, args, NULL)) == NULL)
+    {
+        PrintFault(IoErr(), "GLFrameBench");
+        return RETURN_FAIL;
+    }
+
+    width = args[ARG_WIDTH] ? *(ULONG *)args[ARG_WIDTH] : 640;
+    height = args[ARG_HEIGHT] ? *(ULONG *)args[ARG_HEIGHT] : 480;
+    frames = args[ARG_FRAMES] ? *(ULONG *)args[ARG_FRAMES] : 200;
+    quads = args[ARG_QUADS] ? *(ULONG *)args[ARG_QUADS] : 8;
+    if (frames < 1)
+        frames = 1;
+
+    if (args[ARG_PUBSCREEN])
+    {
+        if ((screen = LockPubScreen(NULL)) != NULL)
+        {
+            win = OpenWindowTags(NULL,
+                                 WA_Title,          (IPTR)"GLFrameBench",
+                                 WA_PubScreen,      (IPTR)screen,
+                                 WA_InnerWidth,     width,
+                                 WA_InnerHeight,    height,
+                                 WA_DragBar,        TRUE,
+                                 WA_SimpleRefresh,  TRUE,
+                                 WA_NoCareRefresh,  TRUE,
+                                 TAG_DONE);
+            UnlockPubScreen(NULL, screen);
+            screen = NULL;
+        }
+    }
+    else if ((CyberGfxBase = OpenLibrary("cybergraphics.library", 0)) != NULL)
+    {
+        modeid = BestCModeIDTags(CYBRBIDTG_NominalWidth,  width,
+                                 CYBRBIDTG_NominalHeight, height,
+                                 CYBRBIDTG_Depth,         24,
+                                 TAG_DONE);
+        if (modeid != INVALID_ID)
+        {
+            screen = OpenScreenTags(NULL,
+                                    SA_DisplayID,   modeid,
+                                    SA_Width,       width,
+                                    SA_Height,      height,
+                                    SA_Depth,       24,
+                                    SA_Behind,      TRUE,
+                                    SA_Quiet,       TRUE,
+                                    SA_ShowTitle,   FALSE,
+                                    TAG_DONE);
+        }
+        if (screen)
+        {
+            win = OpenWindowTags(NULL,
+                                 WA_CustomScreen,   (IPTR)screen,
+                                 WA_Width,          width,
+                                 WA_Height,         height,
+                                 WA_Flags,          WFLG_BACKDROP | WFLG_BORDERLESS | WFLG_RMBTRAP,
+                                 TAG_DONE);
+        }
+    }
+
+    if (win)
+    {
+        glcont = glACreateContextTags(GLA_Window,      (IPTR)win,
+                                      GLA_Left,        win->BorderLeft,
+                                      GLA_Top,         win->BorderTop,
+                                      GLA_Right,       win->BorderRight,
+                                      GLA_Bottom,      win->BorderBottom,
+                                      GLA_DoubleBuf,   GL_TRUE,
+                                      GLA_RGBMode,     GL_TRUE,
+                                      GLA_NoStencil,   GL_TRUE,
+                                      GLA_NoAccum,     GL_TRUE,
+                                      TAG_DONE);
+    }
+
+    if (glcont == NULL)
+    {
+        printf("Couldn't open a %lux%lu GL context\n", (unsigned long)width, (unsigned long)height);
+        result = RETURN_FAIL;
+    }
+    else
+    {
+        glAMakeCurrent(glcont);
+        glViewport(0, 0, width, height);
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(-1.0, 1.0, -1.0, 1.0, -2.0, 2.0);
+        glMatrixMode(GL_MODELVIEW);
+
+        printf("GLFrameBench: %lu frames of %lux%lu pixels, %lu quads each, %s\n\n",
+               (unsigned long)frames, (unsigned long)width, (unsigned long)height,
+               (unsigned long)quads, screen ? "hidden screen" : "public screen");
+
+        /* Leave the setup of the first frame out of the timing */
+        render(0, quads);
+        glFinish();
+        glASwapBuffers(glcont);
+
+        gettimeofday(&tv_start, NULL);
+        for (i = 0; i < frames; i++)
+        {
+            gettimeofday(&tv_frame, NULL);
+            render(i, quads);
+            glFinish();
+            t = elapsed(&tv_frame);
+            render_t += t;
+
+            glASwapBuffers(glcont);
+            frame_t = elapsed(&tv_frame);
+            swap = frame_t - t;
+            swap_t += swap;
+
+            if (swap < minswap_t)
+                minswap_t = swap;
+            if (swap > maxswap_t)
+                maxswap_t = swap;
+
+            if (frame_t < min_t)
+                min_t = frame_t;
+            if (frame_t > max_t)
+                max_t = frame_t;
+
+            if (CheckSignal(SIGBREAKF_CTRL_C))
+            {
+                printf("***Break\n");
+                i++;
+                break;
+            }
+        }
+        t = elapsed(&tv_start);
+
+        printf("  %-24s %10.2f\n", "Frames per second", (t > 0) ? i / t : 0.0);
+        printf("  %-24s %10.3f ms\n", "Average frame", t * 1000.0 / i);
+        printf("  %-24s %10.3f ms\n", "Fastest frame", min_t * 1000.0);
+        printf("  %-24s %10.3f ms\n", "Slowest frame", max_t * 1000.0);
+        printf("  %-24s %10.3f ms\n", "Rendering", render_t * 1000.0 / i);
+        printf("  %-24s %10.3f ms\n", "glASwapBuffers", swap_t * 1000.0 / i);
+        printf("  %-24s %10.3f ms\n", "Fastest swap", minswap_t * 1000.0);
+        printf("  %-24s %10.3f ms\n", "Slowest swap", maxswap_t * 1000.0);
+
+        glADestroyContext(glcont);
+    }
+
+    if (win)
+        CloseWindow(win);
+    if (screen)
+        CloseScreen(screen);
+    if (CyberGfxBase)
+        CloseLibrary(CyberGfxBase);
+    FreeArgs(rda);
+
+    return result;
+}
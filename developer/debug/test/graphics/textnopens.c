@@ -0,0 +1,146 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Checks the colours of Text() on a rastport with pens disabled
+*/
+
+/*
+ * Draws text into a truecolor bitmap with RPTAG_PenMode off, and the
+ * colours given with RPTAG_FgColor and RPTAG_BgColor, the way the
+ * window and screen decorations do. All pixels of the text must then
+ * have one of these colours: JAM2 draws both, JAM1 draws the foreground
+ * onto whatever is there. Returns RETURN_FAIL if any pixel is wrong.
+ */
+
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <graphics/gfx.h>
+#include <graphics/rastport.h>
+#include <graphics/rpattr.h>
+#include <cybergraphx/cybergraphics.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+#include <proto/cybergraphics.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define WIDTH       320
+#define HEIGHT      32
+
+#define COL_FG      0xFF00C000
+#define COL_BG      0xFF0000C0
+#define COL_FILL    0xFFC00000
+
+static const char text[] = "AROS Text() with pens disabled";
+
+struct Library *CyberGfxBase;
+
+/* Counts the pixels of the text box that are col1 or col2, returns FALSE if any other is found */
+static BOOL check(struct RastPort *rp, ULONG *buf, struct TextExtent *te, ULONG col1, ULONG col2,
+                  ULONG *count1, ULONG *count2)
+{
+    WORD w = te->te_Extent.MaxX - te->te_Extent.MinX + 1;
+    WORD h = te->te_Extent.MaxY - te->te_Extent.MinY + 1;
+    LONG i;
+
+    ReadPixelArray(buf, 0, 0, w * 4, rp, 10 + te->te_Extent.MinX, 20 + te->te_Extent.MinY,
+                   w, h, RECTFMT_ARGB);
+
+    *count1 = *count2 = 0;
+    for (i = 0; i < w * h; i++)
+    {
+        /* ReadPixelArray() gives big endian ARGB */
+        UBYTE *p = (UBYTE *)&buf[i];
+        ULONG col = (0xFFUL << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+
+        if (col == col1)
+            (*count1)++;
+        else if (col == col2)
+            (*count2)++;
+        else
+        {
+            printf("  pixel %ld,%ld is 0x%08lx\n", (long)(i % w), (long)(i / w), (unsigned long)col);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+int main(void)
+{
+    struct BitMap *bm;
+    struct RastPort rp;
+    struct TextExtent te;
+    ULONG *buf;
+    ULONG fg, other;
+    int result = RETURN_OK;
+
+    if (!(CyberGfxBase = OpenLibrary("cybergraphics.library", 0)))
+    {
+        printf("Can't open cybergraphics.library\n");
+        return RETURN_FAIL;
+    }
+
+    bm = AllocBitMap(WIDTH, HEIGHT, 32, BMF_CLEAR | BMF_SPECIALFMT | SHIFT_PIXFMT(PIXFMT_ARGB32), NULL);
+    buf = AllocVec(WIDTH * HEIGHT * 4, MEMF_ANY);
+    if (!bm || !buf)
+    {
+        printf("Can't allocate a truecolor bitmap\n");
+        FreeVec(buf);
+        FreeBitMap(bm);
+        CloseLibrary(CyberGfxBase);
+        return RETURN_FAIL;
+    }
+
+    InitRastPort(&rp);
+    rp.BitMap = bm;
+    SetFont(&rp, GfxBase->DefaultFont);
+    TextExtent(&rp, text, strlen(text), &te);
+
+    /* JAM2: every pixel is the foreground or the background colour */
+    SetRPAttrs(&rp, RPTAG_PenMode, FALSE,
+                    RPTAG_FgColor, COL_FG,
+                    RPTAG_BgColor, COL_BG,
+                    TAG_DONE);
+    SetDrMd(&rp, JAM2);
+    Move(&rp, 10, 20);
+    Text(&rp, text, strlen(text));
+
+    if (!check(&rp, buf, &te, COL_FG, COL_BG, &fg, &other) || !fg || !other)
+    {
+        printf("JAM2: FAILED (%lu foreground, %lu background pixels)\n",
+               (unsigned long)fg, (unsigned long)other);
+        result = RETURN_FAIL;
+    }
+    else
+        printf("JAM2: passed\n");
+
+    /* JAM1: the foreground colour, on what was there */
+    SetRPAttrs(&rp, RPTAG_FgColor, COL_FILL, TAG_DONE);
+    RectFill(&rp, 0, 0, WIDTH - 1, HEIGHT - 1);
+
+    SetRPAttrs(&rp, RPTAG_FgColor, COL_FG, TAG_DONE);
+    SetDrMd(&rp, JAM1);
+    Move(&rp, 10, 20);
+    Text(&rp, text, strlen(text));
+
+    if (!check(&rp, buf, &te, COL_FG, COL_FILL, &fg, &other) || !fg || !other)
+    {
+        printf("JAM1: FAILED (%lu foreground, %lu untouched pixels)\n",
+               (unsigned long)fg, (unsigned long)other);
+        result = RETURN_FAIL;
+    }
+    else
+        printf("JAM1: passed\n");
+
+    WaitBlit();
+    DeinitRastPort(&rp);
+    FreeVec(buf);
+    FreeBitMap(bm);
+    CloseLibrary(CyberGfxBase);
+
+    return result;
+}
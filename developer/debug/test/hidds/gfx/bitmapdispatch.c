@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Method calls per second through the gfx bitmap class.
+*/
+
+#define __OOP_NOATTRBASES__
+
+#include <hidd/gfx.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <sys/time.h>
+#include <stdio.h>
+
+#define CALLS 10000000
+
+static struct timeval tv_start;
+
+static void StartTimer(void)
+{
+    gettimeofday(&tv_start, NULL);
+}
+
+static void StopTimer(const char *what)
+{
+    struct timeval tv_end;
+    double elapsed;
+
+    gettimeofday(&tv_end, NULL);
+    elapsed = ((double)(((tv_end.tv_sec * 1000000) + tv_end.tv_usec)
+            - ((tv_start.tv_sec * 1000000) + tv_start.tv_usec)))/1000000.0;
+
+    printf("%-32s %f seconds, %f calls/s\n", what, elapsed, (double)CALLS / elapsed);
+}
+
+int main(void)
+{
+    struct pHidd_BitMap_PutPixel msg;
+    struct OOP_MethodCache cache = { NULL, NULL, NULL };
+    struct BitMap *bitmap;
+    OOP_MethodFunc putpixel;
+    OOP_Class *putpixel_Class;
+    OOP_Object *bm;
+    LONG i;
+
+    bitmap = AllocBitMap(64, 64, 16, 0, NULL);
+    if (!bitmap)
+    {
+        printf("Failed to allocate a bitmap!\n");
+        return RETURN_FAIL;
+    }
+    bm = HIDD_BM_OBJ(bitmap);
+
+    printf("Bitmap class: %s\n\n", OOP_OCLASS(bm)->ClassNode.ln_Name);
+
+    msg.mID = OOP_GetMethodID(IID_Hidd_BitMap, moHidd_BitMap_PutPixel);
+    msg.pixel = 0;
+
+    /* What the stubs use: the flat method table, if the class has one */
+    StartTimer();
+    for (i = 0; i < CALLS; i++)
+    {
+        msg.x = i & 63;
+        msg.y = (i >> 6) & 63;
+        OOP_DoMethod(bm, (OOP_Msg)&msg);
+    }
+    StopTimer("OOP_DoMethod():");
+
+    /* The class dispatcher, which OOP_DoMethod() used to call */
+    StartTimer();
+    for (i = 0; i < CALLS; i++)
+    {
+        msg.x = i & 63;
+        msg.y = (i >> 6) & 63;
+        OOP_OCLASS(bm)->cl_DoMethod(bm, (OOP_Msg)&msg);
+    }
+    StopTimer("cl_DoMethod():");
+
+    /* Looking the method up for every call */
+    StartTimer();
+    for (i = 0; i < CALLS; i++)
+    {
+        msg.x = i & 63;
+        msg.y = (i >> 6) & 63;
+        putpixel = OOP_GetMethod(bm, msg.mID, &putpixel_Class);
+        putpixel(putpixel_Class, bm, (OOP_Msg)&msg);
+    }
+    StopTimer("OOP_GetMethod() per call:");
+
+    StartTimer();
+    for (i = 0; i < CALLS; i++)
+    {
+        msg.x = i & 63;
+        msg.y = (i >> 6) & 63;
+        putpixel = OOP_GetCachedMethod(bm, msg.mID, &cache);
+        putpixel(cache.mc_ImplClass, bm, (OOP_Msg)&msg);
+    }
+    StopTimer("OOP_GetCachedMethod() per call:");
+
+    /* The best case, a method pointer fetched once */
+    putpixel = OOP_GetMethod(bm, msg.mID, &putpixel_Class);
+    StartTimer();
+    for (i = 0; i < CALLS; i++)
+    {
+        msg.x = i & 63;
+        msg.y = (i >> 6) & 63;
+        putpixel(putpixel_Class, bm, (OOP_Msg)&msg);
+    }
+    StopTimer("Direct call:");
+
+    FreeBitMap(bitmap);
+
+    return 0;
+}
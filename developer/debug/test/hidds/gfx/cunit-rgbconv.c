@@ -0,0 +1,222 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Checks that the conversion routines installed in the graphics HIDD,
+ * which may be vectorised ones, give exactly the same result as the
+ * scalar routines, for every pair of RGB pixel formats.
+ */
+
+#define __OOP_NOATTRBASES__
+
+#include <hidd/gfx.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <CUnit/Basic.h>
+#include <CUnit/Automated.h>
+
+/* The scalar routines, straight from the graphics HIDD sources */
+#include "rgbconv.c"
+
+#undef ConvertPixels
+
+#define MAXWIDTH    67
+#define HEIGHT      3
+/* Row padding, keeps the rows of all formats 4 byte aligned */
+#define PAD         8
+#define MAXMOD      (MAXWIDTH * 4 + PAD)
+#define CANARY      0xA5
+
+static OOP_AttrBase HiddBitMapAttrBase;
+static struct BitMap *bitmap;
+static OOP_Object *gfxhidd;
+
+static HIDDT_RGBConversionFunction scalarfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
+
+static UBYTE srcbuf[MAXMOD * HEIGHT];
+static UBYTE dstbuf[MAXMOD * HEIGHT + 16];
+static UBYTE refbuf[MAXMOD * HEIGHT + 16];
+
+/* Odd widths too, to test the scalar edge of the vector routines */
+static const UWORD widths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 24, 31, 32, 33, 48, 63, 64, 67 };
+
+static ULONG seed = 1;
+
+static UBYTE random8(void)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return seed >> 16;
+}
+
+static ULONG bytesperpixel(HIDDT_StdPixFmt fmt)
+{
+    switch (fmt)
+    {
+    case vHidd_StdPixFmt_RGB24:
+    case vHidd_StdPixFmt_BGR24:
+        return 3;
+
+    case vHidd_StdPixFmt_RGB16:
+    case vHidd_StdPixFmt_RGB16_LE:
+    case vHidd_StdPixFmt_BGR16:
+    case vHidd_StdPixFmt_BGR16_LE:
+    case vHidd_StdPixFmt_RGB15:
+    case vHidd_StdPixFmt_RGB15_LE:
+    case vHidd_StdPixFmt_BGR15:
+    case vHidd_StdPixFmt_BGR15_LE:
+        return 2;
+
+    default:
+        return 4;
+    }
+}
+
+/* The suite initialization function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int init_suite(void)
+{
+    HiddBitMapAttrBase = OOP_ObtainAttrBase(IID_Hidd_BitMap);
+    if (!HiddBitMapAttrBase) {
+        return -1;
+    }
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    if (!bitmap) {
+        OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+        return -1;
+    }
+
+    OOP_GetAttr(HIDD_BM_OBJ(bitmap), aHidd_BitMap_GfxHidd, (IPTR *)&gfxhidd);
+    if (!gfxhidd) {
+        FreeBitMap(bitmap);
+        OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+        return -1;
+    }
+
+    SetRGBConversionFunctions(scalarfuncs);
+
+    return 0;
+}
+
+/* The suite cleanup function.
+  * Returns zero on success, non-zero otherwise.
+ */
+int clean_suite(void)
+{
+    FreeBitMap(bitmap);
+    OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+    return 0;
+}
+
+static BOOL ConvertPixels(APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt,
+                   APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt,
+                   ULONG width, ULONG height)
+{
+    OOP_Object *srcpf, *dstpf;
+    APTR src = srcPixels;
+    APTR dst = dstPixels;
+
+    srcpf = HIDD_Gfx_GetPixFmt(gfxhidd, srcPixFmt);
+    dstpf = HIDD_Gfx_GetPixFmt(gfxhidd, dstPixFmt);
+
+    if (!srcpf || !dstpf)
+        return FALSE;
+
+    HIDD_BM_ConvertPixels(HIDD_BM_OBJ(bitmap), &src, (HIDDT_PixelFormat *)srcpf, srcMod,
+                          &dst, (HIDDT_PixelFormat *)dstpf, dstMod,
+                          width, height, NULL);
+    return TRUE;
+}
+
+/* Convert random pixels of every width, and compare with the scalar result.
+ * The canary bytes around the rows must stay untouched.
+ */
+static BOOL TestPair(HIDDT_StdPixFmt srcfmt, HIDDT_StdPixFmt dstfmt)
+{
+    HIDDT_RGBConversionFunction f = scalarfuncs[srcfmt - FIRST_RGB_STDPIXFMT][dstfmt - FIRST_RGB_STDPIXFMT];
+    ULONG i, w;
+
+    if (!f)
+        return TRUE;
+
+    for (w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+    {
+        ULONG width = widths[w];
+        ULONG srcmod = width * bytesperpixel(srcfmt) + PAD;
+        ULONG dstmod = width * bytesperpixel(dstfmt) + PAD;
+
+        for (i = 0; i < sizeof(srcbuf); i++)
+            srcbuf[i] = random8();
+        memset(dstbuf, CANARY, sizeof(dstbuf));
+        memset(refbuf, CANARY, sizeof(refbuf));
+
+        f(srcbuf, srcmod, srcfmt, refbuf, dstmod, dstfmt, width, HEIGHT);
+        if (!ConvertPixels(srcbuf, srcmod, srcfmt, dstbuf, dstmod, dstfmt, width, HEIGHT))
+            return FALSE;
+
+        if (memcmp(dstbuf, refbuf, sizeof(dstbuf)))
+        {
+            printf("Mismatch converting pixfmt %ld to %ld, width %ld\n",
+                   (long)srcfmt, (long)dstfmt, (long)width);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+void testRGBCONV(void)
+{
+    HIDDT_StdPixFmt srcfmt, dstfmt;
+
+    for (srcfmt = FIRST_RGB_STDPIXFMT; srcfmt <= LAST_RGB_STDPIXFMT; srcfmt++)
+    {
+        for (dstfmt = FIRST_RGB_STDPIXFMT; dstfmt <= LAST_RGB_STDPIXFMT; dstfmt++)
+        {
+            if (srcfmt != dstfmt)
+                CU_ASSERT(TestPair(srcfmt, dstfmt));
+        }
+    }
+}
+
+int main(void)
+{
+    CU_pSuite pSuite = NULL;
+
+    /* initialize the CUnit test registry */
+    if (CUE_SUCCESS != CU_initialize_registry())
+        return CU_get_error();
+
+    /* add a suite to the registry */
+    pSuite = CU_add_suite("RGBConv_Suite", init_suite, clean_suite);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* add the tests to the suite */
+    if (NULL == CU_add_test(pSuite, "test of RGB conversions against the scalar routines", testRGBCONV))
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic & Automated interfaces */
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    CU_basic_run_tests();
+    CU_basic_set_mode(CU_BRM_SILENT);
+    CU_automated_package_name_set("GfxHiddUnitTests");
+    CU_set_output_filename("GfxHidd-RGBConv");
+    CU_automated_enable_junit_xml(CU_TRUE);
+    CU_automated_run_tests();
+    CU_cleanup_registry();
+
+    return CU_get_error();
+}
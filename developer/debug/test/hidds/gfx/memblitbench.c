@@ -0,0 +1,261 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures the speed of the bitmap class' memory blit methods for rects
+ * from 8x8 up to a full screen, next to the portable routines that the
+ * graphics HIDD may have replaced.
+ */
+
+#define __OOP_NOATTRBASES__
+
+#include <hidd/gfx.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <devices/timer.h>
+
+#include <stdio.h>
+
+/* The portable routines, straight from the graphics HIDD sources */
+#include "memblit.c"
+
+static OOP_AttrBase HiddGCAttrBase;
+
+#define GFXBUFWIDTH  640
+#define GFXBUFHEIGHT 480
+#define GFXBUFSIZE   (GFXBUFWIDTH * GFXBUFHEIGHT * 4)
+
+/* One spare word per row, for templates that do not start on a word */
+#define TEMPLATEMOD  (GFXBUFWIDTH / 8 + 2)
+#define TEMPLATESIZE (TEMPLATEMOD * GFXBUFHEIGHT)
+
+/* How long each operation is run for, in seconds */
+#define BENCHTIME    1
+
+enum
+{
+    OP_FILL16,
+    OP_FILL24,
+    OP_FILL32,
+    OP_COPY32,
+    OP_SCROLL32,
+    OP_TEMPLATE32,
+    OP_PATTERN32,
+    NUM_OPS
+};
+
+static const CONST_STRPTR opnames[NUM_OPS] =
+{
+    "FillMemRect16",
+    "FillMemRect24",
+    "FillMemRect32",
+    "CopyMemBox32",
+    "CopyMemBox32 scroll",
+    "PutMemTemplate32",
+    "PutMemPattern32"
+};
+
+static const struct
+{
+    UWORD width, height;
+} sizes[] =
+{
+    {   8,   8 },
+    {  32,  32 },
+    { 128, 128 },
+    { GFXBUFWIDTH, GFXBUFHEIGHT }
+};
+
+static UWORD pattern[8] =
+{
+    0xAAAA, 0x5555, 0xAAAA, 0x5555, 0xF0F0, 0x0F0F, 0xFF00, 0x00FF
+};
+
+static struct MemBlitFuncs genericfuncs;
+
+static VOID RunOp(ULONG op, BOOL generic, OOP_Object *bm, OOP_Object *gc,
+                  UBYTE *src, UBYTE *dst, UBYTE *template, UWORD width, UWORD height)
+{
+    ULONG mod = GFXBUFWIDTH * 4;
+
+    switch (op)
+    {
+    case OP_FILL16:
+        if (generic)
+            genericfuncs.mbf_Fill16(dst, mod, width, height, 0x1234);
+        else
+            HIDD_BM_FillMemRect16(bm, dst, 0, 0, width - 1, height - 1, mod, 0x1234);
+        break;
+
+    case OP_FILL24:
+        if (generic)
+            genericfuncs.mbf_Fill24(dst, mod, width, height, 0x123456);
+        else
+            HIDD_BM_FillMemRect24(bm, dst, 0, 0, width - 1, height - 1, mod, 0x123456);
+        break;
+
+    case OP_FILL32:
+        if (generic)
+            genericfuncs.mbf_Fill32(dst, mod, width, height, 0x12345678);
+        else
+            HIDD_BM_FillMemRect32(bm, dst, 0, 0, width - 1, height - 1, mod, 0x12345678);
+        break;
+
+    case OP_COPY32:
+        if (generic)
+            genericfuncs.mbf_Copy(src, mod, dst, mod, width * 4, height);
+        else
+            HIDD_BM_CopyMemBox32(bm, src, 0, 0, dst, 0, 0, width, height, mod, mod);
+        break;
+
+    case OP_SCROLL32:
+        /* Scroll down and right by a few pixels inside the same buffer */
+        if (height > GFXBUFHEIGHT - 8)
+            height = GFXBUFHEIGHT - 8;
+        if (width > GFXBUFWIDTH - 3)
+            width = GFXBUFWIDTH - 3;
+        if (generic)
+            genericfuncs.mbf_Copy(dst, mod, dst + 8 * mod + 3 * 4, mod, width * 4, height);
+        else
+            HIDD_BM_CopyMemBox32(bm, dst, 0, 0, dst, 3, 8, width, height, mod, mod);
+        break;
+
+    case OP_TEMPLATE32:
+        HIDD_BM_PutMemTemplate32(bm, gc, template, TEMPLATEMOD, 5, dst, mod,
+                                 0, 0, width, height, FALSE);
+        break;
+
+    case OP_PATTERN32:
+        HIDD_BM_PutMemPattern32(bm, gc, (UBYTE *)pattern, 3, 0, 8, 1, NULL, FALSE,
+                                NULL, 0, 0, dst, mod, 0, 0, width, height);
+        break;
+    }
+}
+
+/* Returns the number of pixels drawn per second */
+static double Bench(ULONG op, BOOL generic, OOP_Object *bm, OOP_Object *gc,
+                    UBYTE *src, UBYTE *dst, UBYTE *template, UWORD width, UWORD height)
+{
+    struct timeval tv_start, tv_end;
+    LONG t, i;
+
+    CurrentTime(&tv_start.tv_secs, &tv_start.tv_micro);
+    for(i = 0; ; i++)
+    {
+        /* Small rects are too quick to look at the clock for each one */
+        LONG n;
+
+        CurrentTime(&tv_end.tv_secs, &tv_end.tv_micro);
+        t = (tv_end.tv_sec - tv_start.tv_sec) * 1000000 + tv_end.tv_micro - tv_start.tv_micro;
+        if (t >= BENCHTIME * 1000000) break;
+
+        for (n = 0; n < 16; n++)
+            RunOp(op, generic, bm, gc, src, dst, template, width, height);
+    }
+
+    return (double)i * 16 * width * height * 1000000.0 / t;
+}
+
+int main(void)
+{
+    struct TagItem gctags[] =
+    {
+        { aHidd_GC_Foreground,         0x00FF8040                },
+        { aHidd_GC_Background,         0x00102030                },
+        { aHidd_GC_DrawMode,           vHidd_GC_DrawMode_Copy    },
+        { aHidd_GC_ColorExpansionMode, vHidd_GC_ColExp_Opaque    },
+        { TAG_DONE,                    0                         }
+    };
+    struct BitMap *bitmap;
+    OOP_Object *gc;
+    UBYTE *src, *dst, *template;
+    ULONG i, op;
+
+    printf("MemBlitBench: Timing the bitmap memory blit methods.\n");
+
+    src = AllocMem(GFXBUFSIZE, MEMF_ANY);
+    dst = AllocMem(GFXBUFSIZE, MEMF_ANY);
+    template = AllocMem(TEMPLATESIZE, MEMF_ANY);
+    if (!src || !dst || !template) {
+        if (src)
+            FreeMem(src, GFXBUFSIZE);
+        if (dst)
+            FreeMem(dst, GFXBUFSIZE);
+        if (template)
+            FreeMem(template, TEMPLATESIZE);
+        printf("Failed to allocate buffers\n");
+        return RETURN_FAIL;
+    }
+
+    for (i = 0; i < GFXBUFSIZE; i++)
+        src[i] = i * 7;
+    for (i = 0; i < TEMPLATESIZE; i++)
+        template[i] = i * 13;
+
+    HiddGCAttrBase = OOP_ObtainAttrBase(IID_Hidd_GC);
+    if (!HiddGCAttrBase) {
+        FreeMem(template, TEMPLATESIZE);
+        FreeMem(dst, GFXBUFSIZE);
+        FreeMem(src, GFXBUFSIZE);
+        printf("Failed to obtain IID_Hidd_GC\n");
+        return RETURN_FAIL;
+    }
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    gc = OOP_NewObject(NULL, CLID_Hidd_GC, gctags);
+    if (!bitmap || !gc) {
+        if (gc)
+            OOP_DisposeObject(gc);
+        if (bitmap)
+            FreeBitMap(bitmap);
+        FreeMem(template, TEMPLATESIZE);
+        FreeMem(dst, GFXBUFSIZE);
+        FreeMem(src, GFXBUFSIZE);
+        printf("Failed to allocate a placeholder bitmap and GC!\n");
+        OOP_ReleaseAttrBase(IID_Hidd_GC);
+        return RETURN_FAIL;
+    }
+
+    SetMemBlitFunctions(&genericfuncs);
+
+    printf("\n %-20s %9s %15s %14s %8s\n", "Operation", "Size", "generic Mpix/s", "HIDD Mpix/s", "speedup");
+
+    for (op = 0; op < NUM_OPS; op++)
+    {
+        for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+        {
+            /* Templates and patterns have no stand alone portable routine */
+            BOOL hasgeneric = (op < OP_TEMPLATE32);
+            double generic = 0, hidd;
+            char size[16];
+
+            if (hasgeneric)
+                generic = Bench(op, TRUE, HIDD_BM_OBJ(bitmap), gc, src, dst, template,
+                                sizes[i].width, sizes[i].height);
+            hidd = Bench(op, FALSE, HIDD_BM_OBJ(bitmap), gc, src, dst, template,
+                         sizes[i].width, sizes[i].height);
+
+            snprintf(size, sizeof(size), "%ux%u", sizes[i].width, sizes[i].height);
+            if (hasgeneric)
+                printf(" %-20s %9s %15.1f %14.1f %7.2fx\n", opnames[op], size,
+                       generic / 1000000.0, hidd / 1000000.0, (generic > 0) ? hidd / generic : 0.0);
+            else
+                printf(" %-20s %9s %15s %14.1f\n", opnames[op], size, "-", hidd / 1000000.0);
+        }
+    }
+
+    printf("\nTesting complete.\n");
+
+    OOP_DisposeObject(gc);
+    FreeBitMap(bitmap);
+    FreeMem(template, TEMPLATESIZE);
+    FreeMem(dst, GFXBUFSIZE);
+    FreeMem(src, GFXBUFSIZE);
+
+    OOP_ReleaseAttrBase(IID_Hidd_GC);
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+/*
+ * Measures the speed of the common RGB conversions installed in the
+ * graphics HIDD, next to the scalar routines they may have replaced.
+ */
+
+#define __OOP_NOATTRBASES__
+
+#include <hidd/gfx.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include <devices/timer.h>
+
+#include <stdio.h>
+
+/* The scalar routines, straight from the graphics HIDD sources */
+#include "rgbconv.c"
+
+#undef ConvertPixels
+
+static OOP_AttrBase HiddBitMapAttrBase;
+
+static HIDDT_RGBConversionFunction scalarfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
+
+#define GFXBUFWIDTH  640
+#define GFXBUFHEIGHT 480
+#define GFXBUFSIZE   (GFXBUFWIDTH * GFXBUFHEIGHT * 4)
+
+/* How long each conversion is run for, in seconds */
+#define BENCHTIME    2
+
+static const struct
+{
+    HIDDT_StdPixFmt src, dst;
+    CONST_STRPTR    name;
+} pairs[] =
+{
+#if AROS_BIG_ENDIAN
+    { vHidd_StdPixFmt_ARGB32, vHidd_StdPixFmt_BGRA32, "ARGB32 -> BGRA32" },
+    { vHidd_StdPixFmt_ARGB32, vHidd_StdPixFmt_RGBA32, "ARGB32 -> RGBA32" },
+    { vHidd_StdPixFmt_RGB24,  vHidd_StdPixFmt_ARGB32, "RGB24  -> ARGB32" },
+    { vHidd_StdPixFmt_ARGB32, vHidd_StdPixFmt_RGB24,  "ARGB32 -> RGB24"  },
+    { vHidd_StdPixFmt_ARGB32, vHidd_StdPixFmt_RGB16,  "ARGB32 -> RGB16"  },
+    { vHidd_StdPixFmt_RGB16,  vHidd_StdPixFmt_ARGB32, "RGB16  -> ARGB32" },
+    { vHidd_StdPixFmt_ARGB32, vHidd_StdPixFmt_RGB15,  "ARGB32 -> RGB15"  },
+    { vHidd_StdPixFmt_RGB15,  vHidd_StdPixFmt_ARGB32, "RGB15  -> ARGB32" },
+#else
+    { vHidd_StdPixFmt_BGRA32,   vHidd_StdPixFmt_ARGB32,   "BGRA32 -> ARGB32"   },
+    { vHidd_StdPixFmt_BGRA32,   vHidd_StdPixFmt_RGBA32,   "BGRA32 -> RGBA32"   },
+    { vHidd_StdPixFmt_BGR24,    vHidd_StdPixFmt_BGRA32,   "BGR24  -> BGRA32"   },
+    { vHidd_StdPixFmt_BGRA32,   vHidd_StdPixFmt_BGR24,    "BGRA32 -> BGR24"    },
+    { vHidd_StdPixFmt_BGRA32,   vHidd_StdPixFmt_RGB16_LE, "BGRA32 -> RGB16_LE" },
+    { vHidd_StdPixFmt_RGB16_LE, vHidd_StdPixFmt_BGRA32,   "RGB16_LE -> BGRA32" },
+    { vHidd_StdPixFmt_BGRA32,   vHidd_StdPixFmt_RGB15_LE, "BGRA32 -> RGB15_LE" },
+    { vHidd_StdPixFmt_RGB15_LE, vHidd_StdPixFmt_BGRA32,   "RGB15_LE -> BGRA32" },
+#endif
+};
+
+static ULONG bytesperpixel(HIDDT_StdPixFmt fmt)
+{
+    switch (fmt)
+    {
+    case vHidd_StdPixFmt_RGB24:
+    case vHidd_StdPixFmt_BGR24:
+        return 3;
+
+    case vHidd_StdPixFmt_RGB16:
+    case vHidd_StdPixFmt_RGB16_LE:
+    case vHidd_StdPixFmt_RGB15:
+    case vHidd_StdPixFmt_RGB15_LE:
+        return 2;
+
+    default:
+        return 4;
+    }
+}
+
+/* Returns the number of pixels converted per second */
+static double Bench(HIDDT_RGBConversionFunction f, OOP_Object *bm,
+                    UBYTE *src, HIDDT_StdPixFmt srcfmt, UBYTE *dst, HIDDT_StdPixFmt dstfmt)
+{
+    OOP_Object *gfxhidd = NULL;
+    OOP_Object *srcpf = NULL, *dstpf = NULL;
+    ULONG srcmod = GFXBUFWIDTH * bytesperpixel(srcfmt);
+    ULONG dstmod = GFXBUFWIDTH * bytesperpixel(dstfmt);
+    struct timeval tv_start, tv_end;
+    LONG t, i;
+
+    if (!f)
+    {
+        OOP_GetAttr(bm, aHidd_BitMap_GfxHidd, (IPTR *)&gfxhidd);
+        if (!gfxhidd)
+            return 0;
+
+        srcpf = HIDD_Gfx_GetPixFmt(gfxhidd, srcfmt);
+        dstpf = HIDD_Gfx_GetPixFmt(gfxhidd, dstfmt);
+        if (!srcpf || !dstpf)
+            return 0;
+    }
+
+    CurrentTime(&tv_start.tv_secs, &tv_start.tv_micro);
+    for(i = 0; ; i++)
+    {
+        CurrentTime(&tv_end.tv_secs, &tv_end.tv_micro);
+        t = (tv_end.tv_sec - tv_start.tv_sec) * 1000000 + tv_end.tv_micro - tv_start.tv_micro;
+        if (t >= BENCHTIME * 1000000) break;
+
+        if (f)
+            f(src, srcmod, srcfmt, dst, dstmod, dstfmt, GFXBUFWIDTH, GFXBUFHEIGHT);
+        else
+        {
+            APTR s = src, d = dst;
+
+            HIDD_BM_ConvertPixels(bm, &s, (HIDDT_PixelFormat *)srcpf, srcmod,
+                                  &d, (HIDDT_PixelFormat *)dstpf, dstmod,
+                                  GFXBUFWIDTH, GFXBUFHEIGHT, NULL);
+        }
+    }
+
+    return (double)i * GFXBUFWIDTH * GFXBUFHEIGHT * 1000000.0 / t;
+}
+
+int main(void)
+{
+    struct BitMap *bitmap;
+    UBYTE *src, *dst;
+    ULONG i;
+
+    printf("RGBConvBench: Timing the RGB pixel format conversion routines.\n");
+
+    src = AllocMem(GFXBUFSIZE, MEMF_ANY);
+    dst = AllocMem(GFXBUFSIZE, MEMF_ANY);
+    if (!src || !dst) {
+        if (src)
+            FreeMem(src, GFXBUFSIZE);
+        if (dst)
+            FreeMem(dst, GFXBUFSIZE);
+        printf("Failed to allocate buffers for conversions\n");
+        return RETURN_FAIL;
+    }
+
+    for (i = 0; i < GFXBUFSIZE; i++)
+        src[i] = i * 7;
+
+    HiddBitMapAttrBase = OOP_ObtainAttrBase(IID_Hidd_BitMap);
+    if (!HiddBitMapAttrBase) {
+        FreeMem(dst, GFXBUFSIZE);
+        FreeMem(src, GFXBUFSIZE);
+        printf("Failed to obtain IID_Hidd_BitMap\n");
+        return RETURN_FAIL;
+    }
+
+    bitmap = AllocBitMap(1, 1, 16, 0, NULL);
+    if (!bitmap) {
+        FreeMem(dst, GFXBUFSIZE);
+        FreeMem(src, GFXBUFSIZE);
+        printf("Failed to allocate a placeholder bitmap!\n");
+        OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+        return RETURN_FAIL;
+    }
+
+    SetRGBConversionFunctions(scalarfuncs);
+
+    printf("\n %-20s %14s %14s %8s\n", "Conversion", "scalar Mpix/s", "HIDD Mpix/s", "speedup");
+
+    for (i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+    {
+        HIDDT_RGBConversionFunction f =
+            scalarfuncs[pairs[i].src - FIRST_RGB_STDPIXFMT][pairs[i].dst - FIRST_RGB_STDPIXFMT];
+        double scalar, hidd;
+
+        if (!f)
+            continue;
+
+        scalar = Bench(f, NULL, src, pairs[i].src, dst, pairs[i].dst);
+        hidd = Bench(NULL, HIDD_BM_OBJ(bitmap), src, pairs[i].src, dst, pairs[i].dst);
+
+        printf(" %-20s %14.1f %14.1f %7.2fx\n", pairs[i].name,
+               scalar / 1000000.0, hidd / 1000000.0, (scalar > 0) ? hidd / scalar : 0.0);
+    }
+
+    printf("\nTesting complete.\n");
+
+    FreeBitMap(bitmap);
+    FreeMem(dst, GFXBUFSIZE);
+    FreeMem(src, GFXBUFSIZE);
+
+    OOP_ReleaseAttrBase(IID_Hidd_BitMap);
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH2(void, AbortAsyncPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+        AROS_LHA(struct DosPacket *   , dp, A1),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 232, Dos)
+
+/*  FUNCTION
+        Cancel a packet sent with SendAsyncPkt(). Its reply will never be
+        returned by CheckAsyncPkt() or WaitAsyncPkt(); the packet goes
+        back to the pool by itself once the handler is done with it.
+
+    INPUTS
+        pool - Pool the packet came from.
+        dp   - The packet to cancel. May be NULL. A packet that was
+               already collected is simply released.
+
+    RESULT
+
+    NOTES
+        Most handlers can't stop an action once it was started, so the
+        action may still be carried out, and buffers passed with the
+        packet must stay valid until the pool is deleted or
+        app_Pending drops to zero.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        SendAsyncPkt(), ReleaseAsyncPkt(), AbortPkt()
+
+    INTERNALS
+        AbortPkt() is called on the packet, so that handlers get the
+        chance should it ever be implemented.
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct AsyncPacket *ap;
+
+    if (dp == NULL)
+        return;
+
+    ap = ASYNCPACKET(dp);
+    D(bug("[DOS] AbortAsyncPkt(0x%p, 0x%p): flags=%lx\n", pool, dp, ap->ap_Flags));
+
+    if (ap->ap_Flags & APF_INFLIGHT)
+    {
+        ap->ap_Flags |= APF_ABORTED;
+        if (ap->ap_Target != NULL)
+            AbortPkt(ap->ap_Target, dp);
+    }
+    else if (ap->ap_Flags & APF_HELD)
+        asyncpkt_recycle((struct IntAsyncPktPool *)pool, ap);
+
+    AROS_LIBFUNC_EXIT
+} /* AbortAsyncPkt */
@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Internal helpers for asynchronous packet pools
+*/
+
+#include <aros/debug.h>
+#include <exec/alerts.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*
+ * Takes a reply that arrived at the pool's port. Returns the packet, or
+ * NULL if it had been aborted and went straight back to the pool.
+ */
+struct DosPacket *asyncpkt_collect(struct IntAsyncPktPool *pool, struct Message *msg)
+{
+    struct DosPacket   *dp = (struct DosPacket *)msg->mn_Node.ln_Name;
+    struct AsyncPacket *ap = ASYNCPACKET(dp);
+
+    /* Something else replied to our port. System is in unstable state. */
+    if (ap->ap_Pool != pool || !(ap->ap_Flags & APF_INFLIGHT))
+        Alert(AN_AsyncPkt);
+
+    pool->pub.app_Pending--;
+
+    D(bug("[DOS] asyncpkt_collect(0x%p): dp=0x%p res1=%ld res2=%ld flags=%lx\n",
+          pool, dp, dp->dp_Res1, dp->dp_Res2, ap->ap_Flags));
+
+    if (ap->ap_Flags & APF_ABORTED)
+    {
+        asyncpkt_recycle(pool, ap);
+        return NULL;
+    }
+
+    ap->ap_Flags = APF_HELD;
+
+    return dp;
+}
+
+void asyncpkt_recycle(struct IntAsyncPktPool *pool, struct AsyncPacket *ap)
+{
+    ap->ap_Flags  = 0;
+    ap->ap_Target = NULL;
+
+    /* Reuse the packet that was touched last first */
+    AddHead((struct List *)&pool->freelist, (struct Node *)&ap->ap_Std.sp_Msg);
+}
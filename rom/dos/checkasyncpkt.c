@@ -0,0 +1,69 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH1(struct DosPacket *, CheckAsyncPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 230, Dos)
+
+/*  FUNCTION
+        Check whether a packet sent with SendAsyncPkt() has completed,
+        without waiting.
+
+    INPUTS
+        pool - Pool created with CreateAsyncPktPool().
+
+    RESULT
+        A completed packet, with dp_Res1 and dp_Res2 filled in by the
+        handler, or NULL if no reply has arrived yet. Pass the packet to
+        ReleaseAsyncPkt() once you are done with it.
+
+    NOTES
+        Replies are returned in the order they arrive, which need not be
+        the order the packets were sent in.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        SendAsyncPkt(), WaitAsyncPkt(), ReleaseAsyncPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct IntAsyncPktPool *ipool = (struct IntAsyncPktPool *)pool;
+    struct Message *msg;
+    struct DosPacket *dp;
+
+    while ((msg = GetMsg(pool->app_Port)) != NULL)
+    {
+        /* Aborted packets go back to the pool, keep looking */
+        if ((dp = asyncpkt_collect(ipool, msg)) != NULL)
+            return dp;
+    }
+
+    return NULL;
+
+    AROS_LIBFUNC_EXIT
+} /* CheckAsyncPkt */
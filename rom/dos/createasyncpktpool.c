@@ -0,0 +1,112 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <exec/memory.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH1(struct AsyncPktPool *, CreateAsyncPktPool,
+
+/*  SYNOPSIS */
+        AROS_LHA(ULONG, packets, D1),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 227, Dos)
+
+/*  FUNCTION
+        Create a pool of packets that can be sent to handlers without
+        waiting for each of them to complete. Up to 'packets' packets
+        may be in flight at the same time, for example several reads and
+        writes to one or more filesystems.
+
+        The packets and the reply port are allocated once here, so
+        sending a packet with SendAsyncPkt() does not allocate any memory.
+
+    INPUTS
+        packets - The number of packets in the pool. Must not be 0.
+
+    RESULT
+        The new pool, or NULL on failure, in which case IoErr() tells
+        why.
+
+    NOTES
+        The reply port belongs to the calling task, so only that task may
+        send packets from the pool and wait for them.
+
+    EXAMPLE
+        pool = CreateAsyncPktPool(4);
+        SendAsyncPkt(pool, fh->fh_Type, ACTION_READ, fh->fh_Arg1, buf, len, 0, 0);
+        ... do something else ...
+        dp = WaitAsyncPkt(pool);
+        actual = dp->dp_Res1;
+        ReleaseAsyncPkt(pool, dp);
+        DeleteAsyncPktPool(pool);
+
+    BUGS
+
+    SEE ALSO
+        DeleteAsyncPktPool(), SendAsyncPkt(), CheckAsyncPkt(),
+        WaitAsyncPkt(), AbortAsyncPkt(), ReleaseAsyncPkt()
+
+    INTERNALS
+        The pool and all its packets are a single allocation. Idle
+        packets are kept on a list linked through their messages.
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct IntAsyncPktPool *pool;
+    struct AsyncPacket *ap;
+    ULONG i;
+
+    if (packets == 0)
+    {
+        SetIoErr(ERROR_BAD_NUMBER);
+        return NULL;
+    }
+
+    pool = AllocVec(sizeof(struct IntAsyncPktPool) + packets * sizeof(struct AsyncPacket),
+                    MEMF_PUBLIC | MEMF_CLEAR);
+    if (pool == NULL)
+    {
+        SetIoErr(ERROR_NO_FREE_STORE);
+        return NULL;
+    }
+
+    pool->pub.app_Port = CreateMsgPort();
+    if (pool->pub.app_Port == NULL)
+    {
+        FreeVec(pool);
+        SetIoErr(ERROR_NO_FREE_STORE);
+        return NULL;
+    }
+
+    NEWLIST((struct List *)&pool->freelist);
+    ap = (struct AsyncPacket *)(pool + 1);
+    for (i = 0; i < packets; i++, ap++)
+    {
+        ap->ap_Std.sp_Pkt.dp_Link = &ap->ap_Std.sp_Msg;
+        ap->ap_Std.sp_Msg.mn_Node.ln_Name = (char *)&ap->ap_Std.sp_Pkt;
+        ap->ap_Pool = pool;
+        AddTail((struct List *)&pool->freelist, (struct Node *)&ap->ap_Std.sp_Msg);
+    }
+    pool->pub.app_Size = packets;
+
+    D(bug("[DOS] CreateAsyncPktPool(%lu) = 0x%p\n", packets, pool));
+
+    return &pool->pub;
+
+    AROS_LIBFUNC_EXIT
+} /* CreateAsyncPktPool */
@@ -0,0 +1,73 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH1(void, DeleteAsyncPktPool,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 228, Dos)
+
+/*  FUNCTION
+        Free a pool created with CreateAsyncPktPool(). Packets that are
+        still in flight are waited for first, since the handlers will
+        reply to them no matter what.
+
+    INPUTS
+        pool - The pool to free. May be NULL.
+
+    RESULT
+
+    NOTES
+        Packets returned by CheckAsyncPkt() or WaitAsyncPkt() are freed
+        with the pool, whether they were released or not.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        CreateAsyncPktPool(), AbortAsyncPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct MsgPort *port;
+
+    if (pool == NULL)
+        return;
+
+    D(bug("[DOS] DeleteAsyncPktPool(0x%p): %lu packets pending\n", pool, pool->app_Pending));
+
+    port = pool->app_Port;
+    while (pool->app_Pending > 0)
+    {
+        if (GetMsg(port) != NULL)
+            pool->app_Pending--;
+        else
+            Wait(1L << port->mp_SigBit);
+    }
+
+    DeleteMsgPort(port);
+    FreeVec(pool);
+
+    AROS_LIBFUNC_EXIT
+} /* DeleteAsyncPktPool */
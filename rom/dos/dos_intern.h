@@ -107,6 +107,31 @@ struct DosPacket *internal_WaitPkt(struct MsgPort *msgPort);
 void internal_ReplyPkt(struct DosPacket *dp, struct MsgPort *replyPort, SIPTR res1, LONG res2);
 SIPTR handleNIL(LONG action, SIPTR arg1, SIPTR arg2, SIPTR arg3);
 
+/* Asynchronous packet pools, see CreateAsyncPktPool() */
+struct IntAsyncPktPool
+{
+    struct AsyncPktPool pub;
+    struct MinList      freelist;   /* Idle packets, linked through sp_Msg */
+};
+
+struct AsyncPacket
+{
+    struct StandardPacket   ap_Std;     /* Must be first */
+    struct IntAsyncPktPool *ap_Pool;
+    struct MsgPort         *ap_Target;  /* Handler the packet was sent to */
+    ULONG                   ap_Flags;
+};
+
+#define APF_INFLIGHT 0x0001     /* Sent, reply not collected yet */
+#define APF_HELD     0x0002     /* Reply collected, not released yet */
+#define APF_ABORTED  0x0004     /* Recycle the packet when its reply arrives */
+
+#define ASYNCPACKET(dp) \
+    ((struct AsyncPacket *)((UBYTE *)(dp) - (IPTR)&((struct StandardPacket *)0)->sp_Pkt))
+
+struct DosPacket *asyncpkt_collect(struct IntAsyncPktPool *pool, struct Message *msg);
+void asyncpkt_recycle(struct IntAsyncPktPool *pool, struct AsyncPacket *ap);
+
 #define dopacket5(base, res2, port, action, arg1, arg2, arg3, arg4, arg5) dopacket(res2, port, action, (SIPTR)(arg1), (SIPTR)(arg2), (SIPTR)(arg3), (SIPTR)(arg4), (SIPTR)(arg5), 0, 0)
 #define dopacket4(base, res2, port, action, arg1, arg2, arg3, arg4)       dopacket(res2, port, action, (SIPTR)(arg1), (SIPTR)(arg2), (SIPTR)(arg3), (SIPTR)(arg4), 0, 0, 0)
 #define dopacket3(base, res2, port, action, arg1, arg2, arg3)             dopacket(res2, port, action, (SIPTR)(arg1), (SIPTR)(arg2), (SIPTR)(arg3), 0, 0, 0, 0)
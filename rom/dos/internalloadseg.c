@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: DOS function InternalLoadSeg()
 */
@@ -73,10 +73,21 @@
 {
     AROS_LIBFUNC_INIT
 
+    return ils_LoadSeg(fh, (SIPTR *)funcarray, stack, 0, DOSBase);
+
+    AROS_LIBFUNC_EXIT
+} /* InternalLoadSeg */
+
+/*
+ * Does the work of InternalLoadSeg(). LoadSeg() calls it directly, with
+ * ILSF_DOSFILE, to let the loaders know that fh is a real FileHandle.
+ */
+BPTR ils_LoadSeg(BPTR fh, SIPTR *funcarray, LONG *stack, ULONG flags, struct DosLibrary *DOSBase)
+{
     typedef struct _segfunc_t
     {
         ULONG id;
-        BPTR (*func)(BPTR, BPTR, SIPTR *, LONG *, struct DosLibrary *);
+        BPTR (*func)(BPTR, BPTR, SIPTR *, LONG *, ULONG, struct DosLibrary *);
         D(CONST_STRPTR format;)
     } segfunc_t;
 
@@ -102,8 +113,8 @@
             id = AROS_BE2LONG(id);
             for (i = 0; i < num_funcs; i++) {
                 if (funcs[i].id == id) {
-                    segs = (*funcs[i].func)(fh, BNULL, (SIPTR *)funcarray,
-                        stack, DOSBase);
+                    segs = (*funcs[i].func)(fh, BNULL, funcarray,
+                        stack, flags, DOSBase);
                     D(bug("[InternalLoadSeg] %s loading %p as an %s object.\n",
                         segs ? "Succeeded" : "FAILED", fh, funcs[i].format));
                     if (segs)
@@ -126,9 +137,7 @@
         SetIoErr(ERROR_NOT_EXECUTABLE);
 
     return BNULL;
-  
-    AROS_LIBFUNC_EXIT
-} /* InternalLoadSeg */
+}
 
 int read_block(BPTR file, APTR buffer, ULONG size, SIPTR * funcarray, struct DosLibrary * DOSBase)
 {
@@ -5,16 +5,27 @@
 #define SEGTYPE_HUNK_OVERLAY    2
 #define SEGTYPE_ELF             10
 
+/* Flags for ils_LoadSeg() and the loaders */
+#define ILSF_DOSFILE            (1 << 0)    /* file is a FileHandle, read with LoadSeg()'s functions */
+
+BPTR ils_LoadSeg(BPTR fh,
+                 SIPTR * funcarray,
+                 LONG  * stacksize,
+                 ULONG flags,
+                 struct DosLibrary * DOSBase);
+
 BPTR InternalLoadSeg_AOS(BPTR file,
                          BPTR table,
                          SIPTR * funcarray,
                          LONG  * stacksize,
+                         ULONG flags,
                          struct DosLibrary * DOSBase);
 
 BPTR InternalLoadSeg_ELF(BPTR file,
                          BPTR hunk_table,
                          SIPTR * funcarray,
                          LONG  * stacksize,
+                         ULONG flags,
                          struct DosLibrary * DOSBase);
 
 int read_block(BPTR file, APTR buffer, ULONG size, SIPTR * funcarray, struct DosLibrary * DOSBase);
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2025, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -89,6 +89,7 @@ BPTR InternalLoadSeg_AOS(BPTR fh,
                          BPTR table,
                          SIPTR * funcarray,
                          LONG  * stacksize,
+                         ULONG flags __unused,
                          struct DosLibrary * DOSBase)
 {
   #define ERROR(a)    { *error=a; goto end; }
@@ -653,7 +654,7 @@ AROS_UFH4(BPTR, LoadSeg_Overlay,
     hunktype = AROS_BE2LONG(hunktype);
     if (hunktype != HUNK_HEADER)
         return BNULL;
-    return InternalLoadSeg_AOS(fh, hunktable, (SIPTR*)FunctionArray, NULL, DosBase);
+    return InternalLoadSeg_AOS(fh, hunktable, (SIPTR*)FunctionArray, NULL, 0, DosBase);
 
     AROS_USERFUNC_EXIT
 }
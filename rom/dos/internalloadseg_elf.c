@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2025, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Code to dynamically load ELF executables
 */
@@ -54,6 +54,106 @@ struct SRBuffer
     APTR    srb_Buffer;
 };
 
+/* Relocated image cache
+ *
+ * Loading an object means reading all of its sections, and looking up the
+ * symbol of every relocation and applying it, every time. When there is a
+ * LOADSEGCACHE: assign, the result of a LoadSeg() is written there too: the
+ * relocated images of the sections, the symbol and string tables (for
+ * debug.library), and a table of those relocations that depend on where
+ * the sections end up in memory, with their symbols already resolved to a
+ * section and an offset. Relocations that are relative to a place in the
+ * same section don't, and are left out. Loading a file with the same name,
+ * size and date again then only takes a single read of the cache file, a
+ * copy into the new hunks and a pass over that table.
+ *
+ * The cache file starts with a struct ELFCacheHeader, followed by the name
+ * of the file, the ELF header and the section headers. Then come the data
+ * of the symbol and string tables, of the other sections in the order they
+ * are loaded in, each padded to ELFCACHE_ALIGN(), and the relocations.
+ */
+#define ELFCACHE_ASSIGN     "LOADSEGCACHE"
+#define ELFCACHE_MAGIC      AROS_MAKE_ID('E','L','F','C')
+#define ELFCACHE_VERSION    1
+#define ELFCACHE_ABS        0xFFFFFFFF  /* ecr_Target of absolute symbols */
+#define ELFCACHE_ALIGN(x)   AROS_ROUNDUP2(x, 8)
+#define ELFCACHE_MAXSHNUM   0xFFFF      /* SHN_XINDEX is not expected */
+#define ELFCACHE_MAXDATA    0x7FFFFFFF  /* Must fit a Read() */
+
+struct ELFCacheKey
+{
+    ULONG            eck_Hash;
+    ULONG            eck_Size;
+    struct DateStamp eck_Date;
+    ULONG            eck_NameLen;       /* Including the terminating NUL */
+    char             eck_Name[512];
+};
+
+struct ELFCacheHeader
+{
+    ULONG            ech_Magic;
+    ULONG            ech_Version;
+    ULONG            ech_Size;          /* Size and date of the object file */
+    struct DateStamp ech_Date;
+    ULONG            ech_NameLen;
+    ULONG            ech_SHNum;
+    ULONG            ech_NumRelocs;
+    ULONG            ech_DataSize;      /* Everything after the section headers */
+};
+
+struct ELFCacheReloc
+{
+    ULONG            ecr_Section;       /* Section the relocation is applied to */
+    ULONG            ecr_Offset;
+    ULONG            ecr_Type;
+    ULONG            ecr_Target;        /* Section of the symbol, or ELFCACHE_ABS */
+    elf_uintptr_t    ecr_Value;
+    elf_intptr_t     ecr_Addend;
+    UBYTE            ecr_Orig[8];       /* What was there before the relocation */
+};
+
+/* Only the RELA format has an explicit addend */
+#if defined(__i386__) || (defined(__riscv) && !defined(__riscv64))
+#define RELO_ADDEND(rel)    0
+#else
+#define RELO_ADDEND(rel)    ((rel)->addend)
+#endif
+
+/*
+ * For the cache: relocations which don't do anything, those whose result
+ * only depends on the distance between the place and the symbol, and how
+ * many bytes a relocation changes.
+ */
+#if defined(__i386__)
+#define RELOC_NONE(t)       ((t) == R_386_NONE)
+#define RELOC_PCREL(t)      ((t) == R_386_PC32)
+#define RELOC_WIDTH(t)      4
+#elif defined(__x86_64__)
+#define RELOC_NONE(t)       ((t) == R_X86_64_NONE)
+#define RELOC_PCREL(t)      ((t) == R_X86_64_PC32 || (t) == R_X86_64_PLT32 || (t) == R_X86_64_PC64)
+#define RELOC_WIDTH(t)      (((t) == R_X86_64_64 || (t) == R_X86_64_PC64 || (t) == R_X86_64_GOTOFF64) ? 8 : 4)
+#elif defined(__mc68000__)
+#define RELOC_NONE(t)       ((t) == R_68K_NONE)
+#define RELOC_PCREL(t)      ((t) == R_68K_PC32 || (t) == R_68K_PC16 || (t) == R_68K_PC8)
+#define RELOC_WIDTH(t)      (((t) == R_68K_16 || (t) == R_68K_PC16) ? 2 : \
+                             ((t) == R_68K_8 || (t) == R_68K_PC8) ? 1 : 4)
+#elif defined(__ppc__) || defined(__powerpc__)
+#define RELOC_NONE(t)       ((t) == R_PPC_NONE)
+#define RELOC_PCREL(t)      ((t) == R_PPC_REL16_LO || (t) == R_PPC_REL16_HA || \
+                             (t) == R_PPC_REL24 || (t) == R_PPC_REL32)
+#define RELOC_WIDTH(t)      (((t) == R_PPC_ADDR16_LO || (t) == R_PPC_ADDR16_HA || \
+                              (t) == R_PPC_REL16_LO || (t) == R_PPC_REL16_HA) ? 2 : 4)
+#elif defined(__arm__)
+#define RELOC_NONE(t)       ((t) == R_ARM_NONE)
+#define RELOC_PCREL(t)      ((t) == R_ARM_CALL || (t) == R_ARM_JUMP24 || (t) == R_ARM_PC24 || \
+                             (t) == R_ARM_PREL31 || (t) == R_ARM_THM_CALL || (t) == R_ARM_THM_JUMP24)
+#define RELOC_WIDTH(t)      4
+#else
+#define RELOC_NONE(t)       0
+#define RELOC_PCREL(t)      0
+#define RELOC_WIDTH(t)      4
+#endif
+
 static int elf_read_block
 (
     BPTR               file,
@@ -200,15 +300,13 @@ static int load_header(BPTR file, struct elfheader *eh, SIPTR *funcarray, struct
     return 1;
 }
 
-static int __attribute__ ((noinline)) load_hunk
+static int alloc_hunk
 (
-    BPTR                 file,
     BPTR               **next_hunk_ptr,
     struct sheader      *sh,
     CONST_STRPTR         strtab,
     SIPTR               *funcarray,
     BOOL                 do_align,
-    struct SRBuffer     *srb,
     struct DosLibrary   *DOSBase
 )
 {
@@ -285,11 +383,7 @@ static int __attribute__ ((noinline)) load_hunk
         /* Update the pointer to the previous one, which is now the current one */
         *next_hunk_ptr = (APTR)((IPTR)hunk + offsetof(struct hunk, next));
 
-        if (sh->type != SHT_NOBITS)
-            return !elf_read_block(file, sh->offset, sh->addr, sh->size, funcarray, srb, DOSBase);
-
         return 1;
-
     }
 
     SetIoErr(ERROR_NO_FREE_STORE);
@@ -297,373 +391,432 @@ static int __attribute__ ((noinline)) load_hunk
     return 0;
 }
 
-static int relocate
+static int __attribute__ ((noinline)) load_hunk
+(
+    BPTR                 file,
+    BPTR               **next_hunk_ptr,
+    struct sheader      *sh,
+    CONST_STRPTR         strtab,
+    SIPTR               *funcarray,
+    BOOL                 do_align,
+    struct SRBuffer     *srb,
+    struct DosLibrary   *DOSBase
+)
+{
+    if (!alloc_hunk(next_hunk_ptr, sh, strtab, funcarray, do_align, DOSBase))
+        return 0;
+
+    if (sh->size && sh->type != SHT_NOBITS)
+        return !elf_read_block(file, sh->offset, sh->addr, sh->size, funcarray, srb, DOSBase);
+
+    return 1;
+}
+
+static int apply_reloc
 (
-    struct elfheader  *eh,
-    struct sheader    *sh,
-    ULONG              shrel_idx,
-    struct sheader    *symtab_shndx,
+    ULONG              type,
+    ULONG             *p,
+    IPTR               s,
+    elf_intptr_t       addend,
+    IPTR               got_base,
     struct DosLibrary *DOSBase
 )
 {
-    struct sheader *shrel    = &sh[shrel_idx];
-    struct sheader *shsymtab = &sh[shrel->link];
-    struct sheader *toreloc  = &sh[shrel->info];
+    switch (type)
+    {
+        #if defined(__i386__)
 
-    struct symbol *symtab   = (struct symbol *)shsymtab->addr;
-    struct relo   *rel      = (struct relo *)shrel->addr;
+        case R_386_32: /* 32bit absolute */
+            *p += s;
+            break;
 
-    /*
-     * Ignore relocs if the target section has no allocation. that can happen
-     * eg. with a .debug PROGBITS and a .rel.debug section
-     */
-    if (!(toreloc->flags & SHF_ALLOC))
-        return 1;
+        case R_386_PC32: /* 32bit PC relative */
+            *p += s - (ULONG)p;
+            break;
 
-    ULONG numrel = shrel->size / shrel->entsize;
-    ULONG i;
-#if defined(__i386__) || defined(__x86_64__)
-    IPTR got_base = 0;
+        case R_386_GOTPC: /* PC-relative offset to GOT */
+            if (!got_base) {
+                SetIoErr(ERROR_BAD_HUNK);
+                return 0;
+            }
+            *p = got_base - (ULONG)p;
+            break;
 
-    for (int i = 0; i < eh->shnum; ++i) {
-        const char *name = (const char *)((UBYTE *)sh[eh->shstrndx].addr + sh[i].name);
-        if (strcmp(name, ".got") == 0) {
-            got_base = (IPTR)sh[i].addr;
+        case R_386_NONE:
             break;
-        }
-    }
-#endif
 
-    for (i=0; i<numrel; i++, rel++)
-    {
-        struct symbol *sym;
-        ULONG *p;
-        IPTR s;
-        ULONG shindex;
+        #elif defined(__x86_64__)
+        case R_X86_64_64: /* 64bit direct/absolute */
+            *(UQUAD *)p = s + addend;
+            break;
 
-#ifdef __arm__
-        /*
-         * R_ARM_V4BX are actually special marks for the linker.
-         * They even never have a target (shindex == SHN_UNDEF),
-         * so we simply ignore them before doing any checks.
-         */
-        if (ELF_R_TYPE(rel->info) == R_ARM_V4BX)
-            continue;
-#endif
+        case R_X86_64_PLT32:
+        case R_X86_64_PC32: /* PC relative 32 bit signed */
+            *(ULONG *)p = s + addend - (IPTR) p;
+            break;
 
-        sym = &symtab[ELF_R_SYM(rel->info)];
-        p = toreloc->addr + rel->offset;
+        case R_X86_64_32:
+            *(ULONG *)p = (UQUAD)s + (UQUAD)addend;
+            break;
 
-        DB2(bug("[ELF Loader] Processing symbol %s\n", sh[shsymtab->link].addr + sym->name));
+        case R_X86_64_32S:
+            *(LONG *)p = (QUAD)s + (QUAD)addend;
+            break;
 
-        switch (sym->shindex)
-        {
-            case SHN_COMMON:
-                D(bug("[ELF Loader] COMMON symbol '%s'\n",
-                      (STRPTR)sh[shsymtab->link].addr + sym->name));
-                      SetIoErr(ERROR_BAD_HUNK);
-                return 0;
+        case R_X86_64_PC64:
+            *(UQUAD *)p = (UQUAD)s + (UQUAD)addend - (IPTR) p;
+            break;
 
-            case SHN_ABS:
-                s = sym->value;
-                break;
+        case R_X86_64_GOTOFF64:
+            if (!got_base) {
+                SetIoErr(ERROR_BAD_HUNK);
+                return 0;
+            }
+            *(UQUAD *)p = (UQUAD)s + (UQUAD)addend - (UQUAD)got_base;
+            break;
 
-            case SHN_UNDEF:
-                if (ELF_R_TYPE(rel->info) != 0) {
-                    D(bug("[ELF Loader] Undefined symbol '%s'\n",
-                      (STRPTR)sh[shsymtab->link].addr + sym->name));
-                    SetIoErr(ERROR_BAD_HUNK);
-                    return 0;
-                }
-                /* fall through */
+        case R_X86_64_NONE: /* No reloc */
+            break;
 
-            default:
-                if (sym->shindex != SHN_XINDEX)
-                    shindex = sym->shindex;
-                else {
-                    if (symtab_shndx == NULL) {
-                        D(bug("[ELF Loader] got symbol with shndx 0xfff, but there's no symtab shndx table\n"));
-                        SetIoErr(ERROR_BAD_HUNK);
-                        return 0;
-                    }
-                    shindex = ((ULONG *)symtab_shndx->addr)[ELF_R_SYM(rel->info)];
-                }
-                s = (IPTR)sh[shindex].addr + sym->value;
-        }
+        #elif defined(__mc68000__)
 
-        switch (ELF_R_TYPE(rel->info))
-        {
-            #if defined(__i386__)
+        case R_68K_32:
+            *p = s + addend;
+            break;
 
-            case R_386_32: /* 32bit absolute */
-                *p += s;
-                break;
+        case R_68K_16:
+            *(UWORD *)p = s + addend;
+            break;
 
-            case R_386_PC32: /* 32bit PC relative */
-                *p += s - (ULONG)p;
-                break;
+        case R_68K_8:
+            *(UBYTE *)p = s + addend;
+            break;
 
-            case R_386_GOTPC: /* PC-relative offset to GOT */
-                if (!got_base) {
-                    SetIoErr(ERROR_BAD_HUNK);
-                    return 0;
-                }
-                *p = got_base - (ULONG)p;
-                break;
+        case R_68K_PC32:
+            *p = s + addend - (ULONG)p;
+            break;
 
-            case R_386_NONE:
-                break;
+        case R_68K_PC16:
+            *(UWORD *)p = s + addend - (ULONG)p;
+            break;
 
-            #elif defined(__x86_64__)
-            case R_X86_64_64: /* 64bit direct/absolute */
-                *(UQUAD *)p = s + rel->addend;
-                break;
+        case R_68K_PC8:
+            *(UBYTE *)p = s + addend - (ULONG)p;
+            break;
 
-            case R_X86_64_PLT32:
-            case R_X86_64_PC32: /* PC relative 32 bit signed */
-                *(ULONG *)p = s + rel->addend - (IPTR) p;
-                break;
+        case R_68K_NONE:
+            break;
 
-            case R_X86_64_32:
-                *(ULONG *)p = (UQUAD)s + (UQUAD)rel->addend;
-                break;
+        #elif defined(__ppc__) || defined(__powerpc__)
 
-            case R_X86_64_32S:
-                *(LONG *)p = (QUAD)s + (QUAD)rel->addend;
-                break;
+        case R_PPC_ADDR32:
+            *p = s + addend;
+            break;
 
-            case R_X86_64_PC64:
-                *(UQUAD *)p = (UQUAD)s + (UQUAD)rel->addend - (IPTR) p;
-                break;
+        case R_PPC_ADDR16_LO:
+            {
+                unsigned short *c = (unsigned short *) p;
+                *c = (s + addend) & 0xffff;
+            }
+            break;
 
-            case R_X86_64_GOTOFF64:
-                if (!got_base) {
-                    SetIoErr(ERROR_BAD_HUNK);
-                    return 0;
-                }
-                *(UQUAD *)p = (UQUAD)s + (UQUAD)rel->addend - (UQUAD)got_base;
-                break;
+        case R_PPC_ADDR16_HA:
+            {
+                unsigned short *c = (unsigned short *) p;
+                ULONG temp = s + addend;
+                *c = temp >> 16;
+                if ((temp & 0x8000) != 0)
+                    (*c)++;
+            }
+            break;
 
-            case R_X86_64_NONE: /* No reloc */
-                break;
+        case R_PPC_REL16_LO:
+            {
+                unsigned short *c = (unsigned short *) p;
+                *c = (s + addend - (ULONG) p) & 0xffff;
+            }
+            break;
 
-            #elif defined(__mc68000__)
+        case R_PPC_REL16_HA:
+            {
+                unsigned short *c = (unsigned short *) p;
+                ULONG temp = s + addend - (ULONG) p;
+                *c = temp >> 16;
+                if ((temp & 0x8000) != 0)
+                    (*c)++;
+            }
+            break;
 
-            case R_68K_32:
-                *p = s + rel->addend;
-                break;
+        case R_PPC_REL24:
+            *p &= ~0x3fffffc;
+            *p |= (s + addend - (ULONG) p) & 0x3fffffc;
+            break;
 
-            case R_68K_16:
-                *(UWORD *)p = s + rel->addend;
-                break;
+        case R_PPC_REL32:
+            *p = s + addend - (ULONG) p;
+            break;
 
-            case R_68K_8:
-                *(UBYTE *)p = s + rel->addend;
-                break;
+        case R_PPC_NONE:
+            break;
 
-            case R_68K_PC32:
-                *p = s + rel->addend - (ULONG)p;
-                break;
+        #elif defined(__arm__)
+        case R_ARM_CALL:
+        case R_ARM_JUMP24:
+        case R_ARM_PC24:
+        case R_ARM_PREL31:
+        {
+            /* On ARM the 24 bit offset is shifted by 2 to the right */
+            signed long offset = (AROS_LE2LONG(*p) & 0x00ffffff) << 2;
+            /* If highest bit set, make offset negative */
+            if (offset & 0x02000000)
+                offset -= 0x04000000;
+
+            if (offset >= 0x02000000 ||
+                    offset <= -0x02000000)
+            {
+                    bug("[ELF Loader] Relocation type %d out of range!\n", type);
+                    SetIoErr(ERROR_BAD_HUNK);
+                    return 0;
+            }
+            offset += s - (ULONG)p;
 
-            case R_68K_PC16:
-                *(UWORD *)p = s + rel->addend - (ULONG)p;
-                break;
+            offset >>= 2;
+            *p &= AROS_LONG2LE(0xff000000);
+            *p |= AROS_LONG2LE(offset & 0x00ffffff);
+        }
+        break;
 
-            case R_68K_PC8:
-                *(UBYTE *)p = s + rel->addend - (ULONG)p;
-                break;
+        case R_ARM_THM_CALL:
+        case R_ARM_THM_JUMP24:
+        {
+            ULONG upper,lower,sign,j1,j2;
+            LONG offset;
 
-            case R_68K_NONE:
-                break;
+            upper = AROS_WORD2LE(*((UWORD *)p));
+            lower = AROS_WORD2LE(*((UWORD *)p+1));
 
-            #elif defined(__ppc__) || defined(__powerpc__)
+            sign = (upper >> 10) & 1;
+            j1 = (lower >> 13) & 1;
+            j2 = (lower >> 11) & 1;
 
-            case R_PPC_ADDR32:
-                *p = s + rel->addend;
-                break;
+            offset = (sign << 24) | ((~(j1 ^ sign) & 1) << 23) |
+                            ((~(j2 ^ sign) & 1) << 22) |
+                            ((upper & 0x03ff) << 12) |
+                            ((lower & 0x07ff) << 1);
 
-            case R_PPC_ADDR16_LO:
-                {
-                    unsigned short *c = (unsigned short *) p;
-                    *c = (s + rel->addend) & 0xffff;
-                }
-                break;
+            if (offset & 0x01000000)
+                    offset -= 0x02000000;
 
-            case R_PPC_ADDR16_HA:
-                {
-                    unsigned short *c = (unsigned short *) p;
-                    ULONG temp = s + rel->addend;
-                    *c = temp >> 16;
-                    if ((temp & 0x8000) != 0)
-                        (*c)++;
-                }
-                break;
+            if (offset >= 0x01000000 ||
+                    offset <= -0x01000000)
+            {
+                    bug("[ELF Loader] Relocation type %d out of range!\n", type);
+                    SetIoErr(ERROR_BAD_HUNK);
+                    return 0;
+            }
+            offset += s - (ULONG)p;
 
-            case R_PPC_REL16_LO:
-                {
-                    unsigned short *c = (unsigned short *) p;
-                    *c = (s + rel->addend - (ULONG) p) & 0xffff;
-                }
-                break;
+            sign = (offset >> 24) & 1;
+            j1 = sign ^ (~(offset >> 23) & 1);
+            j2 = sign ^ (~(offset >> 22) & 1);
 
-            case R_PPC_REL16_HA:
-                {
-                    unsigned short *c = (unsigned short *) p;
-                    ULONG temp = s + rel->addend - (ULONG) p;
-                    *c = temp >> 16;
-                    if ((temp & 0x8000) != 0)
-                        (*c)++;
-                }
-                break;
+            *(UWORD *)p = AROS_WORD2LE((UWORD)((upper & 0xf800) | (sign << 10) |
+                            ((offset >> 12) & 0x03ff)));
+            *((UWORD *)p + 1) = AROS_WORD2LE((UWORD)((lower & 0xd000) |
+                            (j1 << 13) | (j2 << 11) | ((offset >> 1) & 0x07ff)));
 
-            case R_PPC_REL24:
-                *p &= ~0x3fffffc;
-                *p |= (s + rel->addend - (ULONG) p) & 0x3fffffc;
-                break;
+        }
+        break;
 
-            case R_PPC_REL32:
-                *p = s + rel->addend - (ULONG) p;
-                break;
+        case R_ARM_THM_MOVW_ABS_NC:
+        case R_ARM_THM_MOVT_ABS:
+        {
+            ULONG upper,lower;
+            LONG offset;
 
-            case R_PPC_NONE:
-                break;
+            upper = AROS_LE2WORD(*((UWORD *)p));
+            lower = AROS_LE2WORD(*((UWORD *)p+1));
 
-            #elif defined(__arm__)
-            case R_ARM_CALL:
-            case R_ARM_JUMP24:
-            case R_ARM_PC24:
-            case R_ARM_PREL31:
-            {
-                /* On ARM the 24 bit offset is shifted by 2 to the right */
-                signed long offset = (AROS_LE2LONG(*p) & 0x00ffffff) << 2;
-                /* If highest bit set, make offset negative */
-                if (offset & 0x02000000)
-                    offset -= 0x04000000;
-
-                if (offset >= 0x02000000 ||
-                        offset <= -0x02000000)
-                {
-                        bug("[ELF Loader] Relocation type %d %d out of range!\n", i, ELF_R_TYPE(rel->info));
-                        SetIoErr(ERROR_BAD_HUNK);
-                        return 0;
-                }
-                offset += s - (ULONG)p;
+            offset = ((upper & 0x000f) << 12) |
+                            ((upper & 0x0400) << 1) |
+                            ((lower & 0x7000) >> 4) |
+                            (lower & 0x00ff);
 
-                offset >>= 2;
-                *p &= AROS_LONG2LE(0xff000000);
-                *p |= AROS_LONG2LE(offset & 0x00ffffff);
-            }
-            break;
+            offset = (offset ^ 0x8000) - 0x8000;
 
-            case R_ARM_THM_CALL:
-            case R_ARM_THM_JUMP24:
-            {
-                ULONG upper,lower,sign,j1,j2;
-                LONG offset;
+            offset += s;
 
-                upper = AROS_WORD2LE(*((UWORD *)p));
-                lower = AROS_WORD2LE(*((UWORD *)p+1));
+            if (type == R_ARM_THM_MOVT_ABS)
+                    offset >>= 16;
 
-                sign = (upper >> 10) & 1;
-                j1 = (lower >> 13) & 1;
-                j2 = (lower >> 11) & 1;
+            *(UWORD *)p = AROS_WORD2LE((UWORD)((upper & 0xfbf0) |
+                            ((offset & 0xf000) >> 12) |
+                            ((offset & 0x0800) >> 1)));
+            *((UWORD *)p + 1) = AROS_WORD2LE((UWORD)((lower & 0x8f00) |
+                            ((offset & 0x0700)<< 4) |
+                            (offset & 0x00ff)));
+        }
+        break;
 
-                offset = (sign << 24) | ((~(j1 ^ sign) & 1) << 23) |
-                                ((~(j2 ^ sign) & 1) << 22) |
-                                ((upper & 0x03ff) << 12) |
-                                ((lower & 0x07ff) << 1);
+        case R_ARM_MOVW_ABS_NC:
+        case R_ARM_MOVT_ABS:
+        {
+            signed long offset = AROS_LE2LONG(*p);
+            offset = ((offset & 0xf0000) >> 4) | (offset & 0xfff);
+            offset = (offset ^ 0x8000) - 0x8000;
 
-                if (offset & 0x01000000)
-                        offset -= 0x02000000;
+            offset += s;
 
-                if (offset >= 0x01000000 ||
-                        offset <= -0x01000000)
-                {
-                        bug("[ELF Loader] Relocation type %d %d out of range!\n", i, ELF_R_TYPE(rel->info));
-                        SetIoErr(ERROR_BAD_HUNK);
-                        return 0;
-                }
-                offset += s - (ULONG)p;
+            if (type == R_ARM_MOVT_ABS)
+                offset >>= 16;
 
-                sign = (offset >> 24) & 1;
-                j1 = sign ^ (~(offset >> 23) & 1);
-                j2 = sign ^ (~(offset >> 22) & 1);
+            *p &= AROS_LONG2LE(0xfff0f000);
+            *p |= AROS_LONG2LE(((offset & 0xf000) << 4) | (offset & 0x0fff));
+        }
+        break;
 
-                *(UWORD *)p = AROS_WORD2LE((UWORD)((upper & 0xf800) | (sign << 10) |
-                                ((offset >> 12) & 0x03ff)));
-                *((UWORD *)p + 1) = AROS_WORD2LE((UWORD)((lower & 0xd000) |
-                                (j1 << 13) | (j2 << 11) | ((offset >> 1) & 0x07ff)));
+        case R_ARM_TARGET2: /* maps to R_ARM_ABS32 under EABI for AROS*/
+        case R_ARM_TARGET1: /* use for constructors/destructors; maps to
+                               R_ARM_ABS32 */
+        case R_ARM_ABS32:
+            *p += s;
+            break;
 
-            }
+        case R_ARM_NONE:
             break;
+        #elif defined(__riscv)
 
-            case R_ARM_THM_MOVW_ABS_NC:
-            case R_ARM_THM_MOVT_ABS:
-            {
-                ULONG upper,lower;
-                LONG offset;
+        #else
+        #    error Your architecture is not supported
+        #endif
 
-                upper = AROS_LE2WORD(*((UWORD *)p));
-                lower = AROS_LE2WORD(*((UWORD *)p+1));
+        default:
+            bug("[ELF Loader] Unknown relocation type %d\n", type);
+            SetIoErr(ERROR_BAD_HUNK);
+            return 0;
+    }
 
-                offset = ((upper & 0x000f) << 12) |
-                                ((upper & 0x0400) << 1) |
-                                ((lower & 0x7000) >> 4) |
-                                (lower & 0x00ff);
+    return 1;
+}
 
-                offset = (offset ^ 0x8000) - 0x8000;
+#if defined(__i386__) || defined(__x86_64__)
+static IPTR got_address(struct elfheader *eh, struct sheader *sh)
+{
+    for (int i = 0; i < eh->shnum; ++i) {
+        const char *name = (const char *)((UBYTE *)sh[eh->shstrndx].addr + sh[i].name);
+        if (strcmp(name, ".got") == 0)
+            return (IPTR)sh[i].addr;
+    }
 
-                offset += s;
+    return 0;
+}
+#else
+#define got_address(eh, sh) 0
+#endif
 
-                if (ELF_R_TYPE(rel->info) == R_ARM_THM_MOVT_ABS)
-                        offset >>= 16;
+static int relocate
+(
+    struct elfheader      *eh,
+    struct sheader        *sh,
+    ULONG                  shrel_idx,
+    struct sheader        *symtab_shndx,
+    struct ELFCacheReloc **cache_next,
+    struct DosLibrary     *DOSBase
+)
+{
+    struct sheader *shrel    = &sh[shrel_idx];
+    struct sheader *shsymtab = &sh[shrel->link];
+    struct sheader *toreloc  = &sh[shrel->info];
 
-                *(UWORD *)p = AROS_WORD2LE((UWORD)((upper & 0xfbf0) |
-                                ((offset & 0xf000) >> 12) |
-                                ((offset & 0x0800) >> 1)));
-                *((UWORD *)p + 1) = AROS_WORD2LE((UWORD)((lower & 0x8f00) |
-                                ((offset & 0x0700)<< 4) |
-                                (offset & 0x00ff)));
-            }
-            break;
+    struct symbol *symtab   = (struct symbol *)shsymtab->addr;
+    struct relo   *rel      = (struct relo *)shrel->addr;
 
-            case R_ARM_MOVW_ABS_NC:
-            case R_ARM_MOVT_ABS:
-            {
-                signed long offset = AROS_LE2LONG(*p);
-                offset = ((offset & 0xf0000) >> 4) | (offset & 0xfff);
-                offset = (offset ^ 0x8000) - 0x8000;
+    /*
+     * Ignore relocs if the target section has no allocation. that can happen
+     * eg. with a .debug PROGBITS and a .rel.debug section
+     */
+    if (!(toreloc->flags & SHF_ALLOC))
+        return 1;
 
-                offset += s;
+    ULONG numrel = shrel->size / shrel->entsize;
+    ULONG i;
+    IPTR got_base = got_address(eh, sh);
+
+    for (i=0; i<numrel; i++, rel++)
+    {
+        struct symbol *sym;
+        ULONG *p;
+        IPTR s;
+        ULONG shindex;
+        ULONG type = ELF_R_TYPE(rel->info);
+
+#ifdef __arm__
+        /*
+         * R_ARM_V4BX are actually special marks for the linker.
+         * They even never have a target (shindex == SHN_UNDEF),
+         * so we simply ignore them before doing any checks.
+         */
+        if (type == R_ARM_V4BX)
+            continue;
+#endif
 
-                if (ELF_R_TYPE(rel->info) == R_ARM_MOVT_ABS)
-                    offset >>= 16;
+        sym = &symtab[ELF_R_SYM(rel->info)];
+        p = toreloc->addr + rel->offset;
 
-                *p &= AROS_LONG2LE(0xfff0f000);
-                *p |= AROS_LONG2LE(((offset & 0xf000) << 4) | (offset & 0x0fff));
-            }
-            break;
+        DB2(bug("[ELF Loader] Processing symbol %s\n", sh[shsymtab->link].addr + sym->name));
 
-            case R_ARM_TARGET2: /* maps to R_ARM_ABS32 under EABI for AROS*/
-            case R_ARM_TARGET1: /* use for constructors/destructors; maps to
-                                   R_ARM_ABS32 */
-            case R_ARM_ABS32:
-                *p += s;
-                break;
+        switch (sym->shindex)
+        {
+            case SHN_COMMON:
+                D(bug("[ELF Loader] COMMON symbol '%s'\n",
+                      (STRPTR)sh[shsymtab->link].addr + sym->name));
+                      SetIoErr(ERROR_BAD_HUNK);
+                return 0;
 
-            case R_ARM_NONE:
+            case SHN_ABS:
+                shindex = ELFCACHE_ABS;
+                s = sym->value;
                 break;
-            #elif defined(__riscv)
 
-            #else
-            #    error Your architecture is not supported
-            #endif
+            case SHN_UNDEF:
+                if (type != 0) {
+                    D(bug("[ELF Loader] Undefined symbol '%s'\n",
+                      (STRPTR)sh[shsymtab->link].addr + sym->name));
+                    SetIoErr(ERROR_BAD_HUNK);
+                    return 0;
+                }
+                /* fall through */
 
             default:
-                bug("[ELF Loader] Unknown relocation #%d type %d\n", i, ELF_R_TYPE(rel->info));
-                SetIoErr(ERROR_BAD_HUNK);
-                return 0;
+                if (sym->shindex != SHN_XINDEX)
+                    shindex = sym->shindex;
+                else {
+                    if (symtab_shndx == NULL) {
+                        D(bug("[ELF Loader] got symbol with shndx 0xfff, but there's no symtab shndx table\n"));
+                        SetIoErr(ERROR_BAD_HUNK);
+                        return 0;
+                    }
+                    shindex = ((ULONG *)symtab_shndx->addr)[ELF_R_SYM(rel->info)];
+                }
+                s = (IPTR)sh[shindex].addr + sym->value;
+        }
+
+        /* Remember what is needed to do this again at another address */
+        if (cache_next && !RELOC_NONE(type) && !(RELOC_PCREL(type) && shindex == shrel->info))
+        {
+            struct ELFCacheReloc *ecr = (*cache_next)++;
+
+            ecr->ecr_Section = shrel->info;
+            ecr->ecr_Offset  = rel->offset;
+            ecr->ecr_Type    = type;
+            ecr->ecr_Target  = shindex;
+            ecr->ecr_Value   = sym->value;
+            ecr->ecr_Addend  = RELO_ADDEND(rel);
+            CopyMem(p, ecr->ecr_Orig, RELOC_WIDTH(type));
         }
+
+        if (!apply_reloc(type, p, s, RELO_ADDEND(rel), got_base, DOSBase))
+            return 0;
     }
 
     return 1;
@@ -879,12 +1032,466 @@ static BOOL ARM_ParseAttrs(UBYTE *data, ULONG len, struct DosLibrary *DOSBase)
 
 #endif
 
+#if defined(DOCACHECLEAR)
+/* Clear the caches to let the CPU see the new data and instructions. */
+static void clear_caches(BPTR hunks)
+{
+    BPTR curr = hunks;
+
+    while (curr)
+    {
+        struct hunk *hunk = BPTR2HUNK(BADDR(curr));
+
+        ils_ClearCache(hunk->data, hunk->size, CACRF_ClearD | CACRF_ClearI);
+        curr = hunk->next;
+    }
+}
+#endif
+
+#define IS_TABLE(sh) \
+    ((sh)->type == SHT_SYMTAB || (sh)->type == SHT_STRTAB || (sh)->type == SHT_SYMTAB_SHNDX)
+
+#define IS_IMAGE(sh) \
+    (!IS_TABLE(sh) && ((sh)->flags & SHF_ALLOC) && (sh)->size && (sh)->type != SHT_NOBITS)
+
+/* LOADSEGCACHE:<hash>, or LOADSEGCACHE:<hash>.<tag> for one being written */
+static void elfcache_path(char *path, ULONG hash, ULONG tag)
+{
+    static const char digits[] = "0123456789abcdef";
+    int i;
+
+    strcpy(path, ELFCACHE_ASSIGN ":");
+    path += sizeof(ELFCACHE_ASSIGN);
+
+    for (i = 28; i >= 0; i -= 4)
+        *path++ = digits[(hash >> i) & 15];
+
+    if (tag)
+    {
+        *path++ = '.';
+        for (i = 28; i >= 0; i -= 4)
+            *path++ = digits[(tag >> i) & 15];
+    }
+
+    *path = 0;
+}
+
+/* FNV-1a */
+static ULONG elfcache_hash(ULONG hash, const void *data, ULONG len)
+{
+    const UBYTE *c = data;
+
+    while (len--)
+        hash = (hash ^ *c++) * 16777619UL;
+
+    return hash;
+}
+
+/*
+ * Identifies the file that is being loaded, if the cache is in use.
+ * file must be a FileHandle. Only an assign to a directory is used,
+ * so that opening a cache file can never mean having to load a handler.
+ */
+static struct ELFCacheKey *elfcache_key(BPTR file, struct DosLibrary *DOSBase)
+{
+    struct ELFCacheKey   *key;
+    struct FileInfoBlock *fib;
+    struct DosList       *dl;
+    BOOL                  enabled = FALSE;
+
+    if (!DOSBase)
+        return NULL;
+
+    dl = LockDosList(LDF_ASSIGNS | LDF_READ);
+    dl = FindDosEntry(dl, ELFCACHE_ASSIGN, LDF_ASSIGNS);
+    if (dl && dl->dol_Type == DLT_DIRECTORY && dl->dol_Lock)
+        enabled = TRUE;
+    UnLockDosList(LDF_ASSIGNS | LDF_READ);
+
+    if (!enabled)
+        return NULL;
+
+    if ((key = AllocMem(sizeof(struct ELFCacheKey), MEMF_ANY)) == NULL)
+        return NULL;
+
+    if (NameFromFH(file, key->eck_Name, sizeof(key->eck_Name)) &&
+        (fib = AllocDosObject(DOS_FIB, NULL)) != NULL)
+    {
+        enabled = ExamineFH(file, fib);
+        key->eck_Size = fib->fib_Size;
+        key->eck_Date = fib->fib_Date;
+        FreeDosObject(DOS_FIB, fib);
+
+        if (enabled)
+        {
+            key->eck_NameLen = strlen(key->eck_Name) + 1;
+
+            /*
+             * Only the name picks the cache file, so that a new version of
+             * an object replaces the cached copy of the old one. The size
+             * and date are checked against the header of the cache file.
+             */
+            key->eck_Hash = elfcache_hash(2166136261UL, key->eck_Name, key->eck_NameLen);
+
+            return key;
+        }
+    }
+
+    FreeMem(key, sizeof(struct ELFCacheKey));
+
+    return NULL;
+}
+
+/*
+ * Checks that the section headers read from a cache file go with its
+ * header, and that the data it says follow them add up to ech_DataSize.
+ * Nothing read from the file is trusted before it passed this.
+ */
+static BOOL elfcache_check(struct ELFCacheHeader *ech, struct ELFCacheKey *key,
+                           struct elfheader *eh, struct sheader *sh)
+{
+    ULONG i, used = 0, size;
+
+    if (eh->shstrndx >= ech->ech_SHNum || eh->shnum > ech->ech_SHNum ||
+        sh[eh->shstrndx].type != SHT_STRTAB || !sh[eh->shstrndx].size)
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < ech->ech_SHNum; i++)
+    {
+        /* Whatever was there, the addresses are set up by the loader */
+        sh[i].addr = NULL;
+
+        if (sh[i].name >= sh[eh->shstrndx].size)
+            return FALSE;
+
+        if (IS_TABLE(&sh[i]) || IS_IMAGE(&sh[i]))
+        {
+            /* All of them were read from the object file */
+            if (sh[i].size > key->eck_Size || sh[i].size > ech->ech_DataSize - used)
+                return FALSE;
+            size = ELFCACHE_ALIGN(sh[i].size);
+            if (size > ech->ech_DataSize - used)
+                return FALSE;
+            used += size;
+        }
+    }
+
+    return ech->ech_NumRelocs <= (ech->ech_DataSize - used) / sizeof(struct ELFCacheReloc) &&
+           used + ech->ech_NumRelocs * sizeof(struct ELFCacheReloc) == ech->ech_DataSize;
+}
+
+/*
+ * Checks the symbol and string tables, once they have been read: string
+ * tables must be terminated, and symbol tables must point to tables of the
+ * right type.
+ */
+static BOOL elfcache_check_tables(struct sheader *sh, ULONG shnum)
+{
+    ULONG i;
+
+    for (i = 0; i < shnum; i++)
+    {
+        switch (sh[i].type)
+        {
+        case SHT_STRTAB:
+            if (!sh[i].size || ((UBYTE *)sh[i].addr)[sh[i].size - 1] != 0)
+                return FALSE;
+            break;
+
+        case SHT_SYMTAB:
+            if (sh[i].link >= shnum || sh[sh[i].link].type != SHT_STRTAB ||
+                sh[i].info > sh[i].size / sizeof(struct symbol))
+            {
+                return FALSE;
+            }
+            break;
+
+        case SHT_SYMTAB_SHNDX:
+            if (sh[i].link >= shnum || sh[sh[i].link].type != SHT_SYMTAB || sh[i].info != 0)
+                return FALSE;
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+/* Checks that a relocation from a cache file stays within its sections */
+static BOOL elfcache_check_reloc(struct ELFCacheHeader *ech, struct sheader *sh, struct ELFCacheReloc *ecr)
+{
+    struct sheader *target;
+
+    if (ecr->ecr_Section >= ech->ech_SHNum || !IS_IMAGE(&sh[ecr->ecr_Section]) ||
+        ecr->ecr_Offset > sh[ecr->ecr_Section].size ||
+        RELOC_WIDTH(ecr->ecr_Type) > sh[ecr->ecr_Section].size - ecr->ecr_Offset)
+    {
+        return FALSE;
+    }
+
+    if (ecr->ecr_Target == ELFCACHE_ABS)
+        return TRUE;
+
+    if (ecr->ecr_Target >= ech->ech_SHNum)
+        return FALSE;
+    target = &sh[ecr->ecr_Target];
+
+    return !IS_TABLE(target) && (target->flags & SHF_ALLOC) && target->size;
+}
+
+/* Loads the object from the cache, if there is an up to date copy of it */
+static BPTR elfcache_load(BPTR file, struct ELFCacheKey *key, SIPTR *funcarray, struct DosLibrary *DOSBase)
+{
+    struct ELFCacheHeader ech;
+    struct ELFCacheReloc *ecr;
+    struct elfheader      eh;
+    struct sheader       *sh = NULL;
+    CONST_STRPTR          strtab = NULL;
+    UBYTE                *data = NULL, *pos;
+    char                 *name, path[sizeof(ELFCACHE_ASSIGN) + 18];
+    BPTR                  cf, hunks = BNULL;
+    BPTR                 *next_hunk_ptr = &hunks;
+    ULONG                 shsize = 0, i;
+    IPTR                  got_base;
+    BOOL                  exec_hunk_seen = FALSE, valid = FALSE;
+
+    elfcache_path(path, key->eck_Hash, 0);
+    if ((cf = Open(path, MODE_OLDFILE)) == BNULL)
+        return BNULL;
+
+    if (Read(cf, &ech, sizeof(ech)) == sizeof(ech) &&
+        ech.ech_Magic   == ELFCACHE_MAGIC &&
+        ech.ech_Version == ELFCACHE_VERSION &&
+        ech.ech_Size    == key->eck_Size &&
+        ech.ech_NameLen == key->eck_NameLen &&
+        ech.ech_SHNum > 0 && ech.ech_SHNum <= ELFCACHE_MAXSHNUM &&
+        ech.ech_DataSize > 0 && ech.ech_DataSize <= ELFCACHE_MAXDATA &&
+        CompareDates(&ech.ech_Date, &key->eck_Date) == 0 &&
+        (name = AllocMem(ech.ech_NameLen, MEMF_ANY)) != NULL)
+    {
+        if (Read(cf, name, ech.ech_NameLen) == ech.ech_NameLen &&
+            memcmp(name, key->eck_Name, ech.ech_NameLen) == 0 &&
+            Read(cf, &eh, sizeof(eh)) == sizeof(eh) &&
+            eh.machine == AROS_ELF_MACHINE &&
+            eh.shentsize == sizeof(struct sheader))
+        {
+            shsize = ech.ech_SHNum * sizeof(struct sheader);
+
+            if ((sh = ilsAllocMem(shsize, MEMF_ANY)) != NULL &&
+                Read(cf, sh, shsize) == shsize &&
+                elfcache_check(&ech, key, &eh, sh) &&
+                (data = AllocMem(ech.ech_DataSize, MEMF_ANY)) != NULL &&
+                Read(cf, data, ech.ech_DataSize) == ech.ech_DataSize)
+            {
+                valid = TRUE;
+            }
+        }
+        FreeMem(name, ech.ech_NameLen);
+    }
+
+    Close(cf);
+
+    if (!valid)
+        goto end;
+
+    D(bug("[ELF Loader] Loading '%s' from %s\n", key->eck_Name, path));
+
+    /* The symbol and string tables are used from where they were read to */
+    pos = data;
+    for (i = 0; i < ech.ech_SHNum; i++)
+    {
+        if (IS_TABLE(&sh[i]))
+        {
+            sh[i].addr = pos;
+            pos += ELFCACHE_ALIGN(sh[i].size);
+        }
+    }
+
+    if (!elfcache_check_tables(sh, ech.ech_SHNum))
+        goto end;
+
+    /* Section names are looked up in the string table */
+    strtab = sh[eh.shstrndx].addr;
+
+    /* Check all the relocations before anything is done */
+    ecr = (struct ELFCacheReloc *)(data + ech.ech_DataSize) - ech.ech_NumRelocs;
+    for (i = 0; i < ech.ech_NumRelocs; i++)
+    {
+        if (!elfcache_check_reloc(&ech, sh, &ecr[i]))
+        {
+            D(bug("[ELF Loader] Bad relocation %u in %s\n", i, path));
+            goto end;
+        }
+    }
+
+    /* Lay out the hunks exactly like the loader does */
+    for (i = 0; i < ech.ech_SHNum; i++)
+    {
+        if (IS_TABLE(&sh[i]) || !(sh[i].flags & SHF_ALLOC) || !sh[i].size)
+            continue;
+
+        if (sh[i].flags & SHF_EXECINSTR)
+            exec_hunk_seen = TRUE;
+
+        if (!alloc_hunk(&next_hunk_ptr, &sh[i], strtab, funcarray, exec_hunk_seen, DOSBase))
+            goto error;
+
+        if (IS_IMAGE(&sh[i]))
+        {
+            CopyMem(pos, sh[i].addr, sh[i].size);
+            pos += ELFCACHE_ALIGN(sh[i].size);
+        }
+    }
+
+    /* Redo what depends on where the sections are */
+    got_base = got_address(&eh, sh);
+    ecr = (struct ELFCacheReloc *)pos;
+    for (i = 0; i < ech.ech_NumRelocs; i++, ecr++)
+    {
+        ULONG *p = sh[ecr->ecr_Section].addr + ecr->ecr_Offset;
+        IPTR   s = ecr->ecr_Value;
+
+        if (ecr->ecr_Target != ELFCACHE_ABS)
+            s += (IPTR)sh[ecr->ecr_Target].addr;
+
+        CopyMem(ecr->ecr_Orig, p, RELOC_WIDTH(ecr->ecr_Type));
+        if (!apply_reloc(ecr->ecr_Type, p, s, ecr->ecr_Addend, got_base, DOSBase))
+            goto error;
+    }
+
+    register_elf(file, hunks, &eh, sh, DOSBase);
+
+#if defined(DOCACHECLEAR)
+    clear_caches(hunks);
+#endif
+    goto end;
+
+error:
+    InternalUnLoadSeg(hunks, (VOID_FUNC)funcarray[2]);
+    hunks = BNULL;
+
+end:
+    if (data)
+        FreeMem(data, ech.ech_DataSize);
+    if (sh)
+        ilsFreeMem(sh, shsize);
+
+    return hunks;
+}
+
+static BOOL elfcache_write(BPTR cf, CONST_APTR data, ULONG size, struct DosLibrary *DOSBase)
+{
+    static const UBYTE zero[8];
+    ULONG pad = ELFCACHE_ALIGN(size) - size;
+
+    return (!size || FWrite(cf, data, size, 1) == 1) &&
+           (!pad || FWrite(cf, zero, pad, 1) == 1);
+}
+
+/* Writes a freshly loaded and relocated object to the cache */
+static void elfcache_store
+(
+    struct ELFCacheKey   *key,
+    struct elfheader     *eh,
+    struct sheader       *sh,
+    ULONG                 shnum,
+    struct ELFCacheReloc *relocs,
+    ULONG                 numrelocs,
+    struct DosLibrary    *DOSBase
+)
+{
+    struct ELFCacheHeader ech;
+    struct sheader       *shcopy;
+    char                  path[sizeof(ELFCACHE_ASSIGN) + 18];
+    char                  tmppath[sizeof(ELFCACHE_ASSIGN) + 18];
+    ULONG                 shsize = shnum * eh->shentsize, i;
+    BPTR                  cf;
+    BOOL                  ok;
+
+    ech.ech_Magic     = ELFCACHE_MAGIC;
+    ech.ech_Version   = ELFCACHE_VERSION;
+    ech.ech_Size      = key->eck_Size;
+    ech.ech_Date      = key->eck_Date;
+    ech.ech_NameLen   = key->eck_NameLen;
+    ech.ech_SHNum     = shnum;
+    ech.ech_NumRelocs = numrelocs;
+    ech.ech_DataSize  = numrelocs * sizeof(struct ELFCacheReloc);
+
+    for (i = 0; i < shnum; i++)
+    {
+        if (IS_TABLE(&sh[i]) || IS_IMAGE(&sh[i]))
+            ech.ech_DataSize += ELFCACHE_ALIGN(sh[i].size);
+    }
+
+    if ((shcopy = AllocMem(shsize, MEMF_ANY)) == NULL)
+        return;
+    CopyMem(sh, shcopy, shsize);
+
+    /*
+     * Don't write what the next load would throw away, or it would be
+     * written again every time. This also clears the addresses, which are
+     * of no use to the next one to load it.
+     */
+    ok = ech.ech_SHNum <= ELFCACHE_MAXSHNUM && ech.ech_DataSize <= ELFCACHE_MAXDATA &&
+         elfcache_check(&ech, key, eh, shcopy) && elfcache_check_tables(sh, shnum);
+    for (i = 0; ok && i < numrelocs; i++)
+        ok = elfcache_check_reloc(&ech, shcopy, &relocs[i]);
+    if (!ok)
+    {
+        D(bug("[ELF Loader] Not caching '%s'\n", key->eck_Name));
+        FreeMem(shcopy, shsize);
+        return;
+    }
+
+    /* Write it under a name of its own first, in case the file is being loaded elsewhere too */
+    elfcache_path(path, key->eck_Hash, 0);
+    elfcache_path(tmppath, key->eck_Hash, (ULONG)(IPTR)FindTask(NULL));
+
+    if ((cf = Open(tmppath, MODE_NEWFILE)) != BNULL)
+    {
+        ok = FWrite(cf, &ech, sizeof(ech), 1) == 1 &&
+             FWrite(cf, key->eck_Name, key->eck_NameLen, 1) == 1 &&
+             FWrite(cf, eh, sizeof(struct elfheader), 1) == 1 &&
+             FWrite(cf, shcopy, shsize, 1) == 1;
+
+        for (i = 0; ok && i < shnum; i++)
+        {
+            if (IS_TABLE(&sh[i]))
+                ok = elfcache_write(cf, sh[i].addr, sh[i].size, DOSBase);
+        }
+        for (i = 0; ok && i < shnum; i++)
+        {
+            if (IS_IMAGE(&sh[i]))
+                ok = elfcache_write(cf, sh[i].addr, sh[i].size, DOSBase);
+        }
+        if (ok && numrelocs)
+            ok = FWrite(cf, relocs, sizeof(struct ELFCacheReloc), numrelocs) == numrelocs;
+
+        if (!Close(cf))
+            ok = FALSE;
+
+        if (ok)
+        {
+            DeleteFile(path);
+            ok = Rename(tmppath, path);
+        }
+        if (!ok)
+            DeleteFile(tmppath);
+
+        D(bug("[ELF Loader] %s '%s' to %s\n", ok ? "Cached" : "Failed to cache", key->eck_Name, path));
+    }
+
+    FreeMem(shcopy, shsize);
+}
+
 BPTR InternalLoadSeg_ELF
 (
     BPTR               file,
     BPTR               table __unused,
     SIPTR             *funcarray,
     LONG              *stack __unused,
+    ULONG              flags,
     struct DosLibrary *DOSBase
 )
 {
@@ -893,26 +1500,41 @@ BPTR InternalLoadSeg_ELF
     struct sheader   *symtab_shndx = NULL;
     struct sheader   *strtab = NULL;
     BPTR   hunks         = 0;
-#if defined(DOCACHECLEAR)
-    BPTR curr;
-#endif
     BPTR  *next_hunk_ptr = &hunks;
     ULONG  i;
     BOOL   exec_hunk_seen = FALSE;
     ULONG  int_shnum;
     struct SRBuffer srb = { 0 };
+    struct ELFCacheKey   *cache_key = NULL;
+    struct ELFCacheReloc *cache_relocs = NULL, *cache_next = NULL;
+    ULONG  cache_numrelocs = 0;
+
+    /*
+     * Use the cached copy if there is one. Only LoadSeg() is known to pass
+     * a FileHandle that is read with the DOS functions, other callers of
+     * InternalLoadSeg() may pass anything with functions of their own.
+     */
+    if ((flags & ILSF_DOSFILE) && (cache_key = elfcache_key(file, DOSBase)) != NULL)
+    {
+        hunks = elfcache_load(file, cache_key, funcarray, DOSBase);
+        if (hunks)
+        {
+            FreeMem(cache_key, sizeof(struct ELFCacheKey));
+            return hunks;
+        }
+    }
 
     /* load and validate ELF header */
     if (!load_header(file, &eh, funcarray, &srb, DOSBase))
-        return 0;
+        goto nosh;
 
     int_shnum = read_shnum(file, &eh, funcarray, &srb, DOSBase);
     if (!int_shnum)
-        return 0;
+        goto nosh;
 
     /* load section headers */
     if (!(sh = load_block(file, eh.shoff, int_shnum * eh.shentsize, funcarray, &srb, DOSBase)))
-        return 0;
+        goto nosh;
 
 #ifdef __arm__
     for (i = 0; i < int_shnum; i++)
@@ -1000,6 +1622,28 @@ BPTR InternalLoadSeg_ELF
         }
     }
 
+    /* Make room to note the relocations down for the cache */
+    if (cache_key)
+    {
+        for (i = 0; i < int_shnum; i++)
+        {
+            if ((sh[i].type == AROS_ELF_REL) && sh[sh[i].info].addr)
+                cache_numrelocs += sh[i].size / sh[i].entsize;
+        }
+
+        if (cache_numrelocs)
+        {
+            cache_relocs = AllocMem(cache_numrelocs * sizeof(struct ELFCacheReloc), MEMF_ANY);
+            if (cache_relocs)
+                cache_next = cache_relocs;
+            else
+            {
+                FreeMem(cache_key, sizeof(struct ELFCacheKey));
+                cache_key = NULL;
+            }
+        }
+    }
+
     /* Relocate the sections */
     for (i = 0; i < int_shnum; i++)
     {
@@ -1007,7 +1651,7 @@ BPTR InternalLoadSeg_ELF
         if ((sh[i].type == AROS_ELF_REL) && sh[sh[i].info].addr)
         {
             sh[i].addr = load_block(file, sh[i].offset, sh[i].size, funcarray, &srb, DOSBase);
-            if (!sh[i].addr || !relocate(&eh, sh, i, symtab_shndx, DOSBase))
+            if (!sh[i].addr || !relocate(&eh, sh, i, symtab_shndx, cache_key ? &cache_next : NULL, DOSBase))
                 goto error;
 
             ilsFreeMem(sh[i].addr, sh[i].size);
@@ -1015,6 +1659,9 @@ BPTR InternalLoadSeg_ELF
         }
     }
 
+    if (cache_key)
+        elfcache_store(cache_key, &eh, sh, int_shnum, cache_relocs, cache_next - cache_relocs, DOSBase);
+
     register_elf(file, hunks, &eh, sh, DOSBase);
     goto end;
 
@@ -1028,16 +1675,7 @@ error:
 end:
 
 #if defined(DOCACHECLEAR)
-    /* Clear the caches to let the CPU see the new data and instructions. */
-    curr = hunks;
-
-    while (curr)
-    {
-        struct hunk *hunk = BPTR2HUNK(BADDR(curr));
-
-        ils_ClearCache(hunk->data, hunk->size, CACRF_ClearD | CACRF_ClearI);
-        curr = hunk->next;
-    }
+    clear_caches(hunks);
 #endif
 
     /* deallocate the symbol tables */
@@ -1050,6 +1688,10 @@ end:
     /* Free the section headers */
     ilsFreeMem(sh, int_shnum * eh.shentsize);
 
+    if (cache_relocs) FreeMem(cache_relocs, cache_numrelocs * sizeof(struct ELFCacheReloc));
+
+nosh:
+    if (cache_key) FreeMem(cache_key, sizeof(struct ELFCacheKey));
     if (srb.srb_Buffer) FreeMem(srb.srb_Buffer, LOADSEG_SMALL_READ);
 
     return hunks;
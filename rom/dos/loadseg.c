@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: DOS function LoadSeg()
 */
@@ -11,6 +11,7 @@
 #include <proto/dos.h>
 #include <aros/debug.h>
 #include "dos_intern.h"
+#include "internalloadseg.h"
 
 static AROS_UFH4(LONG, ReadFunc,
         AROS_UFHA(BPTR, file,   D1),
@@ -126,7 +127,7 @@ static AROS_UFH3(void, FreeFunc,
         D(bug("[LoadSeg] Loading '%s'...\n", name));
 
         SetVBuf(file, NULL, BUF_FULL, 4096);
-        segs = InternalLoadSeg(file, BNULL, FunctionArray, NULL);
+        segs = ils_LoadSeg(file, (SIPTR *)FunctionArray, NULL, ILSF_DOSFILE, DOSBase);
         /* We cache the IoErr(), since Close() will alter it */
         err = IoErr();
 
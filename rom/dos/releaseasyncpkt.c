@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH2(void, ReleaseAsyncPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+        AROS_LHA(struct DosPacket *   , dp, A1),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 233, Dos)
+
+/*  FUNCTION
+        Give a packet returned by CheckAsyncPkt() or WaitAsyncPkt() back
+        to the pool, so that it can be sent again.
+
+    INPUTS
+        pool - Pool the packet came from.
+        dp   - The packet. May be NULL.
+
+    RESULT
+
+    NOTES
+        Read dp_Res1 and dp_Res2 before releasing the packet.
+
+    EXAMPLE
+
+    BUGS
+        Releasing a packet that is still in flight does nothing; use
+        AbortAsyncPkt() for that.
+
+    SEE ALSO
+        CheckAsyncPkt(), WaitAsyncPkt(), AbortAsyncPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct AsyncPacket *ap;
+
+    if (dp == NULL)
+        return;
+
+    ap = ASYNCPACKET(dp);
+    if (ap->ap_Flags & APF_HELD)
+        asyncpkt_recycle((struct IntAsyncPktPool *)pool, ap);
+
+    AROS_LIBFUNC_EXIT
+} /* ReleaseAsyncPkt */
@@ -0,0 +1,114 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH8(struct DosPacket *, SendAsyncPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+        AROS_LHA(struct MsgPort *     , port, D1),
+        AROS_LHA(LONG                 , action, D2),
+        AROS_LHA(SIPTR                , arg1, D3),
+        AROS_LHA(SIPTR                , arg2, D4),
+        AROS_LHA(SIPTR                , arg3, D5),
+        AROS_LHA(SIPTR                , arg4, D6),
+        AROS_LHA(SIPTR                , arg5, D7),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 229, Dos)
+
+/*  FUNCTION
+        Send a dos packet to a handler, using a packet from the pool, and
+        return without waiting for the action to complete. The reply is
+        collected later with CheckAsyncPkt() or WaitAsyncPkt().
+
+    INPUTS
+        pool   - Pool created with CreateAsyncPktPool().
+        port   - The handler to send the packet to. NULL means NIL:, in
+                 which case the action is done at once and the packet is
+                 queued at the pool's port as if a handler had replied.
+        action - The packet type, e.g. ACTION_READ.
+        arg1-5 - The packet arguments.
+
+    RESULT
+        The packet that was sent, which can be used to tell the replies
+        apart, or NULL if all packets of the pool are in use. IoErr() is
+        ERROR_NO_FREE_STORE in that case; collect a reply and try again.
+
+    NOTES
+        Buffers passed in the arguments belong to the handler until the
+        reply has been collected.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        CreateAsyncPktPool(), CheckAsyncPkt(), WaitAsyncPkt(),
+        AbortAsyncPkt(), DoPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct IntAsyncPktPool *ipool = (struct IntAsyncPktPool *)pool;
+    struct AsyncPacket *ap;
+    struct DosPacket *dp;
+
+    ap = (struct AsyncPacket *)RemHead((struct List *)&ipool->freelist);
+    if (ap == NULL)
+    {
+        D(bug("[DOS] SendAsyncPkt(0x%p): all %lu packets in use\n", pool, pool->app_Size));
+        SetIoErr(ERROR_NO_FREE_STORE);
+        return NULL;
+    }
+
+    dp = &ap->ap_Std.sp_Pkt;
+    dp->dp_Type = action;
+    dp->dp_Arg1 = arg1;
+    dp->dp_Arg2 = arg2;
+    dp->dp_Arg3 = arg3;
+    dp->dp_Arg4 = arg4;
+    dp->dp_Arg5 = arg5;
+    dp->dp_Arg6 = 0;
+    dp->dp_Arg7 = 0;
+    dp->dp_Res1 = 0;
+    dp->dp_Res2 = 0;
+
+    ap->ap_Target = port;
+    ap->ap_Flags  = APF_INFLIGHT;
+    pool->app_Pending++;
+
+    D(bug("[DOS] SendAsyncPkt(0x%p): dp=0x%p act=%ld port=0x%p pending=%lu\n",
+          pool, dp, action, port, pool->app_Pending));
+
+    if (port == NULL)
+    {
+        /* NIL: answers at once. Queue the result like a handler would. */
+        dp->dp_Res1 = handleNIL(action, arg1, arg2, arg3);
+        dp->dp_Port = pool->app_Port;
+        dp->dp_Link->mn_ReplyPort = pool->app_Port;
+        PutMsg(pool->app_Port, dp->dp_Link);
+    }
+    else
+        internal_SendPkt(dp, port, pool->app_Port);
+
+    return dp;
+
+    AROS_LIBFUNC_EXIT
+} /* SendAsyncPkt */
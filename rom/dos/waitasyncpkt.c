@@ -0,0 +1,71 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc:
+*/
+
+#include <aros/debug.h>
+#include <proto/exec.h>
+
+#include "dos_intern.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <dos/dosextens.h>
+#include <proto/dos.h>
+
+        AROS_LH1(struct DosPacket *, WaitAsyncPkt,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct AsyncPktPool *, pool, A0),
+
+/*  LOCATION */
+        struct DosLibrary *, DOSBase, 231, Dos)
+
+/*  FUNCTION
+        Wait until any of the packets sent with SendAsyncPkt() completes.
+
+    INPUTS
+        pool - Pool created with CreateAsyncPktPool().
+
+    RESULT
+        A completed packet, with dp_Res1 and dp_Res2 filled in by the
+        handler, or NULL if there are no packets in flight that haven't
+        been aborted. Pass the packet to ReleaseAsyncPkt() once you are
+        done with it.
+
+    NOTES
+        If only aborted packets are in flight, this waits for them to
+        come back before returning NULL.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        SendAsyncPkt(), CheckAsyncPkt(), ReleaseAsyncPkt()
+
+    INTERNALS
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct IntAsyncPktPool *ipool = (struct IntAsyncPktPool *)pool;
+    struct MsgPort *port = pool->app_Port;
+    struct Message *msg;
+    struct DosPacket *dp;
+
+    while (pool->app_Pending > 0)
+    {
+        if ((msg = GetMsg(port)) == NULL)
+            Wait(1L << port->mp_SigBit);
+        else if ((dp = asyncpkt_collect(ipool, msg)) != NULL)
+            return dp;
+    }
+
+    return NULL;
+
+    AROS_LIBFUNC_EXIT
+} /* WaitAsyncPkt */
@@ -0,0 +1,122 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Query the memory usage of a pool.
+*/
+
+#include <aros/libcall.h>
+
+#include "exec_intern.h"
+#include "exec_util.h"
+#include "memory.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <exec/memory.h>
+#include <exec/memheaderext.h>
+#include <proto/exec.h>
+
+        AROS_LH2(IPTR, AvailPool,
+
+/*  SYNOPSIS */
+        AROS_LHA(APTR,  poolHeader, A0),
+        AROS_LHA(ULONG, flags,      D0),
+
+/*  LOCATION */
+        struct ExecBase *, SysBase, 175, Exec)
+
+/*  FUNCTION
+        Return the amount of memory held by a private memory pool.
+
+    INPUTS
+        poolHeader - Handle of the memory pool
+        flags      - What to return:
+                     0            - The number of free bytes in the pool,
+                                    including free blocks in its slabs
+                     MEMF_TOTAL   - The size of all puddles of the pool
+                     MEMF_LARGEST - The largest free block in the puddles
+                     MEMF_SLAB    - The number of free bytes in the slabs
+                     MEMF_SLAB | MEMF_TOTAL
+                                  - The size of all slabs of the pool
+
+    RESULT
+        The requested number of bytes
+
+    NOTES
+        The slab figures are only non-zero for pools created with
+        MEMF_SLAB. As other tasks may use the pool at the same time, the
+        result is only a snapshot unless the pool is private.
+
+    EXAMPLE
+
+    BUGS
+        Pools in managed memory always return 0.
+
+    SEE ALSO
+        CreatePool(), AllocPooled(), AvailMem()
+
+    INTERNALS
+
+******************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct ProtectedPool *pool = poolHeader + MEMHEADER_TOTAL;
+    struct MemHeader *mh;
+    IPTR puddleFree = 0, puddleTotal = 0, largest = 0;
+    IPTR slabFree = 0, slabTotal = 0;
+    IPTR ret;
+
+    if (IsManagedMem(poolHeader) || (pool->pool.PoolMagic != POOL_MAGIC))
+        return 0;
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+        ObtainSemaphoreShared(&pool->sem);
+
+    ForeachNode(&pool->pool.PuddleList, mh)
+    {
+        puddleFree  += mh->mh_Free;
+        puddleTotal += (IPTR)mh->mh_Upper - (IPTR)mh->mh_Lower;
+
+        if (flags & MEMF_LARGEST)
+        {
+            struct MemChunk *mc;
+
+            for (mc = mh->mh_First; mc; mc = mc->mc_Next)
+            {
+                if (mc->mc_Bytes > largest)
+                    largest = mc->mc_Bytes;
+            }
+        }
+    }
+
+    if (pool->pool.SlabClasses)
+    {
+        ULONG i;
+
+        for (i = 0; i < POOLSLAB_CLASSES; i++)
+        {
+            struct PoolSlabClass *psc = &pool->pool.SlabClasses[i];
+
+            slabFree  += psc->psc_FreeCount * (psc->psc_ObjSize - ALLOCPOOLED_USER_OFFSET);
+            slabTotal += psc->psc_SlabCount * POOLSLAB_SIZE;
+        }
+    }
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+        ReleaseSemaphore(&pool->sem);
+
+    if (flags & MEMF_SLAB)
+        ret = (flags & MEMF_TOTAL) ? slabTotal : slabFree;
+    else if (flags & MEMF_TOTAL)
+        ret = puddleTotal;
+    else if (flags & MEMF_LARGEST)
+        ret = largest;
+    else
+        ret = puddleFree + slabFree;
+
+    return ret;
+
+    AROS_LIBFUNC_EXIT
+} /* AvailPool */
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2014, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Create a memory pool.
 */
@@ -41,6 +41,11 @@
                    directly to the system. threshSize must be
                    smaller than or equal to the puddleSize.
 
+        If requirements contains MEMF_SLAB, allocations of up to 256 bytes
+        are served from per size class slabs instead of the puddles. This
+        makes allocating and freeing small blocks take constant time, at
+        the cost of rounding each block up to its size class.
+
     RESULT
         A handle for the memory pool or NULL if the pool couldn't
         be created
@@ -51,6 +56,8 @@
         threshSize parameter is effectively ignored and is present only
         for backwards compatibility.
 
+        MEMF_SLAB is ignored while MungWall is active.
+
     EXAMPLE
         \* Get the handle to a private memory pool *\
         po=CreatePool(MEMF_ANY,16384,8192);
@@ -69,7 +76,7 @@
     BUGS
 
     SEE ALSO
-        DeletePool(), AllocPooled(), FreePooled()
+        DeletePool(), AllocPooled(), FreePooled(), AvailPool()
 
     INTERNALS
 
@@ -97,6 +104,10 @@
      */
     puddleSize += MEMHEADER_TOTAL + mhac_GetCtxSize() + ALLOCPOOLED_USER_OFFSET;
 
+    /* The size classes of a slab pool live in the first puddle, next to the pool header */
+    if (requirements & MEMF_SLAB)
+        puddleSize += sizeof(struct PoolSlabClass) * POOLSLAB_CLASSES;
+
     /* If mungwall is enabled, count also size of walls, at least for one allocation */
     if (PrivExecBase(SysBase)->IntFlags & EXECF_MungWall)
         puddleSize += MUNGWALL_TOTAL_SIZE;
@@ -106,7 +117,7 @@
     D(bug("[CreatePool] Aligned puddle size: %u (0x%08X)\n", puddleSize, puddleSize);)
 
     /* Allocate the first puddle. It will contain pool header. */
-    firstPuddle = AllocMemHeader(puddleSize, requirements & ~MEMF_SEM_PROTECTED, &tp, SysBase);
+    firstPuddle = AllocMemHeader(puddleSize, requirements & ~(MEMF_SEM_PROTECTED | MEMF_SLAB), &tp, SysBase);
     D(bug("[CreatePool] Initial puddle 0x%p\n", firstPuddle);)
 
     if (firstPuddle)
@@ -128,6 +139,7 @@
         pool->pool.Requirements = requirements;
         pool->pool.PuddleSize   = puddleSize;
         pool->pool.PoolMagic   = POOL_MAGIC;
+        pool->pool.SlabClasses = NULL;
 
         if (requirements & MEMF_SEM_PROTECTED)
         {
@@ -141,6 +153,11 @@
         if (IsManagedMem(firstPuddle))
         {
             D(bug("Managed pool\n");)
+            /*
+             * MEMF_SLAB is ignored here: AllocPooled() and FreePooled() hand
+             * managed pools straight to the MemHeader's own functions and never
+             * reach the slab code, so SlabClasses stays NULL.
+             */
             /*
              * Just link the pool structure at the ln_Name - we will need that
              * for the semaphore
@@ -153,6 +170,12 @@
         }
         else
         {
+            if (requirements & MEMF_SLAB)
+            {
+                pool->pool.SlabClasses = Allocate(firstPuddle, sizeof(struct PoolSlabClass) * POOLSLAB_CLASSES);
+                InitPoolSlabs(pool->pool.SlabClasses);
+            }
+
             /*
              * Add the puddle to the list (yes, contained in itself).
              * This is the first puddle so it's safe to use AddTail() here.
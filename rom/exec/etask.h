@@ -62,6 +62,10 @@ struct IntETask
     IPTR                iet_CpuNumber;          /* core this task is currently running on  */
     cpumask_t           *iet_CpuAffinity;        /* bitmap of cores this task can run on    */
     spinlock_t          *iet_SpinLock;          /* pointer to spinlock task is spinning on */
+    struct MinNode      iet_RunQueueNode;       /* node in a core's ready queue            */
+    struct Task         *iet_RunQueueTask;      /* task owning this ETask, while queued    */
+    APTR                iet_RunQueue;           /* ready queue the task is indexed on      */
+    ULONG               iet_RunQueueLevel;      /* priority level it is queued at          */
 #endif
 #ifdef DEBUG_ETASK
     STRPTR              iet_Me;
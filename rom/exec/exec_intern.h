@@ -75,6 +75,7 @@ struct IntExecBase
     ULONG                       SupervisorDeadEndCnt;           /* Counter of reaching AT_DeadEnd under Supervisor mode         */
     char                        AlertBuffer[ALERT_BUFFER_SIZE]; /* Buffer for alert text                                        */
     void                       *ExecLogBase;
+    APTR                        ReadyQueue;                     /* Priority index of TaskReady (SCHED_PRI), see kernel_readyqueue.h */
 #if defined(__AROSEXEC_BROKENMEMLOCK__)
     struct SignalSemaphore      MemListSem;                     /* Memory list protection semaphore                             */
 #elif defined(__AROSEXEC_SMP__)
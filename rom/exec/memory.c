@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -912,6 +912,173 @@ static void EnqueueMemHeader(struct MinList *list, struct MemHeader *mh)
     next->mh_Node.ln_Pred          = &mh->mh_Node;
 }
 
+/* Object sizes of the slab classes, not including the back pointer */
+static const UWORD poolSlabSizes[POOLSLAB_CLASSES] =
+{
+    16, 32, 48, 64, 96, 128, 192, POOLSLAB_MAXSIZE
+};
+
+/* Set up the size classes of a MEMF_SLAB pool. Called by CreatePool(). */
+void InitPoolSlabs(struct PoolSlabClass *classes)
+{
+    ULONG i;
+
+    for (i = 0; i < POOLSLAB_CLASSES; i++)
+    {
+        struct PoolSlabClass *psc = &classes[i];
+
+        NEWLIST((struct List *)&psc->psc_Slabs);
+        psc->psc_ObjSize   = AROS_ROUNDUP2(poolSlabSizes[i] + ALLOCPOOLED_USER_OFFSET, MEMCHUNK_TOTAL);
+        /* The slab itself is only IPTR-aligned, leave room to align the first object */
+        psc->psc_PerSlab   = (POOLSLAB_SIZE - sizeof(struct PoolSlab) - (MEMCHUNK_TOTAL - 1)) / psc->psc_ObjSize;
+        psc->psc_SlabCount = 0;
+        psc->psc_FreeCount = 0;
+    }
+}
+
+static inline struct PoolSlabClass *FindPoolSlabClass(struct Pool *pool, IPTR memSize)
+{
+    ULONG i;
+
+    for (i = 0; i < POOLSLAB_CLASSES; i++)
+    {
+        if (memSize <= poolSlabSizes[i])
+            return &pool->SlabClasses[i];
+    }
+    return NULL;
+}
+
+/*
+ * Get a new slab for the given class from the puddles. Called with the pool
+ * locked. The slab is added to the class' list of slabs with free objects.
+ */
+static struct PoolSlab *CreatePoolSlab(APTR poolHeader, struct ProtectedPool *pool, struct PoolSlabClass *psc,
+                                       ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct PoolSlab *ps;
+    APTR obj;
+    ULONG i;
+
+    ps = InternalAllocPooled(poolHeader, POOLSLAB_SIZE, flags & ~MEMF_CLEAR, loc, SysBase);
+    D(bug("[InternalAllocPooled] New slab 0x%p for %u byte objects\n", ps, psc->psc_ObjSize));
+    if (ps == NULL)
+        return NULL;
+
+    ps->ps_Class    = psc;
+    ps->ps_Pool     = pool;
+    ps->ps_FreeList = NULL;
+    ps->ps_Free     = psc->psc_PerSlab;
+
+    obj = (APTR)AROS_ROUNDUP2((IPTR)(ps + 1), MEMCHUNK_TOTAL);
+    for (i = 0; i < psc->psc_PerSlab; i++)
+    {
+        *((APTR *)obj) = ps->ps_FreeList;
+        ps->ps_FreeList = obj;
+        obj += psc->psc_ObjSize;
+    }
+
+    ADDHEAD(&psc->psc_Slabs, &ps->ps_Node);
+    psc->psc_SlabCount++;
+    psc->psc_FreeCount += psc->psc_PerSlab;
+
+    return ps;
+}
+
+/* Allocate a small block from a slab, O(1) unless a new slab is needed */
+static APTR AllocPoolSlab(APTR poolHeader, struct ProtectedPool *pool, struct PoolSlabClass *psc,
+                          ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct PoolSlab *ps;
+    APTR ret = NULL;
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+    {
+        ObtainSemaphore(&pool->sem);
+    }
+
+    ps = (struct PoolSlab *)GetHead((struct List *)&psc->psc_Slabs);
+    if (ps == NULL)
+        ps = CreatePoolSlab(poolHeader, pool, psc, flags, loc, SysBase);
+
+    if (ps)
+    {
+        ret = ps->ps_FreeList;
+        ps->ps_FreeList = *((APTR *)ret);
+        psc->psc_FreeCount--;
+
+        /* Full slabs are not kept in any list, FreePooled() will find them */
+        if (--ps->ps_Free == 0)
+            REMOVE(&ps->ps_Node);
+    }
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+    {
+        ReleaseSemaphore(&pool->sem);
+    }
+
+    if (ret)
+    {
+        *((IPTR *)ret) = (IPTR)ps | POOLSLAB_TAG;
+        ret += ALLOCPOOLED_USER_OFFSET;
+
+        if (flags & MEMF_CLEAR)
+            memset(ret, 0, psc->psc_ObjSize - ALLOCPOOLED_USER_OFFSET);
+    }
+
+    return ret;
+}
+
+static void FreePoolSlab(APTR poolHeader, struct PoolSlab *ps, APTR memory, IPTR memSize,
+                         struct TraceLocation *loc, struct ExecBase *SysBase)
+{
+    struct ProtectedPool *pool = ps->ps_Pool;
+    struct PoolSlabClass *psc = ps->ps_Class;
+    APTR poolHeaderMH = (APTR)((IPTR)pool - MEMHEADER_TOTAL);
+    APTR obj = memory - ALLOCPOOLED_USER_OFFSET;
+
+    if (pool->pool.PoolMagic != POOL_MAGIC)
+    {
+        PoolManagerAlert(PME_FREE_INV_POOL, AT_DeadEnd, memSize, memory, poolHeaderMH, NULL);
+    }
+
+    if (poolHeaderMH != poolHeader)
+    {
+        PoolManagerAlert(PME_FREE_MXD_POOL, 0, memSize, memory, poolHeaderMH, poolHeader);
+    }
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+    {
+        ObtainSemaphore(&pool->sem);
+    }
+
+    *((APTR *)obj) = ps->ps_FreeList;
+    ps->ps_FreeList = obj;
+    psc->psc_FreeCount++;
+
+    if (ps->ps_Free++ == 0)
+        ADDHEAD(&psc->psc_Slabs, &ps->ps_Node);
+
+    /*
+     * Give an empty slab back to the puddles, unless it is the only one
+     * with free objects. Keeping one avoids creating and destroying a slab
+     * over and over again when a single block is allocated and freed.
+     */
+    if ((ps->ps_Free == psc->psc_PerSlab) && (psc->psc_FreeCount > psc->psc_PerSlab))
+    {
+        D(bug("[FreePooled] Slab 0x%p is empty, giving back to the puddles\n", ps));
+
+        REMOVE(&ps->ps_Node);
+        psc->psc_SlabCount--;
+        psc->psc_FreeCount -= psc->psc_PerSlab;
+        InternalFreePooled(poolHeader, ps, POOLSLAB_SIZE, loc, SysBase);
+    }
+
+    if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
+    {
+        ReleaseSemaphore(&pool->sem);
+    }
+}
+
 /*
  * Allocate memory with given physical properties from the given pool.
  * Our pools can be mixed. This means that different puddles from the
@@ -946,6 +1113,21 @@ APTR InternalAllocPooled(APTR poolHeader, IPTR memSize, ULONG flags, struct Trac
         PoolManagerAlert(PME_ALLOC_INV_POOL, AT_DeadEnd, memSize, NULL, NULL, poolHeader);
     }
 
+    /*
+     * Small blocks from MEMF_SLAB pools come from the slabs, as long as the
+     * memory type is the pool's own. MungWall needs real chunks with walls
+     * around them, so the slabs are not used with it. origSize already
+     * includes the back pointer, the slab classes are sized without it.
+     */
+    if (pool->pool.SlabClasses && (origSize <= POOLSLAB_MAXSIZE + ALLOCPOOLED_USER_OFFSET) &&
+        !(PrivExecBase(SysBase)->IntFlags & EXECF_MungWall) &&
+        ((flags & MEMF_PHYSICAL_MASK) == (pool->pool.Requirements & MEMF_PHYSICAL_MASK)))
+    {
+        struct PoolSlabClass *psc = FindPoolSlabClass(&pool->pool, origSize - ALLOCPOOLED_USER_OFFSET);
+
+        return AllocPoolSlab(poolHeader, pool, psc, flags, loc, SysBase);
+    }
+
     if (pool->pool.Requirements & MEMF_SEM_PROTECTED)
     {
         ObtainSemaphore(&pool->sem);
@@ -1092,6 +1274,13 @@ void InternalFreePooled(APTR poolHeader, APTR memory, IPTR memSize, struct Trace
     freeSize = memSize + ALLOCPOOLED_USER_OFFSET;
     mh = *((struct MemHeader **)freeStart);
 
+    /* Blocks from a slab point back to it with a tag bit set */
+    if ((IPTR)mh & POOLSLAB_TAG)
+    {
+        FreePoolSlab(poolHeader, (struct PoolSlab *)((IPTR)mh & ~POOLSLAB_TAG), memory, memSize, loc, SysBase);
+        return;
+    }
+
     /* Check walls first */
     freeStart = MungWall_Check(freeStart, freeSize, loc, SysBase);
     if (PrivExecBase(SysBase)->IntFlags & EXECF_MungWall)
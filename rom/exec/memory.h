@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc:
 */
@@ -38,6 +38,42 @@
 #define ALLOCPOOLED_USER_OFFSET sizeof(struct MemHeader *)
 #endif /* AMIGA */
 
+/*
+ * Pools created with MEMF_SLAB serve small allocations from slabs. A slab is
+ * one ordinary pool allocation of POOLSLAB_SIZE bytes, cut into equally sized
+ * objects of one size class. Every object starts with the usual back pointer,
+ * which points to the slab with POOLSLAB_TAG set, so that FreePooled() can
+ * tell it from a MemHeader. While an object is free the back pointer links it
+ * into the slab's free list instead.
+ *
+ * POOLSLAB_MAXSIZE and the class sizes are sizes as passed to AllocPooled(),
+ * without the back pointer. A request is served from a slab only if that
+ * size, with any header the caller puts in front of its data already added,
+ * is at most POOLSLAB_MAXSIZE; it then gets the smallest class it fits in.
+ */
+#define POOLSLAB_CLASSES        8
+#define POOLSLAB_MAXSIZE        256     /* Largest AllocPooled() size served from slabs */
+#define POOLSLAB_SIZE           2048
+#define POOLSLAB_TAG            1
+
+struct PoolSlabClass
+{
+    struct MinList  psc_Slabs;          /* Slabs with free objects               */
+    ULONG           psc_ObjSize;        /* Object size, including back pointer   */
+    ULONG           psc_PerSlab;        /* Number of objects in one slab         */
+    ULONG           psc_SlabCount;      /* Number of slabs of this class         */
+    ULONG           psc_FreeCount;      /* Number of free objects in all slabs   */
+};
+
+struct PoolSlab
+{
+    struct MinNode          ps_Node;
+    struct PoolSlabClass    *ps_Class;
+    struct ProtectedPool    *ps_Pool;
+    APTR                    ps_FreeList;
+    ULONG                   ps_Free;
+};
+
 /* Private Pool structure */
 struct Pool 
 {
@@ -45,6 +81,7 @@ struct Pool
     ULONG Requirements;
     ULONG PuddleSize;
     ULONG PoolMagic;
+    struct PoolSlabClass *SlabClasses;  /* NULL unless an unmanaged MEMF_SLAB pool */
 };
 
 struct ProtectedPool
@@ -87,6 +124,7 @@ void FreeMemHeader(APTR addr, struct TraceLocation *loc, struct ExecBase *SysBas
 
 APTR InternalAllocPooled(APTR poolHeader, IPTR memSize, ULONG flags, struct TraceLocation *loc, struct ExecBase *SysBase);
 void InternalFreePooled(APTR poolHeader, APTR memory, IPTR memSize, struct TraceLocation *loc, struct ExecBase *SysBase);
+void InitPoolSlabs(struct PoolSlabClass *classes);
 
 ULONG checkMemHandlers(struct checkMemHandlersState *cmhs, struct ExecBase *SysBase);
 
@@ -17,6 +17,8 @@
 #include "exec_util.h"
 #include "exec_debug.h"
 
+#include <kernel_readyqueue.h>
+
 #if defined(__AROSEXEC_SMP__)
 #define __KERNEL_NOLIBBASE__
 #include <proto/kernel.h>
@@ -33,7 +35,7 @@ static void TaskLaunch(struct Task *parent, struct Task *task, struct Hook *plHo
     /* Add the new task to the ready list. */
 #if !defined(__AROSEXEC_SMP__)
     task->tc_State = TS_READY;
-    Enqueue(&SysBase->TaskReady, &task->tc_Node);
+    READYQUEUE_ENQUEUE(task);
 #else
     task->tc_State = TS_INVALID;
     krnSysCallReschedTask(task, TS_READY);
@@ -15,6 +15,8 @@
 #include "exec_util.h"
 #include "exec_debug.h"
 
+#include <kernel_readyqueue.h>
+
 /*****************************************************************************
 
     NAME */
@@ -95,8 +97,13 @@
              * the MemEntry list might contain the task struct itself!
             */
 #if !defined(EXEC_REMTASK_NEEDSSWITCH)
+            Disable();
+            if (task->tc_State == TS_READY)
+                READYQUEUE_REMOVE(task);
+            else
+                Remove(&task->tc_Node);
             task->tc_State = TS_REMOVED;
-            Remove(&task->tc_Node);
+            Enable();
 #else
             krnSysCallReschedTask(task, TS_REMOVED);
 #endif
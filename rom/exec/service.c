@@ -14,6 +14,8 @@
 #include "exec_util.h"
 #include "exec_debug.h"
 
+#include <kernel_readyqueue.h>
+
 void ServiceTask(struct ExecBase *SysBase)
 {
 #if defined(__AROSEXEC_SMP__)
@@ -100,8 +102,10 @@ void ServiceTask(struct ExecBase *SysBase)
                      * Mark the task as ready to run again. Move it back to TaskReady list.
                      */
 #if !defined(EXEC_REMTASK_NEEDSSWITCH)
+                    Disable();
                     task->tc_State = TS_READY;
-                    Enqueue(&SysBase->TaskReady, &task->tc_Node);
+                    READYQUEUE_ENQUEUE(task);
+                    Enable();
 #else
                     krnSysCallReschedTask(task, TS_READY);
 #endif
@@ -17,6 +17,8 @@
 #include "exec_locks.h"
 #endif
 
+#include <kernel_readyqueue.h>
+
 /*****************************************************************************
 
     NAME */
@@ -93,19 +95,24 @@
     /* Get returncode */
     old = task->tc_Node.ln_Pri;
 
-    /* Set new value. */
-    task->tc_Node.ln_Pri = priority;
+    /*
+        Set new value. If the task is in the ready list remove and reinsert it,
+        it must be removed before the priority changes, since the ready list
+        index is kept by priority.
+    */
+    if (task->tc_State == TS_READY)
+    {
+        READYQUEUE_REMOVE(task);
+        task->tc_Node.ln_Pri = priority;
+        READYQUEUE_ENQUEUE(task);
+        READYQUEUE_REPRIORITISE(task);
+    }
+    else
+        task->tc_Node.ln_Pri = priority;
 
     /* Check if the task is willing to run. */
     if (task->tc_State != TS_WAIT)
     {
-        /* If it is in the ready list remove and reinsert it. */
-        if (task->tc_State == TS_READY)
-        {
-            Remove(&task->tc_Node);
-            Enqueue(&SysBase->TaskReady, &task->tc_Node);
-        }
-
 #if defined(__AROSEXEC_SMP__)
         EXEC_UNLOCK(task_listlock);
 
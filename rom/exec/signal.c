@@ -14,6 +14,8 @@
 #define __AROS_KERNEL__
 #include "exec_intern.h"
 
+#include <kernel_readyqueue.h>
+
 #if defined(__AROSEXEC_SMP__)
 #include <utility/hooks.h>
 
@@ -228,7 +230,7 @@ AROS_UFH3(IPTR, signal_hook,
 #else
                 Remove(&task->tc_Node);
                 task->tc_State = TS_READY;
-                Enqueue(&SysBase->TaskReady, &task->tc_Node);
+                READYQUEUE_ENQUEUE(task);
 #endif
             }
 
@@ -24,19 +24,73 @@ extern void setchecksum(struct CacheBuffer *);
 
 /* Internal globals */
 
+#define CBHASHCHAIN(blckno) (&globals->cbhashlist[(blckno) & globals->cbhashmask])
+
 LONG initcachebuffers(void) {
   WORD n=HASHSIZE;
 
   initlist((struct List *)&globals->cblrulist);
   while(n--!=0) {
-    initlist((struct List *)&globals->cbhashlist[n]);
+    initlist((struct List *)&globals->cbhashlist_min[n]);
   }
 
+  globals->cbhashlist=globals->cbhashlist_min;
+  globals->cbhashmask=HASHSIZE-1;
+
   return(0);
 }
 
 
 
+static void resizecbhash(LONG buffers) {
+  struct MinList *newhash=globals->cbhashlist_min;
+  struct CacheBuffer *cb;
+  ULONG size=HASHSIZE;
+
+  /* Sizes the hash table to have about two CacheBuffers per chain.  If
+     a larger table can't be allocated the old one is kept; it only
+     makes the chains longer. */
+
+  while(size<((ULONG)buffers>>1) && size<(1<<MAXHASHSHIFT)) {
+    size<<=1;
+  }
+
+  if(size==globals->cbhashmask+1) {
+    return;
+  }
+
+  if(size>HASHSIZE && (newhash=AllocVec(size * sizeof(struct MinList), MEMF_ANY))==0) {
+    return;
+  }
+
+  _DEBUG("resizecbhash: %ld chains for %ld buffers\n", size, buffers);
+
+  {
+    ULONG n=size;
+
+    while(n--!=0) {
+      initlist((struct List *)&newhash[n]);
+    }
+  }
+
+  if(globals->cbhashlist!=globals->cbhashlist_min) {
+    FreeVec(globals->cbhashlist);
+  }
+
+  globals->cbhashlist=newhash;
+  globals->cbhashmask=size-1;
+
+  /* All CacheBuffers are on the ring, so the hashed ones are relinked from there. */
+
+  for(cb=(struct CacheBuffer *)globals->cblrulist.mlh_Head; cb->node.mln_Succ!=0; cb=(struct CacheBuffer *)cb->node.mln_Succ) {
+    if(cb->hashnode.mln_Succ!=0 && cb->hashnode.mln_Pred!=0) {
+      addtailm(CBHASHCHAIN(cb->blckno),&cb->hashnode);
+    }
+  }
+}
+
+
+
 static void checkcb(struct CacheBuffer *cb,UBYTE *string) {
 //  if(cb->id!=0x4A48 || cb->data!=&cb->attached_data[0] || (cb->bits & (CB_ORIGINAL|CB_EMPTY))==(CB_ORIGINAL|CB_EMPTY) || (cb->bits & (CB_ORIGINAL|CB_LATEST))==(CB_ORIGINAL|CB_LATEST) || (cb->bits & (CB_ORIGINAL|CB_LATEST|CB_EMPTY))==CB_EMPTY) {
   if(cb->id!=0x4A48 || cb->data!=&cb->attached_data[0] || (cb->bits & (CB_ORIGINAL|CB_EMPTY))==(CB_ORIGINAL|CB_EMPTY) || (cb->bits & (CB_ORIGINAL|CB_LATEST|CB_EMPTY))==CB_EMPTY) {
@@ -55,7 +109,7 @@ static void checkcb(struct CacheBuffer *cb,UBYTE *string) {
 struct CacheBuffer *findoriginalcachebuffer(BLCK blckno) {
   struct CacheBuffer *cb;
 
-  cb=(struct CacheBuffer *)(globals->cbhashlist[blckno & (HASHSIZE-1)].mlh_Head-1);
+  cb=(struct CacheBuffer *)(CBHASHCHAIN(blckno)->mlh_Head-1);
 
   while(cb->hashnode.mln_Succ!=0) {
     if(cb->blckno==blckno && (cb->bits & CB_ORIGINAL)!=0) {
@@ -72,7 +126,7 @@ struct CacheBuffer *findoriginalcachebuffer(BLCK blckno) {
 struct CacheBuffer *findlatestcachebuffer(BLCK blckno) {
   struct CacheBuffer *cb;
 
-  cb=(struct CacheBuffer *)(globals->cbhashlist[blckno & (HASHSIZE-1)].mlh_Head-1);
+  cb=(struct CacheBuffer *)(CBHASHCHAIN(blckno)->mlh_Head-1);
 
   while(cb->hashnode.mln_Succ!=0) {
     if(cb->blckno==blckno && (cb->bits & CB_LATEST)!=0) {
@@ -86,13 +140,14 @@ struct CacheBuffer *findlatestcachebuffer(BLCK blckno) {
 
 
 
-static __inline void mrucachebuffer(struct CacheBuffer *cb) {
+static __inline void touchcachebuffer(struct CacheBuffer *cb) {
 
-  /* Moves the passed in CacheBuffer to the end of the LRU list.
-     This means it becomes the MRU CacheBuffer. */
+  /* Marks the passed in CacheBuffer as recently used.  Unlike moving it
+     to the end of an LRU list this doesn't touch any list at all; the
+     CLOCK hand in getcachebuffer() takes care of the rest. */
 
-  removem(&cb->node);
-  addtailm(&globals->cblrulist,&cb->node);
+  cb->referenced=TRUE;
+  cb->lastused=++globals->cbclock;
 }
 
 
@@ -115,7 +170,7 @@ LONG readcachebuffer(struct CacheBuffer **returned_cb, BLCK block) {
 
   checkcb(*returned_cb,"readcachebuffer");
 
-  mrucachebuffer(*returned_cb);
+  touchcachebuffer(*returned_cb);
 
   if(((*returned_cb)->bits & CB_LATEST)==0) {
     dreq("readcachebuffer didn't return the latest cachebuffer!\nPlease notify the author!");
@@ -140,7 +195,7 @@ LONG readoriginalcachebuffer(struct CacheBuffer **returned_cb,BLCK blckno) {
 
     _XDEBUG(DEBUG_CACHEBUFFER,"    readorgcb: block %ld (from cache)\n",blckno);
 
-    mrucachebuffer(cb);
+    touchcachebuffer(cb);
   }
   else if((cb=getcachebuffer())!=0) {
 
@@ -167,7 +222,9 @@ LONG readoriginalcachebuffer(struct CacheBuffer **returned_cb,BLCK blckno) {
       cb->bits|=CB_LATEST;
     }
 
-    addtailm(&globals->cbhashlist[blckno & (HASHSIZE-1)],&cb->hashnode);
+    touchcachebuffer(cb);
+
+    addtailm(CBHASHCHAIN(blckno),&cb->hashnode);
   }
   else {
     return(ERROR_NO_FREE_STORE);
@@ -214,6 +271,8 @@ void resetcachebuffer(struct CacheBuffer *cb) {
   cb->locked=0;
   cb->bits=0;
   cb->blckno=0;
+  cb->referenced=FALSE;
+  cb->lastused=globals->cbclock-MINSAFETYBLOCKS;
 }
 
 
@@ -224,7 +283,7 @@ void emptycachebuffer(struct CacheBuffer *cb) {
 
   resetcachebuffer(cb);
 
-  /* Add empty buffer to head of LRU chain.  This will not only increase
+  /* Add empty buffer to head of the ring.  This will not only increase
      performance when looking for a free buffer, but it will also ensure
      that EMPTY buffers are reused first, while otherwise a potentially
      useful buffer could be reused. */
@@ -289,7 +348,9 @@ struct CacheBuffer *createnewcachebuffer(BLCK block) {
   cb->blckno=block;
   cb->bits=CB_LATEST|CB_EMPTY;
 
-  addtailm(&globals->cbhashlist[block & (HASHSIZE-1)],&cb->hashnode);
+  touchcachebuffer(cb);
+
+  addtailm(CBHASHCHAIN(block),&cb->hashnode);
 
   return(cb);
 }
@@ -405,7 +466,7 @@ struct CacheBuffer *saveoriginalcachebuffer(struct CacheBuffer *cb) {
 
   CopyMemQuick(cb->data, cb_new->data, globals->bytes_block);
 
-  addtailm(&globals->cbhashlist[cb_new->blckno & (HASHSIZE-1)],&cb_new->hashnode);
+  addtailm(CBHASHCHAIN(cb_new->blckno),&cb_new->hashnode);
 
   return(cb_new);
 }
@@ -635,15 +696,21 @@ void killunlockedcachebuffers(void) {
 
 struct CacheBuffer *getcachebuffer() {
   struct CacheBuffer *cb;
-  LONG buffers=globals->totalbuffers;
+  LONG buffers=globals->totalbuffers*2;
+
+  /* getcachebuffer uses the CLOCK algorithm to pick a cachebuffer
+     which isn't currently used in an operation.  The hand sweeps the
+     ring and gives every cachebuffer which was used since it last
+     passed a second chance, which keeps the often used blocks in the
+     cache about as well as LRU, without having to move a cachebuffer
+     on every access.
 
-  /* It's absolutely essential that getcachebuffer always uses the
-     LEAST recently used cachebuffer which isn't currently used in
-     an operation.  The reason for this is not only because this is
-     a good algorithm to ensure the cache contains blocks which are
-     the most often used, but also because a lot of functions -rely-
+     It's absolutely essential though that a cachebuffer which has been
+     used very recently is never returned.  A lot of functions -rely-
      on the fact that a buffer which has been used (read!) recently
-     remains in the cache for a while longer(!).
+     remains in the cache for a while longer(!).  Therefore the last
+     MINSAFETYBLOCKS cachebuffers used are always skipped, regardless
+     of where the hand is.
 
      Because this process of 'relying' on a recently read buffer to
      still be in cache is a bit tricky business, we recently added
@@ -665,26 +732,41 @@ struct CacheBuffer *getcachebuffer() {
 
 //  killunlockedcachebuffers();
 
-  do {
-//    cb=(struct CacheBuffer *)globals->cblrulist.mlh_Head;
-//    mrucachebuffer(cb);
+  /* Two sweeps are enough: the first one clears all referenced bits. */
+
+  for(;;) {
+    if(buffers--<=0) {
+      _XDEBUG(DEBUG_CACHEBUFFER,"getcachebuffer: No more cachebuffers available!\n");
+      dumpcachebuffers();
+
+      req_unusual("SFS has ran out of cache buffers.");
+
+      return(0);
+    }
 
     /* weissms: changed to trick gcc-4.4.4 optimizer */
     cb=(struct CacheBuffer *)RemHead((struct List*)&globals->cblrulist);
     addtailm(&globals->cblrulist,&cb->node);
 
-  } while((cb->locked>0 || ((cb->bits & (CB_ORIGINAL|CB_LATEST))==CB_ORIGINAL && findlatestcachebuffer(cb->blckno)!=0)) && buffers-->0);
+    if(cb->locked>0 || ((cb->bits & (CB_ORIGINAL|CB_LATEST))==CB_ORIGINAL && findlatestcachebuffer(cb->blckno)!=0)) {
+      continue;
+    }
 
-  if(buffers<=0) {
-    _XDEBUG(DEBUG_CACHEBUFFER,"getcachebuffer: No more cachebuffers available!\n");
-    dumpcachebuffers();
+    if(cb->referenced!=FALSE) {
+      cb->referenced=FALSE;
+      continue;
+    }
 
-    req_unusual("SFS has ran out of cache buffers.");
+    if(globals->cbclock - cb->lastused >= MINSAFETYBLOCKS) {
+      break;
+    }
+  }
 
-    return(0);
+  if(cb->bits!=0) {
+    globals->statistics.cache_evictions++;
   }
 
-  resetcachebuffer(cb);  /* emptycachebuffer also adds cachebuffer at top of LRU list... we don't want that. */
+  resetcachebuffer(cb);  /* emptycachebuffer also adds cachebuffer at the hand of the ring... we don't want that. */
 
   return(cb);
 }
@@ -790,6 +872,7 @@ LONG addcachebuffers(LONG buffers) {
 
       cb->data=&cb->attached_data[0];
       cb->id=0x4A48;
+      cb->lastused=globals->cbclock-MINSAFETYBLOCKS;
     }
     _DEBUG(" end\n");
 
@@ -813,6 +896,8 @@ LONG addcachebuffers(LONG buffers) {
 
   globals->totalbuffers=newbuffers;
 
+  resizecbhash(newbuffers);
+
   return(errorcode);
 }
 
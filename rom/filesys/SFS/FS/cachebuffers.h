@@ -21,6 +21,10 @@ struct CacheBuffer {
 
   ULONG blckno;                      // Partition Blocknumber, or zero if this block isn't in use
 
+  ULONG lastused;                    // globals->cbclock at the last access
+  UBYTE referenced;                  // Set on each access, cleared when the CLOCK hand passes
+  UBYTE pad[3];
+
   void *data;                        /* Make sure this is LONGWORD aligned! */
 
   UBYTE attached_data[0];
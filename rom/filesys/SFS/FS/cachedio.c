@@ -19,16 +19,20 @@
 #include "globals.h"
 
 static LONG copybackiocache(struct IOCache *ioc);
+static BOOL startcopyback(struct IOCache *ioc);
+static LONG waitiocaches(void);
+void reuseiocache(struct IOCache *ioc);
 
 /* Internal structures */
 
 struct IOCache {
-  struct MinNode node;   /* LRU chain */
+  struct MinNode node;   /* CLOCK ring */
 
   struct IOCache *nexthash;
   struct IOCache *prevhash;
 
   void *data;
+  struct fsIORequest *fsi;  /* Set while the IOCache is read or written asynchronously */
 
   ULONG block;           /* Unused IOCache has blocks = 0 */
   ULONG blocks;
@@ -38,7 +42,10 @@ struct IOCache {
 
   UBYTE bits;            /* See defines below */
   UBYTE locked;          /* Indicates that lruiocache should not return this iocache */
-  UWORD pad3;
+  UBYTE referenced;      /* Set on each access, cleared when the CLOCK hand passes */
+  UBYTE pad3;
+
+  ULONG lastused;        /* globals->ioc_clock at the last access */
 
   /* Possible combinations for dirty and valid:
 
@@ -53,6 +60,17 @@ struct IOCache {
 
 #define IOC_DIRTY  (1)   /* IOCache contains dirty data */
 
+/* The number of most recently used IOCaches lruiocache never returns */
+
+#define IOC_SAFETYLINES (2)
+
+/* The number of IOCache transfers which may be in progress at the same time */
+
+#define IOC_MAXASYNC     (16)
+#define IOC_DEFAULTASYNC (4)
+
+#define IOCHASHCHAIN(block) (globals->ioc_hashtable[((block)>>globals->iocache_shift) & globals->ioc_hashmask])
+
 /*
 
 Functions making use of the IOCache mechanism:
@@ -80,19 +98,28 @@ mode the cache operates in.  WriteThrough caching means the
 buffers are just updated and kept in memory.  Otherwise a
 buffer is simply marked invalid.
 
+IOCaches can also be transferred asynchronously, with up to
+iocache_async requests in progress at the same time.  When
+sequential reads are detected the lines following them are
+read ahead, and dirty lines the CLOCK hand wants to reuse are
+written behind, while the filesystem goes on with other
+packets.  An IOCache with a transfer in progress has its fsi
+set; findiocache() waits for the transfer to complete before
+it returns such an IOCache, so nothing else has to care.  If
+a read-ahead failed, findiocache() acts as if it was never
+started.
+
 */
 
 
 
 void hashit(struct IOCache *ioc) {
-  WORD hashentry=(ioc->block>>globals->iocache_shift) & (IOC_HASHSIZE-1);
-
-  ioc->nexthash=globals->ioc_hashtable[hashentry];
+  ioc->nexthash=IOCHASHCHAIN(ioc->block);
   if(ioc->nexthash!=0) {
     ioc->nexthash->prevhash=ioc;
   }
   ioc->prevhash=0;
-  globals->ioc_hashtable[hashentry]=ioc;
+  IOCHASHCHAIN(ioc->block)=ioc;
 }
 
 
@@ -106,7 +133,7 @@ static void dehash(struct IOCache *ioc) {
       ioc->prevhash->nexthash=ioc->nexthash;
     }
     else {
-      globals->ioc_hashtable[ (ioc->block>>globals->iocache_shift) & (IOC_HASHSIZE-1)]=ioc->nexthash;    /* Aug 11 1998: changed '=0' to '=ioc->nexthash' !! */
+      IOCHASHCHAIN(ioc->block)=ioc->nexthash;    /* Aug 11 1998: changed '=0' to '=ioc->nexthash' !! */
     }
   }
 
@@ -179,6 +206,9 @@ struct MinList *allocate(ULONG size, LONG n) {
       ioc->nexthash=0;
       ioc->prevhash=0;
       ioc->locked=0;
+      ioc->fsi=0;
+      ioc->referenced=FALSE;
+      ioc->lastused=globals->ioc_clock-IOC_SAFETYLINES;
       invalidateiocache(ioc);
 
       /* ioc->data is aligned to 16 byte boundaries. */
@@ -217,9 +247,65 @@ BYTE queryiocache_copyback(void) {
 
 
 
+ULONG queryiocache_async(void) {
+  return(globals->iocache_async);
+}
+
+
+
+static void freeiorequests(void) {
+  struct fsIORequest *fsi;
+
+  while((fsi=globals->ioc_requests)!=0) {
+    globals->ioc_requests=fsi->next;
+    deleteiorequest(fsi);
+  }
+}
+
+
+
+LONG setiocacheasync(ULONG requests) {
+  LONG errorcode;
+  ULONG n;
+
+  /* Changes the number of IOCache transfers which may be in progress at
+     the same time.  Zero makes all IOCache transfers synchronous. */
+
+  if(requests>IOC_MAXASYNC) {
+    requests=IOC_MAXASYNC;
+  }
+
+  if(globals->iocache_lruhead!=0 && (errorcode=waitiocaches())!=0) {
+    return(errorcode);
+  }
+
+  freeiorequests();
+  globals->iocache_async=0;
+  globals->ioc_readaheadlines=0;
+
+  for(n=0; n<requests; n++) {
+    struct fsIORequest *fsi;
+
+    if((fsi=createiorequest())==0) {
+      break;        /* Fewer transfers will be in progress, that's all */
+    }
+
+    fsi->next=globals->ioc_requests;
+    globals->ioc_requests=fsi;
+  }
+
+  globals->iocache_async=n;
+
+  return(0);
+}
+
+
+
 LONG setiocache(ULONG lines, ULONG readahead, BYTE copyback) {
   struct MinList *lruhead;
+  struct IOCache **hashtable;
   ULONG sizeinblocks=readahead>>globals->shifts_block;
+  ULONG hashsize;
   WORD shift;
 
   /* This function changes the size and type of the IOCache.  The
@@ -260,12 +346,22 @@ LONG setiocache(ULONG lines, ULONG readahead, BYTE copyback) {
     lines=1024;
   }
 
+  /* The hashtable gets roughly one chain per line, so lookups stay
+     short for large caches as well. */
+
+  hashsize=IOC_HASHSIZE;
+  while(hashsize<lines) {
+    hashsize<<=1;
+  }
+
+  if((hashtable=AllocVec(hashsize * sizeof(struct IOCache *), MEMF_CLEAR))==0) {
+    return(ERROR_NO_FREE_STORE);
+  }
+
   if((lruhead=allocate(sizeinblocks<<globals->shifts_block, lines))!=0) {
     LONG errorcode=0;
 
     if(globals->iocache_lruhead==0 || (errorcode=flushiocache())==0) {
-      WORD m=IOC_HASHSIZE;
-
       globals->iocache_sizeinblocks=sizeinblocks;
       globals->iocache_lines=lines;
       globals->iocache_copyback=copyback;
@@ -278,22 +374,25 @@ LONG setiocache(ULONG lines, ULONG readahead, BYTE copyback) {
       freeIOCache(globals->iocache_lruhead);
       globals->iocache_lruhead=lruhead;
 
+      FreeVec(globals->ioc_hashtable);
+      globals->ioc_hashtable=hashtable;
+      globals->ioc_hashmask=hashsize-1;
+
       if(globals->iocache_readonwrite==FALSE && globals->iocache_copyback!=FALSE) {
         globals->ioc_buffer=(struct IOCache *)globals->iocache_lruhead->mlh_Head;
         globals->ioc_buffer->locked=TRUE;
       }
-
-      while(--m>=0) {
-        globals->ioc_hashtable[m]=0;
-      }
     }
     else {
       freeIOCache(lruhead);
+      FreeVec(hashtable);
     }
 
     return(errorcode);
   }
 
+  FreeVec(hashtable);
+
   return(ERROR_NO_FREE_STORE);
 }
 
@@ -311,6 +410,7 @@ LONG initcachedio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de
     /* Note: There MUST be atleast 4 IOCache_lines for cachedio to work correctly at the moment!! */
 
     if((setiocache(8, 8192, TRUE))==0) {
+      setiocacheasync(IOC_DEFAULTASYNC);   /* Without requests all transfers are simply synchronous */
       return(0);
     }
   }
@@ -328,6 +428,12 @@ void cleanupcachedio(void) {
   freeIOCache(globals->iocache_lruhead);
   globals->iocache_lruhead=0;
 
+  FreeVec(globals->ioc_hashtable);
+  globals->ioc_hashtable=0;
+
+  freeiorequests();
+  globals->iocache_async=0;
+
   globals->iocache_lines=0;
 
   cleanupdeviceio();
@@ -335,12 +441,11 @@ void cleanupcachedio(void) {
 
 
 
-struct IOCache *findiocache(BLCK block) {
-  struct IOCache *ioc=globals->ioc_hashtable[ (block>>globals->iocache_shift) & (IOC_HASHSIZE-1) ];
+static struct IOCache *hashediocache(BLCK block) {
+  struct IOCache *ioc=IOCHASHCHAIN(block);
 
-  /* For internal use only.  This function will find the IOCache, if available.
-     It won't move the block to the end of the LRU chain though -- use locateiocache
-     instead. */
+  /* Like findiocache, but also returns IOCaches which are still being
+     transferred. */
 
   while(ioc!=0) {
     if(block>=ioc->block && block<ioc->block+ioc->blocks) {
@@ -355,12 +460,113 @@ struct IOCache *findiocache(BLCK block) {
 
 
 
+static LONG completeiocache(struct IOCache *ioc) {
+  struct fsIORequest *fsi=ioc->fsi;
+  LONG errorcode;
+
+  /* Waits for the asynchronous transfer of the passed in IOCache to
+     complete, and returns its request to the free list.  A failed
+     read-ahead drops the line again.  A failed write-behind leaves
+     the line dirty, so it will be written again later on.  Either
+     way the error is returned, for the callers which care. */
+
+  if(fsi==0) {
+    return(0);
+  }
+
+  errorcode=endtransfer(fsi, fsi->action==DIO_WRITE);
+
+  ioc->fsi=0;
+  fsi->next=globals->ioc_requests;
+  globals->ioc_requests=fsi;
+
+  if(fsi->action==DIO_READ) {
+    if(errorcode==0) {
+      ioc->valid[0]=0xFFFFFFFF;
+      ioc->valid[1]=0xFFFFFFFF;
+      ioc->valid[2]=0xFFFFFFFF;
+      ioc->valid[3]=0xFFFFFFFF;
+    }
+    else {
+      invalidateiocache(ioc);
+      reuseiocache(ioc);
+    }
+  }
+  else if(errorcode==0) {
+    ioc->bits&=~IOC_DIRTY;
+    ioc->dirty[0]=0;
+    ioc->dirty[1]=0;
+    ioc->dirty[2]=0;
+    ioc->dirty[3]=0;
+  }
+
+  return(errorcode);
+}
+
+
+
+static LONG waitiocaches(void) {
+  struct IOCache *ioc;
+  struct IOCache *next;
+  LONG firsterrorcode=0;
+  LONG errorcode;
+
+  /* Waits for all asynchronous IOCache transfers to complete.  Only
+     failed writes are reported; a failed read-ahead was never asked
+     for by anyone. */
+
+  for(ioc=(struct IOCache *)globals->iocache_lruhead->mlh_Head; ioc->node.mln_Succ!=0; ioc=next) {
+    BOOL writing=ioc->fsi!=0 && ioc->fsi->action==DIO_WRITE;
+
+    next=(struct IOCache *)(ioc->node.mln_Succ);
+
+    if((errorcode=completeiocache(ioc))!=0 && writing!=FALSE && firsterrorcode==0) {
+      firsterrorcode=errorcode;
+    }
+  }
+
+  return(firsterrorcode);
+}
+
+
+
+struct IOCache *findiocache(BLCK block) {
+  struct IOCache *ioc;
+
+  /* For internal use only.  This function will find the IOCache, if available.
+     It won't mark the IOCache as used though -- use locateiocache instead.
+
+     Read-aheads are completed without retries or requesters, as nobody
+     asked for them.  If one failed its IOCache has been dropped again, and
+     no IOCache is returned, so the caller reads the blocks itself with the
+     full error handling.  A failed write-behind leaves the IOCache dirty,
+     for lruiocache and flushiocache to deal with. */
+
+  if((ioc=hashediocache(block))!=0 && ioc->fsi!=0) {
+    completeiocache(ioc);
+
+    if(ioc->blocks==0) {
+      return(0);
+    }
+  }
+
+  return(ioc);
+}
+
+
+
+static void touchiocache(struct IOCache *ioc) {
+  ioc->referenced=TRUE;
+  ioc->lastused=++globals->ioc_clock;
+}
+
+
+
 struct IOCache *locateiocache(BLCK block) {
   struct IOCache *ioc;
 
   if((ioc=findiocache(block))!=0) {
-    removem(&ioc->node);
-    addtailm(globals->iocache_lruhead, &ioc->node);
+    touchiocache(ioc);
   }
 
   return(ioc);
@@ -368,23 +574,76 @@ struct IOCache *locateiocache(BLCK block) {
 
 
 
-LONG lruiocache(struct IOCache **returned_ioc) {
+static LONG victimiocache(struct IOCache **returned_ioc, BOOL writeback) {
   struct IOCache *ioc;
   LONG errorcode;
+  LONG writeerror=0;
+  ULONG visited=0;
+  BOOL writing;
 
   /* Must be volatile to keep ioc variable value up to date regardless of
      compiler optimizations */
   volatile struct MinList *ioclist = globals->iocache_lruhead;
 
-  /* Returns the least recently used IOCache */
+  /* Returns an IOCache which wasn't used recently, using the CLOCK
+     algorithm: the hand sweeps the ring and gives every IOCache which
+     was used since it last passed a second chance.  The last
+     IOC_SAFETYLINES IOCaches used are never returned, because write()
+     relies on the first of its two lines staying in the cache.
+
+     Dirty IOCaches are only written behind during the first pass of
+     the hand.  On the second pass they are written back synchronously
+     below, so a write which keeps failing (a write protected or removed
+     disk) is returned as an error instead of being retried forever.
+
+     Without writeback only clean IOCaches are returned, so speculative
+     reads never have to wait for a write, or cause a requester. */
+
+  for(;;) {
+    if(visited++ >= globals->iocache_lines*2) {
+      return(writeerror!=0 ? writeerror : ERROR_NO_FREE_STORE);
+    }
 
-  do {
     ioc=(struct IOCache *) ioclist->mlh_Head;
 
     removem(&ioc->node);
     addtailm(globals->iocache_lruhead, &ioc->node);
 
-  } while(ioc->locked!=0);
+    if(ioc->locked!=0 || globals->ioc_clock - ioc->lastused < IOC_SAFETYLINES) {
+      continue;
+    }
+
+    if(ioc->referenced!=FALSE) {
+      ioc->referenced=FALSE;
+      continue;
+    }
+
+    /* A transfer which is still in progress was started long before
+       the hand came by, so this hardly ever has to wait. */
+
+    writing=ioc->fsi!=0 && ioc->fsi->action==DIO_WRITE;
+
+    if((errorcode=completeiocache(ioc))!=0 && writing!=FALSE) {
+      writeerror=errorcode;
+    }
+
+    if(visited<=globals->iocache_lines && (ioc->bits & IOC_DIRTY)!=0 && startcopyback(ioc)!=FALSE) {
+
+      /* The IOCache is being written behind; look for a clean one. */
+
+      continue;
+    }
+
+    if(writeback==FALSE && (ioc->bits & IOC_DIRTY)!=0) {
+      continue;
+    }
+
+    break;
+  }
+
+  if(ioc->blocks!=0) {
+    globals->statistics.cachedio_evictions++;
+  }
 
   if((errorcode=copybackiocache(ioc))!=0) {
     return(errorcode);
@@ -398,6 +657,12 @@ LONG lruiocache(struct IOCache **returned_ioc) {
 
 
 
+LONG lruiocache(struct IOCache **returned_ioc) {
+  return(victimiocache(returned_ioc, TRUE));
+}
+
+
+
 void reuseiocache(struct IOCache *ioc) {
 
   /* This function makes sure that the passed in IOCache is reused
@@ -405,6 +670,8 @@ void reuseiocache(struct IOCache *ioc) {
      and you're certain it won't be needed again.  In such a case you
      can call this function so this cache is the first to be reused. */
 
+  ioc->referenced=FALSE;
+
   removem(&ioc->node);
   addheadm(globals->iocache_lruhead, &ioc->node);
 }
@@ -530,24 +797,79 @@ static LONG copybackiocache(struct IOCache *ioc) {
 
 
 
+static BOOL startcopyback(struct IOCache *ioc) {
+  BOOL started=FALSE;
+  LONG dirtylow, dirtyhigh;
+
+  /* Like copybackiocache, but only starts the writes and returns
+     before they are completed.  The dirty IOCaches directly following
+     this one are started as well, so the device gets them as one
+     ascending run.  Returns FALSE if not even the passed in IOCache
+     could be started; copybackiocache should be used then. */
+
+  while(ioc!=0 && ioc->fsi==0 && ioc->blocks!=0 && (ioc->bits & IOC_DIRTY)!=0 && globals->ioc_requests!=0) {
+    struct fsIORequest *fsi;
+
+    if(started!=FALSE && ioc->referenced!=FALSE) {
+      break;        /* Don't hold up IOCaches which are in use */
+    }
+
+    if((dirtyhigh=bmflo(ioc->dirty, ioc->blocks-1))<0) {
+      break;
+    }
+
+    dirtylow=bmffo(ioc->dirty, 4, 0);
+
+    if(bmffz(ioc->valid, 4, dirtylow)<dirtyhigh) {
+      break;        /* Needs validateiocache, which is synchronous */
+    }
+
+    fsi=globals->ioc_requests;
+    globals->ioc_requests=fsi->next;
+    ioc->fsi=fsi;
+
+    starttransfer(fsi, DIO_WRITE, (UBYTE *)ioc->data + (dirtylow<<globals->shifts_block), ioc->block + dirtylow, dirtyhigh - dirtylow + 1);
+    started=TRUE;
+
+    ioc=hashediocache(ioc->block+ioc->blocks);
+  }
+
+  return(started);
+}
+
+
+
 LONG flushiocache(void) {
   struct IOCache *ioc;
   LONG errorcode=0;
 
   /* Writes all dirty data to disk, but keeps the cached data for
      later reads.  Use this to ensure data is comitted to disk
-     when doing critical operations. */
+     when doing critical operations.
+
+     As many writes as possible are kept in progress at the same
+     time.  When no request is free the writes in progress are waited
+     for and the IOCache is written the normal way. */
 
   ioc=(struct IOCache *)globals->iocache_lruhead->mlh_Head;
 
   while(ioc->node.mln_Succ!=0) {
-    if((errorcode=copybackiocache(ioc))!=0) {
-      break;
+    if(ioc->fsi==0 && (ioc->bits & IOC_DIRTY)!=0 && startcopyback(ioc)==FALSE) {
+      if((errorcode=waitiocaches())!=0 || (errorcode=copybackiocache(ioc))!=0) {
+        break;
+      }
     }
 
     ioc=(struct IOCache *)(ioc->node.mln_Succ);
   }
 
+  if(errorcode==0) {
+    errorcode=waitiocaches();
+  }
+  else {
+    waitiocaches();
+  }
+
   if(errorcode==0) {
     update();
   }
@@ -567,6 +889,8 @@ void invalidateiocaches(void) {
      ACTION_INHIBIT(TRUE)).  Before calling this function make
      sure all pending changes have been flushed using flushiocache() */
 
+  waitiocaches();
+
   ioc=(struct IOCache *)globals->iocache_lruhead->mlh_Head;
 
   while(ioc->node.mln_Succ!=0) {
@@ -601,11 +925,80 @@ void copyiocachetobuffer(struct IOCache *ioc, BLCK *block, UBYTE **buffer, ULONG
 */
 
 
+static void readahead(BLCK block) {
+  BLCK line=block & ~globals->iocache_mask;
+  ULONG maxlines=globals->iocache_lines>>2;
+  ULONG n;
+
+  /* Detects sequential reads, and keeps the lines following them
+     being read asynchronously.  Each further line read in sequence
+     doubles the number of lines read ahead, up to a quarter of the
+     cache or the number of requests.  Any other read stops it. */
+
+  if(maxlines>globals->iocache_async) {
+    maxlines=globals->iocache_async;
+  }
+
+  if(line==globals->ioc_nextline) {
+    n=globals->ioc_readaheadlines<<1;
+    globals->ioc_readaheadlines=n==0 ? 1 : (n>maxlines ? maxlines : n);
+  }
+  else if(line!=globals->ioc_nextline-globals->iocache_sizeinblocks) {
+    globals->ioc_readaheadlines=0;
+  }
+
+  globals->ioc_nextline=line+globals->iocache_sizeinblocks;
+
+  for(n=1; n<=globals->ioc_readaheadlines; n++) {
+    BLCK blockstart=line+n*globals->iocache_sizeinblocks;
+    ULONG blocklength=globals->iocache_sizeinblocks;
+    struct IOCache *ioc;
+    struct fsIORequest *fsi;
+
+    if(blockstart>=globals->blocks_total) {
+      break;
+    }
+
+    if(hashediocache(blockstart)!=0) {
+      continue;
+    }
+
+    if(globals->ioc_requests==0 || victimiocache(&ioc, FALSE)!=0) {
+      break;
+    }
+
+    if((fsi=globals->ioc_requests)==0) {      /* victimiocache may have used it to write behind */
+      reuseiocache(ioc);
+      break;
+    }
+
+    if(blockstart+blocklength>globals->blocks_total) {
+      blocklength=globals->blocks_total-blockstart;
+    }
+
+    globals->ioc_requests=fsi->next;
+    ioc->fsi=fsi;
+    ioc->block=blockstart;
+    ioc->blocks=blocklength;
+
+    hashit(ioc);
+
+    starttransfer(fsi, DIO_READ, ioc->data, blockstart, blocklength);
+  }
+}
+
+
+
 LONG readintocache(BLCK block, struct IOCache **returned_ioc) {
   struct IOCache *ioc;
   LONG errorcode=0;
 
-  if((ioc=locateiocache(block))==0) {
+  if((ioc=locateiocache(block))!=0) {
+    globals->statistics.cachedio_hits++;
+  }
+  else {
+    globals->statistics.cachedio_misses++;
+
     if((errorcode=lruiocache(&ioc))==0) {
       ULONG blockstart=block & ~globals->iocache_mask;
       ULONG blocklength=globals->iocache_sizeinblocks;
@@ -624,10 +1017,15 @@ LONG readintocache(BLCK block, struct IOCache **returned_ioc) {
         ioc->valid[3]=0xFFFFFFFF;
 
         hashit(ioc);
+        touchiocache(ioc);
       }
     }
   }
 
+  if(errorcode==0 && globals->iocache_async!=0) {
+    readahead(block);
+  }
+
   *returned_ioc=ioc;
 
   return(errorcode);
@@ -641,7 +1039,12 @@ LONG readonwriteintocache(BLCK block, struct IOCache **returned_ioc) {
 
   /* Only does a physical read if iocache_readonwrite is TRUE */
 
-  if((ioc=locateiocache(block))==0) {
+  if((ioc=locateiocache(block))!=0) {
+    globals->statistics.cachedio_hits++;
+  }
+  else {
+    globals->statistics.cachedio_misses++;
+
     if((errorcode=lruiocache(&ioc))==0) {
       ULONG blockstart=block & ~globals->iocache_mask;
       ULONG blocklength=globals->iocache_sizeinblocks;
@@ -662,6 +1065,7 @@ LONG readonwriteintocache(BLCK block, struct IOCache **returned_ioc) {
         }
 
         hashit(ioc);
+        touchiocache(ioc);
       }
     }
   }
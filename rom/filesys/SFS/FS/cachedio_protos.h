@@ -19,6 +19,9 @@ ULONG queryiocache_lines(void);
 ULONG queryiocache_readaheadsize(void);
 BYTE queryiocache_copyback(void);
 
+LONG setiocacheasync(ULONG requests);
+ULONG queryiocache_async(void);
+
 LONG flushiocache(void);
 void invalidateiocaches(void);
 
@@ -331,8 +331,7 @@ void changegeometry(struct DosEnvec *de)
     _DEBUG("Start offset 0x%llu, end offset 0x%llu\n", globals->byte_low, globals->byte_high);
 }
 
-#ifdef DEBUGCODE
-static struct fsIORequest *createiorequest(void)
+struct fsIORequest *createiorequest(void)
 {
     struct fsIORequest *fsi;
 
@@ -346,12 +345,18 @@ static struct fsIORequest *createiorequest(void)
         else
         {
             FreeMem(fsi, sizeof(struct fsIORequest));
+            fsi=0;
         }
     }
 
     return(fsi);
 }
-#endif
+
+void deleteiorequest(struct fsIORequest *fsi)
+{
+    DeleteIORequest((struct IORequest *)fsi->ioreq);
+    FreeMem(fsi, sizeof(struct fsIORequest));
+}
 
 LONG initdeviceio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de)
 {
@@ -715,6 +720,65 @@ LONG waittransfers(void)
     return(firsterrorcode);
 }
 
+void starttransfer(struct fsIORequest *fsi, UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength)
+{
+    /* Starts a transfer using the passed in request and returns before it
+       is completed.  Use endtransfer() to wait for it.  Transfers which
+       can't be done in a single request (because of MaxTransfer or Mask)
+       are done right away with transfer(), and endtransfer() just returns
+       their result. */
+
+    fsi->pending=FALSE;
+
+    if(blockoffset < globals->blocks_total && blockoffset+blocklength <= globals->blocks_total &&
+       blocklength <= globals->blocks_maxtransfer && ((IPTR)buffer & ~globals->mask_mask)==0) {
+
+        _TDEBUG("STARTTRANSFER: %ld, buf=0x%p, block=%ld, blocks=%ld\n", action, buffer, blockoffset, blocklength);
+
+        setiorequest(fsi, action, buffer, blockoffset, blocklength);
+
+        /* We're about to do a physical disk access.  (Re)set timeout. */
+
+        starttimeout();
+
+        SendIO((struct IORequest *)fsi->ioreq);
+        fsi->pending=TRUE;
+        fsi->errorcode=0;
+    }
+    else {
+        fsi->action=action;
+        fsi->errorcode=transfer(action, buffer, blockoffset, blocklength);
+    }
+}
+
+LONG endtransfer(struct fsIORequest *fsi, BOOL handleerrors)
+{
+    LONG errorcode;
+
+    /* Waits for a transfer started with starttransfer() to complete.  If
+       handleerrors is FALSE a failed transfer is not retried and no
+       requester is put up; this is meant for transfers which were only
+       done speculatively. */
+
+    if(fsi->pending!=FALSE) {
+        fsi->pending=FALSE;
+
+        if((errorcode=WaitIO((struct IORequest *)fsi->ioreq))!=0 && handleerrors!=FALSE) {
+            globals->retries=MAX_RETRIES;
+
+            while((errorcode=handleioerror(errorcode, fsi->action, fsi->ioreq))==0) {
+                if((errorcode=DoIO((struct IORequest *)fsi->ioreq))==0) {
+                    break;
+                }
+            }
+        }
+
+        fsi->errorcode=errorcode;
+    }
+
+    return(fsi->errorcode);
+}
+
 #if 0
 static LONG asynctransfer(UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength)
 {
@@ -58,6 +58,9 @@ struct fsIORequest {
   struct SCSICmd scsicmd;
   struct SCSI10Cmd scsi10cmd;
   UWORD action;
+  UBYTE pending;         /* Set while the request is in progress, see starttransfer() */
+  UBYTE pad;
+  LONG errorcode;
 };
 
 #endif // _DEVICEIO_H
@@ -5,6 +5,8 @@
 #include <exec/tasks.h>
 #include <dos/filehandler.h>
 
+struct fsIORequest;
+
 void update(void);
 void motoroff(void);
 
@@ -14,6 +16,11 @@ ULONG deviceapiused(void);
 
 LONG transfer(UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength);
 
+struct fsIORequest *createiorequest(void);
+void deleteiorequest(struct fsIORequest *fsi);
+void starttransfer(struct fsIORequest *fsi, UWORD action, UBYTE *buffer, ULONG blockoffset, ULONG blocklength);
+LONG endtransfer(struct fsIORequest *fsi, BOOL handleerrors);
+
 LONG initdeviceio(UBYTE *devicename, IPTR unit, ULONG flags, struct DosEnvec *de);
 void cleanupdeviceio(void);
 
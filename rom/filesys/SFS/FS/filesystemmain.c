@@ -841,6 +841,9 @@ void mainloop(void) {
                         case ASQ_CACHE_MODE:
                             tag->ti_Data = queryiocache_copyback();
                             break;
+                        case ASQ_CACHE_ASYNC:
+                            tag->ti_Data = queryiocache_async();
+                            break;
                         case ASQ_CACHE_BUFFERS:
                             tag->ti_Data = globals->totalbuffers;
                             break;
@@ -856,6 +859,18 @@ void mainloop(void) {
                         case ASQ_EMPTY_OPERATIONS_DECODED:
                             tag->ti_Data = globals->statistics.cache_emptyoperationdecode;
                             break;
+                        case ASQ_CACHE_EVICTIONS:
+                            tag->ti_Data = globals->statistics.cache_evictions;
+                            break;
+                        case ASQ_IOCACHE_HITS:
+                            tag->ti_Data = globals->statistics.cachedio_hits;
+                            break;
+                        case ASQ_IOCACHE_MISSES:
+                            tag->ti_Data = globals->statistics.cachedio_misses;
+                            break;
+                        case ASQ_IOCACHE_EVICTIONS:
+                            tag->ti_Data = globals->statistics.cachedio_evictions;
+                            break;
                         case ASQ_IS_CASESENSITIVE:
                             tag->ti_Data = globals->is_casesensitive;
                             break;
@@ -893,7 +908,8 @@ void mainloop(void) {
                     {
                         LONG errorcode;
 
-                        if((errorcode = setiocache(globals->packet->dp_Arg1, globals->packet->dp_Arg2, globals->packet->dp_Arg3 & 1)) != 0) {
+                        if((errorcode = setiocache(globals->packet->dp_Arg1, globals->packet->dp_Arg2, globals->packet->dp_Arg3 & SCF_COPYBACK)) != 0 ||
+                           ((globals->packet->dp_Arg3 & SCF_ASYNC) != 0 && (errorcode = setiocacheasync(globals->packet->dp_Arg4)) != 0)) {
                             returnpacket(DOSFALSE, errorcode);
                         } else {
                             returnpacket(DOSTRUE, 0);
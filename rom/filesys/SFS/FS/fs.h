@@ -84,8 +84,11 @@ struct fsStatistics {
   ULONG cache_emptyoperationdecode;
   ULONG cache_misses;
 
+  ULONG cache_evictions;
+
   ULONG cachedio_hits;
   ULONG cachedio_misses;
+  ULONG cachedio_evictions;
 };
 
 #endif // _FS_H
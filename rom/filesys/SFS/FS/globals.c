@@ -43,9 +43,12 @@ void initGlobals()
     globals->compressbuffer = 0;
     globals->transactionnestcount = 0;
     globals->iocache_lruhead = NULL;
+    globals->ioc_hashtable = NULL;
     globals->iocache_lines = 8;
     globals->iocache_copyback = TRUE;
     globals->iocache_readonwrite = FALSE;
+    globals->iocache_async = 0;
+    globals->ioc_requests = NULL;
     globals->templockedobjectnode = 0;
     globals->internalrename = FALSE;
     globals->defrag_maxfilestoscan = 512;
@@ -165,10 +165,14 @@ struct SFSBase
     #define MINSAFETYBLOCKS (16)
     #define MINCACHESIZE    (MINSAFETYBLOCKS*2)
     #define HASHSHIFT       (7)
-    #define HASHSIZE        (1<<HASHSHIFT)
+    #define HASHSIZE        (1<<HASHSHIFT)  /* the minimum number of CacheBuffer hash chains */
+    #define MAXHASHSHIFT    (16)
 
-    struct MinList cbhashlist[HASHSIZE];
-    struct MinList cblrulist;
+    struct MinList *cbhashlist;       /* cbhashlist_min, or a larger table for big caches */
+    ULONG cbhashmask;
+    ULONG cbclock;                    /* Counts CacheBuffer accesses, see getcachebuffer() */
+    struct MinList cbhashlist_min[HASHSIZE];
+    struct MinList cblrulist;         /* The CLOCK ring, with the hand at its head */
 
     void *transactionpool;
     ULONG transactionpoolsize;
@@ -179,10 +183,12 @@ struct SFSBase
     struct Operation operationsentinel;
 
     #define IOC_HASHSHIFT (6)
-    #define IOC_HASHSIZE (1<<IOC_HASHSHIFT)
+    #define IOC_HASHSIZE (1<<IOC_HASHSHIFT)  /* the minimum number of IOCache hash chains */
     
-    struct IOCache *ioc_hashtable[IOC_HASHSIZE];
-    struct MinList *iocache_lruhead;
+    struct IOCache **ioc_hashtable;
+    ULONG ioc_hashmask;
+    ULONG ioc_clock;                      /* Counts IOCache accesses, see lruiocache() */
+    struct MinList *iocache_lruhead;      /* The CLOCK ring, with the hand at its head */
     struct IOCache *ioc_buffer;           /* Used for reading data when another iocache has dirty data in it. */
     ULONG iocache_mask;
     ULONG iocache_sizeinblocks;
@@ -191,6 +197,10 @@ struct SFSBase
     BYTE iocache_copyback;
     // BYTE iocache_readonwrite=TRUE;       /* Determines whether a new line is read before writing to it. */
     BYTE iocache_readonwrite;       /* Determines whether a new line is read before writing to it. */
+    UBYTE iocache_async;                  /* Number of IOCache transfers which may be in progress, 0 disables them */
+    UBYTE ioc_readaheadlines;             /* Number of lines currently read ahead, see readahead() */
+    struct fsIORequest *ioc_requests;     /* Free requests for asynchronous IOCache transfers */
+    ULONG ioc_nextline;                   /* The line which continues a sequential read */
 
     struct EClockVal ecv;
     
@@ -17,6 +17,13 @@
 #define ACTION_SET_CACHE        (SFS_PACKET_BASE + 0xBDC0 + 1)
 #define ACTION_FORMAT_ARGS      (SFS_PACKET_BASE + 0xBDC0 + 2)
 
+/* Flags for arg3 of ACTION_SET_CACHE: */
+
+#define SCF_COPYBACK            (1)  /* Enables copyback mode. */
+#define SCF_ASYNC               (2)  /* arg4 holds the number of transfers which may be in
+                                        progress at the same time (0 makes them synchronous).
+                                        Without this flag this setting is left alone. */
+
 /* Above are 'old' packet types.  Below are the new types. */
 
 #define ACTION_SFS_QUERY             (SFS_PACKET_BASE + 1)
@@ -33,11 +33,18 @@
 #define ASQ_CACHE_READAHEADSIZE     (ASQBASE+3002)
 #define ASQ_CACHE_MODE              (ASQBASE+3003)
 #define ASQ_CACHE_BUFFERS           (ASQBASE+3004)
+#define ASQ_CACHE_ASYNC             (ASQBASE+3005)  /* Number of read-ahead cache transfers which
+                                                        may be in progress at the same time. */
 
 #define ASQ_CACHE_ACCESSES          (ASQBASE+3010)
 #define ASQ_CACHE_MISSES            (ASQBASE+3011)
 #define ASQ_OPERATIONS_DECODED      (ASQBASE+3012)
 #define ASQ_EMPTY_OPERATIONS_DECODED (ASQBASE+3013)
+#define ASQ_CACHE_EVICTIONS         (ASQBASE+3014)  /* Number of DOS buffers reused for another block */
+
+#define ASQ_IOCACHE_HITS            (ASQBASE+3015)  /* Read-ahead cache statistics */
+#define ASQ_IOCACHE_MISSES          (ASQBASE+3016)
+#define ASQ_IOCACHE_EVICTIONS       (ASQBASE+3017)
 
 /* Special properties */
 
@@ -64,6 +64,12 @@ LONG main() {
 
                 {ASQ_IS_CASESENSITIVE     , 0},
                 {ASQ_HAS_RECYCLED         , 0},
+
+                {ASQ_CACHE_EVICTIONS      , 0},
+                {ASQ_IOCACHE_HITS         , 0},
+                {ASQ_IOCACHE_MISSES       , 0},
+                {ASQ_IOCACHE_EVICTIONS    , 0},
+                {ASQ_CACHE_ASYNC          , 0},
                 {TAG_END                  , 0}
 	    };
 
@@ -99,15 +105,19 @@ LONG main() {
 
             printf("Bytes/block      : %-8ld   Total blocks : %ld\n", tags[7].ti_Data, tags[8].ti_Data);
             printf("Cache accesses   : %-8ld   Cache misses : %ld (%ld%%)\n", tags[0].ti_Data, tags[1].ti_Data, (long)perc);
+            printf("Cache evictions  : %ld\n", tags[20].ti_Data);
             printf("Read-ahead cache : %ldx %ld bytes ",tags[14].ti_Data, tags[15].ti_Data);
 
             if(tags[16].ti_Data!=0) {
-              printf("(Copyback)\n");
+              printf("(Copyback, ");
             }
             else {
-              printf("(Write-through)\n");
+              printf("(Write-through, ");
             }
 
+            printf("%ld async)\n", tags[24].ti_Data);
+
+            printf("Read-ahead hits  : %-8ld   Misses : %-8ld   Evictions : %ld\n", tags[21].ti_Data, tags[22].ti_Data, tags[23].ti_Data);
             printf("DOS buffers      : %-8ld\n", tags[17].ti_Data);
 
             printf("SFS settings     : ");
@@ -7,17 +7,18 @@
 #include "../FS/packets.h"
 #include "../FS/query.h"
 
-const char version[]="\0$VER: SetCache 1.2 (" ADATE ")\r\n";
+const char version[]="\0$VER: SetCache 1.3 (" ADATE ")\r\n";
 
 int main()
 {
     struct RDArgs *readarg;
-    UBYTE template[]="DEVICE/A,LINES/N,READAHEAD/N,NOCOPYBACK/S\n";
+    UBYTE template[]="DEVICE/A,LINES/N,READAHEAD/N,NOCOPYBACK/S,ASYNC/N\n";
 
     struct {char *name;
           ULONG *lines;
           ULONG *readahead;
-          IPTR nocopyback;} arglist={NULL};
+          IPTR nocopyback;
+          ULONG *async;} arglist={NULL};
 
     if((DOSBase=(struct DosLibrary *)OpenLibrary("dos.library",37))!=0) {
         if((readarg=ReadArgs(template,(IPTR *)&arglist,0))!=0) {
@@ -35,12 +36,13 @@ int main()
 
             dl=LockDosList(LDF_DEVICES|LDF_READ);
             if((dl=FindDosEntry(dl,arglist.name,LDF_DEVICES))!=0) {
-                ULONG copyback=1;
+                ULONG copyback=SCF_COPYBACK;
+                ULONG async=0;
                 LONG errorcode;
                 msgport=dl->dol_Task;
                 UnLockDosList(LDF_DEVICES|LDF_READ);
 
-                if(arglist.lines!=0 || arglist.readahead!=0 || arglist.nocopyback!=0) {
+                if(arglist.lines!=0 || arglist.readahead!=0 || arglist.nocopyback!=0 || arglist.async!=0) {
                     struct TagItem tags[]={
 		        {ASQ_CACHE_LINES        , 0},
                         {ASQ_CACHE_READAHEADSIZE, 0},
@@ -66,6 +68,11 @@ int main()
                             readahead=*arglist.readahead;
                         }
 
+                        if(arglist.async!=0) {
+                            copyback|=SCF_ASYNC;
+                            async=*arglist.async;
+                        }
+
                         Printf("Setting cache to %ld lines ", lines);
                         Printf("of %ld bytes and copyback mode ", readahead);
                         if(copyback!=0) {
@@ -75,7 +82,7 @@ int main()
                             PutStr("disabled.\n");
                         }
 
-                        if((errorcode=DoPkt(msgport,ACTION_SET_CACHE, lines, readahead, copyback, 0, 0))==DOSFALSE) {
+                        if((errorcode=DoPkt(msgport,ACTION_SET_CACHE, lines, readahead, copyback, async, 0))==DOSFALSE) {
                             PrintFault(IoErr(),"error while setting new cache size");
                         }
                     }
@@ -88,18 +95,25 @@ int main()
                     struct TagItem tags[]={
 			{ASQ_CACHE_LINES        , 0},
                         {ASQ_CACHE_READAHEADSIZE, 0},
-                        {ASQ_CACHE_MODE         , 0}
+                        {ASQ_CACHE_MODE         , 0},
+                        {ASQ_CACHE_ASYNC        , 0},
+                        {ASQ_IOCACHE_HITS       , 0},
+                        {ASQ_IOCACHE_MISSES     , 0},
+                        {ASQ_IOCACHE_EVICTIONS  , 0},
+                        {TAG_END                , 0}
 		    };
 
                     if((errorcode=DoPkt(msgport, ACTION_SFS_QUERY, (SIPTR)&tags, 0, 0, 0, 0))!=DOSFALSE) {
                         Printf("Current cache settings: %ld lines,", (ULONG)tags[0].ti_Data);
                         Printf(" %ld bytes readahead, ", (ULONG)tags[1].ti_Data);
                         if(tags[2].ti_Data==0) {
-                            PutStr("no copyback.\n");
+                            PutStr("no copyback, ");
                         }
                         else {
-                            PutStr("copyback.\n");
+                            PutStr("copyback, ");
                         }
+                        Printf("%ld asynchronous transfers.\n", (ULONG)tags[3].ti_Data);
+                        Printf("Cache statistics: %ld hits, %ld misses, %ld evictions.\n", (ULONG)tags[4].ti_Data, (ULONG)tags[5].ti_Data, (ULONG)tags[6].ti_Data);
                     }
                 }
             }
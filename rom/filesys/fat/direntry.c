@@ -252,40 +252,336 @@ LONG GetDirEntryByCluster(struct DirHandle *dh, ULONG cluster,
     return err;
 }
 
-LONG GetDirEntryByName(struct DirHandle *dh, STRPTR name, ULONG namelen,
-    struct DirEntry *de, struct Globals *glob)
+/*
+ * Directory name indexes. The first time a directory is searched by name,
+ * the short and long names of all its entries are hashed into a table,
+ * which then points straight at the entries that may match. The entries
+ * are always read and compared in full, so a hash collision can't give a
+ * wrong result. Indexes are kept for the most recently searched
+ * directories only, and are kept up to date by CreateDirEntry() and
+ * DeleteDirEntry().
+ */
+
+/* Case insensitive in the same way as strnicmp() */
+static ULONG HashName(const UBYTE *name, ULONG len)
+{
+    ULONG hash = 5381;
+    UBYTE c;
+
+    while (len-- > 0)
+    {
+        c = *name++;
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        hash = hash * 33 + c;
+    }
+
+    return hash;
+}
+
+/* Compare a name with both names of an entry */
+static BOOL MatchDirEntryName(struct DirEntry *de, STRPTR name, ULONG namelen,
+    struct Globals *glob)
+{
+    UBYTE buf[256];
+    ULONG buflen;
+
+    /* Compare with the short name first, since we already have it */
+    GetDirEntryShortName(de, buf, &buflen, glob);
+    if (namelen == buflen
+        && strnicmp((char *)name, (char *)buf, buflen) == 0)
+    {
+        D(bug("[fat] matched short name '%s' at entry %ld\n",
+            buf, de->index));
+        return TRUE;
+    }
+
+    /* No match, extract the long name and compare with that instead */
+    GetDirEntryLongName(de, buf, &buflen);
+    if (namelen == buflen
+        && strnicmp((char *)name, (char *)buf, buflen) == 0)
+    {
+        D(bug("[fat] matched long name '%s' at entry %ld\n",
+            buf, de->index));
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+static struct DirCache *FindDirCache(struct FSSuper *sb, ULONG cluster)
+{
+    struct DirCache *dc;
+
+    ForeachNode(&sb->dir_caches, dc)
+    {
+        if (dc->cluster == cluster)
+            return dc;
+    }
+
+    return NULL;
+}
+
+static void FreeDirCache(struct FSSuper *sb, struct DirCache *dc)
+{
+    struct Globals *glob = sb->glob;
+    struct DirCacheEntry *dce, *next;
+    ULONG i;
+
+    for (i = 0; i <= dc->mask; i++)
+    {
+        for (dce = dc->table[i]; dce != NULL; dce = next)
+        {
+            next = dce->next;
+            FreePooled(glob->mempool, dce, sizeof(struct DirCacheEntry));
+        }
+    }
+    FreeVecPooled(glob->mempool, dc->table);
+    FreeVecPooled(glob->mempool, dc);
+}
+
+static void DropDirCache(struct FSSuper *sb, struct DirCache *dc)
+{
+    struct Globals *glob = sb->glob;
+
+    D(bug("[fat] dropping name index for dir at cluster %ld\n",
+        dc->cluster));
+
+    Remove((struct Node *)dc);
+    sb->dir_cache_count--;
+    sb->dir_cache_drops++;
+    FreeDirCache(sb, dc);
+}
+
+void FreeDirCaches(struct FSSuper *sb)
+{
+    D(struct Globals *glob = sb->glob);
+    struct DirCache *dc, *dc2;
+
+    D(bug("[fat] name index statistics: %ld lookups, %ld found,"
+        " %ld collisions, %ld dirs indexed, %ld dropped\n",
+        sb->dir_cache_lookups, sb->dir_cache_found,
+        sb->dir_cache_collisions, sb->dir_cache_builds,
+        sb->dir_cache_drops));
+
+    ForeachNodeSafe(&sb->dir_caches, dc, dc2)
+    {
+        FreeDirCache(sb, dc);
+    }
+    NEWLIST(&sb->dir_caches);
+    sb->dir_cache_count = 0;
+}
+
+/* Double the number of buckets once the chains get long */
+static void GrowDirCache(struct DirCache *dc, struct Globals *glob)
+{
+    struct DirCacheEntry **table, *dce, *next;
+    ULONG mask = (dc->mask << 1) | 1, i;
+
+    table = AllocVecPooled(glob->mempool,
+        sizeof(struct DirCacheEntry *) * (mask + 1));
+    if (table == NULL)
+        return;
+    SetMem(table, 0, sizeof(struct DirCacheEntry *) * (mask + 1));
+
+    for (i = 0; i <= dc->mask; i++)
+    {
+        for (dce = dc->table[i]; dce != NULL; dce = next)
+        {
+            next = dce->next;
+            dce->next = table[dce->hash & mask];
+            table[dce->hash & mask] = dce;
+        }
+    }
+
+    FreeVecPooled(glob->mempool, dc->table);
+    dc->table = table;
+    dc->mask = mask;
+}
+
+static BOOL AddDirCacheName(struct DirCache *dc, ULONG hash, ULONG index,
+    struct Globals *glob)
+{
+    struct DirCacheEntry *dce;
+
+    dce = AllocPooled(glob->mempool, sizeof(struct DirCacheEntry));
+    if (dce == NULL)
+        return FALSE;
+
+    dce->hash = hash;
+    dce->index = index;
+    dce->next = dc->table[hash & dc->mask];
+    dc->table[hash & dc->mask] = dce;
+
+    if (++dc->count > (dc->mask + 1) * 2)
+        GrowDirCache(dc, glob);
+
+    return TRUE;
+}
+
+static void RemDirCacheName(struct DirCache *dc, ULONG hash, ULONG index,
+    struct Globals *glob)
+{
+    struct DirCacheEntry **prev, *dce;
+
+    for (prev = &dc->table[hash & dc->mask]; (dce = *prev) != NULL;
+        prev = &dce->next)
+    {
+        if (dce->hash == hash && dce->index == index)
+        {
+            *prev = dce->next;
+            FreePooled(glob->mempool, dce, sizeof(struct DirCacheEntry));
+            dc->count--;
+            return;
+        }
+    }
+}
+
+/* Hash the short name of an entry and, if there is a different one, its
+ * long name. Returns the number of hashes */
+static ULONG HashDirEntryNames(struct DirEntry *de, ULONG *hashes,
+    struct Globals *glob)
 {
     UBYTE buf[256];
     ULONG buflen;
+
+    GetDirEntryShortName(de, buf, &buflen, glob);
+    hashes[0] = HashName(buf, buflen);
+
+    buflen = 0;
+    if (GetDirEntryLongName(de, buf, &buflen) == 0 && buflen != 0)
+    {
+        hashes[1] = HashName(buf, buflen);
+        if (hashes[1] != hashes[0])
+            return 2;
+    }
+
+    return 1;
+}
+
+static BOOL AddDirCacheEntry(struct DirCache *dc, struct DirEntry *de,
+    struct Globals *glob)
+{
+    ULONG hashes[2], n, i;
+
+    n = HashDirEntryNames(de, hashes, glob);
+    for (i = 0; i < n; i++)
+    {
+        if (!AddDirCacheName(dc, hashes[i], de->index, glob))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/* Index all names in a directory. Returns NULL if that wasn't possible, in
+ * which case the caller just searches the directory itself */
+static struct DirCache *BuildDirCache(struct DirHandle *dh, struct DirEntry *de,
+    struct Globals *glob)
+{
+    struct FSSuper *sb = dh->ioh.sb;
+    struct DirCache *dc;
+    LONG err;
+
+    /* Make room by throwing away the least recently used index */
+    if (sb->dir_cache_count >= DIRCACHE_MAX)
+        DropDirCache(sb, (struct DirCache *)sb->dir_caches.mlh_TailPred);
+
+    dc = AllocVecPooled(glob->mempool, sizeof(struct DirCache));
+    if (dc == NULL)
+        return NULL;
+    dc->cluster = dh->ioh.first_cluster;
+    dc->count = 0;
+    dc->mask = DIRCACHE_BUCKETS - 1;
+    dc->table = AllocVecPooled(glob->mempool,
+        sizeof(struct DirCacheEntry *) * DIRCACHE_BUCKETS);
+    if (dc->table == NULL)
+    {
+        FreeVecPooled(glob->mempool, dc);
+        return NULL;
+    }
+    SetMem(dc->table, 0, sizeof(struct DirCacheEntry *) * DIRCACHE_BUCKETS);
+
+    RESET_DIRHANDLE(dh);
+    while ((err = GetNextDirEntry(dh, de, glob)) == 0)
+    {
+        if (!AddDirCacheEntry(dc, de, glob))
+            break;
+    }
+
+    if (err != ERROR_OBJECT_NOT_FOUND)
+    {
+        D(bug("[fat] couldn't index dir at cluster %ld\n", dc->cluster));
+        FreeDirCache(sb, dc);
+        return NULL;
+    }
+
+    D(bug("[fat] indexed %ld names in dir at cluster %ld\n", dc->count,
+        dc->cluster));
+
+    AddHead((struct List *)&sb->dir_caches, (struct Node *)dc);
+    sb->dir_cache_count++;
+    sb->dir_cache_builds++;
+
+    return dc;
+}
+
+LONG GetDirEntryByName(struct DirHandle *dh, STRPTR name, ULONG namelen,
+    struct DirEntry *de, struct Globals *glob)
+{
+    struct FSSuper *sb = dh->ioh.sb;
+    struct DirCache *dc;
+    struct DirCacheEntry *dce;
+    ULONG hash;
     LONG err;
 
     D(bug("[fat] looking for dir entry with name '%s'\n", name));
 
+    /* Use the directory's name index, if it has one or we can make one */
+    dc = FindDirCache(sb, dh->ioh.first_cluster);
+    if (dc != NULL)
+    {
+        Remove((struct Node *)dc);
+        AddHead((struct List *)&sb->dir_caches, (struct Node *)dc);
+    }
+    else
+        dc = BuildDirCache(dh, de, glob);
+
+    if (dc != NULL)
+    {
+        sb->dir_cache_lookups++;
+
+        hash = HashName((UBYTE *)name, namelen);
+        for (dce = dc->table[hash & dc->mask]; dce != NULL; dce = dce->next)
+        {
+            if (dce->hash != hash)
+                continue;
+
+            if ((err = GetDirEntry(dh, dce->index, de, glob)) != 0)
+                return err;
+
+            if (MatchDirEntryName(de, name, namelen, glob))
+            {
+                sb->dir_cache_found++;
+                return 0;
+            }
+
+            sb->dir_cache_collisions++;
+        }
+
+        D(bug("[fat] name not in dir index\n"));
+        RESET_DIRHANDLE(dh);
+        return ERROR_OBJECT_NOT_FOUND;
+    }
+
     /* Start at the start */
     RESET_DIRHANDLE(dh);
 
     /* Loop through the entries until we find a match */
     while ((err = GetNextDirEntry(dh, de, glob)) == 0)
     {
-        /* Compare with the short name first, since we already have it */
-        GetDirEntryShortName(de, buf, &buflen, glob);
-        if (namelen == buflen
-            && strnicmp((char *)name, (char *)buf, buflen) == 0)
-        {
-            D(bug("[fat] matched short name '%s' at entry %ld, returning\n",
-                buf, dh->cur_index));
+        if (MatchDirEntryName(de, name, namelen, glob))
             return 0;
-        }
-
-        /* No match, extract the long name and compare with that instead */
-        GetDirEntryLongName(de, buf, &buflen);
-        if (namelen == buflen
-            && strnicmp((char *)name, (char *)buf, buflen) == 0)
-        {
-            D(bug("[fat] matched long name '%s' at entry %ld, returning\n",
-                buf, dh->cur_index));
-            return 0;
-        }
     }
 
     return err;
@@ -521,6 +817,7 @@ LONG AllocDirEntry(struct DirHandle *dh, ULONG gap, struct DirEntry *de,
 LONG CreateDirEntry(struct DirHandle *dh, STRPTR name, ULONG namelen,
     UBYTE attr, ULONG cluster, struct DirEntry *de, struct Globals *glob)
 {
+    struct DirCache *dc;
     ULONG gap;
     LONG err;
 
@@ -547,9 +844,16 @@ LONG CreateDirEntry(struct DirHandle *dh, STRPTR name, ULONG namelen,
     {
         D(bug(
             "[fat] couldn't update base directory entry, creation failed\n"));
+        if ((dc = FindDirCache(dh->ioh.sb, dh->ioh.first_cluster)) != NULL)
+            DropDirCache(dh->ioh.sb, dc);
         return err;
     }
 
+    /* Add the new names to the directory's index */
+    if ((dc = FindDirCache(dh->ioh.sb, dh->ioh.first_cluster)) != NULL
+        && !AddDirCacheEntry(dc, de, glob))
+        DropDirCache(dh->ioh.sb, dc);
+
     D(bug("[fat] created dir entry %ld\n", de->index));
 
     return 0;
@@ -587,10 +891,24 @@ void FillDirEntry(struct DirEntry *de, UBYTE attr, ULONG cluster,
 LONG DeleteDirEntry(struct DirEntry *de, struct Globals *glob)
 {
     struct DirHandle dh;
+    struct DirCache *dc;
     UBYTE checksum;
-    ULONG order;
+    ULONG order, hashes[2], n;
     LONG err;
 
+    /* Take the names out of the directory's index while we still have
+     * them. A deleted directory's own index has to go too, as its first
+     * cluster may be given to another directory */
+    if ((dc = FindDirCache(glob->sb, de->cluster)) != NULL)
+    {
+        n = HashDirEntryNames(de, hashes, glob);
+        while (n-- > 0)
+            RemDirCacheName(dc, hashes[n], de->index, glob);
+    }
+    if ((de->e.entry.attr & ATTR_DIRECTORY) != 0
+        && (dc = FindDirCache(glob->sb, FIRST_FILE_CLUSTER(de))) != NULL)
+        DropDirCache(glob->sb, dc);
+
     InitDirHandle(glob->sb, de->cluster, &dh, FALSE, glob);
 
     /* Calculate the short name checksum before we trample on the name */
@@ -11,6 +11,7 @@
  */
 
 #include <exec/types.h>
+#include <proto/exec.h>
 
 #include "fat_fs.h"
 #include "fat_protos.h"
@@ -285,12 +286,193 @@ BOOL SetFat32Entry(struct FSSuper *sb, ULONG n, ULONG val)
     return success;
 }
 
+/*
+ * The free cluster map has one bit per data cluster, which is set if the
+ * cluster is free. Indexing the whole FAT takes seconds on big FAT32
+ * volumes, so the map is built in chunks of FREE_MAP_CHUNK clusters: in
+ * order while the handler is idle (see main.c), and on demand when a
+ * search reaches a chunk that hasn't been indexed yet. free_map_done has a
+ * bit set for every chunk that has been indexed.
+ */
+#define FREE_MAP_WORD(sb, cl) ((sb)->free_map[((cl) - 2) >> 5])
+#define FREE_MAP_BIT(cl)      ((ULONG)1 << (((cl) - 2) & 31))
+#define FREE_MAP_INDEXED(sb, ch) \
+    (((sb)->free_map_done[(ch) >> 5] & ((ULONG)1 << ((ch) & 31))) != 0)
+
+void InitFreeMap(struct FSSuper *sb)
+{
+    struct Globals *glob = sb->glob;
+    ULONG words = (sb->clusters_count + 31) >> 5;
+    ULONG chunks = (sb->clusters_count + FREE_MAP_CHUNK - 1) / FREE_MAP_CHUNK;
+
+    sb->free_map_end = 2;
+    sb->free_map_free = 0;
+
+    /* Without the map we just go back to scanning the FAT */
+    sb->free_map = AllocVecPooled(glob->mempool,
+        (words + ((chunks + 31) >> 5)) * sizeof(ULONG));
+    if (sb->free_map != NULL)
+    {
+        SetMem(sb->free_map, 0, (words + ((chunks + 31) >> 5))
+            * sizeof(ULONG));
+        sb->free_map_done = sb->free_map + words;
+    }
+
+    D(bug("[fat] free cluster map %s\n",
+        sb->free_map != NULL ? "allocated" : "not available"));
+}
+
+void FreeFreeMap(struct FSSuper *sb)
+{
+    struct Globals *glob = sb->glob;
+
+    if (sb->free_map != NULL)
+    {
+        FreeVecPooled(glob->mempool, sb->free_map);
+        sb->free_map = NULL;
+        sb->free_map_done = NULL;
+    }
+}
+
+/* Index one chunk of the map */
+static void IndexFreeMap(struct FSSuper *sb, ULONG chunk)
+{
+    ULONG cluster = chunk * FREE_MAP_CHUNK + 2, last;
+
+    last = (FREE_MAP_CHUNK < sb->clusters_count + 2 - cluster) ?
+        cluster + FREE_MAP_CHUNK : sb->clusters_count + 2;
+
+    for (; cluster < last; cluster++)
+    {
+        if (GET_NEXT_CLUSTER(sb, cluster) == 0)
+        {
+            FREE_MAP_WORD(sb, cluster) |= FREE_MAP_BIT(cluster);
+            sb->free_map_free++;
+        }
+    }
+    sb->free_map_done[chunk >> 5] |= (ULONG)1 << (chunk & 31);
+}
+
+/* Index up to count more clusters, skipping the chunks that have already
+ * been indexed on demand. Returns TRUE once the map is complete */
+BOOL ScanFreeMap(struct FSSuper *sb, ULONG count)
+{
+    D(struct Globals *glob = sb->glob);
+    ULONG end = sb->clusters_count + 2;
+    ULONG chunk, done = 0;
+
+    if (sb->free_map_end >= end)
+        return TRUE;
+
+    while (sb->free_map_end < end)
+    {
+        chunk = (sb->free_map_end - 2) / FREE_MAP_CHUNK;
+        if (!FREE_MAP_INDEXED(sb, chunk))
+        {
+            if (done >= count)
+                break;
+            IndexFreeMap(sb, chunk);
+            done += FREE_MAP_CHUNK;
+        }
+        sb->free_map_end = (FREE_MAP_CHUNK < end - sb->free_map_end) ?
+            sb->free_map_end + FREE_MAP_CHUNK : end;
+    }
+
+    if (sb->free_map_end == end)
+    {
+        D(bug("[fat] free cluster map complete, %ld free clusters\n",
+            sb->free_map_free));
+
+        /* Now the real free count is known. The one from the FSInfo sector
+         * is only a hint, and is often wrong after other systems have
+         * written to the volume */
+        if (sb->free_clusters != sb->free_map_free)
+        {
+            sb->free_clusters = sb->free_map_free;
+            if (sb->fsinfo_buffer != NULL)
+            {
+                sb->fsinfo_buffer->free_count =
+                    AROS_LONG2LE(sb->free_clusters);
+                Cache_MarkBlockDirty(sb->cache, sb->fsinfo_block);
+            }
+        }
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/* Find the first free cluster from 'from' onwards, wrapping around at the
+ * end of the volume. Only the chunks the search gets to are indexed here,
+ * the ones before 'from' are left to the background scan until the search
+ * wraps around to them */
+static BOOL SearchFreeMap(struct FSSuper *sb, ULONG from, ULONG *rcluster)
+{
+    ULONG words = (sb->clusters_count + 31) >> 5;
+    ULONG start, i, n, w, chunk;
+
+    if (from < 2 || from >= sb->clusters_count + 2)
+        from = 2;
+    start = (from - 2) >> 5;
+
+    /* The first word is looked at twice: first from 'from' onwards, and at
+     * the end for the clusters before 'from' */
+    for (n = 0; n <= words; n++)
+    {
+        i = start + n;
+        if (i >= words)
+            i -= words;
+
+        chunk = (i << 5) / FREE_MAP_CHUNK;
+        if (!FREE_MAP_INDEXED(sb, chunk))
+            IndexFreeMap(sb, chunk);
+
+        w = sb->free_map[i];
+        if (n == 0)
+            w &= ~(ULONG)0 << ((from - 2) & 31);
+        else if (n == words)
+            w &= ~(~(ULONG)0 << ((from - 2) & 31));
+
+        if (w != 0)
+        {
+            ULONG cluster = (i << 5) + 2;
+
+            while ((w & 1) == 0)
+            {
+                w >>= 1;
+                cluster++;
+            }
+
+            *rcluster = cluster;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 LONG FindFreeCluster(struct FSSuper *sb, ULONG *rcluster)
 {
     D(struct Globals *glob = sb->glob);
     ULONG cluster = 0;
     BOOL found = FALSE;
 
+    if (sb->free_map != NULL)
+    {
+        if (!SearchFreeMap(sb, sb->next_cluster, rcluster))
+        {
+            D(bug("[fat] no more free clusters, we're out of space\n"));
+            return ERROR_DISK_FULL;
+        }
+
+        sb->next_cluster = *rcluster;
+
+        D(bug("[fat] found free cluster %ld\n", *rcluster));
+
+        return 0;
+    }
+
     for (cluster = sb->next_cluster;
         cluster < 2 + sb->clusters_count && !found; cluster++)
     {
@@ -326,6 +508,31 @@ LONG FindFreeCluster(struct FSSuper *sb, ULONG *rcluster)
     return 0;
 }
 
+/* Find a free cluster to follow 'prev' in a chain. The one directly after
+ * it is preferred, so that files stay contiguous where possible, even when
+ * several of them grow at the same time */
+LONG FindNextFreeCluster(struct FSSuper *sb, ULONG prev, ULONG *rcluster)
+{
+    ULONG next = prev + 1;
+
+    if (next >= sb->clusters_count + 2)
+        return FindFreeCluster(sb, rcluster);
+
+    if (sb->free_map != NULL)
+    {
+        if (!SearchFreeMap(sb, next, rcluster))
+            return ERROR_DISK_FULL;
+    }
+    else if (GET_NEXT_CLUSTER(sb, next) == 0)
+        *rcluster = next;
+    else
+        return FindFreeCluster(sb, rcluster);
+
+    sb->next_cluster = *rcluster;
+
+    return 0;
+}
+
 /* See how many unused clusters are available */
 void CountFreeClusters(struct FSSuper *sb)
 {
@@ -333,6 +540,14 @@ void CountFreeClusters(struct FSSuper *sb)
     ULONG cluster = 0;
     ULONG free = 0;
 
+    /* With a free cluster map, this just builds all of it right away */
+    if (sb->free_map != NULL)
+    {
+        sb->free_clusters = -1;
+        ScanFreeMap(sb, sb->clusters_count);
+        return;
+    }
+
     /* Loop over all the data clusters */
     for (cluster = 2; cluster < sb->clusters_count + 2; cluster++)
     {
@@ -350,6 +565,13 @@ void CountFreeClusters(struct FSSuper *sb)
 void AllocCluster(struct FSSuper *sb, ULONG cluster)
 {
     SET_NEXT_CLUSTER(sb, cluster, sb->eoc_mark);
+    if (sb->free_map != NULL
+        && FREE_MAP_INDEXED(sb, (cluster - 2) / FREE_MAP_CHUNK)
+        && (FREE_MAP_WORD(sb, cluster) & FREE_MAP_BIT(cluster)) != 0)
+    {
+        FREE_MAP_WORD(sb, cluster) &= ~FREE_MAP_BIT(cluster);
+        sb->free_map_free--;
+    }
     sb->free_clusters--;
     if (sb->fsinfo_buffer != NULL)
     {
@@ -362,6 +584,13 @@ void AllocCluster(struct FSSuper *sb, ULONG cluster)
 void FreeCluster(struct FSSuper *sb, ULONG cluster)
 {
     SET_NEXT_CLUSTER(sb, cluster, 0);
+    if (sb->free_map != NULL
+        && FREE_MAP_INDEXED(sb, (cluster - 2) / FREE_MAP_CHUNK)
+        && (FREE_MAP_WORD(sb, cluster) & FREE_MAP_BIT(cluster)) == 0)
+    {
+        FREE_MAP_WORD(sb, cluster) |= FREE_MAP_BIT(cluster);
+        sb->free_map_free++;
+    }
     sb->free_clusters++;
     if (sb->fsinfo_buffer != NULL)
     {
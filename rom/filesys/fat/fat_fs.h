@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2018 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -82,6 +82,32 @@ struct DirHandle
     ULONG               cur_index;      /* last entry returned, for GetNextDirEntry */
 };
 
+/* One name in a directory name index. Entries with both a short and a
+ * different long name have one of these for each */
+struct DirCacheEntry
+{
+    struct DirCacheEntry *next;         /* next in the same hash bucket */
+    ULONG               hash;
+    ULONG               index;          /* index of the short name entry */
+};
+
+/* Name index for one directory, so GetDirEntryByName() doesn't have to
+ * read through the whole directory */
+struct DirCache
+{
+    struct MinNode      node;
+    ULONG               cluster;        /* first cluster of the directory */
+    ULONG               count;          /* names in the index */
+    ULONG               mask;           /* number of hash buckets - 1 */
+    struct DirCacheEntry **table;
+};
+
+/* Number of directories that are indexed at the same time */
+#define DIRCACHE_MAX        8
+
+/* Initial number of hash buckets for a directory. Must be a power of 2 */
+#define DIRCACHE_BUCKETS    64
+
 /* Single directory entry */
 struct DirEntry
 {
@@ -206,6 +232,21 @@ struct FSSuper
     ULONG free_clusters;
     ULONG next_cluster;
 
+    ULONG *free_map;        /* one bit per data cluster, set if it's free */
+    ULONG *free_map_done;   /* one bit per FREE_MAP_CHUNK clusters, set once indexed */
+    ULONG free_map_end;     /* background indexing carries on from here */
+    ULONG free_map_free;    /* free clusters indexed so far */
+
+    struct MinList dir_caches;  /* directory name indexes, most recent first */
+    ULONG dir_cache_count;
+
+    /* name index statistics */
+    ULONG dir_cache_lookups;    /* lookups answered from an index */
+    ULONG dir_cache_found;      /* ... of which found the name */
+    ULONG dir_cache_collisions; /* entries read that didn't match after all */
+    ULONG dir_cache_builds;     /* directories indexed */
+    ULONG dir_cache_drops;      /* indexes thrown away */
+
     ULONG volume_id;
     ULONG type;
     ULONG eoc_mark;
@@ -261,12 +302,14 @@ struct Globals
     struct MsgPort *diskport;
     ULONG diskchgsig_bit;
     struct timerequest *timereq;
+    struct timerequest *scanreq;   /* paces building the free cluster map */
     struct MsgPort *timerport;
     ULONG last_num;    /* last block number that was outside boundaries */
     UWORD readcmd;
     UWORD writecmd;
     BOOL timer_active;
     BOOL restart_timer;
+    BOOL scan_active;
 
     /* volumes */
     struct FSSuper *sb;    /* current sb */
@@ -328,6 +371,17 @@ struct Globals
 #define GET_NEXT_CLUSTER(sb,cl)     (sb->func_get_fat_entry(sb,cl))
 #define SET_NEXT_CLUSTER(sb,cl,val) (sb->func_set_fat_entry(sb,cl,val))
 
+/* Number of clusters indexed in each step while building the free cluster
+ * map. Must be a multiple of 32 */
+#define FREE_MAP_CHUNK 4096
+
+/* Delay in microseconds between steps of building the free cluster map in
+ * the background */
+#define FREE_MAP_DELAY 20000
+
+#define FREE_MAP_COMPLETE(sb) \
+    ((sb)->free_map == NULL || (sb)->free_map_end >= (sb)->clusters_count + 2)
+
 #define CALC_SHORT_NAME_CHECKSUM(name,checksum) \
     do \
     { \
@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2015 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -47,6 +47,7 @@ LONG CreateDirEntry(struct DirHandle *dh, STRPTR name, ULONG namelen,
 void FillDirEntry(struct DirEntry *de, UBYTE attr, ULONG cluster,
     struct Globals *glob);
 LONG DeleteDirEntry(struct DirEntry *de, struct Globals *glob);
+void FreeDirCaches(struct FSSuper *sb);
 LONG FillFIB(struct ExtFileLock *fl, struct FileInfoBlock *fib,
     struct Globals *glob);
 
@@ -65,7 +66,11 @@ BOOL SetFat12Entry(struct FSSuper *sb, ULONG n, ULONG val);
 BOOL SetFat16Entry(struct FSSuper *sb, ULONG n, ULONG val);
 BOOL SetFat32Entry(struct FSSuper *sb, ULONG n, ULONG val);
 LONG FindFreeCluster(struct FSSuper *sb, ULONG *rcluster);
+LONG FindNextFreeCluster(struct FSSuper *sb, ULONG prev, ULONG *rcluster);
 void CountFreeClusters(struct FSSuper *sb);
+void InitFreeMap(struct FSSuper *sb);
+void FreeFreeMap(struct FSSuper *sb);
+BOOL ScanFreeMap(struct FSSuper *sb, ULONG count);
 void AllocCluster(struct FSSuper *sb, ULONG cluster);
 void FreeCluster(struct FSSuper *sb, ULONG cluster);
 
@@ -142,6 +147,7 @@ void ProcessNotify(struct Globals *glob);
 LONG InitTimer(struct Globals *glob);
 void CleanupTimer(struct Globals *glob);
 void RestartTimer(struct Globals *glob);
+void StartScanTimer(struct Globals *glob);
 void HandleTimer(struct Globals *glob);
 
 #endif
@@ -330,7 +330,8 @@ LONG WriteFileChunk(struct IOHandle *ioh, ULONG file_pos, ULONG nwant,
                     D(bug("[fat] hit empty or eoc cluster,"
                         " allocating another\n"));
 
-                    if ((err = FindFreeCluster(ioh->sb, &next_cluster)) != 0)
+                    if ((err = FindNextFreeCluster(ioh->sb, ioh->cur_cluster,
+                        &next_cluster)) != 0)
                     {
                         RESET_HANDLE(ioh);
                         return err;
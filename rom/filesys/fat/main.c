@@ -2,7 +2,7 @@
  * fat-handler - FAT12/16/32 filesystem handler
  *
  * Copyright (C) 2006 Marek Szyprowski
- * Copyright (C) 2007-2020 The AROS Development Team
+ * Copyright (C) 2007-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -178,6 +178,12 @@ LONG handler(struct ExecBase *SysBase)
 
         while (!glob->quit)
         {
+            /* Carry on building the free cluster map, one chunk each time
+             * the scan timer expires, so we still sleep in between */
+            if (glob->sb != NULL && glob->disk_inhibited == 0
+                && !FREE_MAP_COMPLETE(glob->sb))
+                StartScanTimer(glob);
+
             sigs = Wait(mask);
             if (sigs & diskchgsig)
                 ProcessDiskChange(glob);
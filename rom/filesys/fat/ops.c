@@ -1025,7 +1025,12 @@ LONG OpSetFileSize(struct ExtFileLock *lock, LONG offset, LONG whence,
 
         while (count < want)
         {
-            if ((err = FindFreeCluster(glob->sb, &next)) != 0)
+            /* Try to keep the file contiguous */
+            if (cl == 0)
+                err = FindFreeCluster(glob->sb, &next);
+            else
+                err = FindNextFreeCluster(glob->sb, cl, &next);
+            if (err != 0)
             {
                 /* XXX: probably no free clusters left. We should clean up the
                  * extras we allocated before returning. It won't hurt
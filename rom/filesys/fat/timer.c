@@ -1,7 +1,7 @@
 /*
  * fat-handler - FAT12/16/32 filesystem handler
  *
- * Copyright (C) 2008-2015 The AROS Development Team
+ * Copyright (C) 2008-2026 The AROS Development Team
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the same terms as AROS itself.
@@ -36,11 +36,26 @@ LONG InitTimer(struct Globals *glob)
                 err = ERROR_DEVICE_NOT_MOUNTED;
             else
             {
-                glob->timer_active = FALSE;
-                glob->restart_timer = TRUE;
-                glob->gl_TimerBase = glob->timereq->tr_node.io_Device;
-                D(bug("[fat] Timer ready\n"));
-                return 0;
+                /* A second request, replying to the same port, for building
+                 * the free cluster map */
+                glob->scanreq =
+                    (struct timerequest *)CreateIORequest(glob->timerport,
+                    sizeof(struct timerequest));
+                if (glob->scanreq)
+                {
+                    glob->scanreq->tr_node.io_Device =
+                        glob->timereq->tr_node.io_Device;
+                    glob->scanreq->tr_node.io_Unit =
+                        glob->timereq->tr_node.io_Unit;
+
+                    glob->timer_active = FALSE;
+                    glob->restart_timer = TRUE;
+                    glob->scan_active = FALSE;
+                    glob->gl_TimerBase = glob->timereq->tr_node.io_Device;
+                    D(bug("[fat] Timer ready\n"));
+                    return 0;
+                }
+                CloseDevice((struct IORequest *)glob->timereq);
             }
             DeleteIORequest((struct IORequest *)glob->timereq);
         }
@@ -58,6 +73,12 @@ void CleanupTimer(struct Globals *glob)
         AbortIO((struct IORequest *)glob->timereq);
         WaitIO((struct IORequest *)glob->timereq);
     }
+    if (glob->scan_active)
+    {
+        AbortIO((struct IORequest *)glob->scanreq);
+        WaitIO((struct IORequest *)glob->scanreq);
+    }
+    DeleteIORequest((struct IORequest *)glob->scanreq);
     CloseDevice((struct IORequest *)glob->timereq);
     DeleteIORequest((struct IORequest *)glob->timereq);
     DeleteMsgPort(glob->timerport);
@@ -81,8 +102,37 @@ void RestartTimer(struct Globals *glob)
     }
 }
 
+/* Wake up the handler to index the next part of the free cluster map */
+void StartScanTimer(struct Globals *glob)
+{
+    if (!glob->scan_active)
+    {
+        glob->scanreq->tr_node.io_Command = TR_ADDREQUEST;
+        glob->scanreq->tr_time.tv_secs = 0;
+        glob->scanreq->tr_time.tv_micro = FREE_MAP_DELAY;
+        SendIO((struct IORequest *)glob->scanreq);
+        glob->scan_active = TRUE;
+    }
+}
+
 void HandleTimer(struct Globals *glob)
 {
+    if (glob->scan_active && CheckIO((struct IORequest *)glob->scanreq))
+    {
+        WaitIO((struct IORequest *)glob->scanreq);
+        glob->scan_active = FALSE;
+        if (glob->sb != NULL && glob->disk_inhibited == 0
+            && !FREE_MAP_COMPLETE(glob->sb))
+        {
+            /* Write out a corrected FSInfo free count soon */
+            if (ScanFreeMap(glob->sb, FREE_MAP_CHUNK))
+                RestartTimer(glob);
+        }
+    }
+
+    if (!glob->timer_active || !CheckIO((struct IORequest *)glob->timereq))
+        return;
+
     WaitIO((struct IORequest *)glob->timereq);
     glob->timer_active = 0;
     if (glob->restart_timer)
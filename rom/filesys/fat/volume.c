@@ -89,6 +89,8 @@ LONG ReadFATSuper(struct FSSuper *sb)
 
     D(bug("[fat] reading boot sector\n"));
 
+    NEWLIST(&sb->dir_caches);
+
     boot = AllocMem(bsize, MEMF_ANY);
     if (!boot)
         return ERROR_NO_FREE_STORE;
@@ -445,6 +447,7 @@ LONG ReadFATSuper(struct FSSuper *sb)
                 Cache_FreeBlock(sb->cache, sb->fsinfo_block);
         }
     }
+    InitFreeMap(sb);
     if (sb->free_clusters == -1)
         CountFreeClusters(sb);
     if (sb->next_cluster == -1)
@@ -831,6 +834,8 @@ static void FreeFATSuper(struct FSSuper *sb)
 {
     struct Globals *glob = sb->glob;
     D(bug("\tRemoving Super Block from memory\n"));
+    FreeFreeMap(sb);
+    FreeDirCaches(sb);
     Cache_DestroyCache(sb->cache);
     FreeVecPooled(glob->mempool, sb->fat_buffers);
     sb->fat_buffers = NULL;
@@ -127,6 +127,16 @@ BOOL CmdStartup(struct Handler *handler, STRPTR name, struct DeviceNode *dev_nod
       if(handler->public_pool == NULL)
          error = IoErr();
 
+      /* Create the name index. Names are searched for the slow way if
+         there's not enough memory for it */
+
+      if(error == 0)
+      {
+         handler->name_table = AllocPooled(handler->clear_pool,
+            sizeof(APTR) * NAME_TABLE_SIZE);
+         handler->name_mask = NAME_TABLE_SIZE - 1;
+      }
+
       /* Create a volume dos node */
 
       volume = MyMakeDosEntry(handler, default_vol_name, DLT_VOLUME);
@@ -714,7 +724,13 @@ UPINT CmdSeek(struct Handler *handler, struct Opening *opening, PINT offset, LON
       return -1;
    }
 
-   if(offset >= 0)
+   if(file->block_index != NULL)
+   {
+      /* Look the position up in the file's block index */
+
+      block = FindBlock(file, new_pos, &block_pos);
+   }
+   else if(offset >= 0)
    {
       /* Go forwards */
 
@@ -1894,6 +1910,7 @@ BOOL CmdRenameObject(struct Handler *handler, struct Lock *old_lock,
          Remove((struct Node *)object);
          AddTail((struct List *)&parent->elements, (struct Node *)object);
          object->parent = parent;
+         AddObjectName(handler, object);
          AdjustExaminations(handler, object);
       }
 
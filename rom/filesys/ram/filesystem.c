@@ -30,6 +30,9 @@ static struct Block *AddDataBlock(struct Handler *handler,
 static VOID FreeDataBlock(struct Handler *handler, struct Object *file,
    struct Block *block);
 static struct Block *GetLastBlock(struct Object *file);
+static VOID AppendBlock(struct Handler *handler, struct Object *file,
+   struct Block *block);
+static struct Block *RemLastBlock(struct Object *file);
 
 
 
@@ -179,7 +182,10 @@ struct Object *CreateObject(struct Handler *handler, const TEXT *name,
       NewList((struct List *)&object->notifications);
 
       if(type == ST_FILE)
+      {
          AddTail((APTR)&object->elements, (APTR)&object->start_block);
+         object->data_block_count = 1;
+      }
 
       if(name != NULL)
       {
@@ -329,7 +335,10 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
       /* Remove the object from its directory */
 
       if(object->parent != NULL)
+      {
          Remove((struct Node *)object);
+         RemObjectName(handler, object);
+      }
 
       /* Delete a hard link */
 
@@ -375,6 +384,8 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
 
          object->parent = heir->parent;
          AddTail((APTR)&object->parent->elements, (APTR)object);
+         RemObjectName(handler, heir);
+         AddObjectName(handler, object);
 
          if(heir == master_link)
          {
@@ -401,6 +412,10 @@ VOID DeleteObject(struct Handler *handler, struct Object *object)
                FreePooled(handler->muddy_pool, block,
                   sizeof(struct Block) + block->length);
          }
+
+         if(object->block_index != NULL)
+            FreePooled(handler->muddy_pool, object->block_index,
+               sizeof(APTR) * object->index_size);
       }
 
       /* Free object's memory */
@@ -537,8 +552,7 @@ struct Object *GetObject(struct Handler *handler, struct Lock *lock,
          {
             old_object = object;
             object = GetRealObject(object);
-            object = (struct Object *)
-               FindNameNoCase(handler, (struct List *)&object->elements, buffer);
+            object = FindObjectName(handler, object, buffer);
             if(object != NULL)
             {
                /* Check for and handle a soft link */
@@ -703,7 +717,7 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
       while(full_length > new_length)
       {
          FreeDataBlock(handler, file, block);
-         block = (APTR)RemTail((APTR)&file->elements);
+         block = RemLastBlock(file);
          full_length -= block->length;
       }
       end_block = (APTR)file->elements.mlh_TailPred;
@@ -722,7 +736,7 @@ PINT ChangeFileSize(struct Handler *handler, struct Opening *opening,
          FreeDataBlock(handler, file, block);
       }
       else
-         AddTail((struct List *)&file->elements, (APTR)block);
+         AppendBlock(handler, file, block);
    }
 
    /* Store new file size */
@@ -1237,6 +1251,11 @@ BOOL SetName(struct Handler *handler, struct Object *object,
       handler->block_count += block_diff;
    }
 
+   /* Keep the name index up to date */
+
+   if(error == 0)
+      AddObjectName(handler, object);
+
    /* Return success indicator */
 
    SetIoErr(error);
@@ -1309,9 +1328,9 @@ static struct Block *AddDataBlock(struct Handler *handler,
 
    if(block != NULL)
    {
-      AddTail((struct List *)&file->elements, (struct Node *)block);
       block->length = alloc_size - sizeof(struct Block);
       file->block_count += alloc_size >> MEM_BLOCKSHIFT;
+      AppendBlock(handler, file, block);
    }
    else
       SetIoErr(ERROR_DISK_FULL);
@@ -1368,6 +1387,193 @@ static VOID FreeDataBlock(struct Handler *handler, struct Object *file,
 
 
 
+/****i* ram.handler/AppendBlock ********************************************
+*
+*   NAME
+*	AppendBlock -- Add a block to the end of a file.
+*
+*   SYNOPSIS
+*	AppendBlock(handler, file, block)
+*
+*	VOID AppendBlock(struct Handler *, struct Object *, struct Block *);
+*
+*   FUNCTION
+*	Adds a block after the file's current last block, which must be
+*	full, and updates the file's block index. Once a file has enough
+*	blocks, an index is built so that seeks don't have to walk the
+*	block list.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*	A file whose index can't be grown just loses it. Seeks then walk
+*	the list again until an index can be built once more.
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static VOID AppendBlock(struct Handler *handler, struct Object *file,
+   struct Block *block)
+{
+   struct Block *last_block, **index, *b;
+   UPINT size, i;
+
+   last_block = GetLastBlock(file);
+   block->offset = last_block->offset + last_block->length;
+   AddTail((struct List *)&file->elements, (struct Node *)block);
+   file->data_block_count++;
+
+   if(file->block_index == NULL && file->data_block_count < BLOCK_INDEX_MIN)
+      return;
+
+   /* Make room in the index, or build it from scratch */
+
+   if(file->data_block_count > file->index_size || file->block_index == NULL)
+   {
+      size = file->data_block_count * 2;
+      index = AllocPooled(handler->muddy_pool, sizeof(APTR) * size);
+      if(index != NULL)
+      {
+         file->block_count += MEMBLOCKS(sizeof(APTR) * size);
+         if(file->block_index != NULL)
+            CopyMem(file->block_index, index,
+               sizeof(APTR) * (file->data_block_count - 1));
+         else
+         {
+            i = 0;
+            ForeachNode(&file->elements, b)
+               index[i++] = b;
+         }
+      }
+
+      if(file->block_index != NULL)
+      {
+         FreePooled(handler->muddy_pool, file->block_index,
+            sizeof(APTR) * file->index_size);
+         file->block_count -= MEMBLOCKS(sizeof(APTR) * file->index_size);
+      }
+      file->block_index = index;
+      file->index_size = (index != NULL) ? size : 0;
+   }
+
+   if(file->block_index != NULL)
+      file->block_index[file->data_block_count - 1] = block;
+
+   return;
+}
+
+
+
+/****i* ram.handler/RemLastBlock *******************************************
+*
+*   NAME
+*	RemLastBlock -- Remove the last block from a file.
+*
+*   SYNOPSIS
+*	block = RemLastBlock(file)
+*
+*	struct Block *RemLastBlock(struct Object *);
+*
+*   FUNCTION
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static struct Block *RemLastBlock(struct Object *file)
+{
+   struct Block *block;
+
+   /* Entries past the end of the block index are just ignored */
+
+   block = (APTR)RemTail((struct List *)&file->elements);
+   file->data_block_count--;
+
+   return block;
+}
+
+
+
+/****i* ram.handler/FindBlock **********************************************
+*
+*   NAME
+*	FindBlock -- Find the block holding a file position.
+*
+*   SYNOPSIS
+*	block = FindBlock(file, pos, block_pos)
+*
+*	struct Block *FindBlock(struct Object *, UPINT, UPINT *);
+*
+*   FUNCTION
+*	Looks up a position in a file's block index. A position at the
+*	boundary between two blocks is at the end of the first one, as
+*	CmdSeek() would have it if it walked the block list.
+*
+*   INPUTS
+*	file - a file that has a block index.
+*	pos - a position no greater than the file's length.
+*	block_pos - the offset of pos within the block is stored here.
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+struct Block *FindBlock(struct Object *file, UPINT pos, UPINT *block_pos)
+{
+   struct Block *block;
+   UPINT low, high, mid;
+
+   low = 0;
+   high = file->data_block_count - 1;
+   while(low < high)
+   {
+      mid = (low + high) / 2;
+      block = file->block_index[mid];
+      if(block->offset + GetBlockLength(file, block) >= pos)
+         high = mid;
+      else
+         low = mid + 1;
+   }
+
+   block = file->block_index[low];
+   *block_pos = pos - block->offset;
+
+   return block;
+}
+
+
+
 /****i* ram.handler/GetRealObject ******************************************
 *
 *   NAME
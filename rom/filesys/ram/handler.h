@@ -73,6 +73,8 @@ typedef LONG PINT;
 #define MUDDY_PUDDLE_THRESH (8 * 1024)
 #define PUBLIC_PUDDLE_SIZE (4 * 1024)
 #define PUBLIC_PUDDLE_THRESH (2 * 1024)
+#define NAME_TABLE_SIZE 256     /* initial number of name hash buckets */
+#define BLOCK_INDEX_MIN 16      /* blocks a file needs before it's indexed */
 #define DOS_VERSION 39
 #define UTILITY_VERSION 37
 #define LOCALE_VERSION 38
@@ -82,6 +84,7 @@ struct Block
 {
    struct MinNode node;
    UWORD length;            /* number of data bytes */
+   UPINT offset;            /* position of first data byte in file */
 };
 
 
@@ -109,6 +112,11 @@ struct Object
    struct MinNode hard_link;
    struct MinList notifications;
    struct Block start_block;   /* a zero-length block */
+   struct Object *hash_next;   /* next object in same name hash bucket */
+   ULONG hash;                 /* hash of name and parent directory */
+   UPINT data_block_count;     /* number of blocks in a file's list */
+   struct Block **block_index; /* a file's blocks in order, or NULL */
+   UPINT index_size;           /* number of entries block index has room for */
 };
 #define soft_link_target comment
 
@@ -154,6 +162,9 @@ struct Handler
    APTR clear_pool;
    APTR muddy_pool;
    APTR public_pool;
+   struct Object **name_table; /* all objects in directories, by name */
+   UPINT name_mask;            /* number of name hash buckets - 1 */
+   UPINT name_count;
 
    TEXT b_buffer[256];
    TEXT b_buffer2[256];
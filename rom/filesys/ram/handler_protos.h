@@ -113,6 +113,7 @@ VOID AdjustExaminations(struct Handler *handler, struct Object *object);
 BOOL SetName(struct Handler *handler, struct Object *object,
    const TEXT *name);
 UPINT GetBlockLength(struct Object *file, struct Block *block);
+struct Block *FindBlock(struct Object *file, UPINT pos, UPINT *block_pos);
 struct Object *GetRealObject(struct Object *object);
 
 VOID MatchNotifyRequests(struct Handler *handler);
@@ -132,6 +133,10 @@ PINT SwapStrings(TEXT **field1, TEXT **field2);
 UPINT StrLen(const TEXT *s);
 UPINT StrSize(const TEXT *s);
 struct Node *FindNameNoCase(struct Handler *handler, struct List *start, const TEXT *name);
+VOID AddObjectName(struct Handler *handler, struct Object *object);
+VOID RemObjectName(struct Handler *handler, struct Object *object);
+struct Object *FindObjectName(struct Handler *handler, struct Object *dir,
+   const TEXT *name);
 struct DosList *MyMakeDosEntry(struct Handler *handler, const TEXT *name, LONG type);
 VOID MyFreeDosEntry(struct Handler *handler, struct DosList *entry);
 BOOL MyRenameDosEntry(struct Handler *handler, struct DosList *entry, const TEXT *name);
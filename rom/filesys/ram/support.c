@@ -299,6 +299,297 @@ struct Node *FindNameNoCase(struct Handler *handler, struct List *start, const T
 
 
 
+/****i* ram.handler/HashName ***********************************************
+*
+*   NAME
+*	HashName -- Hash a name within a directory.
+*
+*   SYNOPSIS
+*	hash = HashName(handler, dir, name)
+*
+*	ULONG HashName(struct Handler *, struct Object *, TEXT *);
+*
+*   FUNCTION
+*	Names that Stricmp() considers equal get the same hash, as long as
+*	they are plain ASCII. Only a-z are folded to upper case, and bytes
+*	of 0x80 and above are left out, because the hash is kept for as
+*	long as the object exists, while locale.library may change how
+*	Stricmp() and ToUpper() treat those bytes at any time.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static ULONG HashName(struct Handler *handler, struct Object *dir,
+   const TEXT *name)
+{
+   ULONG hash;
+   UBYTE ch;
+
+   hash = (ULONG)((UPINT)dir >> 4);
+   while((ch = *name++) != '\0')
+   {
+      if(ch >= 0x80)
+         continue;
+      if(ch >= 'a' && ch <= 'z')
+         ch -= 'a' - 'A';
+      hash = hash * 33 + ch;
+   }
+
+   return hash;
+}
+
+
+
+/****i* ram.handler/GrowNameTable ******************************************
+*
+*   NAME
+*	GrowNameTable -- Double the number of name hash buckets.
+*
+*   SYNOPSIS
+*	GrowNameTable(handler)
+*
+*	VOID GrowNameTable(struct Handler *);
+*
+*   FUNCTION
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*	If there isn't enough memory, the table is left as it is.
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+static VOID GrowNameTable(struct Handler *handler)
+{
+   struct Object **table, *object, *next_object;
+   UPINT mask, i;
+
+   mask = (handler->name_mask << 1) | 1;
+   table = AllocPooled(handler->clear_pool, sizeof(APTR) * (mask + 1));
+   if(table != NULL)
+   {
+      for(i = 0; i <= handler->name_mask; i++)
+      {
+         for(object = handler->name_table[i]; object != NULL;
+            object = next_object)
+         {
+            next_object = object->hash_next;
+            object->hash_next = table[object->hash & mask];
+            table[object->hash & mask] = object;
+         }
+      }
+
+      FreePooled(handler->clear_pool, handler->name_table,
+         sizeof(APTR) * (handler->name_mask + 1));
+      handler->name_table = table;
+      handler->name_mask = mask;
+   }
+
+   return;
+}
+
+
+
+/****i* ram.handler/AddObjectName ******************************************
+*
+*   NAME
+*	AddObjectName -- Add an object to the name index.
+*
+*   SYNOPSIS
+*	AddObjectName(handler, object)
+*
+*	VOID AddObjectName(struct Handler *, struct Object *);
+*
+*   FUNCTION
+*	Makes an object findable by FindObjectName() under its current name
+*	and parent directory. This must be called again whenever either of
+*	them changes.
+*
+*   INPUTS
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*	Objects without a name or parent directory aren't indexed.
+*
+*   BUGS
+*
+*   SEE ALSO
+*	RemObjectName()
+*
+****************************************************************************
+*
+*/
+
+VOID AddObjectName(struct Handler *handler, struct Object *object)
+{
+   struct Object **bucket;
+   const TEXT *name;
+
+   RemObjectName(handler, object);
+
+   name = ((struct Node *)object)->ln_Name;
+   if(handler->name_table != NULL && object->parent != NULL && name != NULL)
+   {
+      object->hash = HashName(handler, object->parent, name);
+      bucket = &handler->name_table[object->hash & handler->name_mask];
+      object->hash_next = *bucket;
+      *bucket = object;
+
+      if(++handler->name_count > (handler->name_mask + 1) * 2)
+         GrowNameTable(handler);
+   }
+
+   return;
+}
+
+
+
+/****i* ram.handler/RemObjectName ******************************************
+*
+*   NAME
+*	RemObjectName -- Remove an object from the name index.
+*
+*   SYNOPSIS
+*	RemObjectName(handler, object)
+*
+*	VOID RemObjectName(struct Handler *, struct Object *);
+*
+*   FUNCTION
+*
+*   INPUTS
+*	object - an object, which doesn't have to be in the index.
+*
+*   RESULT
+*
+*   EXAMPLE
+*
+*   NOTES
+*
+*   BUGS
+*
+*   SEE ALSO
+*	AddObjectName()
+*
+****************************************************************************
+*
+*/
+
+VOID RemObjectName(struct Handler *handler, struct Object *object)
+{
+   struct Object **prev, *o;
+
+   if(handler->name_table != NULL)
+   {
+      prev = &handler->name_table[object->hash & handler->name_mask];
+      while((o = *prev) != NULL)
+      {
+         if(o == object)
+         {
+            *prev = object->hash_next;
+            object->hash_next = NULL;
+            handler->name_count--;
+            break;
+         }
+         prev = &o->hash_next;
+      }
+   }
+
+   return;
+}
+
+
+
+/****i* ram.handler/FindObjectName *****************************************
+*
+*   NAME
+*	FindObjectName -- Find an object in a directory by name.
+*
+*   SYNOPSIS
+*	object = FindObjectName(handler, dir, name)
+*
+*	struct Object *FindObjectName(struct Handler *, struct Object *,
+*	    TEXT *);
+*
+*   FUNCTION
+*	Looks for an object with the given name in a directory, ignoring
+*	case.
+*
+*   INPUTS
+*	dir - the directory to search. Must not be a hard link.
+*	name - the name to look for.
+*
+*   RESULT
+*	object - the object found, or NULL.
+*
+*   EXAMPLE
+*
+*   NOTES
+*	Falls back to searching the directory's list if there's no name
+*	index, or if the name has bytes of 0x80 and above, which the
+*	current locale may match differently than it did when the objects
+*	were hashed.
+*
+*   BUGS
+*
+*   SEE ALSO
+*
+****************************************************************************
+*
+*/
+
+struct Object *FindObjectName(struct Handler *handler, struct Object *dir,
+   const TEXT *name)
+{
+   struct Object *object;
+   ULONG hash;
+   const TEXT *p;
+
+   for(p = name; *p != '\0' && (UBYTE)*p < 0x80; p++);
+
+   if(handler->name_table == NULL || *p != '\0')
+      return (struct Object *)FindNameNoCase(handler,
+         (struct List *)&dir->elements, name);
+
+   hash = HashName(handler, dir, name);
+   for(object = handler->name_table[hash & handler->name_mask];
+      object != NULL; object = object->hash_next)
+   {
+      if(object->hash == hash && object->parent == dir
+         && Stricmp(name, ((struct Node *)object)->ln_Name) == 0)
+         break;
+   }
+
+   return object;
+}
+
+
+
 /****i* ram.handler/MyMakeDosEntry *****************************************
 *
 *   NAME
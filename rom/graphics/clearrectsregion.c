@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Graphics function ClearRectsRegion()
+*/
+
+#include <exec/memory.h>
+#include <graphics/regions.h>
+#include <proto/exec.h>
+
+#include "graphics_intern.h"
+#include "intregions.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <proto/graphics.h>
+
+        AROS_LH3(BOOL, ClearRectsRegion,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct Region    *, Reg,   A0),
+        AROS_LHA(struct Rectangle *, Rects, A1),
+        AROS_LHA(ULONG             , Count, D0),
+
+/*  LOCATION */
+        struct GfxBase *, GfxBase, 195, Graphics)
+
+/*  FUNCTION
+        Clear an array of Rectangles from the given Region. The
+        result is the same as calling ClearRectRegion() for each of
+        them, but it is a lot faster when there are many rectangles.
+
+    INPUTS
+        region - pointer to Region structure
+        rects - pointer to an array of Rectangle structures
+        count - number of rectangles in the array
+
+    RESULT
+        TRUE if the operation was successful, else FALSE
+        (out of memory). The region is left unchanged if the
+        operation fails.
+
+    NOTES
+        This function is AROS specific.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        ClearRectRegion(), OrRectsRegion()
+
+    INTERNALS
+        The rectangles are first turned into a region of their own,
+        see _RectsToRegion(), which is then cleared from the given one.
+
+    HISTORY
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct Region Sub, Res;
+    BOOL res = TRUE;
+
+    if (!Reg->RegionRectangle)
+    {
+        /* Nothing to clear */
+        return TRUE;
+    }
+
+    InitRegion(&Sub);
+
+    if (!_RectsToRegion(Rects, Count, &Sub, GfxBase))
+        return FALSE;
+
+    /* If the rectangles and the region don't overlap just return */
+    if (!Sub.RegionRectangle || !overlap(Sub.bounds, Reg->bounds))
+    {
+        _DisposeRegionRectangleList(Sub.RegionRectangle, GfxBase);
+        return TRUE;
+    }
+
+    InitRegion(&Res);
+
+    if (_DoOperationBandBand(_ClearBandBand,
+                             MinX(&Sub), MinX(Reg), MinY(&Sub), MinY(Reg),
+                             Sub.RegionRectangle, Reg->RegionRectangle,
+                             &Res.RegionRectangle, &Res.bounds, GfxBase))
+    {
+        ClearRegion(Reg);
+
+        *Reg = Res;
+        _TranslateRegionRectangles(Res.RegionRectangle, -MinX(&Res), -MinY(&Res));
+    }
+    else
+        res = FALSE;
+
+    _DisposeRegionRectangleList(Sub.RegionRectangle, GfxBase);
+
+    return res;
+
+    AROS_LIBFUNC_EXIT
+} /* ClearRectsRegion */
@@ -0,0 +1,221 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Collects the updated areas of screen bitmaps, and passes them on
+          to the driver or compositor once a frame.
+*/
+
+#include <aros/debug.h>
+#include <graphics/regions.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/oop.h>
+
+#include "graphics_intern.h"
+#include "compositor_driver.h"
+#include "gfxfuncsupport.h"
+
+/*
+ * Every rendering call on a screen bitmap used to end in an UpdateRect()
+ * of its own, which on hosted drivers and with the compositor means a
+ * copy and a redraw for each of them, however small, and however often
+ * the same area was drawn into. Instead the areas are ORed into a region
+ * per bitmap, which merges touching and overlapping rectangles as it
+ * goes, and a task sends what is left on every vertical blank.
+ */
+
+struct DamageNode
+{
+    struct MinNode     dn_Node;
+    struct BitMap     *dn_BitMap;
+    struct Region     *dn_Region;
+};
+
+/* Above this many rectangles, or this much coverage, send the bounds instead */
+#define DAMAGE_MAXRECTS         16
+#define DAMAGE_COVERAGE         75      /* percent */
+
+#define DAMAGE_IDLE             0
+#define DAMAGE_RUNNING          1
+#define DAMAGE_FAILED           2
+
+static void damage_flush(struct GfxBase *GfxBase)
+{
+    struct MinList     flush;
+    struct DamageNode *dn;
+
+    NEWLIST(&flush);
+
+    ObtainSemaphore(&PrivGBase(GfxBase)->damage_flushsema);
+
+    /* Take the collected damage, so that rendering can go on while it is sent */
+    ObtainSemaphore(&PrivGBase(GfxBase)->damage_sema);
+    PrivGBase(GfxBase)->damage_pending = FALSE;
+    while ((dn = (struct DamageNode *)RemHead((struct List *)&PrivGBase(GfxBase)->damage_list)) != NULL)
+        AddTail((struct List *)&flush, (struct Node *)dn);
+    ReleaseSemaphore(&PrivGBase(GfxBase)->damage_sema);
+
+    while ((dn = (struct DamageNode *)RemHead((struct List *)&flush)) != NULL)
+    {
+        struct Region          *r = dn->dn_Region;
+        struct RegionRectangle *rr;
+        OOP_Object             *bm = HIDD_BM_OBJ(dn->dn_BitMap);
+        ULONG                   count = 0, area = 0, bounds;
+
+        for (rr = r->RegionRectangle; rr; rr = rr->Next)
+        {
+            count++;
+            area += (rr->bounds.MaxX - rr->bounds.MinX + 1) * (rr->bounds.MaxY - rr->bounds.MinY + 1);
+        }
+
+        bounds = (r->bounds.MaxX - r->bounds.MinX + 1) * (r->bounds.MaxY - r->bounds.MinY + 1);
+
+        if (count > DAMAGE_MAXRECTS || area * 100 >= bounds * DAMAGE_COVERAGE)
+        {
+            update_bitmap_rect(dn->dn_BitMap, bm, r->bounds.MinX, r->bounds.MinY,
+                               r->bounds.MaxX - r->bounds.MinX + 1,
+                               r->bounds.MaxY - r->bounds.MinY + 1, GfxBase);
+            count = 1;
+        }
+        else
+        {
+            for (rr = r->RegionRectangle; rr; rr = rr->Next)
+            {
+                update_bitmap_rect(dn->dn_BitMap, bm,
+                                   r->bounds.MinX + rr->bounds.MinX, r->bounds.MinY + rr->bounds.MinY,
+                                   rr->bounds.MaxX - rr->bounds.MinX + 1,
+                                   rr->bounds.MaxY - rr->bounds.MinY + 1, GfxBase);
+            }
+        }
+
+        PrivGBase(GfxBase)->damage_flushed += count;
+
+        DisposeRegion(r);
+        FreeMem(dn, sizeof(struct DamageNode));
+    }
+
+    ReleaseSemaphore(&PrivGBase(GfxBase)->damage_flushsema);
+}
+
+static void damage_main(struct GfxBase *GfxBase)
+{
+    ULONG frames = 0;
+
+    for (;;)
+    {
+        Wait(SIGBREAKF_CTRL_F);
+
+        damage_flush(GfxBase);
+
+        if ((++frames & 255) == 0)
+        {
+            D(bug("[Damage] %u rectangles submitted, %u sent\n",
+                  PrivGBase(GfxBase)->damage_submitted, PrivGBase(GfxBase)->damage_flushed));
+        }
+    }
+}
+
+/*
+ * Adds an area of a screen bitmap to the damage of the current frame.
+ * The task is started the first time. Returns FALSE if the area couldn't
+ * be added, it must then be sent on at once.
+ */
+BOOL damage_add(struct BitMap *bitmap, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase)
+{
+    struct DamageNode *dn;
+    struct Rectangle   rect;
+    BOOL               done = FALSE;
+
+    if (PrivGBase(GfxBase)->damage_state == DAMAGE_FAILED)
+        return FALSE;
+
+    ObtainSemaphore(&PrivGBase(GfxBase)->damage_sema);
+
+    if (PrivGBase(GfxBase)->damage_state == DAMAGE_IDLE)
+    {
+        PrivGBase(GfxBase)->damage_task = NewCreateTask(TASKTAG_NAME, "Graphics Damage",
+                                                        TASKTAG_PRI,  2,
+                                                        TASKTAG_PC,   damage_main,
+                                                        TASKTAG_ARG1, GfxBase,
+                                                        TAG_DONE);
+
+        D(bug("[Damage] Started task 0x%p\n", PrivGBase(GfxBase)->damage_task));
+
+        PrivGBase(GfxBase)->damage_state = PrivGBase(GfxBase)->damage_task ? DAMAGE_RUNNING : DAMAGE_FAILED;
+    }
+
+    if (PrivGBase(GfxBase)->damage_state == DAMAGE_RUNNING)
+    {
+        /* Most of the time it is the bitmap that was drawn into last */
+        ForeachNode(&PrivGBase(GfxBase)->damage_list, dn)
+        {
+            if (dn->dn_BitMap == bitmap)
+                break;
+        }
+
+        if (dn->dn_Node.mln_Succ == NULL)
+        {
+            if ((dn = AllocMem(sizeof(struct DamageNode), MEMF_ANY)) != NULL)
+            {
+                dn->dn_BitMap = bitmap;
+                if ((dn->dn_Region = NewRegion()) != NULL)
+                {
+                    AddHead((struct List *)&PrivGBase(GfxBase)->damage_list, (struct Node *)dn);
+                }
+                else
+                {
+                    FreeMem(dn, sizeof(struct DamageNode));
+                    dn = NULL;
+                }
+            }
+        }
+        else if ((struct MinNode *)dn != PrivGBase(GfxBase)->damage_list.mlh_Head)
+        {
+            Remove((struct Node *)dn);
+            AddHead((struct List *)&PrivGBase(GfxBase)->damage_list, (struct Node *)dn);
+        }
+
+        rect.MinX = x;
+        rect.MinY = y;
+        rect.MaxX = x + width - 1;
+        rect.MaxY = y + height - 1;
+
+        if (dn && OrRectRegion(dn->dn_Region, &rect))
+        {
+            PrivGBase(GfxBase)->damage_submitted++;
+            PrivGBase(GfxBase)->damage_pending = TRUE;
+            done = TRUE;
+        }
+    }
+
+    ReleaseSemaphore(&PrivGBase(GfxBase)->damage_sema);
+
+    return done;
+}
+
+/* Drops the damage of a bitmap that is going away */
+void damage_forget(struct BitMap *bitmap, struct GfxBase *GfxBase)
+{
+    struct DamageNode *dn;
+
+    if (PrivGBase(GfxBase)->damage_state != DAMAGE_RUNNING)
+        return;
+
+    /* Wait for a flush that may be busy with the bitmap */
+    ObtainSemaphore(&PrivGBase(GfxBase)->damage_flushsema);
+    ObtainSemaphore(&PrivGBase(GfxBase)->damage_sema);
+
+    ForeachNode(&PrivGBase(GfxBase)->damage_list, dn)
+    {
+        if (dn->dn_BitMap == bitmap)
+        {
+            Remove((struct Node *)dn);
+            DisposeRegion(dn->dn_Region);
+            FreeMem(dn, sizeof(struct DamageNode));
+            break;
+        }
+    }
+
+    ReleaseSemaphore(&PrivGBase(GfxBase)->damage_sema);
+    ReleaseSemaphore(&PrivGBase(GfxBase)->damage_flushsema);
+}
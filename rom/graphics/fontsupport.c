@@ -1,9 +1,10 @@
 /*
-    Copyright (C) 1995-2010, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Misc font help funcs
 */
 
+#include <aros/debug.h>
 #include <proto/exec.h>
 #include <proto/oop.h>
 #include <proto/graphics.h>
@@ -173,3 +174,137 @@ UBYTE *colorfontbm_to_chunkybuffer(struct TextFont *font, struct GfxBase *GfxBas
 
 
 
+
+/*
+ * Text() renders most strings with the same few glyphs over and over, so
+ * they are kept expanded to one byte per pixel, and don't have to be picked
+ * out of the font's bit plane bit by bit every time. The cache of a font
+ * hangs off its extension, and the glyphs of all fonts share one LRU list
+ * and one memory budget. Must be called with glyphcache_sema held, the
+ * glyph may be evicted as soon as it is released.
+ */
+
+struct GlyphCacheEntry *glyphcache_obtain(struct tfe_hashnode *hn, struct TextFont *tf,
+                                          ULONG idx, struct GfxBase *GfxBase)
+{
+    struct GlyphCache      *gc = hn->glyphcache;
+    struct GlyphCacheEntry *gce;
+    ULONG                   charloc, size;
+    UWORD                   width, height, pos, x, y;
+    UBYTE                  *src, *dst;
+
+    if (NULL == gc)
+    {
+        UWORD numglyphs = NUMCHARS(tf);
+
+        gc = AllocMem(sizeof(struct GlyphCache) + (numglyphs - 1) * sizeof(struct GlyphCacheEntry *),
+                      MEMF_ANY|MEMF_CLEAR);
+        if (NULL == gc)
+            return NULL;
+
+        gc->gc_NumGlyphs = numglyphs;
+        hn->glyphcache = gc;
+    }
+
+    if (idx >= gc->gc_NumGlyphs)
+        return NULL;
+
+    if ((gce = gc->gc_Glyphs[idx]) != NULL)
+    {
+        Remove((struct Node *)gce);
+        AddHead((struct List *)&GFBI(GfxBase)->glyphcache_lru, (struct Node *)gce);
+
+        gc->gc_Hits++;
+        GFBI(GfxBase)->glyphcache_hits++;
+
+        return gce;
+    }
+
+    charloc = ((ULONG *)tf->tf_CharLoc)[idx];
+    width   = charloc & 0xFFFF;
+    pos     = charloc >> 16;
+    height  = tf->tf_YSize;
+    size    = sizeof(struct GlyphCacheEntry) + width * height;
+
+    /* Make room by throwing out the glyphs that were used longest ago */
+    while (GFBI(GfxBase)->glyphcache_size + size > GLYPHCACHE_MAXSIZE)
+    {
+        struct GlyphCacheEntry *old;
+
+        old = (struct GlyphCacheEntry *)RemTail((struct List *)&GFBI(GfxBase)->glyphcache_lru);
+        if (NULL == old)
+            break;
+
+        old->gce_Cache->gc_Glyphs[old->gce_Index] = NULL;
+        GFBI(GfxBase)->glyphcache_size -= old->gce_Size;
+        GFBI(GfxBase)->glyphcache_evictions++;
+        FreeMem(old, old->gce_Size);
+    }
+
+    gce = AllocMem(size, MEMF_ANY);
+    if (NULL == gce)
+        return NULL;
+
+    gce->gce_Cache  = gc;
+    gce->gce_Size   = size;
+    gce->gce_Index  = idx;
+    gce->gce_Width  = width;
+    gce->gce_Height = height;
+
+    src = (UBYTE *)tf->tf_CharData;
+    dst = GCE_DATA(gce);
+    for (y = 0; y < height; y++)
+    {
+        for (x = pos; x < pos + width; x++)
+        {
+            *dst++ = (src[x / 8] >> (7 - (x & 7))) & 1;
+        }
+        src += tf->tf_Modulo;
+    }
+
+    AddHead((struct List *)&GFBI(GfxBase)->glyphcache_lru, (struct Node *)gce);
+    GFBI(GfxBase)->glyphcache_size += size;
+    gc->gc_Glyphs[idx] = gce;
+
+    gc->gc_Misses++;
+    GFBI(GfxBase)->glyphcache_misses++;
+
+    return gce;
+}
+
+/****************************************************************************************/
+
+void glyphcache_free(struct tfe_hashnode *hn, struct GfxBase *GfxBase)
+{
+    struct GlyphCache *gc = hn->glyphcache;
+    UWORD              i;
+
+    if (NULL == gc)
+        return;
+
+    ObtainSemaphore(&GFBI(GfxBase)->glyphcache_sema);
+
+    D(bug("[GlyphCache] font 0x%p: %u hits, %u misses; all fonts: %u hits, %u misses, %u evicted, %u bytes\n",
+          hn->back, gc->gc_Hits, gc->gc_Misses,
+          GFBI(GfxBase)->glyphcache_hits, GFBI(GfxBase)->glyphcache_misses,
+          GFBI(GfxBase)->glyphcache_evictions, GFBI(GfxBase)->glyphcache_size));
+
+    for (i = 0; i < gc->gc_NumGlyphs; i++)
+    {
+        struct GlyphCacheEntry *gce = gc->gc_Glyphs[i];
+
+        if (gce)
+        {
+            Remove((struct Node *)gce);
+            GFBI(GfxBase)->glyphcache_size -= gce->gce_Size;
+            FreeMem(gce, gce->gce_Size);
+        }
+    }
+
+    FreeMem(gc, sizeof(struct GlyphCache) + (gc->gc_NumGlyphs - 1) * sizeof(struct GlyphCacheEntry *));
+    hn->glyphcache = NULL;
+
+    ReleaseSemaphore(&GFBI(GfxBase)->glyphcache_sema);
+}
+
+/****************************************************************************************/
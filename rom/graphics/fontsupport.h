@@ -1,7 +1,7 @@
 #ifndef FONTSUPPORT_H
 #define FONTSUPPORT_H
 /*
-    Copyright  1995-2010, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Misc definitions internal to fonts.
@@ -23,6 +23,9 @@ struct tfe_hashnode
     
     /* Color font data in chunky format */
     UBYTE   	    	    	*chunky_colorfont;
+
+    /* Glyphs expanded for Text(), see glyphcache_obtain() */
+    struct GlyphCache	    	*glyphcache;
 };
 
 struct TextFontExtension_intern
@@ -31,6 +34,30 @@ struct TextFontExtension_intern
     struct tfe_hashnode      *hash;    
 };
 
+/* A glyph expanded to one byte per pixel, 0 or 1, followed by its data */
+struct GlyphCacheEntry
+{
+    struct MinNode  	    	 gce_Node;	/* LRU list, most recently used first */
+    struct GlyphCache	    	*gce_Cache;
+    ULONG   	    	    	 gce_Size;
+    UWORD   	    	    	 gce_Index;
+    UWORD   	    	    	 gce_Width;
+    UWORD   	    	    	 gce_Height;
+};
+
+#define GCE_DATA(gce)	((UBYTE *)((gce) + 1))
+
+struct GlyphCache
+{
+    ULONG   	    	    	 gc_Hits;
+    ULONG   	    	    	 gc_Misses;
+    UWORD   	    	    	 gc_NumGlyphs;
+    struct GlyphCacheEntry  	*gc_Glyphs[1];
+};
+
+/* Memory all cached glyphs may take up together */
+#define GLYPHCACHE_MAXSIZE  	(256 * 1024)
+
 #define TFE_INTERN(tfe) (*(struct TextFontExtension_intern **)&tfe)
 
 extern struct tfe_hashnode *tfe_hashlookup(struct TextFont *tf, struct GfxBase *GfxBase);
@@ -43,6 +70,10 @@ extern void tfe_hashdelete(struct TextFont *tf, struct GfxBase *GfxBase);
 struct tfe_hashnode *tfe_hashnode_create(struct GfxBase *GfxBase);
 
 UBYTE *colorfontbm_to_chunkybuffer(struct TextFont *font, struct GfxBase *GfxBase);
+
+struct GlyphCacheEntry *glyphcache_obtain(struct tfe_hashnode *hn, struct TextFont *tf,
+    	    	    	    	    	  ULONG idx, struct GfxBase *GfxBase);
+void glyphcache_free(struct tfe_hashnode *hn, struct GfxBase *GfxBase);
 	
 
 #endif /* FONTSUPPORT_H */
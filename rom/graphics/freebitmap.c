@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Free the memory occupied by a BitMap.
 */
@@ -61,6 +61,9 @@
         
         D(bug("%s: Free HIDD bitmap %p (obj %p)\n", __func__, bm, bmobj));
 
+        if (HIDD_BM_FLAGS(bm) & HIDD_BMF_SCREEN_BITMAP)
+            damage_forget(bm, GfxBase);
+
         if (HIDD_BM_FLAGS(bm) & HIDD_BMF_SHARED_PIXTAB)
         {
             /* NULL colormap otherwise bitmap killing also kills
@@ -210,6 +210,10 @@ BOOL GetRPClipRectangleForBitMap(struct RastPort *rp, struct BitMap *bm,
     	    	    	    	 struct Rectangle *r, struct GfxBase *GfxBase);
 
 void update_bitmap(struct BitMap *bitmap, OOP_Object *bm, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase);
+void update_bitmap_rect(struct BitMap *bitmap, OOP_Object *bm, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase);
+
+BOOL damage_add(struct BitMap *bitmap, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase);
+void damage_forget(struct BitMap *bitmap, struct GfxBase *GfxBase);
 
 void BltRastPortBitMap(struct RastPort *srcRastPort, WORD xSrc, WORD ySrc, 
 		       struct BitMap *destBitMap, WORD xDest, WORD yDest,
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2015, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Graphics library
 */
@@ -60,6 +60,11 @@ static int GfxInit(struct GfxBase *LIBBASE)
     InitSemaphore( &PrivGBase(GfxBase)->view_sema );
     InitSemaphore( &PrivGBase(GfxBase)->tfe_hashtab_sema );
     InitSemaphore( &PrivGBase(GfxBase)->fontsem );
+    InitSemaphore( &PrivGBase(GfxBase)->glyphcache_sema );
+    NEWLIST(&PrivGBase(GfxBase)->glyphcache_lru);
+    InitSemaphore( &PrivGBase(GfxBase)->damage_sema );
+    InitSemaphore( &PrivGBase(GfxBase)->damage_flushsema );
+    NEWLIST(&PrivGBase(GfxBase)->damage_list);
 
     NEWLIST(&LIBBASE->MonitorList);
     LIBBASE->MonitorList.lh_Type = MONITOR_SPEC_TYPE;
@@ -168,6 +173,10 @@ AROS_INTH1(TOF_VBlank, struct GfxBase *, GfxBase)
         }
     }
 
+    /* Let the damage task send what was drawn since the last frame */
+    if (PrivGBase(GfxBase)->damage_pending)
+        Signal(PrivGBase(GfxBase)->damage_task, SIGBREAKF_CTRL_F);
+
     return 0;
 
     AROS_INTFUNC_EXIT
@@ -1,7 +1,7 @@
 #ifndef GRAPHICS_INTERN_H
 #define GRAPHICS_INTERN_H
 /*
-    Copyright  1995-2017, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Internal header file for graphics.library
@@ -191,6 +191,24 @@ struct GfxBase_intern
     struct SignalSemaphore  	tfe_hashtab_sema;
     struct SignalSemaphore  	fontsem;
 
+    /* Glyph cache of Text(), shared by all fonts */
+    struct SignalSemaphore      glyphcache_sema;
+    struct MinList              glyphcache_lru;
+    ULONG                       glyphcache_size;
+    ULONG                       glyphcache_hits;
+    ULONG                       glyphcache_misses;
+    ULONG                       glyphcache_evictions;
+
+    /* Screen bitmap updates collected between vblanks, see damage.c */
+    struct SignalSemaphore      damage_sema;
+    struct SignalSemaphore      damage_flushsema;
+    struct MinList              damage_list;
+    struct Task                *damage_task;
+    volatile UBYTE              damage_pending;
+    UBYTE                       damage_state;
+    ULONG                       damage_submitted;
+    ULONG                       damage_flushed;
+
 #if REGIONS_USE_MEMPOOL
     /* Regions pool */
     struct SignalSemaphore  	regionsem;
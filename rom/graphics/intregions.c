@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Code for various operations on Regions and Rectangles
 */
@@ -850,6 +850,93 @@ end:
 }
 
 
+/*
+   Builds a region out of Count rectangles, for OrRectsRegion() and
+   ClearRectsRegion(). Adding the rectangles one at a time would merge
+   each of them with everything added before, which gets slow when there
+   are many. Instead both halves of the array are built on their own and
+   then merged, so that every rectangle takes part in only about log2(Count)
+   merges. Res must be empty. If the system runs out of memory the
+   function will deallocate any allocated memory and will return FALSE.
+   TRUE, otherwise.
+ */
+
+BOOL _RectsToRegion
+(
+    struct Rectangle *Rects,
+    ULONG             Count,
+    struct Region    *Res,
+    struct GfxBase   *GfxBase
+)
+{
+    struct Region R1, R2;
+    ULONG Half;
+    BOOL res;
+
+    if (!Count)
+        return TRUE;
+
+    if (Count == 1)
+    {
+        struct RegionRectangle *rr;
+
+        if (IS_RECT_EVIL(Rects))
+            return TRUE;
+
+        rr = _NewRegionRectangle(&Res->RegionRectangle, GfxBase);
+        if (!rr)
+            return FALSE;
+
+        Res->bounds = *Rects;
+
+        MinX(rr) = 0;
+        MinY(rr) = 0;
+        MaxX(rr) = Rects->MaxX - Rects->MinX;
+        MaxY(rr) = Rects->MaxY - Rects->MinY;
+
+        return TRUE;
+    }
+
+    InitRegion(&R1);
+    InitRegion(&R2);
+
+    Half = Count / 2;
+
+    if (!_RectsToRegion(Rects, Half, &R1, GfxBase))
+        return FALSE;
+
+    if (!_RectsToRegion(Rects + Half, Count - Half, &R2, GfxBase))
+    {
+        _DisposeRegionRectangleList(R1.RegionRectangle, GfxBase);
+        return FALSE;
+    }
+
+    if (!R1.RegionRectangle)
+    {
+        *Res = R2;
+        return TRUE;
+    }
+
+    if (!R2.RegionRectangle)
+    {
+        *Res = R1;
+        return TRUE;
+    }
+
+    res = _DoOperationBandBand(_OrBandBand,
+                               MinX(&R1), MinX(&R2), MinY(&R1), MinY(&R2),
+                               R1.RegionRectangle, R2.RegionRectangle,
+                               &Res->RegionRectangle, &Res->bounds, GfxBase);
+
+    _DisposeRegionRectangleList(R1.RegionRectangle, GfxBase);
+    _DisposeRegionRectangleList(R2.RegionRectangle, GfxBase);
+
+    if (res)
+        _TranslateRegionRectangles(Res->RegionRectangle, -MinX(Res), -MinY(Res));
+
+    return res;
+}
+
 #if DOTEST
 
 #undef GfxBase
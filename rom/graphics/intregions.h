@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2001, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Header file for intregions.c
 */
@@ -196,6 +196,14 @@ BOOL _DoOperationBandBand
 
 extern BandOperation _OrBandBand, _AndBandBand, _ClearBandBand;
 
+BOOL _RectsToRegion
+(
+    struct Rectangle *Rects,
+    ULONG             Count,
+    struct Region    *Res,
+    struct GfxBase   *GfxBase
+);
+
 #endif
 
 #endif /* !INTREGIONS_H */
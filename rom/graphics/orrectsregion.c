@@ -0,0 +1,108 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Graphics function OrRectsRegion()
+*/
+
+#include <exec/memory.h>
+#include <graphics/regions.h>
+#include <proto/exec.h>
+
+#include "graphics_intern.h"
+#include "intregions.h"
+
+/*****************************************************************************
+
+    NAME */
+#include <proto/graphics.h>
+
+        AROS_LH3(BOOL, OrRectsRegion,
+
+/*  SYNOPSIS */
+        AROS_LHA(struct Region    *, Reg,   A0),
+        AROS_LHA(struct Rectangle *, Rects, A1),
+        AROS_LHA(ULONG             , Count, D0),
+
+/*  LOCATION */
+        struct GfxBase *, GfxBase, 194, Graphics)
+
+/*  FUNCTION
+        Add an array of Rectangles to the given Region. The result
+        is the same as calling OrRectRegion() for each of them, but
+        it is a lot faster when there are many rectangles.
+
+    INPUTS
+        region - pointer to Region structure
+        rects - pointer to an array of Rectangle structures
+        count - number of rectangles in the array
+
+    RESULT
+        TRUE if the operation was successful, else FALSE
+        (out of memory). The region is left unchanged if the
+        operation fails.
+
+    NOTES
+        All relevant data is copied, you may throw away the
+        given rectangles after calling this function
+
+        This function is AROS specific.
+
+    EXAMPLE
+
+    BUGS
+
+    SEE ALSO
+        OrRectRegion(), ClearRectsRegion()
+
+    INTERNALS
+        The rectangles are first turned into a region of their own,
+        see _RectsToRegion(), which is then merged with the given one.
+
+    HISTORY
+
+*****************************************************************************/
+{
+    AROS_LIBFUNC_INIT
+
+    struct Region Add, Res;
+    BOOL res = TRUE;
+
+    InitRegion(&Add);
+
+    if (!_RectsToRegion(Rects, Count, &Add, GfxBase))
+        return FALSE;
+
+    if (!Add.RegionRectangle)
+    {
+        /* Nothing but evil rectangles */
+        return TRUE;
+    }
+
+    if (!Reg->RegionRectangle)
+    {
+        /* Region is empty, it simply becomes the new one */
+        *Reg = Add;
+        return TRUE;
+    }
+
+    InitRegion(&Res);
+
+    if (_DoOperationBandBand(_OrBandBand,
+                             MinX(&Add), MinX(Reg), MinY(&Add), MinY(Reg),
+                             Add.RegionRectangle, Reg->RegionRectangle,
+                             &Res.RegionRectangle, &Res.bounds, GfxBase))
+    {
+        ClearRegion(Reg);
+
+        *Reg = Res;
+        _TranslateRegionRectangles(Res.RegionRectangle, -MinX(&Res), -MinY(&Res));
+    }
+    else
+        res = FALSE;
+
+    _DisposeRegionRectangleList(Add.RegionRectangle, GfxBase);
+
+    return res;
+
+    AROS_LIBFUNC_EXIT
+} /* OrRectsRegion */
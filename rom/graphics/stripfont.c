@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2010, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Graphics function StripFont()
 */
@@ -66,6 +66,7 @@
         tfe = hn->ext;
         
         if (hn->chunky_colorfont) FreeVec(hn->chunky_colorfont);
+        glyphcache_free(hn, GfxBase);
         
         /* Remove the hashitem (tfe_hashdelete() has semaphore protection) */
         tfe_hashdelete(font, GfxBase);
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
     $Id$        $Log
 
     Desc: Graphics function Text()
@@ -16,6 +16,9 @@
 void BltTemplateBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
                           struct GfxBase *GfxBase);
 
+BOOL GlyphCacheBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
+                         struct GfxBase *GfxBase);
+
 void BltTemplateAlphaBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
                                struct GfxBase *GfxBase);
 
@@ -88,7 +91,10 @@ void ColorFontBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
         {
             ColorFontBasedText(rp, string, count, GfxBase);
         }
-        else
+        else if (!IS_HIDD_BM(rp->BitMap) ||
+                 (GetBitMapAttr(rp->BitMap, BMA_DEPTH) < 15) ||
+                 (rp->DrawMode & COMPLEMENT) ||
+                 !GlyphCacheBasedText(rp, string, count, GfxBase))
         {
             BltTemplateBasedText(rp, string, count, GfxBase);
         }
@@ -325,6 +331,221 @@ void BltTemplateBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
 
 /***************************************************************************/
 
+/*
+ * Plain text on hi- and truecolor bitmaps. The glyphs are taken from the
+ * glyph cache, already expanded to one byte per pixel, ORed together into
+ * a chunky buffer and written out through a LUT of the two pens, instead
+ * of building a single bit template that the driver has to expand again.
+ * Returns FALSE without drawing anything if the cache can't be used.
+ */
+BOOL GlyphCacheBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
+                         struct GfxBase *GfxBase)
+{
+    struct TextExtent    te;
+    struct TextFont     *tf = rp->Font;
+    struct tfe_hashnode *hn;
+    HIDDT_PixelLUT       pixlut;
+    HIDDT_Pixel          pixtab[2];
+    WORD                 raswidth, rasheight, x, y, gx;
+    UBYTE               *raster;
+    BOOL                 is_bold, is_italic, inverse;
+
+    if (!ExtendFont(tf, NULL))
+        return FALSE;
+
+    hn = ((struct TextFontExtension_intern *)(tf->tf_Extension))->hash;
+
+    TextExtent(rp, text, len, &te);
+
+    raswidth  = te.te_Extent.MaxX - te.te_Extent.MinX + 1;
+    rasheight = te.te_Extent.MaxY - te.te_Extent.MinY + 1;
+
+    if (!(raster = AllocVec(raswidth * rasheight, MEMF_CLEAR)))
+        return FALSE;
+
+    x = -te.te_Extent.MinX;
+
+    is_bold   = (rp->AlgoStyle & FSF_BOLD) != 0;
+    is_italic = (rp->AlgoStyle & FSF_ITALIC) != 0;
+
+    ObtainSemaphore(&PrivGBase(GfxBase)->glyphcache_sema);
+
+    while(len--)
+    {
+        struct GlyphCacheEntry *gce;
+        UBYTE c = *text++;
+        ULONG idx;
+        UWORD bold;
+
+        if (c < tf->tf_LoChar || c > tf->tf_HiChar)
+        {
+            idx = NUMCHARS(tf) - 1;
+        }
+        else
+        {
+            idx = c - tf->tf_LoChar;
+        }
+
+        if (!(gce = glyphcache_obtain(hn, tf, idx, GfxBase)))
+        {
+            ReleaseSemaphore(&PrivGBase(GfxBase)->glyphcache_sema);
+            FreeVec(raster);
+
+            return FALSE;
+        }
+
+        if (tf->tf_CharKern)
+        {
+            x += ((WORD *)tf->tf_CharKern)[idx];
+        }
+
+        for(bold = 0; bold <= is_bold; bold++)
+        {
+            WORD wx;
+            WORD italicshift, italiccheck = 0;
+            UBYTE *glyphdata = GCE_DATA(gce);
+            UBYTE *dst;
+
+            if (is_italic)
+            {
+                italiccheck = tf->tf_Baseline;
+                italicshift = italiccheck / 2;
+            }
+            else
+            {
+                italicshift = 0;
+            }
+
+            wx = x + italicshift + (bold ? tf->tf_BoldSmear : 0);
+            dst = raster + wx;
+
+            for(y = 0; (y < rasheight) && (y < gce->gce_Height); y++)
+            {
+                for(gx = 0; gx < gce->gce_Width; gx++)
+                {
+                    dst[gx] |= glyphdata[gx];
+                }
+
+                glyphdata += gce->gce_Width;
+                dst += raswidth;
+
+                if (is_italic)
+                {
+                    italiccheck--;
+                    if (italiccheck & 1)
+                    {
+                        italicshift--;
+                        dst--;
+                    }
+                }
+
+            } /* for(y = 0; y < rasheight; y++) */
+
+        } /* for(bold = 0; bold <= is_bold; bold++) */
+
+        if (tf->tf_CharSpace)
+        {
+            x += ((WORD *)tf->tf_CharSpace)[idx];
+        }
+        else
+        {
+            x += tf->tf_XSize;
+        }
+
+        x += rp->TxSpacing;
+
+    } /* while(len--) */
+
+    ReleaseSemaphore(&PrivGBase(GfxBase)->glyphcache_sema);
+
+    if (rp->AlgoStyle & FSF_UNDERLINED)
+    {
+        UBYTE *dst;
+        UBYTE prev_byte, act_byte = 0, next_byte;
+        WORD count;
+        LONG underline;
+
+        underline = rp->TxBaseline + 1;
+        if (underline < rasheight - 1) underline++;
+
+        if (underline < rasheight)
+        {
+            dst = raster + underline * (LONG)raswidth;
+            count  = raswidth;
+
+            next_byte = *dst;
+
+            while(count--)
+            {
+                prev_byte = act_byte;
+                act_byte = next_byte;
+                if (count > 1)
+                {
+                    next_byte = dst[1];
+                }
+                else
+                {
+                    next_byte = 0;
+                }
+
+                *dst++ = (act_byte || (!prev_byte && !next_byte)) ? 1 : 0;
+
+            } /* while(count--) */
+
+        } /* if (underline < rasheight) */
+
+    } /* if (rp->AlgoStyle & FSF_UNDERLINED) */
+
+    /*
+     * Set pixels take the foreground colour, or the background colour in
+     * inverse video. With pens disabled, the colours set with
+     * RPTAG_FgColor/RPTAG_BgColor are already pixel values.
+     */
+    inverse = (rp->DrawMode & INVERSVID) != 0;
+
+    if (rp->Flags & RPF_NO_PENS)
+    {
+        pixtab[inverse ? 0 : 1] = RP_FGCOLOR(rp);
+        pixtab[inverse ? 1 : 0] = RP_BGCOLOR(rp);
+    }
+    else
+    {
+        pixtab[inverse ? 0 : 1] = BM_PIXEL(rp->BitMap, rp->FgPen & PEN_MASK);
+        pixtab[inverse ? 1 : 0] = BM_PIXEL(rp->BitMap, rp->BgPen & PEN_MASK);
+    }
+
+    pixlut.entries = 2;
+    pixlut.pixels  = pixtab;
+
+    if (rp->DrawMode & JAM2)
+    {
+        write_pixels_8(rp, raster, raswidth,
+                       rp->cp_x + te.te_Extent.MinX,
+                       rp->cp_y - rp->TxBaseline,
+                       rp->cp_x + te.te_Extent.MinX + raswidth - 1,
+                       rp->cp_y - rp->TxBaseline + rasheight - 1,
+                       &pixlut, TRUE, GfxBase);
+    }
+    else
+    {
+        /* JAM1 leaves what the template doesn't cover alone */
+        write_transp_pixels_8(rp, raster, raswidth,
+                              rp->cp_x + te.te_Extent.MinX,
+                              rp->cp_y - rp->TxBaseline,
+                              rp->cp_x + te.te_Extent.MinX + raswidth - 1,
+                              rp->cp_y - rp->TxBaseline + rasheight - 1,
+                              &pixlut, inverse ? 1 : 0, TRUE, GfxBase);
+    }
+
+    FreeVec(raster);
+
+    Move(rp, rp->cp_x + te.te_Width, rp->cp_y);
+
+    return TRUE;
+}
+
+/***************************************************************************/
+
 void BltTemplateAlphaBasedText(struct RastPort *rp, CONST_STRPTR text, ULONG len,
                                struct GfxBase *GfxBase)
 {
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2011-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2011-2026, The AROS Development Team. All rights reserved.
 
     Desc: Update specified region of the bitmap, taking software composition into account.
           Private function for cybergraphics.library support.
@@ -28,6 +28,18 @@ AROS_LH5(void, UpdateBitMap,
 }
 
 void update_bitmap(struct BitMap *bitmap, OOP_Object *bm, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase)
+{
+    /* Updates of screen bitmaps are collected and passed on once a frame */
+    if (IS_HIDD_BM(bitmap) && (HIDD_BM_FLAGS(bitmap) & HIDD_BMF_SCREEN_BITMAP) &&
+        (bm == HIDD_BM_OBJ(bitmap)) && damage_add(bitmap, x, y, width, height, GfxBase))
+    {
+        return;
+    }
+
+    update_bitmap_rect(bitmap, bm, x, y, width, height, GfxBase);
+}
+
+void update_bitmap_rect(struct BitMap *bitmap, OOP_Object *bm, UWORD x, UWORD y, UWORD width, UWORD height, struct GfxBase *GfxBase)
 {
     struct monitor_driverdata *mdd = GET_BM_DRIVERDATA(bitmap);
 
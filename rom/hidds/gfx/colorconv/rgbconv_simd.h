@@ -0,0 +1,64 @@
+#ifndef RGBCONV_SIMD_H
+#define RGBCONV_SIMD_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Parameters shared by the vectorised RGB conversion routines.
+*/
+
+/*
+ * The vector routines do not hardcode what a conversion does. When the
+ * gfx hidd starts up, every scalar conversion routine between two
+ * byte-aligned formats is run on probe pixels to find out which source
+ * byte ends up in which destination byte, or (for the 15/16 bit formats)
+ * which source bits are moved by how much. Only conversions that can be
+ * described like that are handed to the vector routines, so they produce
+ * exactly the same output as the scalar ones. Whatever a vector routine
+ * leaves over at the right edge is done by the scalar routine.
+ */
+
+/* Describes one conversion, found with SetSIMDRGBConversionParams() */
+struct RGBConvParams
+{
+    HIDDT_RGBConversionFunction rcp_Generic;    /* The scalar routine          */
+    UBYTE                       rcp_Flags;
+    UBYTE                       rcp_SrcBpp;     /* 2, 3 or 4                   */
+    UBYTE                       rcp_DstBpp;
+    UBYTE                       rcp_NumShifts;
+    UBYTE                       rcp_Shuffle[16];/* Source byte of each of 4 destination
+                                                   pixels' bytes, 0x80 for zero */
+    LONG                        rcp_Shift[4];   /* As for DOSHIFT(), > 0 shifts right */
+    ULONG                       rcp_ShiftMask[4];/* Source bits moved by rcp_Shift[] */
+};
+
+#define RCPF_SHUFFLE    (1 << 0)        /* rcp_Shuffle[] is valid */
+#define RCPF_SHIFT      (1 << 1)        /* rcp_Shift[] and rcp_ShiftMask[] are valid */
+
+#define RGBCONV_MAXPARAMS       160
+
+extern UBYTE rgbconv_paramindex[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
+extern struct RGBConvParams rgbconv_params[RGBCONV_MAXPARAMS];
+
+#define RGBCONVPARAMS(srcfmt, dstfmt) \
+    (&rgbconv_params[rgbconv_paramindex[(srcfmt) - FIRST_RGB_STDPIXFMT][(dstfmt) - FIRST_RGB_STDPIXFMT] - 1])
+
+/* Let the scalar routine convert the pixels from column x on */
+#define RGBCONV_TAIL(params, x)                                                         \
+    if ((x) < width)                                                                    \
+        (params)->rcp_Generic((UBYTE *)srcPixels + (x) * (params)->rcp_SrcBpp, srcMod, srcPixFmt, \
+                              (UBYTE *)dstPixels + (x) * (params)->rcp_DstBpp, dstMod, dstPixFmt, \
+                              width - (x), height);
+
+#define SIMDCONVERTFUNC(name, arch) \
+ULONG convert_ ## name ## _ ## arch \
+    (APTR srcPixels, ULONG srcMod, HIDDT_StdPixFmt srcPixFmt, \
+    APTR dstPixels, ULONG dstMod, HIDDT_StdPixFmt dstPixFmt, \
+    UWORD width, UWORD height)
+
+#define SIMDCONVERTFUNCP(name, arch) \
+extern SIMDCONVERTFUNC(name, arch);
+
+void SetSIMDRGBConversionParams(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT]);
+
+#endif /* RGBCONV_SIMD_H */
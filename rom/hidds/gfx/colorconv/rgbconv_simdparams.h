@@ -0,0 +1,247 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Finds out what the scalar RGB conversion routines do, so that
+          the vectorised ones can do the same. Included by the
+          architecture's rgbconv_arch.c.
+*/
+
+#include <string.h>
+
+#include "colorconv/rgbconv_simd.h"
+
+#define RGBCONV_PROBES  8
+
+UBYTE rgbconv_paramindex[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
+struct RGBConvParams rgbconv_params[RGBCONV_MAXPARAMS];
+
+static UBYTE rgbconv_bpp(HIDDT_StdPixFmt fmt)
+{
+    switch (fmt)
+    {
+    case vHidd_StdPixFmt_RGB24:
+    case vHidd_StdPixFmt_BGR24:
+        return 3;
+
+    case FMT_RGB16:
+    case FMT_BGR16:
+    case FMT_RGB15:
+    case FMT_BGR15:
+        return 2;
+
+    case vHidd_StdPixFmt_ARGB32:
+    case vHidd_StdPixFmt_BGRA32:
+    case vHidd_StdPixFmt_RGBA32:
+    case vHidd_StdPixFmt_ABGR32:
+    case vHidd_StdPixFmt_0RGB32:
+    case vHidd_StdPixFmt_BGR032:
+    case vHidd_StdPixFmt_RGB032:
+    case vHidd_StdPixFmt_0BGR32:
+        return 4;
+
+    default:
+        /* The byte swapped 15/16 bit formats are left to the scalar routines */
+        return 0;
+    }
+}
+
+static ULONG rgbconv_random(ULONG *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+
+    return (*seed >> 8) ^ (*seed << 16);
+}
+
+/* One pixel of any format the shifts are probed for */
+union RGBConvPixel
+{
+    ULONG   l;
+    UWORD   w;
+};
+
+static void rgbconv_setpixel(union RGBConvPixel *pix, UBYTE bpp, ULONG val)
+{
+    if (bpp == 2)
+        pix->w = val;
+    else
+        pix->l = val;
+}
+
+static ULONG rgbconv_getpixel(union RGBConvPixel *pix, UBYTE bpp)
+{
+    return (bpp == 2) ? pix->w : pix->l;
+}
+
+static ULONG rgbconv_applyshift(struct RGBConvParams *rcp, ULONG val)
+{
+    ULONG res = 0;
+    UBYTE i;
+
+    for (i = 0; i < rcp->rcp_NumShifts; i++)
+        res |= DOSHIFT(val & rcp->rcp_ShiftMask[i], rcp->rcp_Shift[i]);
+
+    return res;
+}
+
+/*
+ * Check if the conversion only moves whole bytes around. Four pixels made
+ * of the bytes 1, 2, 3, ... are converted, any non-zero destination byte
+ * then tells where it came from.
+ */
+static BOOL rgbconv_probeshuffle(struct RGBConvParams *rcp, HIDDT_StdPixFmt srcfmt, HIDDT_StdPixFmt dstfmt)
+{
+    ULONG inbuf[4], outbuf[4];
+    UBYTE *in = (UBYTE *)inbuf, *out = (UBYTE *)outbuf;
+    UBYTE ref[16];
+    ULONG seed = 12345;
+    UBYTE i, j;
+
+    for (i = 0; i < 16; i++)
+        in[i] = i + 1;
+    memset(out, 0, sizeof(outbuf));
+    rcp->rcp_Generic(in, 4 * rcp->rcp_SrcBpp, srcfmt, out, 4 * rcp->rcp_DstBpp, dstfmt, 4, 1);
+
+    for (i = 0; i < 16; i++)
+    {
+        if ((i >= 4 * rcp->rcp_DstBpp) || (out[i] == 0))
+            rcp->rcp_Shuffle[i] = 0x80;
+        else if (out[i] > 4 * rcp->rcp_SrcBpp)
+            return FALSE;
+        else
+            rcp->rcp_Shuffle[i] = out[i] - 1;
+    }
+
+    /* Every pixel has to be converted the same way */
+    for (i = rcp->rcp_DstBpp; i < 4 * rcp->rcp_DstBpp; i++)
+    {
+        UBYTE first = rcp->rcp_Shuffle[i % rcp->rcp_DstBpp];
+
+        if (first & 0x80)
+        {
+            if (!(rcp->rcp_Shuffle[i] & 0x80))
+                return FALSE;
+        }
+        else if (rcp->rcp_Shuffle[i] != first + (i / rcp->rcp_DstBpp) * rcp->rcp_SrcBpp)
+            return FALSE;
+    }
+
+    /* Make sure it wasn't a coincidence */
+    for (j = 0; j < RGBCONV_PROBES; j++)
+    {
+        for (i = 0; i < 16; i++)
+            in[i] = rgbconv_random(&seed);
+        rcp->rcp_Generic(in, 4 * rcp->rcp_SrcBpp, srcfmt, out, 4 * rcp->rcp_DstBpp, dstfmt, 4, 1);
+
+        for (i = 0; i < 4 * rcp->rcp_DstBpp; i++)
+            ref[i] = (rcp->rcp_Shuffle[i] & 0x80) ? 0 : in[rcp->rcp_Shuffle[i]];
+        if (memcmp(out, ref, 4 * rcp->rcp_DstBpp))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * Check if the conversion can be written as up to four masked shifts,
+ * like DOWNSHIFT16() and UPSHIFT16() do. Such a conversion moves every
+ * source bit to at most one destination bit, so converting each single
+ * bit tells it all.
+ */
+static BOOL rgbconv_probeshift(struct RGBConvParams *rcp, HIDDT_StdPixFmt srcfmt, HIDDT_StdPixFmt dstfmt)
+{
+    union RGBConvPixel in, out;
+    ULONG seed = 54321;
+    UBYTE bit, i;
+
+    rcp->rcp_NumShifts = 0;
+
+    for (bit = 0; bit < rcp->rcp_SrcBpp * 8; bit++)
+    {
+        ULONG pix = (ULONG)1 << bit, res;
+        LONG shift;
+
+        rgbconv_setpixel(&in, rcp->rcp_SrcBpp, pix);
+        out.l = 0;
+        rcp->rcp_Generic(&in, rcp->rcp_SrcBpp, srcfmt, &out, rcp->rcp_DstBpp, dstfmt, 1, 1);
+
+        res = rgbconv_getpixel(&out, rcp->rcp_DstBpp);
+        if (res == 0)
+            continue;
+        if (res & (res - 1))
+            return FALSE;
+
+        for (shift = bit; res > 1; res >>= 1)
+            shift--;
+
+        for (i = 0; i < rcp->rcp_NumShifts; i++)
+        {
+            if (rcp->rcp_Shift[i] == shift)
+                break;
+        }
+        if (i == rcp->rcp_NumShifts)
+        {
+            if (i == 4)
+                return FALSE;
+            rcp->rcp_Shift[i] = shift;
+            rcp->rcp_ShiftMask[i] = 0;
+            rcp->rcp_NumShifts++;
+        }
+        rcp->rcp_ShiftMask[i] |= pix;
+    }
+
+    for (i = 0; i < RGBCONV_PROBES; i++)
+    {
+        ULONG pix = rgbconv_random(&seed);
+
+        if (rcp->rcp_SrcBpp == 2)
+            pix &= 0xFFFF;
+        rgbconv_setpixel(&in, rcp->rcp_SrcBpp, pix);
+        out.l = 0;
+        rcp->rcp_Generic(&in, rcp->rcp_SrcBpp, srcfmt, &out, rcp->rcp_DstBpp, dstfmt, 1, 1);
+
+        if (rgbconv_getpixel(&out, rcp->rcp_DstBpp) != rgbconv_applyshift(rcp, pix))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+void SetSIMDRGBConversionParams(HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT])
+{
+    HIDDT_StdPixFmt srcfmt, dstfmt;
+    UBYTE count = 0;
+
+    memset(rgbconv_paramindex, 0, sizeof(rgbconv_paramindex));
+
+    for (srcfmt = FIRST_RGB_STDPIXFMT; srcfmt <= LAST_RGB_STDPIXFMT; srcfmt++)
+    {
+        for (dstfmt = FIRST_RGB_STDPIXFMT; dstfmt <= LAST_RGB_STDPIXFMT; dstfmt++)
+        {
+            struct RGBConvParams *rcp = &rgbconv_params[count];
+            UBYTE srcbpp = rgbconv_bpp(srcfmt);
+            UBYTE dstbpp = rgbconv_bpp(dstfmt);
+
+            /* There are no vector routines between the 15/16 bit formats */
+            if ((srcfmt == dstfmt) || !srcbpp || !dstbpp || ((srcbpp == 2) && (dstbpp == 2)))
+                continue;
+            if (count == RGBCONV_MAXPARAMS)
+                return;
+
+            rcp->rcp_Generic = rgbconvertfuncs[srcfmt - FIRST_RGB_STDPIXFMT][dstfmt - FIRST_RGB_STDPIXFMT];
+            if (!rcp->rcp_Generic)
+                continue;
+
+            rcp->rcp_Flags = 0;
+            rcp->rcp_SrcBpp = srcbpp;
+            rcp->rcp_DstBpp = dstbpp;
+
+            if ((srcbpp != 2) && (dstbpp != 2) && rgbconv_probeshuffle(rcp, srcfmt, dstfmt))
+                rcp->rcp_Flags |= RCPF_SHUFFLE;
+            if ((srcbpp != 3) && (dstbpp != 3) && rgbconv_probeshift(rcp, srcfmt, dstfmt))
+                rcp->rcp_Flags |= RCPF_SHIFT;
+
+            if (rcp->rcp_Flags)
+                rgbconv_paramindex[srcfmt - FIRST_RGB_STDPIXFMT][dstfmt - FIRST_RGB_STDPIXFMT] = ++count;
+        }
+    }
+}
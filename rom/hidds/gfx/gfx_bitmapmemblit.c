@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <string.h>
@@ -11,6 +11,140 @@
 
 /****************************************************************************************/
 
+/*
+ * Templates and patterns are expanded in chunks of up to 32 pixels by the
+ * routines in CSD(cl)->memblitfuncs. Bit 31 of a chunk belongs to its
+ * first pixel.
+ */
+
+#define MEMBLIT_CHUNK   32
+
+/* Get count bits starting at bit pos of a big endian bit array, reading only the bytes needed */
+static inline ULONG memblit_getbits(UBYTE *array, ULONG pos, ULONG count)
+{
+    UBYTE *p = array + (pos >> 3);
+    ULONG nbytes = ((pos & 7) + count + 7) >> 3;
+    UQUAD bits = 0;
+    ULONG i;
+
+    for (i = 0; i < nbytes; i++)
+        bits |= (UQUAD)p[i] << (56 - i * 8);
+
+    return (ULONG)((bits << (pos & 7)) >> 32);
+}
+
+static WORD memblit_type(OOP_Object *gc, BOOL invert)
+{
+    WORD type;
+
+    if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
+    {
+        type = 0;
+    }
+    else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
+    {
+        type = 2;
+    }
+    else
+    {
+        type = 4;
+    }
+
+    if (invert) type++;
+
+    return type;
+}
+
+/* Draw one chunk. Only pixels with a bit set in mask may be touched. */
+static inline VOID memblit_chunk(WORD type, UBYTE *dst, ULONG bits, ULONG mask, ULONG count,
+                                 ULONG fg, ULONG bg, MemBlitExpandFunc expand, MemBlitInvertFunc invert)
+{
+    switch(type)
+    {
+        case 0:     /* JAM1 */
+            expand(dst, ~0, bits & mask, count, fg, bg);
+            break;
+
+        case 1:     /* JAM1 | INVERSVID */
+            expand(dst, ~0, ~bits & mask, count, fg, bg);
+            break;
+
+        case 2:     /* COMPLEMENT */
+            invert(dst, bits & mask, count);
+            break;
+
+        case 3:     /* COMPLEMENT | INVERSVID*/
+            invert(dst, ~bits & mask, count);
+            break;
+
+        case 4:     /* JAM2 */
+            expand(dst, bits, mask, count, fg, bg);
+            break;
+
+        case 5:     /* JAM2 | INVERSVID */
+            expand(dst, ~bits, mask, count, fg, bg);
+            break;
+    }
+}
+
+static VOID memblit_template(OOP_Object *gc, UBYTE *masktemplate, ULONG modulo, WORD srcx,
+                             UBYTE *buf, ULONG dstMod, ULONG bpp, WORD width, WORD height, BOOL inverttemplate,
+                             MemBlitExpandFunc expand, MemBlitInvertFunc invert)
+{
+    WORD   type = memblit_type(gc, inverttemplate);
+    ULONG  fg = GC_FG(gc);
+    ULONG  bg = GC_BG(gc);
+    UBYTE *bitarray = masktemplate + ((srcx / 16) * 2);
+    WORD   x, y;
+
+    for(y = 0; y < height; y++)
+    {
+        for(x = 0; x < width; x += MEMBLIT_CHUNK)
+        {
+            ULONG count = (width - x < MEMBLIT_CHUNK) ? width - x : MEMBLIT_CHUNK;
+            ULONG bits = memblit_getbits(bitarray, (srcx & 0xF) + x, count);
+
+            memblit_chunk(type, buf + x * bpp, bits, ~0, count, fg, bg, expand, invert);
+        }
+
+        buf += dstMod;
+        bitarray += modulo;
+    }
+}
+
+static VOID memblit_pattern(OOP_Object *gc, UBYTE *pattern, WORD patternsrcx, WORD patternsrcy, WORD patternheight,
+                            BOOL invertpattern, UBYTE *mask, ULONG maskmodulo, WORD masksrcx,
+                            UBYTE *buf, ULONG dstMod, ULONG bpp, WORD width, WORD height,
+                            MemBlitExpandFunc expand, MemBlitInvertFunc invert)
+{
+    WORD   type = memblit_type(gc, invertpattern);
+    ULONG  fg = GC_FG(gc);
+    ULONG  bg = GC_BG(gc);
+    UBYTE *maskarray = mask ? mask + (masksrcx / 16) * 2 : NULL;
+    WORD   x, y;
+
+    for(y = 0; y < height; y++)
+    {
+        UWORD patword = AROS_BE2WORD(((UWORD *)pattern)[(y + patternsrcy) % patternheight]);
+        /* The pattern repeats every 16 pixels */
+        UQUAD patbits = patword * 0x0001000100010001ULL;
+
+        for(x = 0; x < width; x += MEMBLIT_CHUNK)
+        {
+            ULONG count = (width - x < MEMBLIT_CHUNK) ? width - x : MEMBLIT_CHUNK;
+            ULONG bits = (ULONG)(patbits >> (32 - ((patternsrcx + x) & 0xF)));
+            ULONG maskbits = maskarray ? memblit_getbits(maskarray, (masksrcx & 0xF) + x, count) : ~0;
+
+            memblit_chunk(type, buf + x * bpp, bits, maskbits, count, fg, bg, expand, invert);
+        }
+
+        buf += dstMod;
+        if (maskarray) maskarray += maskmodulo;
+    }
+}
+
+/****************************************************************************************/
+
 VOID BM__Hidd_BitMap__FillMemRect8(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_FillMemRect8 *msg)
 {
     UBYTE *start;
@@ -62,48 +196,14 @@ VOID BM__Hidd_BitMap__FillMemRect8(OOP_Class *cl, OOP_Object *o, struct pHidd_Bi
 VOID BM__Hidd_BitMap__FillMemRect16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_FillMemRect16 *msg)
 {
     UBYTE *start;
-    LONG phase, width, height, w, p;
-    ULONG fill32;
-    ULONG start_add;
-    
+
+    if ((msg->maxX < msg->minX) || (msg->maxY < msg->minY))
+        return;
+
     start = msg->dstBuf + msg->minY * msg->dstMod + msg->minX * 2;
-    width = msg->maxX - msg->minX + 1;
-    height = msg->maxY - msg->minY + 1;
-    start_add = msg->dstMod - width * 2;
-        
-    if ((phase = (IPTR)start & 1L))
-    {
-        phase = 2 - phase;
-        if (phase > width) phase = width;
-        width -= phase;
-    }
-    
-    fill32 = msg->fill;
-    fill32 |= (fill32 << 16);
-    
-    while(height--)
-    {
-        w = width;
-        p = phase;
-        
-        while(p--)
-        {
-            *((UWORD *)start) = (UWORD)fill32;
-            start += 2;
-        }
-        while(w >= 2)
-        {
-            *((ULONG *)start) = fill32;
-            w -= 2; start += 4;
-        }
-        while(w--)
-        {
-            *((UWORD *)start) = (UWORD)fill32;
-            start += 2;
-        }
-        start += start_add;
-    }
-    
+
+    CSD(cl)->memblitfuncs.mbf_Fill16(start, msg->dstMod, msg->maxX - msg->minX + 1,
+                                      msg->maxY - msg->minY + 1, msg->fill);
 }
 
 /****************************************************************************************/
@@ -111,38 +211,14 @@ VOID BM__Hidd_BitMap__FillMemRect16(OOP_Class *cl, OOP_Object *o, struct pHidd_B
 VOID BM__Hidd_BitMap__FillMemRect24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_FillMemRect24 *msg)
 {
     UBYTE *start;
-    LONG width, height, w;
-    UBYTE fill1, fill2, fill3;
-    ULONG start_add;
-    
-    start = msg->dstBuf + msg->minY * msg->dstMod + msg->minX * 3;
-    width = msg->maxX - msg->minX + 1;
-    height = msg->maxY - msg->minY + 1;
-    start_add = msg->dstMod - width * 3;
 
-#if AROS_BIG_ENDIAN
-    fill1 = (msg->fill >> 16) & 0xFF;
-    fill2 = (msg->fill >> 8) & 0xFF;
-    fill3 =  msg->fill & 0xFF;
-#else
-    fill1 =  msg->fill & 0xFF;
-    fill2 = (msg->fill >> 8) & 0xFF;
-    fill3 = (msg->fill >> 16) & 0xFF;
-#endif
+    if ((msg->maxX < msg->minX) || (msg->maxY < msg->minY))
+        return;
 
-    while(height--)
-    {
-        w = width;
-        
-        while(w--)
-        {
-            *start++ = fill1;
-            *start++ = fill2;
-            *start++ = fill3;
-        }
+    start = msg->dstBuf + msg->minY * msg->dstMod + msg->minX * 3;
 
-        start += start_add;
-    }
+    CSD(cl)->memblitfuncs.mbf_Fill24(start, msg->dstMod, msg->maxX - msg->minX + 1,
+                                      msg->maxY - msg->minY + 1, msg->fill);
 }
 
 /****************************************************************************************/
@@ -150,29 +226,14 @@ VOID BM__Hidd_BitMap__FillMemRect24(OOP_Class *cl, OOP_Object *o, struct pHidd_B
 VOID BM__Hidd_BitMap__FillMemRect32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_FillMemRect32 *msg)
 {
     UBYTE *start;
-    LONG width, height, w;
-    ULONG fill32;
-    ULONG start_add;
-    
+
+    if ((msg->maxX < msg->minX) || (msg->maxY < msg->minY))
+        return;
+
     start = msg->dstBuf + msg->minY * msg->dstMod + msg->minX * 4;
-    width = msg->maxX - msg->minX + 1;
-    height = msg->maxY - msg->minY + 1;
-    start_add = msg->dstMod - width * 4;
-        
-    fill32 = msg->fill;
-        
-    while(height--)
-    {
-        w = width;
-        
-        while(w--)
-        {
-            *((ULONG *)start) = fill32;
-            start += 4;
-        }
 
-        start += start_add;
-    }
+    CSD(cl)->memblitfuncs.mbf_Fill32(start, msg->dstMod, msg->maxX - msg->minX + 1,
+                                      msg->maxY - msg->minY + 1, msg->fill);
 }
 
 /****************************************************************************************/
@@ -324,273 +385,96 @@ VOID BM__Hidd_BitMap__CopyMemBox8(OOP_Class *cl, OOP_Object *o, struct pHidd_Bit
 VOID BM__Hidd_BitMap__CopyMemBox16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyMemBox16 *msg)
 {
     UBYTE *src_start, *dst_start;
-    LONG phase, width, height, w, p;
+
+    if (!msg->width || !msg->height)
+        return;
+
+    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 2;
+    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 2;
+
+    /* Takes care of overlapping boxes */
+    CSD(cl)->memblitfuncs.mbf_Copy(src_start, msg->srcMod, dst_start, msg->dstMod,
+                                   msg->width * 2, msg->height);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__CopyMemBox24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyMemBox24 *msg)
+{
+    UBYTE *src_start, *dst_start;
+
+    if (!msg->width || !msg->height)
+        return;
+
+    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 3;
+    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 3;
+
+    /* Takes care of overlapping boxes */
+    CSD(cl)->memblitfuncs.mbf_Copy(src_start, msg->srcMod, dst_start, msg->dstMod,
+                                   msg->width * 3, msg->height);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__CopyMemBox32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyMemBox32 *msg)
+{
+    UBYTE *src_start, *dst_start;
+
+    if (!msg->width || !msg->height)
+        return;
+
+    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 4;
+    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 4;
+
+    /* Takes care of overlapping boxes */
+    CSD(cl)->memblitfuncs.mbf_Copy(src_start, msg->srcMod, dst_start, msg->dstMod,
+                                   msg->width * 4, msg->height);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__CopyLUTMemBox16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyLUTMemBox16 *msg)
+{
+    HIDDT_Pixel *pixlut = msg->pixlut->pixels;
+    UBYTE *src_start, *dst_start;
+    LONG width, height, w;
     ULONG src_start_add, dst_start_add;
-    BOOL descending;
+    
+    if (!pixlut) return;
     
     width = msg->width;
     height = msg->height;
 
-    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 2;
-    src_start_add = msg->srcMod - width * 2;
+    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX;
+    src_start_add = msg->srcMod - width;
 
     dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 2;
     dst_start_add = msg->dstMod - width * 2;
         
-    if ((IPTR)src_start > (IPTR)dst_start)
-    {
-        if ((phase = (IPTR)src_start & 1L))
-        {
-            phase = 2 - phase;
-            if (phase > width) phase = width;
-            width -= phase;
-        }
-        descending = FALSE;
-    }
-    else
-    {
-        src_start += (height - 1) * msg->srcMod + width * 2;
-        dst_start += (height - 1) * msg->dstMod + width * 2;
-        
-        phase = ((IPTR)src_start & 1L);
-        if (phase > width) phase = width;
-        width -= phase;
-        
-        descending = TRUE;
-    }
- 
-    if (!descending)
+    while(height--)
     {
-        while(height--)
-        {
-            w = width;
-            p = phase;
+        w = width;
 
-            while(p--)
-            {
-                *((UWORD *)dst_start) = *((UWORD *)src_start);
-                dst_start += 2; src_start += 2;
-            }
-            while(w >= 2)
-            {
-                *((ULONG *)dst_start) = *((ULONG *)src_start);
-                w -= 2; dst_start += 4; src_start += 4;
-            }
-            while(w--)
-            {
-                *((UWORD *)dst_start) = *((UWORD *)src_start);
-                dst_start += 2; src_start += 2;
-            }
-            src_start += src_start_add;
-            dst_start += dst_start_add;
-        }
-    }
-    else
-    {
-        while(height--)
+        while(w--)
         {
-            w = width;
-            p = phase;
-
-            while(p--)
-            {
-                dst_start -= 2; src_start -= 2;
-                *(UWORD *)dst_start = *(UWORD *)src_start;
-            }
-            while(w >= 2)
-            {
-                dst_start -= 4; src_start -= 4;
-                *(ULONG *)dst_start = *(ULONG *)src_start;
-                w -= 2;
-            }
-            while(w--)
-            {
-                dst_start -= 2; src_start -= 2;
-                *(UWORD *)dst_start = *(UWORD *)src_start;
-            }
-            src_start -= src_start_add;
-            dst_start -= dst_start_add;
+            *(UWORD *)dst_start = (UWORD)(pixlut[*src_start++]);
+            dst_start += 2;
         }
-     }
-    
+        src_start += src_start_add;
+        dst_start += dst_start_add;
+    }
 }
 
 /****************************************************************************************/
 
-VOID BM__Hidd_BitMap__CopyMemBox24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyMemBox24 *msg)
+VOID BM__Hidd_BitMap__CopyLUTMemBox24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyLUTMemBox24 *msg)
 {
+    HIDDT_Pixel *pixlut = msg->pixlut->pixels;
     UBYTE *src_start, *dst_start;
     LONG width, height, w;
     ULONG src_start_add, dst_start_add;
-    BOOL descending;
-    
-    width = msg->width;
-    height = msg->height;
-
-    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 3;
-    src_start_add = msg->srcMod - width * 3;
-
-    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 3;
-    dst_start_add = msg->dstMod - width * 3;
-        
-    if ((IPTR)src_start > (IPTR)dst_start)
-    {
-        descending = FALSE;
-    }
-    else
-    {
-        src_start += (height - 1) * msg->srcMod + width * 3;
-        dst_start += (height - 1) * msg->dstMod + width * 3;
-        
-        descending = TRUE;
-    }
- 
-    if (!descending)
-    {
-        while(height--)
-        {
-            w = width;
-
-            while(w--)
-            {
-                *dst_start++ = *src_start++;
-                *dst_start++ = *src_start++;
-                *dst_start++ = *src_start++;
-            }
-
-            src_start += src_start_add;
-            dst_start += dst_start_add;
-        }
-    }
-    else
-    {
-        while(height--)
-        {
-            w = width;
-
-            while(w--)
-            {
-                *--dst_start = *--src_start;
-                *--dst_start = *--src_start;
-                *--dst_start = *--src_start;
-            }
-            
-            src_start -= src_start_add;
-            dst_start -= dst_start_add;
-        }
-     }
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__CopyMemBox32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyMemBox32 *msg)
-{
-    UBYTE *src_start, *dst_start;
-    LONG width, height, w;
-    ULONG src_start_add, dst_start_add;
-    BOOL descending;
-    
-    width = msg->width;
-    height = msg->height;
-
-    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX * 4;
-    src_start_add = msg->srcMod - width * 4;
-
-    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 4;
-    dst_start_add = msg->dstMod - width * 4;
-        
-    if ((IPTR)src_start > (IPTR)dst_start)
-    {
-        descending = FALSE;
-    }
-    else
-    {
-        src_start += (height - 1) * msg->srcMod + width * 4;
-        dst_start += (height - 1) * msg->dstMod + width * 4;
-        
-        descending = TRUE;
-    }
- 
-    if (!descending)
-    {
-        while(height--)
-        {
-            w = width;
-
-            while(w--)
-            {
-                *((ULONG *)dst_start) = *((ULONG *)src_start);
-                dst_start += 4; src_start += 4;
-            }
-
-            src_start += src_start_add;
-            dst_start += dst_start_add;
-        }
-    }
-    else
-    {
-        while(height--)
-        {
-            w = width;
-
-            while(w--)
-            {
-                dst_start -= 4; src_start -= 4;
-                *(ULONG *)dst_start = *(ULONG *)src_start;
-            }
-            
-            src_start -= src_start_add;
-            dst_start -= dst_start_add;
-        }
-     }
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__CopyLUTMemBox16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyLUTMemBox16 *msg)
-{
-    HIDDT_Pixel *pixlut = msg->pixlut->pixels;
-    UBYTE *src_start, *dst_start;
-    LONG width, height, w;
-    ULONG src_start_add, dst_start_add;
-    
-    if (!pixlut) return;
-    
-    width = msg->width;
-    height = msg->height;
-
-    src_start = msg->src + msg->srcY * msg->srcMod + msg->srcX;
-    src_start_add = msg->srcMod - width;
-
-    dst_start = msg->dst + msg->dstY * msg->dstMod + msg->dstX * 2;
-    dst_start_add = msg->dstMod - width * 2;
-        
-    while(height--)
-    {
-        w = width;
-
-        while(w--)
-        {
-            *(UWORD *)dst_start = (UWORD)(pixlut[*src_start++]);
-            dst_start += 2;
-        }
-        src_start += src_start_add;
-        dst_start += dst_start_add;
-    }
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__CopyLUTMemBox24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_CopyLUTMemBox24 *msg)
-{
-    HIDDT_Pixel *pixlut = msg->pixlut->pixels;
-    UBYTE *src_start, *dst_start;
-    LONG width, height, w;
-    ULONG src_start_add, dst_start_add;
-
-    if (!pixlut) return;
+
+    if (!pixlut) return;
     
     width = msg->width;
     height = msg->height;
@@ -985,1392 +869,73 @@ VOID BM__Hidd_BitMap__PutMemTemplate8(OOP_Class *cl, OOP_Object *o, struct pHidd
                     }
 
                 } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    *xbuf++ = (bitword & mask) ? bg : fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        bitarray += msg->modulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemTemplate16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate16 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *bitarray, *buf;
-    UWORD                    bitmask;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    ULONG                    bg = GC_BG(gc);
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-    if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-    {
-        type = 0;
-    }
-    else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-    {
-        type = 2;
-    }
-    else
-    {
-        type = 4;
-    }
-    
-    if (msg->inverttemplate) type++;
-    
-    bitarray = msg->masktemplate + ((msg->srcx / 16) * 2);
-    bitmask = 0x8000 >> (msg->srcx & 0xF);
-    
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 2;
-
-    for(y = 0; y < msg->height; y++)
-    {
-        ULONG  mask = bitmask;
-        UWORD *array = (UWORD *)bitarray;
-        UWORD  bitword = AROS_BE2WORD(*array);
-        UWORD *xbuf = (UWORD *)buf;
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (bitword & mask) *xbuf = fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!(bitword & mask)) *xbuf = fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (bitword & mask) *xbuf = ~(*xbuf);
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!(bitword & mask)) *xbuf = ~(*xbuf);
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                 } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++)
-                {
-                    *xbuf++ = (bitword & mask) ? fg : bg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    *xbuf++ = (bitword & mask) ? bg : fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        bitarray += msg->modulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemTemplate24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate24 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *bitarray, *buf;
-    UWORD                    bitmask;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    UBYTE                    fg1, fg2, fg3;
-    ULONG                    bg = GC_BG(gc);
-    UBYTE                    bg1, bg2, bg3;
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-#if AROS_BIG_ENDIAN
-    fg1 = (fg >> 16) & 0xFF;
-    fg2 = (fg >> 8) & 0xFF;
-    fg3 =  fg & 0xFF;
-
-    bg1 = (bg >> 16) & 0xFF;
-    bg2 = (bg >> 8) & 0xFF;
-    bg3 =  bg & 0xFF;
-#else
-    fg1 =  fg & 0xFF;
-    fg2 = (fg >> 8) & 0xFF;
-    fg3 = (fg >> 16) & 0xFF;
-
-    bg1 =  bg & 0xFF;
-    bg2 = (bg >> 8) & 0xFF;
-    bg3 = (bg >> 16) & 0xFF;
-#endif
-
-    if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-    {
-        type = 0;
-    }
-    else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-    {
-        type = 2;
-    }
-    else
-    {
-        type = 4;
-    }
-    
-    if (msg->inverttemplate) type++;
-    
-    bitarray = msg->masktemplate + ((msg->srcx / 16) * 2);
-    bitmask = 0x8000 >> (msg->srcx & 0xF);
-    
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 3;
-    
-    for(y = 0; y < msg->height; y++)
-    {
-        ULONG  mask = bitmask;
-        UWORD *array = (UWORD *)bitarray;
-        UWORD  bitword = AROS_BE2WORD(*array);
-        UBYTE *xbuf = buf;
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (bitword & mask)
-                    {
-                        xbuf[0] = fg1;
-                        xbuf[1] = fg2;
-                        xbuf[2] = fg3;
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!(bitword & mask))
-                    {
-                        xbuf[0] = fg1;
-                        xbuf[1] = fg2;
-                        xbuf[2] = fg3;
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (bitword & mask)
-                    {
-                        xbuf[0] = ~xbuf[0];
-                        xbuf[1] = ~xbuf[1];
-                        xbuf[2] = ~xbuf[2];
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!(bitword & mask))
-                    {
-                        xbuf[0] = ~xbuf[0];
-                        xbuf[1] = ~xbuf[1];
-                        xbuf[2] = ~xbuf[2];
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                 } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (bitword & mask)
-                    {
-                        *xbuf++ = fg1;
-                        *xbuf++ = fg2;
-                        *xbuf++ = fg3;
-                    }
-                    else
-                    {
-                        *xbuf++ = bg1;
-                        *xbuf++ = bg2;
-                        *xbuf++ = bg3;
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (bitword & mask)
-                    {
-                        *xbuf++ = bg1;
-                        *xbuf++ = bg2;
-                        *xbuf++ = bg3;
-                    }
-                    else
-                    {
-                        *xbuf++ = fg1;
-                        *xbuf++ = fg2;
-                        *xbuf++ = fg3;
-                    }
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        bitarray += msg->modulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemTemplate32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate32 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *bitarray, *buf;
-    UWORD                    bitmask;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    ULONG                    bg = GC_BG(gc);
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-    if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-    {
-        type = 0;
-    }
-    else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-    {
-        type = 2;
-    }
-    else
-    {
-        type = 4;
-    }
-    
-    if (msg->inverttemplate) type++;
-    
-    bitarray = msg->masktemplate + ((msg->srcx / 16) * 2);
-    bitmask = 0x8000 >> (msg->srcx & 0xF);
-    
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 4;
-    
-    for(y = 0; y < msg->height; y++)
-    {
-        ULONG  mask = bitmask;
-        UWORD *array = (UWORD *)bitarray;
-        UWORD  bitword = AROS_BE2WORD(*array);
-        ULONG *xbuf = (ULONG *)buf;
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (bitword & mask) *xbuf = fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!(bitword & mask)) *xbuf = fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (bitword & mask) *xbuf = ~(*xbuf);
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!(bitword & mask)) *xbuf = ~(*xbuf);
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                 } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++)
-                {
-                    *xbuf++ = (bitword & mask) ? fg : bg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    *xbuf++ = (bitword & mask) ? bg : fg;
-
-                    mask >>= 1;
-                    if (!mask)
-                    {
-                        mask = 0x8000;
-                        array++;
-                        bitword = AROS_BE2WORD(*array);
-                    }
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        bitarray += msg->modulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemPattern8(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern8 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *patarray, *buf, *maskarray = 0;
-    UWORD                    patmask, maskmask = 0;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    ULONG                    bg = GC_BG(gc);
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-    if (msg->patterndepth > 1)
-    {
-        type = 6;
-    }
-    else
-    {
-        if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-        {
-            type = 0;
-        }
-        else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-        {
-            type = 2;
-        }
-        else
-        {
-            type = 4;
-        }
-
-        if (msg->invertpattern) type++;
-    }
-
-    patarray = msg->pattern;
-    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
-
-    if ((maskarray = msg->mask))
-    {
-        maskarray += (msg->masksrcx / 16) * 2;
-        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
-    }
-        
-    buf = msg->dst + msg->y * msg->dstMod + msg->x;
-    
-    for(y = 0; y < msg->height; y++)
-    {
-        UWORD  pmask = patmask;
-        UWORD  mmask = maskmask;
-        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
-        UWORD  patword = AROS_BE2WORD(*parray);
-        UWORD *marray = NULL;
-        UWORD  maskword = 0;
-        UBYTE *xbuf = (UBYTE *)buf;
-
-        if (maskarray)
-        {
-            marray = (UWORD *)maskarray;
-            maskword = AROS_BE2WORD(*marray);
-        }
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask) *xbuf = fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
- 
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask)) *xbuf = fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask) *xbuf = ~(*xbuf);
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask)) *xbuf = ~(*xbuf);
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        xbuf[x] = (patword & pmask) ? fg : bg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        xbuf[x] = (patword & pmask) ? bg : fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 6: /* multi color pattern */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        WORD plane;
-                        ULONG pixel = (patword & pmask) ? 1 : 0;
-
-                        for(plane = 1; plane < msg->patterndepth; plane++)
-                        {
-                            UWORD *_parray = parray + plane * msg->patternheight;
-                            UWORD _patword = AROS_BE2WORD(*_parray);
-
-                            if (_patword & pmask) pixel |= 1L << plane;
-                        }
-
-                        if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
-
-                        xbuf[x] = pixel;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        if (maskarray) maskarray += msg->maskmodulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-    
-}
-
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemPattern16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern16 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *patarray, *buf, *maskarray = 0;
-    UWORD                    patmask, maskmask = 0;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    ULONG                    bg = GC_BG(gc);
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-    if (msg->patterndepth > 1)
-    {
-        type = 6;
-    }
-    else
-    {
-        if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-        {
-            type = 0;
-        }
-        else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-        {
-            type = 2;
-        }
-        else
-        {
-            type = 4;
-        }
-
-        if (msg->invertpattern) type++;
-    }
-
-    patarray = msg->pattern;
-    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
-
-    if ((maskarray = msg->mask))
-    {
-        maskarray += (msg->masksrcx / 16) * 2;
-        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
-    }
-        
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 2;
-    
-    for(y = 0; y < msg->height; y++)
-    {
-        UWORD  pmask = patmask;
-        UWORD  mmask = maskmask;
-        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
-        UWORD  patword = AROS_BE2WORD(*parray);
-        UWORD *marray = NULL;
-        UWORD  maskword = 0;
-        UWORD *xbuf = (UWORD *)buf;
-
-        if (maskarray)
-        {
-            marray = (UWORD *)maskarray;
-            maskword = AROS_BE2WORD(*marray);
-        }
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask) *xbuf = fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
- 
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask)) *xbuf = fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask) *xbuf = ~(*xbuf);
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask)) *xbuf = ~(*xbuf);
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        xbuf[x] = (patword & pmask) ? fg : bg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        xbuf[x] = (patword & pmask) ? bg : fg;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 6: /* multi color pattern */
-                for(x = 0; x < msg->width; x++)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        WORD plane;
-                        ULONG pixel = (patword & pmask) ? 1 : 0;
-
-                        for(plane = 1; plane < msg->patterndepth; plane++)
-                        {
-                            UWORD *_parray = parray + plane * msg->patternheight;
-                            UWORD _patword = AROS_BE2WORD(*_parray);
-
-                            if (_patword & pmask) pixel |= 1L << plane;
-                        }
-
-                        if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
-
-                        xbuf[x] = pixel;
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-        } /* switch(type) */
-
-        buf += msg->dstMod;
-        if (maskarray) maskarray += msg->maskmodulo;
-
-    } /* for(y = 0; y < msg->height; y++) */
-    
-}
-/****************************************************************************************/
-
-VOID BM__Hidd_BitMap__PutMemPattern24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern24 *msg)
-{
-    WORD                     x, y;
-    UBYTE                   *patarray, *buf, *maskarray = 0;
-    UWORD                    patmask, maskmask = 0;
-    OOP_Object              *gc = msg->gc;
-    ULONG                    fg = GC_FG(gc);
-    UBYTE                    fg1, fg2, fg3;
-    ULONG                    bg = GC_BG(gc);
-    UBYTE                    bg1, bg2, bg3;
-    WORD                     type = 0;
-    
-    if (msg->width <= 0 || msg->height <= 0)
-        return;
-
-#if AROS_BIG_ENDIAN
-    fg1 = (fg >> 16) & 0xFF;
-    fg2 = (fg >> 8) & 0xFF;
-    fg3 =  fg & 0xFF;
-
-    bg1 = (bg >> 16) & 0xFF;
-    bg2 = (bg >> 8) & 0xFF;
-    bg3 =  bg & 0xFF;
-#else
-    fg1 =  fg & 0xFF;
-    fg2 = (fg >> 8) & 0xFF;
-    fg3 = (fg >> 16) & 0xFF;
-
-    bg1 =  bg & 0xFF;
-    bg2 = (bg >> 8) & 0xFF;
-    bg3 = (bg >> 16) & 0xFF;
-#endif
-
-    if (msg->patterndepth > 1)
-    {
-        type = 6;
-    }
-    else
-    {
-        if (GC_COLEXP(gc) == vHidd_GC_ColExp_Transparent)
-        {
-            type = 0;
-        }
-        else if (GC_DRMD(gc) == vHidd_GC_DrawMode_Invert)
-        {
-            type = 2;
-        }
-        else
-        {
-            type = 4;
-        }
-
-        if (msg->invertpattern) type++;
-    }
-
-    patarray = msg->pattern;
-    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
-
-    if ((maskarray = msg->mask))
-    {
-        maskarray += (msg->masksrcx / 16) * 2;
-        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
-    }
-        
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 3;
-    
-    for(y = 0; y < msg->height; y++)
-    {
-        UWORD  pmask = patmask;
-        UWORD  mmask = maskmask;
-        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
-        UWORD  patword = AROS_BE2WORD(*parray);
-        UWORD *marray = NULL;
-        UWORD  maskword = 0;
-        UBYTE *xbuf = (UBYTE *)buf;
-
-        if (maskarray)
-        {
-            marray = (UWORD *)maskarray;
-            maskword = AROS_BE2WORD(*marray);
-        }
-
-        switch(type)
-        {
-            case 0:     /* JAM1 */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask)
-                        {
-                            xbuf[0] = fg1;
-                            xbuf[1] = fg2;
-                            xbuf[2] = fg3;
-                        }
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
- 
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 1:     /* JAM1 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask))
-                        {
-                            xbuf[0] = fg1;
-                            xbuf[1] = fg2;
-                            xbuf[2] = fg3;
-                        }
-
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 2: /* COMPLEMENT */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask)
-                        {
-                            xbuf[0] = ~xbuf[0];
-                            xbuf[1] = ~xbuf[1];
-                            xbuf[2] = ~xbuf[2];
-                        }
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 3: /* COMPLEMENT | INVERSVID*/
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (!(patword & pmask))
-                        {
-                            xbuf[0] = ~xbuf[0];
-                            xbuf[1] = ~xbuf[1];
-                            xbuf[2] = ~xbuf[2];
-                        }
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-                        
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 4:     /* JAM2 */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask)
-                        {
-                            xbuf[0] = fg1;
-                            xbuf[1] = fg2;
-                            xbuf[2] = fg3;
-                        }
-                        else
-                        {
-                            xbuf[0] = bg1;
-                            xbuf[1] = bg2;
-                            xbuf[2] = bg3;
-                        }
-                        
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 5:     /* JAM2 | INVERSVID */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        if (patword & pmask)
-                        {
-                            xbuf[0] = bg1;
-                            xbuf[1] = bg2;
-                            xbuf[2] = bg3;
-                        }
-                        else
-                        {
-                            xbuf[0] = fg1;
-                            xbuf[1] = fg2;
-                            xbuf[2] = fg3;
-                        }
-                        
-                    }
-
-                    if (maskarray)
-                    {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
-                    }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
-                } /* for(x = 0; x < msg->width; x++) */
-                break;
-
-            case 6: /* multi color pattern */
-                for(x = 0; x < msg->width; x++, xbuf += 3)
-                {
-                    if (!maskarray || (maskword & mmask))
-                    {
-                        WORD plane;
-                        ULONG pixel = (patword & pmask) ? 1 : 0;
-
-                        for(plane = 1; plane < msg->patterndepth; plane++)
-                        {
-                            UWORD *_parray = parray + plane * msg->patternheight;
-                            UWORD _patword = AROS_BE2WORD(*_parray);
-
-                            if (_patword & pmask) pixel |= 1L << plane;
-                        }
-
-                        if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
+                break;
 
-                    #if AROS_BIG_ENDIAN
-                        xbuf[0] = (pixel >> 16) & 0xFF;
-                        xbuf[1] = (pixel >> 8) & 0xFF;
-                        xbuf[2] = (pixel) & 0xFF;
-                    #else
-                        xbuf[0] = (pixel) & 0xFF;
-                        xbuf[1] = (pixel >> 8) & 0xFF;
-                        xbuf[2] = (pixel >> 16) & 0xFF;
-                    #endif
-                    }
+            case 5:     /* JAM2 | INVERSVID */
+                for(x = 0; x < msg->width; x++)
+                {
+                    *xbuf++ = (bitword & mask) ? bg : fg;
 
-                    if (maskarray)
+                    mask >>= 1;
+                    if (!mask)
                     {
-                        mmask >>= 1;
-                        if (!mmask)
-                        {
-                            mmask = 0x8000;
-                            marray++;
-                            maskword = AROS_BE2WORD(*marray);
-                        }
+                        mask = 0x8000;
+                        array++;
+                        bitword = AROS_BE2WORD(*array);
                     }
-
-                    pmask >>= 1;
-                    if (!pmask) pmask = 0x8000;
-
                 } /* for(x = 0; x < msg->width; x++) */
                 break;
 
         } /* switch(type) */
 
         buf += msg->dstMod;
-        if (maskarray) maskarray += msg->maskmodulo;
+        bitarray += msg->modulo;
 
     } /* for(y = 0; y < msg->height; y++) */
-    
 }
 
 /****************************************************************************************/
 
-VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern32 *msg)
+VOID BM__Hidd_BitMap__PutMemTemplate16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate16 *msg)
+{
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    memblit_template(msg->gc, msg->masktemplate, msg->modulo, msg->srcx,
+                     msg->dst + msg->y * msg->dstMod + msg->x * 2, msg->dstMod, 2,
+                     msg->width, msg->height, msg->inverttemplate,
+                     CSD(cl)->memblitfuncs.mbf_Expand16, CSD(cl)->memblitfuncs.mbf_Invert16);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemTemplate24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate24 *msg)
+{
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    memblit_template(msg->gc, msg->masktemplate, msg->modulo, msg->srcx,
+                     msg->dst + msg->y * msg->dstMod + msg->x * 3, msg->dstMod, 3,
+                     msg->width, msg->height, msg->inverttemplate,
+                     CSD(cl)->memblitfuncs.mbf_Expand24, CSD(cl)->memblitfuncs.mbf_Invert24);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemTemplate32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemTemplate32 *msg)
+{
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    memblit_template(msg->gc, msg->masktemplate, msg->modulo, msg->srcx,
+                     msg->dst + msg->y * msg->dstMod + msg->x * 4, msg->dstMod, 4,
+                     msg->width, msg->height, msg->inverttemplate,
+                     CSD(cl)->memblitfuncs.mbf_Expand32, CSD(cl)->memblitfuncs.mbf_Invert32);
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemPattern8(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern8 *msg)
 {
     WORD                     x, y;
     UBYTE                   *patarray, *buf, *maskarray = 0;
@@ -2414,7 +979,7 @@ VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd
         maskmask = 0x8000 >> (msg->masksrcx & 0xF);
     }
         
-    buf = msg->dst + msg->y * msg->dstMod + msg->x * 4;
+    buf = msg->dst + msg->y * msg->dstMod + msg->x;
     
     for(y = 0; y < msg->height; y++)
     {
@@ -2424,7 +989,7 @@ VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd
         UWORD  patword = AROS_BE2WORD(*parray);
         UWORD *marray = NULL;
         UWORD  maskword = 0;
-        ULONG *xbuf = (ULONG *)buf;
+        UBYTE *xbuf = (UBYTE *)buf;
 
         if (maskarray)
         {
@@ -2631,3 +1196,287 @@ VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd
 }
 
 /****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemPattern16(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern16 *msg)
+{
+    WORD                     x, y;
+    UBYTE                   *patarray, *buf, *maskarray = 0;
+    UWORD                    patmask, maskmask = 0;
+
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    buf = msg->dst + msg->y * msg->dstMod + msg->x * 2;
+
+    if (msg->patterndepth <= 1)
+    {
+        memblit_pattern(msg->gc, msg->pattern, msg->patternsrcx, msg->patternsrcy, msg->patternheight,
+                        msg->invertpattern, msg->mask, msg->maskmodulo, msg->masksrcx,
+                        buf, msg->dstMod, 2, msg->width, msg->height,
+                        CSD(cl)->memblitfuncs.mbf_Expand16, CSD(cl)->memblitfuncs.mbf_Invert16);
+        return;
+    }
+
+    /* multi color pattern */
+
+    patarray = msg->pattern;
+    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
+
+    if ((maskarray = msg->mask))
+    {
+        maskarray += (msg->masksrcx / 16) * 2;
+        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
+    }
+
+    for(y = 0; y < msg->height; y++)
+    {
+        UWORD  pmask = patmask;
+        UWORD  mmask = maskmask;
+        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+        UWORD  patword = AROS_BE2WORD(*parray);
+        UWORD *marray = NULL;
+        UWORD  maskword = 0;
+        UWORD *xbuf = (UWORD *)buf;
+
+        if (maskarray)
+        {
+            marray = (UWORD *)maskarray;
+            maskword = AROS_BE2WORD(*marray);
+        }
+
+        for(x = 0; x < msg->width; x++)
+        {
+            if (!maskarray || (maskword & mmask))
+            {
+                WORD plane;
+                ULONG pixel = (patword & pmask) ? 1 : 0;
+
+                for(plane = 1; plane < msg->patterndepth; plane++)
+                {
+                    UWORD *_parray = parray + plane * msg->patternheight;
+                    UWORD _patword = AROS_BE2WORD(*_parray);
+
+                    if (_patword & pmask) pixel |= 1L << plane;
+                }
+
+                if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
+
+                xbuf[x] = pixel;
+            }
+
+            if (maskarray)
+            {
+                mmask >>= 1;
+                if (!mmask)
+                {
+                    mmask = 0x8000;
+                    marray++;
+                    maskword = AROS_BE2WORD(*marray);
+                }
+            }
+
+            pmask >>= 1;
+            if (!pmask) pmask = 0x8000;
+
+        } /* for(x = 0; x < msg->width; x++) */
+
+        buf += msg->dstMod;
+        if (maskarray) maskarray += msg->maskmodulo;
+
+    } /* for(y = 0; y < msg->height; y++) */
+
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemPattern24(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern24 *msg)
+{
+    WORD                     x, y;
+    UBYTE                   *patarray, *buf, *maskarray = 0;
+    UWORD                    patmask, maskmask = 0;
+
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    buf = msg->dst + msg->y * msg->dstMod + msg->x * 3;
+
+    if (msg->patterndepth <= 1)
+    {
+        memblit_pattern(msg->gc, msg->pattern, msg->patternsrcx, msg->patternsrcy, msg->patternheight,
+                        msg->invertpattern, msg->mask, msg->maskmodulo, msg->masksrcx,
+                        buf, msg->dstMod, 3, msg->width, msg->height,
+                        CSD(cl)->memblitfuncs.mbf_Expand24, CSD(cl)->memblitfuncs.mbf_Invert24);
+        return;
+    }
+
+    /* multi color pattern */
+
+    patarray = msg->pattern;
+    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
+
+    if ((maskarray = msg->mask))
+    {
+        maskarray += (msg->masksrcx / 16) * 2;
+        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
+    }
+
+    for(y = 0; y < msg->height; y++)
+    {
+        UWORD  pmask = patmask;
+        UWORD  mmask = maskmask;
+        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+        UWORD  patword = AROS_BE2WORD(*parray);
+        UWORD *marray = NULL;
+        UWORD  maskword = 0;
+        UBYTE *xbuf = buf;
+
+        if (maskarray)
+        {
+            marray = (UWORD *)maskarray;
+            maskword = AROS_BE2WORD(*marray);
+        }
+
+        for(x = 0; x < msg->width; x++, xbuf += 3)
+        {
+            if (!maskarray || (maskword & mmask))
+            {
+                WORD plane;
+                ULONG pixel = (patword & pmask) ? 1 : 0;
+
+                for(plane = 1; plane < msg->patterndepth; plane++)
+                {
+                    UWORD *_parray = parray + plane * msg->patternheight;
+                    UWORD _patword = AROS_BE2WORD(*_parray);
+
+                    if (_patword & pmask) pixel |= 1L << plane;
+                }
+
+                if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
+
+                #if AROS_BIG_ENDIAN
+                xbuf[0] = (pixel >> 16) & 0xFF;
+                xbuf[1] = (pixel >> 8) & 0xFF;
+                xbuf[2] = (pixel) & 0xFF;
+#else
+                xbuf[0] = (pixel) & 0xFF;
+                xbuf[1] = (pixel >> 8) & 0xFF;
+                xbuf[2] = (pixel >> 16) & 0xFF;
+#endif
+            }
+
+            if (maskarray)
+            {
+                mmask >>= 1;
+                if (!mmask)
+                {
+                    mmask = 0x8000;
+                    marray++;
+                    maskword = AROS_BE2WORD(*marray);
+                }
+            }
+
+            pmask >>= 1;
+            if (!pmask) pmask = 0x8000;
+
+        } /* for(x = 0; x < msg->width; x++) */
+
+        buf += msg->dstMod;
+        if (maskarray) maskarray += msg->maskmodulo;
+
+    } /* for(y = 0; y < msg->height; y++) */
+
+}
+
+/****************************************************************************************/
+
+VOID BM__Hidd_BitMap__PutMemPattern32(OOP_Class *cl, OOP_Object *o, struct pHidd_BitMap_PutMemPattern32 *msg)
+{
+    WORD                     x, y;
+    UBYTE                   *patarray, *buf, *maskarray = 0;
+    UWORD                    patmask, maskmask = 0;
+
+    if (msg->width <= 0 || msg->height <= 0)
+        return;
+
+    buf = msg->dst + msg->y * msg->dstMod + msg->x * 4;
+
+    if (msg->patterndepth <= 1)
+    {
+        memblit_pattern(msg->gc, msg->pattern, msg->patternsrcx, msg->patternsrcy, msg->patternheight,
+                        msg->invertpattern, msg->mask, msg->maskmodulo, msg->masksrcx,
+                        buf, msg->dstMod, 4, msg->width, msg->height,
+                        CSD(cl)->memblitfuncs.mbf_Expand32, CSD(cl)->memblitfuncs.mbf_Invert32);
+        return;
+    }
+
+    /* multi color pattern */
+
+    patarray = msg->pattern;
+    patmask = 0x8000 >> (msg->patternsrcx & 0xF);
+
+    if ((maskarray = msg->mask))
+    {
+        maskarray += (msg->masksrcx / 16) * 2;
+        maskmask = 0x8000 >> (msg->masksrcx & 0xF);
+    }
+
+    for(y = 0; y < msg->height; y++)
+    {
+        UWORD  pmask = patmask;
+        UWORD  mmask = maskmask;
+        UWORD *parray = ((UWORD *)patarray) + ((y + msg->patternsrcy) % msg->patternheight);
+        UWORD  patword = AROS_BE2WORD(*parray);
+        UWORD *marray = NULL;
+        UWORD  maskword = 0;
+        ULONG *xbuf = (ULONG *)buf;
+
+        if (maskarray)
+        {
+            marray = (UWORD *)maskarray;
+            maskword = AROS_BE2WORD(*marray);
+        }
+
+        for(x = 0; x < msg->width; x++)
+        {
+            if (!maskarray || (maskword & mmask))
+            {
+                WORD plane;
+                ULONG pixel = (patword & pmask) ? 1 : 0;
+
+                for(plane = 1; plane < msg->patterndepth; plane++)
+                {
+                    UWORD *_parray = parray + plane * msg->patternheight;
+                    UWORD _patword = AROS_BE2WORD(*_parray);
+
+                    if (_patword & pmask) pixel |= 1L << plane;
+                }
+
+                if (msg->patternlut) pixel = msg->patternlut->pixels[pixel];
+
+                xbuf[x] = pixel;
+            }
+
+            if (maskarray)
+            {
+                mmask >>= 1;
+                if (!mmask)
+                {
+                    mmask = 0x8000;
+                    marray++;
+                    maskword = AROS_BE2WORD(*marray);
+                }
+            }
+
+            pmask >>= 1;
+            if (!pmask) pmask = 0x8000;
+
+        } /* for(x = 0; x < msg->width; x++) */
+
+        buf += msg->dstMod;
+        if (maskarray) maskarray += msg->maskmodulo;
+
+    } /* for(y = 0; y < msg->height; y++) */
+
+}
+
+/****************************************************************************************/
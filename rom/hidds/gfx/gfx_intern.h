@@ -16,6 +16,8 @@
 #include <graphics/gfxbase.h>
 #include <graphics/monitor.h>
 
+#include "memblit.h"
+
 #define USE_FAST_GETPIXEL		1
 #define USE_FAST_PUTPIXEL		1
 #define OPTIMIZE_DRAWPIXEL_FOR_COPY	1
@@ -340,6 +342,9 @@ struct class_static_data
 
     HIDDT_RGBConversionFunction rgbconvertfuncs[NUM_RGB_STDPIXFMT][NUM_RGB_STDPIXFMT];
     struct SignalSemaphore rgbconvertfuncs_sem;
+
+    /* Routines behind the FillMemRect, CopyMemBox, PutMemTemplate and PutMemPattern methods */
+    struct MemBlitFuncs    memblitfuncs;
 };
 
 #define __IHidd_BitMap	    (csd->attrBases[0])
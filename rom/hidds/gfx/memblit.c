@@ -0,0 +1,342 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Portable memory blit routines.
+*/
+
+#include <exec/types.h>
+#include <hidd/gfx.h>
+
+#include "memblit.h"
+
+/*
+ * These move a whole register (IPTR) at a time wherever source and
+ * destination allow it, and only ever access memory with the alignment
+ * of the type used.
+ */
+
+#define MEMBLIT_ALIGN(ptr, type)   (((IPTR)(ptr) & (sizeof(type) - 1)) == 0)
+
+static IPTR memblit_replicate32(ULONG fill)
+{
+    IPTR pattern = fill;
+
+    if (sizeof(IPTR) > 4)
+        pattern |= (pattern << 16) << 16;
+
+    return pattern;
+}
+
+/****************************************************************************************/
+
+static VOID fill16_generic(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    UWORD fill16 = fill;
+    IPTR pattern = memblit_replicate32(fill16 | (fill16 << 16));
+
+    while (height--)
+    {
+        UBYTE *p = dst;
+        ULONG w = width;
+
+        while (w && !MEMBLIT_ALIGN(p, IPTR))
+        {
+            *(UWORD *)p = fill16;
+            p += 2; w--;
+        }
+        while (w >= sizeof(IPTR) / 2)
+        {
+            *(IPTR *)p = pattern;
+            p += sizeof(IPTR); w -= sizeof(IPTR) / 2;
+        }
+        while (w--)
+        {
+            *(UWORD *)p = fill16;
+            p += 2;
+        }
+
+        dst += dstMod;
+    }
+}
+
+static VOID fill24_generic(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    /* Three registers hold a whole number of pixels, starting at any of their three bytes */
+    union
+    {
+        UBYTE b[3 * sizeof(IPTR)];
+        IPTR  w[3];
+    } pattern[3];
+    UBYTE pix[3];
+    ULONG i, j;
+
+#if AROS_BIG_ENDIAN
+    pix[0] = (fill >> 16) & 0xFF;
+    pix[1] = (fill >> 8) & 0xFF;
+    pix[2] =  fill & 0xFF;
+#else
+    pix[0] =  fill & 0xFF;
+    pix[1] = (fill >> 8) & 0xFF;
+    pix[2] = (fill >> 16) & 0xFF;
+#endif
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 3 * sizeof(IPTR); j++)
+            pattern[i].b[j] = pix[(i + j) % 3];
+    }
+
+    while (height--)
+    {
+        UBYTE *p = dst;
+        ULONG bytes = width * 3;
+        ULONG phase = 0;
+        IPTR w0, w1, w2;
+
+        while (bytes && !MEMBLIT_ALIGN(p, IPTR))
+        {
+            *p++ = pix[phase];
+            if (++phase == 3) phase = 0;
+            bytes--;
+        }
+
+        w0 = pattern[phase].w[0];
+        w1 = pattern[phase].w[1];
+        w2 = pattern[phase].w[2];
+        while (bytes >= 3 * sizeof(IPTR))
+        {
+            ((IPTR *)p)[0] = w0;
+            ((IPTR *)p)[1] = w1;
+            ((IPTR *)p)[2] = w2;
+            p += 3 * sizeof(IPTR); bytes -= 3 * sizeof(IPTR);
+        }
+
+        while (bytes--)
+        {
+            *p++ = pix[phase];
+            if (++phase == 3) phase = 0;
+        }
+
+        dst += dstMod;
+    }
+}
+
+static VOID fill32_generic(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill)
+{
+    IPTR pattern = memblit_replicate32(fill);
+
+    while (height--)
+    {
+        UBYTE *p = dst;
+        ULONG w = width;
+
+        while (w && !MEMBLIT_ALIGN(p, IPTR))
+        {
+            *(ULONG *)p = fill;
+            p += 4; w--;
+        }
+        while (w >= sizeof(IPTR) / 4)
+        {
+            *(IPTR *)p = pattern;
+            p += sizeof(IPTR); w -= sizeof(IPTR) / 4;
+        }
+        while (w--)
+        {
+            *(ULONG *)p = fill;
+            p += 4;
+        }
+
+        dst += dstMod;
+    }
+}
+
+/****************************************************************************************/
+
+#define MEMBLIT_COPYFORWARD(type, d, s, n)              \
+    while ((n) && !MEMBLIT_ALIGN(d, type))              \
+    {                                                   \
+        *(d)++ = *(s)++; (n)--;                         \
+    }                                                   \
+    while ((n) >= sizeof(type))                         \
+    {                                                   \
+        *(type *)(d) = *(type *)(s);                    \
+        (d) += sizeof(type); (s) += sizeof(type);       \
+        (n) -= sizeof(type);                            \
+    }                                                   \
+    while (n)                                           \
+    {                                                   \
+        *(d)++ = *(s)++; (n)--;                         \
+    }
+
+#define MEMBLIT_COPYBACKWARD(type, d, s, n)             \
+    while ((n) && !MEMBLIT_ALIGN(d, type))              \
+    {                                                   \
+        *--(d) = *--(s); (n)--;                         \
+    }                                                   \
+    while ((n) >= sizeof(type))                         \
+    {                                                   \
+        (d) -= sizeof(type); (s) -= sizeof(type);       \
+        *(type *)(d) = *(type *)(s);                    \
+        (n) -= sizeof(type);                            \
+    }                                                   \
+    while (n)                                           \
+    {                                                   \
+        *--(d) = *--(s); (n)--;                         \
+    }
+
+/*
+ * The widest type, up to a register, that both pointers can be aligned
+ * to at the same time. Rows may have different moduli, so this is asked
+ * for every row.
+ */
+static inline UBYTE memblit_copywidth(UBYTE *src, UBYTE *dst)
+{
+    IPTR misalign = ((IPTR)src ^ (IPTR)dst) & (sizeof(IPTR) - 1);
+
+    if (!misalign)
+        return sizeof(IPTR);
+    if (!(misalign & 3))
+        return 4;
+    if (!(misalign & 1))
+        return 2;
+    return 1;
+}
+
+#define MEMBLIT_COPYROW(dir, d, s, n)                           \
+    switch (memblit_copywidth(s, d))                            \
+    {                                                           \
+    case 8:     MEMBLIT_COPY ## dir(UQUAD, d, s, n) break;      \
+    case 4:     MEMBLIT_COPY ## dir(ULONG, d, s, n) break;      \
+    case 2:     MEMBLIT_COPY ## dir(UWORD, d, s, n) break;      \
+    default:    MEMBLIT_COPY ## dir(UBYTE, d, s, n) break;      \
+    }
+
+static VOID copy_generic(UBYTE *src, ULONG srcMod, UBYTE *dst, ULONG dstMod, ULONG bytes, ULONG height)
+{
+    if ((IPTR)src > (IPTR)dst)
+    {
+        while (height--)
+        {
+            UBYTE *s = src, *d = dst;
+            ULONG n = bytes;
+
+            MEMBLIT_COPYROW(FORWARD, d, s, n)
+
+            src += srcMod;
+            dst += dstMod;
+        }
+    }
+    else
+    {
+        /* The destination is behind the source, so start at the end */
+        src += (height - 1) * srcMod + bytes;
+        dst += (height - 1) * dstMod + bytes;
+
+        while (height--)
+        {
+            UBYTE *s = src, *d = dst;
+            ULONG n = bytes;
+
+            MEMBLIT_COPYROW(BACKWARD, d, s, n)
+
+            src -= srcMod;
+            dst -= dstMod;
+        }
+    }
+}
+
+/****************************************************************************************/
+
+static VOID expand16_generic(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    UWORD *p = (UWORD *)dst;
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+static VOID expand24_generic(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    for (; count; count--, dst += 3, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+        {
+            ULONG pixel = (bits & 0x80000000) ? fg : bg;
+
+#if AROS_BIG_ENDIAN
+            dst[0] = (pixel >> 16) & 0xFF;
+            dst[1] = (pixel >> 8) & 0xFF;
+            dst[2] =  pixel & 0xFF;
+#else
+            dst[0] =  pixel & 0xFF;
+            dst[1] = (pixel >> 8) & 0xFF;
+            dst[2] = (pixel >> 16) & 0xFF;
+#endif
+        }
+    }
+}
+
+static VOID expand32_generic(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg)
+{
+    ULONG *p = (ULONG *)dst;
+
+    for (; count; count--, p++, bits <<= 1, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = (bits & 0x80000000) ? fg : bg;
+    }
+}
+
+static VOID invert16_generic(UBYTE *dst, ULONG write, ULONG count)
+{
+    UWORD *p = (UWORD *)dst;
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+static VOID invert24_generic(UBYTE *dst, ULONG write, ULONG count)
+{
+    for (; count; count--, dst += 3, write <<= 1)
+    {
+        if (write & 0x80000000)
+        {
+            dst[0] = ~dst[0];
+            dst[1] = ~dst[1];
+            dst[2] = ~dst[2];
+        }
+    }
+}
+
+static VOID invert32_generic(UBYTE *dst, ULONG write, ULONG count)
+{
+    ULONG *p = (ULONG *)dst;
+
+    for (; count; count--, p++, write <<= 1)
+    {
+        if (write & 0x80000000)
+            *p = ~*p;
+    }
+}
+
+/****************************************************************************************/
+
+void SetMemBlitFunctions(struct MemBlitFuncs *funcs)
+{
+    funcs->mbf_Fill16   = fill16_generic;
+    funcs->mbf_Fill24   = fill24_generic;
+    funcs->mbf_Fill32   = fill32_generic;
+    funcs->mbf_Copy     = copy_generic;
+    funcs->mbf_Expand16 = expand16_generic;
+    funcs->mbf_Expand24 = expand24_generic;
+    funcs->mbf_Expand32 = expand32_generic;
+    funcs->mbf_Invert16 = invert16_generic;
+    funcs->mbf_Invert24 = invert24_generic;
+    funcs->mbf_Invert32 = invert32_generic;
+}
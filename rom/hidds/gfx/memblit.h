@@ -0,0 +1,58 @@
+#ifndef MEMBLIT_H
+#define MEMBLIT_H
+
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Low level routines behind the bitmap class' memory blit methods.
+*/
+
+#include <exec/types.h>
+
+/*
+ * The FillMemRect, CopyMemBox, PutMemTemplate and PutMemPattern methods
+ * for 16, 24 and 32 bit chunky buffers do their work through these.
+ * memblit.c has portable versions working on whole registers, which an
+ * architecture may replace with vectorised ones in its
+ * SetArchMemBlitFunctions().
+ *
+ * Templates and patterns are handed over in chunks of up to 32 pixels.
+ * Bit 31 of a chunk's masks belongs to its first pixel.
+ */
+
+/* Fill a width x height rectangle with a pixel value */
+typedef VOID (*MemBlitFillFunc)(UBYTE *dst, ULONG dstMod, ULONG width, ULONG height, ULONG fill);
+
+/*
+ * Copy height rows of bytes bytes each. Source and destination may
+ * overlap, as when scrolling inside one buffer.
+ */
+typedef VOID (*MemBlitCopyFunc)(UBYTE *src, ULONG srcMod, UBYTE *dst, ULONG dstMod, ULONG bytes, ULONG height);
+
+/*
+ * Of the first count pixels, set those with a bit set in write to fg
+ * or bg, depending on the same bit in bits.
+ */
+typedef VOID (*MemBlitExpandFunc)(UBYTE *dst, ULONG bits, ULONG write, ULONG count, ULONG fg, ULONG bg);
+
+/* Of the first count pixels, invert those with a bit set in write */
+typedef VOID (*MemBlitInvertFunc)(UBYTE *dst, ULONG write, ULONG count);
+
+struct MemBlitFuncs
+{
+    MemBlitFillFunc     mbf_Fill16;
+    MemBlitFillFunc     mbf_Fill24;
+    MemBlitFillFunc     mbf_Fill32;
+    MemBlitCopyFunc     mbf_Copy;
+    MemBlitExpandFunc   mbf_Expand16;
+    MemBlitExpandFunc   mbf_Expand24;
+    MemBlitExpandFunc   mbf_Expand32;
+    MemBlitInvertFunc   mbf_Invert16;
+    MemBlitInvertFunc   mbf_Invert24;
+    MemBlitInvertFunc   mbf_Invert32;
+};
+
+void SetMemBlitFunctions(struct MemBlitFuncs *funcs);
+void SetArchMemBlitFunctions(struct MemBlitFuncs *funcs);
+
+#endif /* MEMBLIT_H */
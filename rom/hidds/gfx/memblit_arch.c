@@ -0,0 +1,11 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+*/
+
+#include <exec/types.h>
+
+#include "memblit.h"
+
+void SetArchMemBlitFunctions(struct MemBlitFuncs *funcs)
+{
+}
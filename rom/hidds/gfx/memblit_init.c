@@ -0,0 +1,28 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Gfx Hidd memory blit initialization code.
+*/
+#include <exec/types.h>
+#include <proto/exec.h>
+#include <aros/symbolsets.h>
+
+#include "gfx_intern.h"
+
+#include LC_LIBDEFS_FILE
+
+#undef csd
+
+static int MemBlit_Init(LIBBASETYPEPTR LIBBASE)
+{
+    struct class_static_data *csd = &LIBBASE->hdg_csd;
+
+    EnterFunc(bug("MemBlit_Init()\n"));
+
+    SetMemBlitFunctions(&csd->memblitfuncs);
+    SetArchMemBlitFunctions(&csd->memblitfuncs);
+
+    ReturnInt("MemBlit_Init", ULONG, TRUE);
+}
+
+ADD2INITLIB(MemBlit_Init, -1)
@@ -7,6 +7,7 @@
 #include <aros/kernel.h>
 
 #include <kernel_base.h>
+#include <kernel_scheduler.h>
 
 /*****************************************************************************
 
@@ -21,10 +22,13 @@
         struct KernelBase *, KernelBase, 1, Kernel)
 
 /*  FUNCTION
+        Find out how the scheduler keeps track of ready tasks.
 
     INPUTS
+        None
 
     RESULT
+        SCHED_RR or SCHED_PRI, see KrnSetScheduler()
 
     NOTES
 
@@ -33,6 +37,7 @@
     BUGS
 
     SEE ALSO
+        KrnSetScheduler()
 
     INTERNALS
 
@@ -40,7 +45,7 @@
 {
     AROS_LIBFUNC_INIT
     
-    return SCHED_RR;
+    return core_GetScheduler();
     
     AROS_LIBFUNC_EXIT
 }
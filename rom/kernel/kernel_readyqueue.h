@@ -0,0 +1,167 @@
+#ifndef KERNEL_READYQUEUE_H
+#define KERNEL_READYQUEUE_H
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Priority bitmap index for the TaskReady list
+*/
+
+#include <exec/execbase.h>
+#include <exec/lists.h>
+#include <exec/tasks.h>
+
+/*
+ * With the SCHED_PRI scheduler TaskReady stays a single list sorted by
+ * priority, in exactly the order Enqueue() would leave it in, so everything
+ * that walks it keeps working. Next to it we keep which priority levels are
+ * populated and the last task of every level, so queueing a task behind its
+ * peers no longer needs to walk the list.
+ *
+ * Every change to TaskReady must then go through the functions below. exec
+ * uses the READYQUEUE_xxx() macros, which fall back to plain list handling
+ * when the index is not in use (SCHED_RR).
+ */
+
+#define RQ_LEVELS       256
+#define RQ_WORDS        (RQ_LEVELS / 32)
+#define RQ_LEVEL(pri)   ((ULONG)((LONG)(pri) + 128))
+
+struct ReadyQueueIndex
+{
+    ULONG               rq_Mask[RQ_WORDS];      /* bit set for every populated level    */
+    struct Task         *rq_Tail[RQ_LEVELS];    /* last task queued at every level      */
+};
+
+/* Find the lowest populated level above the given one, -1 if there is none */
+static inline LONG krnReadyLevelAbove(struct ReadyQueueIndex *rq, ULONG level)
+{
+    ULONG word, bits;
+
+    if (++level >= RQ_LEVELS)
+        return -1;
+
+    word = level >> 5;
+    bits = rq->rq_Mask[word] & (~0U << (level & 31));
+    for (;;)
+    {
+        if (bits)
+            return (word << 5) + __builtin_ctz(bits);
+        if (++word >= RQ_WORDS)
+            return -1;
+        bits = rq->rq_Mask[word];
+    }
+}
+
+static inline void krnReadyEnqueue(struct ReadyQueueIndex *rq, struct List *list, struct Task *task)
+{
+    struct Node *node = &task->tc_Node, *pred;
+    ULONG level = RQ_LEVEL(node->ln_Pri);
+    LONG above;
+
+    if (rq->rq_Mask[level >> 5] & (1UL << (level & 31)))
+    {
+        /* Behind the last task of the same priority */
+        pred = &rq->rq_Tail[level]->tc_Node;
+    }
+    else
+    {
+        /* Behind the last task of the next higher priority, or at the head */
+        if ((above = krnReadyLevelAbove(rq, level)) < 0)
+            pred = (struct Node *)list;
+        else
+            pred = &rq->rq_Tail[above]->tc_Node;
+        rq->rq_Mask[level >> 5] |= (1UL << (level & 31));
+    }
+
+    node->ln_Succ = pred->ln_Succ;
+    node->ln_Pred = pred;
+    pred->ln_Succ->ln_Pred = node;
+    pred->ln_Succ = node;
+
+    rq->rq_Tail[level] = task;
+}
+
+static inline void krnReadyRemove(struct ReadyQueueIndex *rq, struct Task *task)
+{
+    struct Node *node = &task->tc_Node;
+    ULONG level = RQ_LEVEL(node->ln_Pri);
+
+    if (rq->rq_Tail[level] == task)
+    {
+        struct Node *pred = node->ln_Pred;
+
+        /* A list header has no predecessor */
+        if (pred->ln_Pred && (pred->ln_Pri == node->ln_Pri))
+            rq->rq_Tail[level] = (struct Task *)pred;
+        else
+        {
+            rq->rq_Tail[level] = NULL;
+            rq->rq_Mask[level >> 5] &= ~(1UL << (level & 31));
+        }
+    }
+
+    REMOVE(node);
+}
+
+static inline struct Task *krnReadyRemHead(struct ReadyQueueIndex *rq, struct List *list)
+{
+    struct Task *task = (struct Task *)GetHead(list);
+
+    if (task)
+        krnReadyRemove(rq, task);
+
+    return task;
+}
+
+/* (Re)build the index from the current contents of the list */
+static inline void krnReadyBuild(struct ReadyQueueIndex *rq, struct List *list)
+{
+    struct Task *task;
+    ULONG level;
+
+    for (level = 0; level < RQ_WORDS; level++)
+        rq->rq_Mask[level] = 0;
+
+    ForeachNode(list, task)
+    {
+        level = RQ_LEVEL(task->tc_Node.ln_Pri);
+        rq->rq_Mask[level >> 5] |= (1UL << (level & 31));
+        rq->rq_Tail[level] = task;
+    }
+}
+
+/*
+ * Helpers for exec and the scheduler. They need exec_intern.h, and must be
+ * called with task switching and interrupts disabled.
+ */
+#define READYQUEUE_ENQUEUE(task)                                                        \
+    do {                                                                                \
+        if (PrivExecBase(SysBase)->ReadyQueue)                                          \
+            krnReadyEnqueue(PrivExecBase(SysBase)->ReadyQueue, &SysBase->TaskReady, (task)); \
+        else                                                                            \
+            Enqueue(&SysBase->TaskReady, &(task)->tc_Node);                             \
+    } while (0)
+
+#define READYQUEUE_REMOVE(task)                                                         \
+    do {                                                                                \
+        if (PrivExecBase(SysBase)->ReadyQueue)                                          \
+            krnReadyRemove(PrivExecBase(SysBase)->ReadyQueue, (task));                  \
+        else                                                                            \
+            REMOVE(&(task)->tc_Node);                                                   \
+    } while (0)
+
+#define READYQUEUE_REMHEAD()                                                            \
+    (PrivExecBase(SysBase)->ReadyQueue ?                                                \
+        krnReadyRemHead(PrivExecBase(SysBase)->ReadyQueue, &SysBase->TaskReady) :       \
+        (struct Task *)REMHEAD(&SysBase->TaskReady))
+
+/*
+ * Schedulers that keep their own index of the ready tasks next to TaskReady
+ * (x86 SMP) define this in exec_platform.h, to requeue a ready task whose
+ * priority has just been changed.
+ */
+#ifndef READYQUEUE_REPRIORITISE
+#define READYQUEUE_REPRIORITISE(task)
+#endif
+
+#endif /* !KERNEL_READYQUEUE_H */
@@ -15,12 +15,61 @@
 #define AROS_NO_ATOMIC_OPERATIONS
 #include "exec_platform.h"
 
+#define __AROS_KERNEL__
+#include "exec_intern.h"
+
+#include <kernel_readyqueue.h>
+
 #define D(x)
 
+/*
+ * Select how the TaskReady list is maintained:
+ * SCHED_RR  - plain Enqueue(), O(n) in the number of ready tasks.
+ * SCHED_PRI - the same list, plus a priority bitmap index which makes
+ *             queueing a task O(1). See kernel_readyqueue.h.
+ */
+BOOL core_SetScheduler(KRN_SchedType sched)
+{
+    struct ReadyQueueIndex *rq = PrivExecBase(SysBase)->ReadyQueue;
+
+    switch (sched)
+    {
+    case SCHED_RR:
+        if (rq)
+        {
+            Disable();
+            PrivExecBase(SysBase)->ReadyQueue = NULL;
+            Enable();
+            FreeMem(rq, sizeof(struct ReadyQueueIndex));
+        }
+        return TRUE;
+
+    case SCHED_PRI:
+        if (!rq)
+        {
+            if ((rq = AllocMem(sizeof(struct ReadyQueueIndex), MEMF_PUBLIC | MEMF_CLEAR)) == NULL)
+                return FALSE;
+
+            Disable();
+            krnReadyBuild(rq, &SysBase->TaskReady);
+            PrivExecBase(SysBase)->ReadyQueue = rq;
+            Enable();
+        }
+        return TRUE;
+
+    default:
+        return FALSE;
+    }
+}
+
+KRN_SchedType core_GetScheduler(void)
+{
+    return PrivExecBase(SysBase)->ReadyQueue ? SCHED_PRI : SCHED_RR;
+}
+
 /*
  * Schedule the currently running task away. Put it into the TaskReady list
- * in some smart way. This function is subject of change and it will be probably replaced
- * by some plugin system in the future
+ * in some smart way. The way the list is kept is selected by core_SetScheduler().
  */
 BOOL core_Schedule(void)
 {
@@ -67,7 +116,9 @@ void core_Switch(void)
 
     D(bug("[KRN] core_Switch(): Old task = %p (%s)\n", task, task->tc_Node.ln_Name));
 
-    if (task->tc_State != TS_RUN)
+    if (task->tc_State == TS_READY)
+        READYQUEUE_REMOVE(task);
+    else if (task->tc_State != TS_RUN)
         Remove(&task->tc_Node);
 
     if ((task->tc_State != TS_WAIT) && (task->tc_State != TS_REMOVED))
@@ -96,7 +147,7 @@ void core_Switch(void)
     {
         if (task->tc_Flags & TF_SWITCH)
             AROS_UFC1NR(void, task->tc_Switch, AROS_UFCA(struct ExecBase *, SysBase, A6));
-        Enqueue(&SysBase->TaskReady, &task->tc_Node);
+        READYQUEUE_ENQUEUE(task);
     }
     else if (task->tc_State != TS_REMOVED)
     {
@@ -117,7 +168,7 @@ struct Task *core_Dispatch(void)
 
     D(bug("[KRN] core_Dispatch()\n"));
 
-    task = (struct Task *)REMHEAD(&SysBase->TaskReady);
+    task = READYQUEUE_REMHEAD();
     if (!task)
     {
         /* Is the list of ready tasks empty? Well, go idle. */
@@ -4,6 +4,10 @@
     Desc:
 */
 
+#include <aros/kernel.h>
+
 BOOL core_Schedule(void);			/* Reschedule the current task if needed */
 void core_Switch(void);				/* Switch away from the current task     */
 struct Task *core_Dispatch(void);		/* Select the new task for execution     */
+BOOL core_SetScheduler(KRN_SchedType);		/* Select the ready list handling        */
+KRN_SchedType core_GetScheduler(void);
@@ -7,6 +7,7 @@
 #include <aros/kernel.h>
 
 #include <kernel_base.h>
+#include <kernel_scheduler.h>
 
 /*****************************************************************************
 
@@ -22,18 +23,31 @@
         struct KernelBase *, KernelBase, 2, Kernel)
 
 /*  FUNCTION
+        Select the way the scheduler keeps track of ready tasks.
 
     INPUTS
+        sched - SCHED_RR  - TaskReady is a plain list, sorted on priority
+                            when a task is queued. This is the default.
+                SCHED_PRI - TaskReady is kept in the same order, but indexed
+                            by a priority bitmap. Queueing a task takes constant
+                            time, regardless of the number of ready tasks.
 
     RESULT
+        None
 
     NOTES
+        With SCHED_PRI all changes to TaskReady must be done by exec.library
+        and the scheduler. Software that manipulates TaskReady directly will
+        corrupt the index, and must not be run with it.
+
+        Schedulers that do not support SCHED_PRI ignore the request.
 
     EXAMPLE
 
     BUGS
 
     SEE ALSO
+        KrnGetScheduler()
 
     INTERNALS
 
@@ -41,5 +55,7 @@
 {
     AROS_LIBFUNC_INIT
 
+    core_SetScheduler(sched);
+
     AROS_LIBFUNC_EXIT
 }
@@ -0,0 +1,420 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Cache of where libraries and devices were found in LIBS: and DEVS:.
+*/
+
+#include <aros/debug.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <dos/dosextens.h>
+#include <dos/notify.h>
+#include <proto/exec.h>
+#include <proto/dos.h>
+
+#include <proto/lddemon.h>
+
+#include <string.h>
+
+#include "lddemon.h"
+
+/*
+ * Looking for an object in LIBS: means trying every directory of the
+ * assign in turn, and an object that isn't there at all (optional
+ * libraries that programs probe for) costs a failed lookup in each of
+ * them, every time it is opened. So we remember which directory every
+ * name was found in, or that it wasn't found in any of them.
+ * The directories are watched with DOS notification, and everything is
+ * forgotten as soon as one of them changes. The assign itself is checked
+ * on every lookup, and read again when it was changed. Assigns that
+ * aren't plain directory assigns, or whose directories can't be watched,
+ * are not cached.
+ */
+
+#define LDCACHE_MAXENTRIES      256
+#define LDCACHE_PATHLEN         512
+
+struct LDCacheEntry
+{
+    struct Node             lce_Node;       /* ln_Name is the name as requested */
+    STRPTR                  lce_Path;       /* Where it was found, NULL if nowhere */
+};
+
+struct LDCacheWatch
+{
+    struct Node             lcw_Node;       /* ln_Name is the directory */
+    struct NotifyRequest    lcw_Notify;
+};
+
+struct LDCacheAssign
+{
+    struct Node             lca_Node;       /* ln_Name is the assign, without colon */
+    IPTR                    lca_Signature;  /* Of the assign's locks, when it was read */
+    BOOL                    lca_Valid;      /* All of its directories are watched */
+    ULONG                   lca_Generation;
+    ULONG                   lca_NumEntries;
+    struct List             lca_Dirs;       /* Nodes named after the directories */
+    struct List             lca_Watches;
+    struct List             lca_Entries;
+};
+
+static STRPTR LDStrDup(CONST_STRPTR str, struct ExecBase *SysBase)
+{
+    ULONG  len = strlen(str);
+    STRPTR dup = AllocVec(len + 1, MEMF_ANY);
+
+    if (dup)
+        CopyMem(str, dup, len + 1);
+
+    return dup;
+}
+
+/* Returns 0 if the name isn't a plain directory assign */
+static IPTR LDAssignSignature(CONST_STRPTR name, struct Library *DOSBase)
+{
+    struct DosList    *dl;
+    struct AssignList *al;
+    IPTR               sig = 0;
+
+    dl = LockDosList(LDF_ASSIGNS | LDF_READ);
+    dl = FindDosEntry(dl, name, LDF_ASSIGNS);
+    if (dl && dl->dol_Type == DLT_DIRECTORY)
+    {
+        sig = (IPTR)dl->dol_Lock;
+        for (al = dl->dol_misc.dol_assign.dol_List; al; al = al->al_Next)
+            sig = sig * 31 + (IPTR)al->al_Lock;
+    }
+    UnLockDosList(LDF_ASSIGNS | LDF_READ);
+
+    return sig;
+}
+
+static BOOL LDCacheWatchDir(struct IntLDDemonBase *ldBase, struct LDCacheAssign *lca, CONST_STRPTR dir, struct ExecBase *SysBase)
+{
+    struct Library      *DOSBase = ldBase->dl_DOSBase;
+    struct LDCacheWatch *lcw;
+
+    if (FindName(&lca->lca_Watches, dir))
+        return TRUE;
+
+    if ((lcw = AllocVec(sizeof(struct LDCacheWatch), MEMF_ANY | MEMF_CLEAR)) == NULL)
+        return FALSE;
+
+    if ((lcw->lcw_Node.ln_Name = LDStrDup(dir, SysBase)) != NULL)
+    {
+        lcw->lcw_Notify.nr_Name = lcw->lcw_Node.ln_Name;
+        lcw->lcw_Notify.nr_Flags = NRF_SEND_SIGNAL;
+        lcw->lcw_Notify.nr_stuff.nr_Signal.nr_Task = &ldBase->dl_LDDemonTask->pr_Task;
+        lcw->lcw_Notify.nr_stuff.nr_Signal.nr_SignalNum = SIGBREAKB_CTRL_E;
+
+        if (StartNotify(&lcw->lcw_Notify))
+        {
+            D(bug("[LDCache] Watching %s\n", dir));
+            AddTail(&lca->lca_Watches, &lcw->lcw_Node);
+            return TRUE;
+        }
+
+        D(bug("[LDCache] Can't watch %s\n", dir));
+        FreeVec(lcw->lcw_Node.ln_Name);
+    }
+    FreeVec(lcw);
+
+    return FALSE;
+}
+
+static void LDCacheForget(struct LDCacheAssign *lca, struct ExecBase *SysBase)
+{
+    struct LDCacheEntry *lce;
+
+    while ((lce = (struct LDCacheEntry *)RemHead(&lca->lca_Entries)) != NULL)
+    {
+        FreeVec(lce->lce_Path);
+        FreeVec(lce->lce_Node.ln_Name);
+        FreeVec(lce);
+    }
+    lca->lca_NumEntries = 0;
+    lca->lca_Generation++;
+}
+
+static void LDCacheReset(struct IntLDDemonBase *ldBase, struct LDCacheAssign *lca, struct ExecBase *SysBase)
+{
+    struct Library      *DOSBase = ldBase->dl_DOSBase;
+    struct LDCacheWatch *lcw;
+    struct Node         *dir;
+
+    LDCacheForget(lca, SysBase);
+
+    while ((lcw = (struct LDCacheWatch *)RemHead(&lca->lca_Watches)) != NULL)
+    {
+        EndNotify(&lcw->lcw_Notify);
+        FreeVec(lcw->lcw_Node.ln_Name);
+        FreeVec(lcw);
+    }
+
+    while ((dir = RemHead(&lca->lca_Dirs)) != NULL)
+    {
+        FreeVec(dir->ln_Name);
+        FreeVec(dir);
+    }
+
+    lca->lca_Valid = FALSE;
+}
+
+/* Reads the directories of the assign, and starts watching them */
+static void LDCacheRead(struct IntLDDemonBase *ldBase, struct LDCacheAssign *lca, IPTR sig, struct ExecBase *SysBase)
+{
+    struct Library *DOSBase = ldBase->dl_DOSBase;
+    struct DevProc *dvp = NULL;
+    struct Node    *dir;
+    char            assign[32];
+    STRPTR          buf;
+    BOOL            ok = TRUE;
+
+    LDCacheReset(ldBase, lca, SysBase);
+    lca->lca_Signature = sig;
+
+    if ((buf = AllocMem(LDCACHE_PATHLEN, MEMF_ANY)) == NULL)
+        return;
+
+    strcpy(assign, lca->lca_Node.ln_Name);
+    strcat(assign, ":");
+
+    while ((dvp = GetDeviceProc(assign, dvp)) != NULL)
+    {
+        dir = NULL;
+        if (dvp->dvp_Lock && NameFromLock(dvp->dvp_Lock, buf, LDCACHE_PATHLEN)
+            && (dir = AllocVec(sizeof(struct Node), MEMF_ANY | MEMF_CLEAR)) != NULL
+            && (dir->ln_Name = LDStrDup(buf, SysBase)) != NULL)
+        {
+            AddTail(&lca->lca_Dirs, dir);
+            if (LDCacheWatchDir(ldBase, lca, buf, SysBase))
+                continue;
+        }
+        else
+            FreeVec(dir);
+
+        FreeDeviceProc(dvp);
+        ok = FALSE;
+        break;
+    }
+
+    if (ok && IoErr() == ERROR_NO_MORE_ENTRIES && !IsListEmpty(&lca->lca_Dirs))
+    {
+        D(bug("[LDCache] Caching %s\n", assign));
+        lca->lca_Valid = TRUE;
+    }
+    else
+        LDCacheReset(ldBase, lca, SysBase);
+
+    FreeMem(buf, LDCACHE_PATHLEN);
+}
+
+static void LDCacheAdd(struct IntLDDemonBase *ldBase, struct LDCacheAssign *lca, CONST_STRPTR name, CONST_STRPTR path, struct ExecBase *SysBase)
+{
+    struct Library      *DOSBase = ldBase->dl_DOSBase;
+    struct LDCacheEntry *lce;
+    struct Node         *dir;
+    STRPTR               buf;
+    BOOL                 ok = TRUE;
+
+    /* Names in subdirectories need those watched too */
+    if (FilePart(name) != name)
+    {
+        if ((buf = AllocMem(LDCACHE_PATHLEN, MEMF_ANY)) == NULL)
+            return;
+
+        ForeachNode(&lca->lca_Dirs, dir)
+        {
+            strcpy(buf, dir->ln_Name);
+            if (AddPart(buf, name, LDCACHE_PATHLEN))
+            {
+                *PathPart(buf) = '\0';
+                ok = LDCacheWatchDir(ldBase, lca, buf, SysBase);
+            }
+            else
+                ok = FALSE;
+            if (!ok)
+                break;
+        }
+        FreeMem(buf, LDCACHE_PATHLEN);
+
+        if (!ok)
+            return;
+    }
+
+    if (lca->lca_NumEntries >= LDCACHE_MAXENTRIES)
+    {
+        lce = (struct LDCacheEntry *)RemHead(&lca->lca_Entries);
+        FreeVec(lce->lce_Path);
+        FreeVec(lce->lce_Node.ln_Name);
+        FreeVec(lce);
+        lca->lca_NumEntries--;
+    }
+
+    if ((lce = AllocVec(sizeof(struct LDCacheEntry), MEMF_ANY | MEMF_CLEAR)) == NULL)
+        return;
+
+    if ((lce->lce_Node.ln_Name = LDStrDup(name, SysBase)) != NULL
+        && (!path || (lce->lce_Path = LDStrDup(path, SysBase)) != NULL))
+    {
+        AddTail(&lca->lca_Entries, &lce->lce_Node);
+        lca->lca_NumEntries++;
+        return;
+    }
+
+    FreeVec(lce->lce_Node.ln_Name);
+    FreeVec(lce);
+}
+
+/*
+  BPTR LDCacheLoadSeg( ldBase, basedir, name )
+    Load the object <name> from the assign <basedir>, looking in the
+    cache first.
+*/
+BPTR LDCacheLoadSeg(struct IntLDDemonBase *ldBase, STRPTR basedir, STRPTR name, struct ExecBase *SysBase)
+{
+    struct Library       *DOSBase = ldBase->dl_DOSBase;
+    struct LDCacheAssign *lca;
+    struct LDCacheEntry  *lce;
+    struct Node          *dir;
+    STRPTR                paths = NULL, path = NULL;
+    ULONG                 len = 0, generation = 0;
+    BOOL                  known = FALSE, missing = FALSE, notfound = TRUE;
+    BPTR                  seglist = BNULL;
+    IPTR                  sig;
+
+    sig = LDAssignSignature(basedir, DOSBase);
+
+    ObtainSemaphore(&ldBase->dl_CacheSigSem);
+
+    lca = (struct LDCacheAssign *)FindName(&ldBase->dl_CacheAssigns, basedir);
+    if (!lca && (lca = AllocVec(sizeof(struct LDCacheAssign), MEMF_ANY | MEMF_CLEAR)) != NULL)
+    {
+        lca->lca_Node.ln_Name = basedir;
+        NEWLIST(&lca->lca_Dirs);
+        NEWLIST(&lca->lca_Watches);
+        NEWLIST(&lca->lca_Entries);
+        AddTail(&ldBase->dl_CacheAssigns, &lca->lca_Node);
+    }
+
+    if (lca && sig != lca->lca_Signature)
+    {
+        if (sig)
+            LDCacheRead(ldBase, lca, sig, SysBase);
+        else
+        {
+            LDCacheReset(ldBase, lca, SysBase);
+            lca->lca_Signature = 0;
+        }
+    }
+
+    if (lca && lca->lca_Valid)
+    {
+        generation = lca->lca_Generation;
+
+        if ((lce = (struct LDCacheEntry *)FindName(&lca->lca_Entries, name)) != NULL)
+        {
+            if (lce->lce_Path)
+                known = (path = LDStrDup(lce->lce_Path, SysBase)) != NULL;
+            else
+                missing = TRUE;
+
+            /* Keep the ones in use at the end */
+            Remove(&lce->lce_Node);
+            AddTail(&lca->lca_Entries, &lce->lce_Node);
+        }
+        else
+        {
+            /* Take the paths to try, the directories may change meanwhile */
+            ForeachNode(&lca->lca_Dirs, dir)
+                len += strlen(dir->ln_Name) + strlen(name) + 2;
+
+            if ((paths = AllocVec(len + 1, MEMF_ANY)) != NULL)
+            {
+                path = paths;
+                ForeachNode(&lca->lca_Dirs, dir)
+                {
+                    ULONG size = strlen(dir->ln_Name) + strlen(name) + 2;
+
+                    strcpy(path, dir->ln_Name);
+                    AddPart(path, name, size);
+                    path += strlen(path) + 1;
+                }
+                *path = '\0';
+                path = NULL;
+            }
+        }
+    }
+
+    ReleaseSemaphore(&ldBase->dl_CacheSigSem);
+
+    if (missing)
+    {
+        D(bug("[LDCache] %s is not in %s:\n", name, basedir));
+        return BNULL;
+    }
+
+    if (known)
+    {
+        D(bug("[LDCache] %s is %s\n", name, path));
+        seglist = LDLoadSeg(path);
+        FreeVec(path);
+
+        /* If it's gone, we will be told, look for it the long way meanwhile */
+        if (seglist)
+            return seglist;
+    }
+    else if (paths)
+    {
+        for (path = paths; *path; path += strlen(path) + 1)
+        {
+            if ((seglist = LDLoadSeg(path)) != BNULL)
+                break;
+
+            /* Failing for any other reason doesn't mean it isn't there */
+            if (IoErr() != ERROR_OBJECT_NOT_FOUND)
+                notfound = FALSE;
+        }
+
+        /* Only remember it's missing if it wasn't found anywhere */
+        ObtainSemaphore(&ldBase->dl_CacheSigSem);
+        if ((seglist || notfound) &&
+            lca->lca_Valid && lca->lca_Generation == generation && !FindName(&lca->lca_Entries, name))
+        {
+            LDCacheAdd(ldBase, lca, name, seglist ? path : NULL, SysBase);
+        }
+        ReleaseSemaphore(&ldBase->dl_CacheSigSem);
+
+        FreeVec(paths);
+
+        return seglist;
+    }
+
+    len = strlen(basedir) + strlen(name) + 2;
+    if ((path = AllocVec(len, MEMF_ANY)) != NULL)
+    {
+        strcpy(path, basedir);
+        strcat(path, ":");
+        strcat(path, name);
+        seglist = LDLoadSeg(path);
+        FreeVec(path);
+    }
+
+    return seglist;
+}
+
+/*
+  void LDCacheFlush( ldBase )
+    Forget what is cached, called when a watched directory changed.
+*/
+void LDCacheFlush(struct IntLDDemonBase *ldBase, struct ExecBase *SysBase)
+{
+    struct LDCacheAssign *lca;
+
+    D(bug("[LDCache] Flushing\n"));
+
+    ObtainSemaphore(&ldBase->dl_CacheSigSem);
+    ForeachNode(&ldBase->dl_CacheAssigns, lca)
+        LDCacheForget(lca, SysBase);
+    ReleaseSemaphore(&ldBase->dl_CacheSigSem);
+}
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2019, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Loader for shared libraries and devices.
 */
@@ -42,6 +42,17 @@
 
 #define CHECK_DEPENDENCY 1
 
+/*
+ * Number of processes that load objects from disk besides LDDemon.
+ * Where objects are initialised in the LDDemon context, everything has
+ * to be done by LDDemon itself.
+ */
+#if INIT_IN_LDDEMON_CONTEXT
+#define LDDEMON_LOADERS 0
+#else
+#define LDDEMON_LOADERS 4
+#endif
+
 /* Please leave them here! They are needed on Linux-M68K */
 AROS_LD2(struct Library *, OpenLibrary,
     AROS_LDA(STRPTR, libname, A1),
@@ -104,6 +115,7 @@ AROS_LH1(BPTR, LDLoadSeg,
 static BPTR LDLoad(struct IntLDDemonBase *ldBase, struct Process *caller, STRPTR name, STRPTR basedir, struct ExecBase *SysBase)
 {
     struct Process *me = (struct Process *)FindTask(NULL);
+    BPTR oldCurDir = me->pr_CurrentDir;
     BPTR seglist = BNULL;
     STRPTR path;
     ULONG pathLen;
@@ -168,15 +180,16 @@ static BPTR LDLoad(struct IntLDDemonBase *ldBase, struct Process *caller, STRPTR
             }
         }
 
-        if (path) {
-            if (!seglist) {
-                /* Nup, let's try the default directory as supplied. */
-                D(bug("[LDLoad] Trying defaultdir\n"));
-                path[delimPos] = ':';
-                seglist = LDLoadSeg(path);
-            }
+        if (path)
             FreeMem(path, pathLen);
+
+        if (!seglist) {
+            /* Nup, let's try the default directory as supplied. */
+            D(bug("[LDLoad] Trying defaultdir\n"));
+            seglist = LDCacheLoadSeg(ldBase, basedir, name, SysBase);
         }
+
+        me->pr_CurrentDir = oldCurDir;
     } else
         seglist = LDLoadSeg(name);
 
@@ -758,6 +771,106 @@ static void ProcessLDMessage(struct IntLDDemonBase *ldBase, struct LDDMsg *ldd,
 #endif
 }
 
+#if LDDEMON_LOADERS
+
+/*
+ * Loading from disk used to be done by LDDemon alone, one object after
+ * the other, so that a program loading a library from a slow volume held
+ * up everybody else. Now LDDemon passes the requests on to a few loader
+ * processes, which are started when they are first needed and then wait
+ * for more. The object semaphores of LDRequestObject() still make sure
+ * that the same object is only loaded once. When all loaders are busy,
+ * LDDemon loads the object itself.
+ */
+struct LDLoader
+{
+    struct MinNode      ldl_Node;
+    struct MsgPort      ldl_Port;
+};
+
+static const char ldLoaderName[] = "Lib & Dev Loader";
+
+/*
+  void LDLoader()
+    The loader process entry. Loads what LDDemon passes on, and then
+    tells it that it is free again.
+*/
+static AROS_PROCH(LDLoader, argptr, argsize, SysBase)
+{
+    AROS_PROCFUNC_INIT
+
+    struct IntLDDemonBase *ldBase = SysBase->ex_RamLibPrivate;
+    struct LDLoader *ldl = FindTask(NULL)->tc_UserData;
+    struct LDDMsg *ldd;
+
+    for(;;)
+    {
+        WaitPort(&ldl->ldl_Port);
+        while( (ldd = (struct LDDMsg *)GetMsg(&ldl->ldl_Port)) )
+        {
+            ProcessLDMessage(ldBase, ldd, SysBase);
+            ReplyMsg((struct Message *)ldd);
+        }
+
+        ObtainSemaphore(&ldBase->dl_LoadersSigSem);
+        AddTail(&ldBase->dl_IdleLoaders, (struct Node *)ldl);
+        ReleaseSemaphore(&ldBase->dl_LoadersSigSem);
+    }
+
+    return 0;
+
+    AROS_PROCFUNC_EXIT
+}
+
+static struct LDLoader *LDGetLoader(struct IntLDDemonBase *ldBase, struct ExecBase *SysBase)
+{
+    struct Library *DOSBase = ldBase->dl_DOSBase;
+    struct LDLoader *ldl;
+    struct Process *proc;
+
+    ObtainSemaphore(&ldBase->dl_LoadersSigSem);
+    ldl = (struct LDLoader *)RemHead(&ldBase->dl_IdleLoaders);
+    ReleaseSemaphore(&ldBase->dl_LoadersSigSem);
+
+    if (!ldl && (ldBase->dl_NumLoaders < LDDEMON_LOADERS)
+        && (ldl = AllocMem(sizeof(struct LDLoader), MEMF_PUBLIC | MEMF_CLEAR)) != NULL)
+    {
+        struct TagItem tags[] =
+        {
+            { NP_Entry, (IPTR)LDLoader },
+            { NP_Input, 0 },
+            { NP_Output, 0 },
+            { NP_WindowPtr, -1 },
+            { NP_Name, (IPTR)ldLoaderName },
+            { NP_Priority, 5 },
+            { NP_UserData, (IPTR)ldl },
+            { TAG_END , 0 }
+        };
+
+        ldl->ldl_Port.mp_Node.ln_Type = NT_MSGPORT;
+        ldl->ldl_Port.mp_Flags        = PA_SIGNAL;
+        ldl->ldl_Port.mp_SigBit       = SIGBREAKB_CTRL_F;
+        NEWLIST(&ldl->ldl_Port.mp_MsgList);
+
+        if ((proc = CreateNewProc(tags)) != NULL)
+        {
+            /* Nothing is sent to it before this is set */
+            ldl->ldl_Port.mp_SigTask = proc;
+            ldBase->dl_NumLoaders++;
+            D(bug("[LDDemon] Started loader %u\n", ldBase->dl_NumLoaders));
+        }
+        else
+        {
+            FreeMem(ldl, sizeof(struct LDLoader));
+            ldl = NULL;
+        }
+    }
+
+    return ldl;
+}
+
+#endif
+
 /*
   void LDDemon()
     The LDDemon process entry. Sits around and does nothing until a
@@ -770,12 +883,27 @@ static AROS_PROCH(LDDemon, argptr, argsize, SysBase)
 
     struct IntLDDemonBase *ldBase = SysBase->ex_RamLibPrivate;
     struct LDDMsg *ldd;
+    ULONG sigs;
 
     for(;;)
     {
-        WaitPort(ldBase->dl_LDDemonPort);
+        sigs = Wait(SIGBREAKF_CTRL_F | SIGBREAKF_CTRL_E);
+
+        /* A directory of LIBS: or DEVS: changed */
+        if (sigs & SIGBREAKF_CTRL_E)
+            LDCacheFlush(ldBase, SysBase);
+
         while( (ldd = (struct LDDMsg *)GetMsg(ldBase->dl_LDDemonPort)) )
         {
+#if LDDEMON_LOADERS
+            struct LDLoader *ldl = LDGetLoader(ldBase, SysBase);
+
+            if (ldl)
+            {
+                PutMsg(&ldl->ldl_Port, (struct Message *)ldd);
+                continue;
+            }
+#endif
             ProcessLDMessage(ldBase, ldd, SysBase);
             ReplyMsg((struct Message *)ldd);
         } /* messages available */
@@ -825,6 +953,10 @@ static ULONG LDDemon_Init(struct IntLDDemonBase *ldBase)
 
     NEWLIST(&ldBase->dl_LDObjectsList);
     InitSemaphore(&ldBase->dl_LDObjectsListSigSem);
+    NEWLIST(&ldBase->dl_IdleLoaders);
+    InitSemaphore(&ldBase->dl_LoadersSigSem);
+    NEWLIST(&ldBase->dl_CacheAssigns);
+    InitSemaphore(&ldBase->dl_CacheSigSem);
 
     SysBase->ex_RamLibPrivate = ldBase;
 
@@ -4,6 +4,7 @@
 #include <aros/config.h>
 #include <exec/interrupts.h>
 #include <exec/semaphores.h>
+#include <dos/bptr.h>
 
 struct IntLDDemonBase
 {
@@ -21,6 +22,13 @@ struct IntLDDemonBase
     struct MsgPort	        *dl_LDDemonPort;
     struct Process	        *dl_LDDemonTask;
 
+    struct SignalSemaphore  dl_LoadersSigSem;
+    struct List             dl_IdleLoaders;     /* Loader processes waiting for work */
+    ULONG                   dl_NumLoaders;
+
+    struct SignalSemaphore  dl_CacheSigSem;
+    struct List             dl_CacheAssigns;    /* Where things were found in LIBS: and DEVS: */
+
 #if defined(__AROSEXEC_SMP__)
     struct Library 	        *dl_ExecLockRes;
 #endif
@@ -31,4 +39,7 @@ struct IntLDDemonBase
     ULONG		            dl_LDReturn;
 };
 
+BPTR LDCacheLoadSeg(struct IntLDDemonBase *ldBase, STRPTR basedir, STRPTR name, struct ExecBase *SysBase);
+void LDCacheFlush(struct IntLDDemonBase *ldBase, struct ExecBase *SysBase);
+
 #endif /* LDDEMON_H */
@@ -46,12 +46,16 @@
             by calling a method directly
         !!!
 
+        Call sites which look up the same method on objects of different
+        classes can use the OOP_GetCachedMethod() macro instead, which only
+        calls this function when the class of the object changes.
+
     EXAMPLE
 
     BUGS
 
     SEE ALSO
-        OOP_GetMethodID()
+        OOP_GetMethodID(), OOP_GetCachedMethod()
 
     INTERNALS
 
@@ -59,11 +63,20 @@
 {
     AROS_LIBFUNC_INIT
     
+    OOP_Class *cl = OOP_OCLASS(obj);
     struct IFMethod *ifm;
     
-    /* First get mid */
+    /* Classes with a flat method table don't need to ask their metaclass */
+    if (mid < cl->cl_VTableSize)
+    {
+        struct OOP_VTableEntry *vte = &cl->cl_VTable[mid];
+
+        *classPtr = vte->vt_Class;
+        return (OOP_MethodFunc)vte->vt_Func;
+    }
+
     /* Get the method from the object's class */
-    ifm = meta_findmethod((OOP_Object *)OOP_OCLASS(obj), mid, (struct Library *)OOPBase);
+    ifm = meta_findmethod((OOP_Object *)cl, mid, (struct Library *)OOPBase);
     if (NULL == ifm)
         return NULL;
 
@@ -124,6 +124,13 @@ static OOP_Object *hiddmeta_new(OOP_Class *cl, OOP_Object *o, struct pRoot_New *
         ((OOP_Class *)o)->cl_DoMethod   = domethod;
         ((OOP_Class *)o)->cl_CoerceMethod       = coercemethod;
         ((OOP_Class *)o)->cl_DoSuperMethod      = dosupermethod;
+
+        /* OOP_DoMethod() must not bypass a custom dispatcher */
+        if (domethod != HIDD_DoMethod)
+        {
+            ((OOP_Class *)o)->cl_VTable         = NULL;
+            ((OOP_Class *)o)->cl_VTableSize     = 0;
+        }
                   
     }
    
@@ -327,6 +334,11 @@ static BOOL hiddmeta_allocdisptabs(OOP_Class *cl, OOP_Object *o, struct P_meta_a
                 
             } /* for (each interface in this class' interface description) */
             
+            /* The dispatch table is indexed by method ID, so OOP_DoMethod()
+               can use it directly */
+            ((OOP_Class *)o)->cl_VTable     = (struct OOP_VTableEntry *)data->methodtable;
+            ((OOP_Class *)o)->cl_VTableSize = total_num_methods;
+
             ReturnBool("HIIDMeta::allocdisptabs", TRUE);
 init_err:
             FreeVec(data->ifinfo);
@@ -347,6 +359,9 @@ static VOID hiddmeta_freedisptabs(OOP_Class *cl, OOP_Object *o, OOP_Msg msg)
 {
     struct hiddmeta_inst *inst = (struct hiddmeta_inst *)o;
     
+    ((OOP_Class *)o)->cl_VTable     = NULL;
+    ((OOP_Class *)o)->cl_VTableSize = 0;
+
     FreeVec(inst->data.methodtable);
     FreeVec(inst->data.ifinfo);
     return;
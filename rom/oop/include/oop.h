@@ -60,6 +60,13 @@ struct OOP_ABDescr
 
 typedef struct OOP_IClass OOP_Class;
 
+/* An entry in the flat method table of a class, see cl_VTable below */
+struct OOP_VTableEntry
+{
+    IPTR    	    	(*vt_Func)(OOP_Class *, OOP_Object *, OOP_Msg);
+    OOP_Class           *vt_Class;      /* Class to invoke vt_Func with */
+};
+
 struct OOP_IClass
 {
     /* Array of pointers to methodtables for this class */
@@ -71,6 +78,12 @@ struct OOP_IClass
     IPTR    	    	(*cl_CoerceMethod)(OOP_Class *, OOP_Object *, OOP_Msg);
     IPTR    	    	(*cl_DoSuperMethod)(OOP_Class *, OOP_Object *, OOP_Msg);
     OOP_Class           *superclass;
+
+    /* Method table indexed directly by method ID, set up when the class
+       is created. Classes without one have cl_VTableSize == 0.
+       Private to OOP_DoMethod(), do not touch. */
+    struct OOP_VTableEntry *cl_VTable;
+    ULONG               cl_VTableSize;
 };
 
 
@@ -98,7 +111,17 @@ struct _OOP_Object
 #define OOP_OOPBASE(obj) \
     	(OOP_OCLASS(obj)->OOPBasePtr)
 
-#define OOP_DoMethod(o, msg) ( (OOP_OCLASS(o))->cl_DoMethod((o), (msg)) )
+/* Methods found in the flat method table are called directly, others
+   go through the class' dispatcher */
+#define OOP_DoMethod(o, msg)                                                    \
+({                                                                              \
+    OOP_Object *__dm_obj = (OOP_Object *)(o);                                   \
+    OOP_Msg     __dm_msg = (OOP_Msg)(msg);                                      \
+    OOP_Class  *__dm_cl = OOP_OCLASS(__dm_obj);                                 \
+    (*__dm_msg < __dm_cl->cl_VTableSize)                                        \
+        ? __dm_cl->cl_VTable[*__dm_msg].vt_Func(__dm_cl->cl_VTable[*__dm_msg].vt_Class, __dm_obj, __dm_msg) \
+        : __dm_cl->cl_DoMethod(__dm_obj, __dm_msg);                             \
+})
 #define OOP_DoSuperMethod(cl, o, msg) ((cl)->cl_DoSuperMethod(cl, o, msg))
 #define OOP_CoerceMethod(cl, o, msg) ((cl)->cl_CoerceMethod(cl, o, msg))
 
@@ -123,6 +146,29 @@ struct OOP_MethodDescr
     ULONG MethodIdx;
 };
 
+/* Inline cache for OOP_GetMethod(), for call sites that invoke one method
+   on objects of changing classes. The cache belongs to the call site and
+   must be cleared before first use; it must not be shared between tasks.
+*/
+struct OOP_MethodCache
+{
+    OOP_Class       *mc_Class;      /* Class of the object the entry is for */
+    OOP_MethodFunc  mc_Func;
+    OOP_Class       *mc_ImplClass;  /* Class to invoke mc_Func with */
+};
+
+#define OOP_GetCachedMethod(obj, mid, cache)                                    \
+({                                                                              \
+    OOP_Object *__gcm_obj = (OOP_Object *)(obj);                                \
+    struct OOP_MethodCache *__gcm_cache = (cache);                              \
+    if (OOP_OCLASS(__gcm_obj) != __gcm_cache->mc_Class)                         \
+    {                                                                           \
+        __gcm_cache->mc_Func = OOP_GetMethod(__gcm_obj, (mid), &__gcm_cache->mc_ImplClass); \
+        __gcm_cache->mc_Class = OOP_OCLASS(__gcm_obj);                          \
+    }                                                                           \
+    __gcm_cache->mc_Func;                                                       \
+})
+
 
 /* Some basic interfaces and classes */
 
@@ -166,6 +166,8 @@ struct IFBucket
 ** because we skip unimplemented class calls, and
 ** therefore a method can go directly to a parent
 ** class of OCLASS(o)
+** The layout must match struct OOP_VTableEntry, as
+** HIDD classes export their method table as cl_VTable.
 */
 
 typedef IPTR (*IFMethodFunc_t)();
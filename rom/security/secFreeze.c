@@ -9,6 +9,9 @@
 #include "security_intern.h"
 #include "security_task.h"
 
+#include <exec_intern.h>
+#include <kernel_readyqueue.h>
+
 /*****************************************************************************
 
     NAME */
@@ -62,7 +65,10 @@
             case NT_TASK:
             case NT_PROCESS:
                     if (task->tc_State < 7) {
-                        Remove((struct Node*)task);
+                        if (task->tc_State == TS_READY)
+                            READYQUEUE_REMOVE(task);
+                        else
+                            Remove((struct Node*)task);
                         AddHead((struct List *)&secBase->Frozen, (struct Node*)task);
                         task->tc_State += 7;
                         res = TRUE;
@@ -11,6 +11,9 @@
 #include "security_intern.h"
 #include "security_task.h"
 
+#include <exec_intern.h>
+#include <kernel_readyqueue.h>
+
 /*****************************************************************************
 
     NAME */
@@ -67,7 +70,10 @@
                     break;
 
             case NT_PROCESS:
-                    Remove((struct Node*)task);
+                    if (task->tc_State == TS_READY)
+                        READYQUEUE_REMOVE(task);
+                    else
+                        Remove((struct Node*)task);
                     task->tc_State = TS_READY;
                     sp = task->tc_SPReg;
 #if (0)
@@ -91,7 +97,8 @@
                     }
 #endif
                     *(IPTR *)sp = (IPTR)CleanUpBody;
-                    AddHead((struct List*)&SysBase->TaskReady, (struct Node*)task);
+                    /* TaskReady is indexed by priority, so no AddHead() */
+                    READYQUEUE_ENQUEUE(task);
                     res = TRUE;
                     break;
         }
@@ -11,6 +11,9 @@
 #include "security_intern.h"
 #include "security_task.h"
 
+#include <exec_intern.h>
+#include <kernel_readyqueue.h>
+
 /*****************************************************************************
 
     NAME */
@@ -64,7 +67,7 @@
                             if (task->tc_State >= 7) {
                                     Remove((struct Node*)task);
                                     if ((task->tc_State -= 7) == TS_READY)
-                                            Enqueue((struct List*)&SysBase->TaskReady, (struct Node*)task);
+                                            READYQUEUE_ENQUEUE(task);
                                     else
                                             Enqueue((struct List*)&SysBase->TaskWait, (struct Node*)task);
                                     res = TRUE;
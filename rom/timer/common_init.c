@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2011, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Timer startup, common part
 */
@@ -12,7 +12,7 @@
 
 static int common_Init(struct TimerBase *LIBBASE)
 {
-    ULONG i;
+    ULONG i, j, l;
 
     /* kernel.resource is optional for some implementations, so no check */
     LIBBASE->tb_KernelBase = OpenResource("kernel.resource");
@@ -23,9 +23,21 @@ static int common_Init(struct TimerBase *LIBBASE)
     LIBBASE->tb_Elapsed.tv_secs  = 0;
     LIBBASE->tb_Elapsed.tv_micro = 0;
 
-    /* Initialise the lists */
+    /* Initialise the queues */
     for (i = 0; i < NUM_LISTS; i++)
-        NEWLIST(&LIBBASE->tb_Lists[i]);
+    {
+        NEWLIST(&LIBBASE->tb_Queues[i].tq_Due);
+        NEWLIST(&LIBBASE->tb_Queues[i].tq_Far);
+        for (l = 0; l < TIMER_LEVELS; l++)
+        {
+            for (j = 0; j < TIMER_WHEELSIZE; j++)
+                NEWLIST(&LIBBASE->tb_Queues[i].tq_Wheel[l][j]);
+            for (j = 0; j < TIMER_WHEELSIZE / 32; j++)
+                LIBBASE->tb_Queues[i].tq_Mask[l][j] = 0;
+        }
+        LIBBASE->tb_Queues[i].tq_Slot = 0;
+        LIBBASE->tb_Queues[i].tq_FarSlot = ~0ULL;
+    }
 
     return TRUE;
 }
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2018, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 
     Desc: Common IORequest processing routines
 */
@@ -74,6 +74,185 @@ static void addToWaitList(struct MinList *list, struct timerequest *iotr, struct
 #endif
 }
 
+/*
+ * Requests used to be kept in one sorted list per unit, which made every
+ * TR_ADDREQUEST walk past all requests that are due before it, with
+ * interrupts disabled. With thousands of pending requests (network stacks,
+ * timeouts of many tasks) this took longer than the timer interrupt period.
+ * Now only requests that are about to complete are sorted, the others are
+ * hashed onto a two level timing wheel by their due time (see
+ * timer_intern.h). A heap was not used because it needs memory of its own,
+ * which can't be allocated here, and because requests couldn't be aborted
+ * by simply removing them.
+ */
+static inline UQUAD timeSlot(struct timeval *tv)
+{
+    return ((UQUAD)tv->tv_secs * 1000000 + tv->tv_micro) >> TIMER_SLOTSHIFT;
+}
+
+/* Find the lowest bit set in a wheel mask between from and to, -1 if there is none */
+static LONG nextMaskBit(ULONG *mask, ULONG from, ULONG to)
+{
+    ULONG word, bits;
+
+    if (from > to)
+        return -1;
+
+    word = from >> 5;
+    bits = mask[word] & (~0UL << (from & 31));
+    for (;;)
+    {
+        if (bits)
+        {
+            ULONG bit = (word << 5) + __builtin_ctz(bits);
+
+            return (bit <= to) ? (LONG)bit : -1;
+        }
+        if (++word > (to >> 5))
+            return -1;
+        bits = mask[word];
+    }
+}
+
+static void addToQueue(struct TimerQueue *queue, struct timerequest *iotr, struct ExecBase *SysBase)
+{
+    UQUAD slot = timeSlot(&iotr->tr_time);
+    UQUAD unit;
+    ULONG level, i;
+
+    if (slot <= queue->tq_Slot)
+    {
+        addToWaitList(&queue->tq_Due, iotr, SysBase);
+        return;
+    }
+
+    /* The innermost wheel whose current turn the request is due in */
+    for (level = 0; level < TIMER_LEVELS; level++)
+    {
+        unit = slot >> (level * TIMER_WHEELSHIFT);
+        if (unit <= ((queue->tq_Slot >> (level * TIMER_WHEELSHIFT)) | TIMER_WHEELMASK))
+        {
+            i = unit & TIMER_WHEELMASK;
+            ADDTAIL(&queue->tq_Wheel[level][i], iotr);
+            queue->tq_Mask[level][i >> 5] |= (1UL << (i & 31));
+            return;
+        }
+    }
+
+    ADDTAIL(&queue->tq_Far, iotr);
+    if (slot < queue->tq_FarSlot)
+        queue->tq_FarSlot = slot;
+}
+
+/*
+ * Requeue all requests of a list that came up, after tq_Slot has moved on.
+ * They all end up on tq_Due or on a wheel inside the one the list is on.
+ */
+static void requeueList(struct TimerQueue *queue, struct MinList *list, struct ExecBase *SysBase)
+{
+    struct timerequest *tr;
+
+    while ((tr = (struct timerequest *)REMHEAD(list)) != NULL)
+        addToQueue(queue, tr, SysBase);
+}
+
+/*
+ * Brings the queue up to the given time, moving the requests that become
+ * due to the sorted list. Every request is moved at most once per wheel,
+ * and stretches with nothing queued are skipped using the masks, so this
+ * stays cheap even after the clock was set or the queue was idle. Only
+ * tq_Far is walked as a whole, once per turn of the outermost wheel
+ * (~3.2 days), and only if something on it is due in that turn.
+ */
+static void advanceQueue(struct TimerQueue *queue, struct timeval *now, struct ExecBase *SysBase)
+{
+    UQUAD target = timeSlot(now) + TIMER_LOOKAHEAD;
+    UQUAD unit, next, last;
+    struct timerequest *tr;
+    ULONG level, shift;
+    LONG i;
+
+    while (queue->tq_Slot < target)
+    {
+        /* Move the slots of the current turn that came up to tq_Due */
+        last = queue->tq_Slot | TIMER_WHEELMASK;
+        if (last > target)
+            last = target;
+        if (last > queue->tq_Slot)
+        {
+            ULONG from = (queue->tq_Slot + 1) & TIMER_WHEELMASK;
+
+            while ((i = nextMaskBit(queue->tq_Mask[0], from, last & TIMER_WHEELMASK)) >= 0)
+            {
+                queue->tq_Mask[0][i >> 5] &= ~(1UL << (i & 31));
+                while ((tr = (struct timerequest *)REMHEAD(&queue->tq_Wheel[0][i])) != NULL)
+                    addToWaitList(&queue->tq_Due, tr, SysBase);
+                from = i + 1;
+            }
+            queue->tq_Slot = last;
+        }
+        if (queue->tq_Slot >= target)
+            break;
+
+        /*
+         * The current turn of the inner wheel is over. Go on with the next
+         * list of an outer wheel that has requests queued, or with the turn
+         * the target is in if that comes first.
+         */
+        next = target & ~(UQUAD)TIMER_WHEELMASK;
+        for (level = 1; level < TIMER_LEVELS; level++)
+        {
+            shift = level * TIMER_WHEELSHIFT;
+            unit = queue->tq_Slot >> shift;
+            last = unit | TIMER_WHEELMASK;
+            if (last > (target >> shift))
+                last = target >> shift;
+            if ((last > unit) &&
+                ((i = nextMaskBit(queue->tq_Mask[level], (unit + 1) & TIMER_WHEELMASK, last & TIMER_WHEELMASK)) >= 0))
+            {
+                next = ((unit & ~(UQUAD)TIMER_WHEELMASK) + i) << shift;
+                break;
+            }
+        }
+        shift = TIMER_LEVELS * TIMER_WHEELSHIFT;
+        if (level == TIMER_LEVELS)
+        {
+            /* Nothing queued on the wheels before the target, stop where tq_Far needs looking at */
+            unit = queue->tq_FarSlot >> shift;
+            if ((unit > (queue->tq_Slot >> shift)) && ((unit << shift) < next))
+                next = unit << shift;
+        }
+
+        unit = queue->tq_Slot >> shift;
+        queue->tq_Slot = next;
+
+        /* A new turn of the outermost wheel, get the requests due in it off tq_Far */
+        if (((next >> shift) != unit) && ((queue->tq_FarSlot >> shift) <= (next >> shift)))
+        {
+            struct MinList pending;
+
+            /* Requests due later go back onto tq_Far, so take them all off first */
+            NEWLIST(&pending);
+            while ((tr = (struct timerequest *)REMHEAD(&queue->tq_Far)) != NULL)
+                ADDTAIL(&pending, tr);
+
+            queue->tq_FarSlot = ~0ULL;
+            requeueList(queue, &pending, SysBase);
+        }
+
+        /* Spread the requests of the lists that came up over the wheels inside them */
+        for (level = TIMER_LEVELS - 1; level > 0; level--)
+        {
+            i = (next >> (level * TIMER_WHEELSHIFT)) & TIMER_WHEELMASK;
+            if (queue->tq_Mask[level][i >> 5] & (1UL << (i & 31)))
+            {
+                queue->tq_Mask[level][i >> 5] &= ~(1UL << (i & 31));
+                requeueList(queue, &queue->tq_Wheel[level][i], SysBase);
+            }
+        }
+    }
+}
+
 BOOL common_BeginIO(struct timerequest *timereq, struct TimerBase *TimerBase)
 {
     ULONG unitNum = (IPTR)timereq->tr_node.io_Unit;
@@ -163,7 +342,7 @@ BOOL common_BeginIO(struct timerequest *timereq, struct TimerBase *TimerBase)
                 if (ExecLockBase) ObtainLock(TimerBase->tb_ListLock, SPINLOCK_MODE_WRITE, 0);
 #endif
                 /* Ok, we add this to the list */
-                addToWaitList(&TimerBase->tb_Lists[TL_WAITVBL], timereq, SysBase);
+                addToQueue(&TimerBase->tb_Queues[TL_WAITVBL], timereq, SysBase);
                 timereq->tr_node.io_Flags &= ~IOF_QUICK;
 
                 /*
@@ -171,7 +350,7 @@ BOOL common_BeginIO(struct timerequest *timereq, struct TimerBase *TimerBase)
                  * readjust our hardware interrupt (reset elapsed time).
                  * This routine returns TRUE in order to indicate this.
                  */
-                if (TimerBase->tb_Lists[TL_WAITVBL].mlh_Head == (struct MinNode *)timereq)
+                if (TimerBase->tb_Queues[TL_WAITVBL].tq_Due.mlh_Head == (struct MinNode *)timereq)
                     addedhead = TRUE;
 
 #if defined(__AROSEXEC_SMP__)
@@ -206,12 +385,12 @@ BOOL common_BeginIO(struct timerequest *timereq, struct TimerBase *TimerBase)
 #if defined(__AROSEXEC_SMP__)
                 if (ExecLockBase) ObtainLock(TimerBase->tb_ListLock, SPINLOCK_MODE_WRITE, 0);
 #endif
-                /* Slot it into the list. Use unit number as index. */
-                addToWaitList(&TimerBase->tb_Lists[unitNum], timereq, SysBase);
+                /* Slot it into the queue. Use unit number as index. */
+                addToQueue(&TimerBase->tb_Queues[unitNum], timereq, SysBase);
                 timereq->tr_node.io_Flags &= ~IOF_QUICK;
 
                 /* Indicate if HW need to be reprogrammed */
-                if (TimerBase->tb_Lists[unitNum].mlh_Head == (struct MinNode *)timereq)
+                if (TimerBase->tb_Queues[unitNum].tq_Due.mlh_Head == (struct MinNode *)timereq)
                     addedhead = TRUE;
 
 #if defined(__AROSEXEC_SMP__)
@@ -266,8 +445,8 @@ void TimerProcessMicroHZ(struct TimerBase *TimerBase, struct ExecBase *SysBase,
 #if defined(__AROSEXEC_SMP__)
     struct ExecLockBase *ExecLockBase = TimerBase->tb_ExecLockBase;
 #endif
-    struct MinList *unit = &TimerBase->tb_Lists[TL_MICROHZ];
-    struct timerequest *tr, *next;
+    struct TimerQueue *unit = &TimerBase->tb_Queues[TL_MICROHZ];
+    struct timerequest *tr;
 
     /*
      * Go through the list and return requests that have completed.
@@ -276,7 +455,9 @@ void TimerProcessMicroHZ(struct TimerBase *TimerBase, struct ExecBase *SysBase,
 #if defined(__AROSEXEC_SMP__)
     if (ExecLockBase && !locked) ObtainLock(TimerBase->tb_ListLock, SPINLOCK_MODE_WRITE, 0);
 #endif
-    ForeachNodeSafe(unit, tr, next)
+    advanceQueue(unit, &TimerBase->tb_Elapsed, SysBase);
+
+    while ((tr = (struct timerequest *)GetHead(&unit->tq_Due)) != NULL)
     {
         if (CMPTIME(&TimerBase->tb_Elapsed, &tr->tr_time) <= 0)
         {
@@ -313,7 +494,7 @@ void TimerProcessMicroHZ(struct TimerBase *TimerBase, struct ExecBase *SysBase,
                 tr->tr_time.tv_secs  = 0;
                 tr->tr_time.tv_micro = 1000000 / SysBase->VBlankFrequency;
                 ADDTIME(&tr->tr_time, &TimerBase->tb_Elapsed);
-                addToWaitList(unit, tr, SysBase);
+                addToQueue(unit, tr, SysBase);
 
                 continue;
             }
@@ -352,7 +533,7 @@ void TimerProcessVBlank(struct TimerBase *TimerBase, struct ExecBase *SysBase, B
      *    is UNIT_WAITUNTIL queue.
      * We could use subroutines and save some space, but we prefer speed here.
      */
-    struct timerequest *tr, *next;
+    struct timerequest *tr;
 
     /*
      * Go through the "wait for x seconds" list and return requests
@@ -362,7 +543,9 @@ void TimerProcessVBlank(struct TimerBase *TimerBase, struct ExecBase *SysBase, B
 #if defined(__AROSEXEC_SMP__)
     if (ExecLockBase && !locked) ObtainLock(TimerBase->tb_ListLock, SPINLOCK_MODE_WRITE, 0);
 #endif
-    ForeachNodeSafe(&TimerBase->tb_Lists[TL_VBLANK], tr, next)
+    advanceQueue(&TimerBase->tb_Queues[TL_VBLANK], &TimerBase->tb_Elapsed, SysBase);
+
+    while ((tr = (struct timerequest *)GetHead(&TimerBase->tb_Queues[TL_VBLANK].tq_Due)) != NULL)
     {
         if (CMPTIME(&TimerBase->tb_Elapsed, &tr->tr_time) <= 0)
         {
@@ -382,7 +565,9 @@ void TimerProcessVBlank(struct TimerBase *TimerBase, struct ExecBase *SysBase, B
      * The other this is the "wait until a specified time". Here a request
      * is complete if the time we are waiting for is before the current time.
      */
-    ForeachNodeSafe(&TimerBase->tb_Lists[TL_WAITVBL], tr, next)
+    advanceQueue(&TimerBase->tb_Queues[TL_WAITVBL], &TimerBase->tb_CurrentTime, SysBase);
+
+    while ((tr = (struct timerequest *)GetHead(&TimerBase->tb_Queues[TL_WAITVBL].tq_Due)) != NULL)
     {
         if (CMPTIME(&TimerBase->tb_CurrentTime, &tr->tr_time) <= 0)
         {
@@ -2,7 +2,7 @@
 #define _TIMER_INTERN_H
 
 /*
-    Copyright  1995-2020, The AROS Development Team. All rights reserved.
+    Copyright  1995-2026, The AROS Development Team. All rights reserved.
     $Id$
 
     Desc: Internal information about the timer.device and HIDD's
@@ -38,6 +38,38 @@
 #define TL_WAITVBL	2
 #define NUM_LISTS	3
 
+/*
+ * Pending requests of a unit, kept on a hierarchical timing wheel. The
+ * inner wheel is divided into slots of 2^TIMER_SLOTSHIFT microseconds,
+ * each further wheel into turns of the one inside it. Requests due within
+ * TIMER_LOOKAHEAD slots of the time the queue was last processed are kept
+ * sorted in tq_Due, so its head is always the next one to complete. Later
+ * ones are added unsorted to the innermost wheel whose current turn they
+ * are due in, or to tq_Far if they are due after the current turn of the
+ * outermost one. When a list of an outer wheel comes up, its requests are
+ * spread over the wheels inside it, and each slot of the inner wheel is
+ * moved to tq_Due when it comes up, so a request is only moved once per
+ * wheel. A request is always on exactly one of these lists, so AbortIO()
+ * can still simply Remove() it. The masks have a bit set for every list
+ * that may be non-empty, so stretches with nothing queued are skipped.
+ */
+#define TIMER_SLOTSHIFT	14		/* ~16.4 ms */
+#define TIMER_WHEELSHIFT	8
+#define TIMER_WHEELSIZE	(1 << TIMER_WHEELSHIFT)
+#define TIMER_WHEELMASK	(TIMER_WHEELSIZE - 1)
+#define TIMER_LEVELS	3		/* Turns of ~4.2 s, ~18 min and ~3.2 days */
+#define TIMER_LOOKAHEAD	2
+
+struct TimerQueue
+{
+    struct MinList	        tq_Due;			/* Sorted, due before the end of tq_Slot		*/
+    struct MinList	        tq_Far;			/* Due after the current turn of the outermost wheel	*/
+    UQUAD		        tq_Slot;		/* Last slot moved to tq_Due				*/
+    UQUAD		        tq_FarSlot;		/* Nothing on tq_Far is due before this slot		*/
+    ULONG		        tq_Mask[TIMER_LEVELS][TIMER_WHEELSIZE / 32];
+    struct MinList	        tq_Wheel[TIMER_LEVELS][TIMER_WHEELSIZE];
+};
+
 struct TimerBase
 {
     /* Required by the system */
@@ -54,7 +86,7 @@ struct TimerBase
     struct Interrupt	        tb_ResetHandler;	/* Stops interrupt generation before a reboot		*/
 
     /* Request queues */
-    struct MinList	        tb_Lists[NUM_LISTS];
+    struct TimerQueue	        tb_Queues[NUM_LISTS];
 
     /* EClock counter */
     UQUAD                       tb_ticks_total;	        /* Effective EClock value				*/
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2001-2017, The AROS Development Team. All rights reserved.
+    Copyright (C) 2001-2026, The AROS Development Team. All rights reserved.
 
     Desc: Copy CLI command
 */
@@ -18,7 +18,7 @@
         PAT=PATTERN/K, DIRECT/S,SILENT/S, ERRWARN/S, MAKEDIR/S, MOVE/S,
         DELETE/S, HARD=HARDLINK/S, SOFT=SOFTLINK/S, FOLNK=FORCELINK/S,
         FODEL=FORCEDELETE/S, FOOVR=FORCEOVERWRITE/S, DONTOVR=DONTOVERWRITE/S,
-        FORCE/S,NEWER/S
+        FORCE/S,NEWER/S,PIPE=PIPELINE/K/N,PAR=PARALLEL/K/N,STATS/S
 
     LOCATION
 
@@ -209,6 +209,16 @@
         In Copy mode you may use f.e. "Copy C: RAM:K" instead of
         "Copy C:#? RAM:K". For the other modes this does not work!
 
+        PIPELINE keeps that many buffers of a file in flight at the same
+        time, so that reading the source overlaps with writing the
+        destination. The buffer space given with BUFFER is split between
+        them, but no buffer is larger than the devices' MaxTransfer.
+        PARALLEL copies that many files at the same time, which helps
+        with trees of small files. Results of files copied in parallel
+        are printed when they are done. STATS prints the number of files
+        and bytes copied and the throughput at the end. Both PIPELINE and
+        PARALLEL only apply between filesystems.
+
         Destination files are always overwritten, except DONTOVERWRITE is
         turned on, or they are protected.
 
@@ -289,6 +299,10 @@
         arguments mandatory and the command now returns ERROR_REQUIRED_ARG_MISSING
         if required arguments are missing. 
 
+        October 2026
+        Added PIPELINE, PARALLEL and STATS. Files are then copied with
+        asynchronous dos packets.
+
 ******************************************************************************/
 
 #define CTRL_C          (SetSignal(0L,0L) & SIGBREAKF_CTRL_C)
@@ -306,7 +320,9 @@
 #include <exec/memory.h>
 #include <exec/semaphores.h>
 #include <exec/types.h>
+#include <dos/dosextens.h>
 #include <dos/exall.h>
+#include <dos/filehandler.h>
 
 #ifdef __SASC
 typedef ULONG IPTR;
@@ -319,7 +335,7 @@ typedef ULONG IPTR;
 
 #include <string.h>
 
-const TEXT version[] = "\0$VER: Copy 50.18 (08.05.2025)";
+const TEXT version[] = "\0$VER: Copy 50.19 (16.10.2026)";
 
 static const UBYTE *PARAM =
 "FROM/M/A,TO/A,PAT=PATTERN/K,BUF=BUFFER/K/N,ALL/S,"
@@ -332,7 +348,7 @@ static const UBYTE *PARAM =
 "MOVE/S,DELETE/S,HARD=HARDLINK/S,SOFT=SOFTLINK/S,"
 "FOLNK=FORCELINK/S,FODEL=FORCEDELETE/S,"
 "FOOVR=FORCEOVERWRITE/S,DONTOVR=DONTOVERWRITE/S,"
-"FORCE/S,NEWER/S";
+"FORCE/S,NEWER/S,PIPE=PIPELINE/K/N,PAR=PARALLEL/K/N,STATS/S";
 
 #define COPYFLAG_ALL            (1<<0)
 #define COPYFLAG_DATES          (1<<1)
@@ -366,6 +382,15 @@ static const UBYTE *PARAM =
 
 #define FILEPATH_SIZE           2048    /* maximum size of filepaths     */
 
+#define PIPE_MAXBUFS            16      /* maximum buffers per file      */
+#define PAR_MAXJOBS             8       /* maximum files at same time    */
+
+/* state of the buffers of a CopyJob */
+#define JOBBUF_FREE             0
+#define JOBBUF_READING          1
+#define JOBBUF_FULL             2
+#define JOBBUF_WRITING          3
+
 /* return values */
 #define TESTDEST_DIR_OK         2       /* directory exists, go in */
 #define TESTDEST_DELETED        1       /* file or empty directory deleted */
@@ -402,6 +427,9 @@ struct IptrArgs
     IPTR  dontoverwrite;
     IPTR  force;
     IPTR  newer;
+    IPTR  pipeline;
+    IPTR  parallel;
+    IPTR  stats;
 };
 
 
@@ -432,8 +460,47 @@ struct Args
     LONG    dontoverwrite;
     LONG    force;
     LONG    newer;
+    LONG   *pipeline;
+    LONG   *parallel;
+    LONG    stats;
+};
+
+
+/*
+** A file copied with asynchronous packets. Reads into the free buffers
+** are sent ahead, and each buffer is written as soon as all data before
+** it has been written.
+*/
+
+struct CopyJob
+{
+    struct FileInfoBlock Fib;   /* for SetData() when done */
+    BPTR        In;
+    BPTR        Out;
+    STRPTR      Buffer;         /* NumBufs buffers of BufSize bytes */
+    ULONG       BufferLen;      /* allocated size of Buffer */
+    ULONG       BufSize;
+    UBYTE       NumBufs;
+    UBYTE       Active;
+    UBYTE       Sync;           /* CopyFile() waits for it */
+    UBYTE       Eof;
+    UBYTE       Deep;
+    UBYTE       State[PIPE_MAXBUFS];
+    LONG        Len[PIPE_MAXBUFS];
+    ULONG       Seq[PIPE_MAXBUFS];
+    ULONG       NextRead;       /* sequence number of next read  */
+    ULONG       NextWrite;      /* sequence number of next write */
+    ULONG       InFlight;
+    LONG        Err;
+    LONG        IoErr;
+    CONST_STRPTR Text;
+    UBYTE       Name[256];
+    UBYTE       FileName[FILEPATH_SIZE];
+    UBYTE       DestName[FILEPATH_SIZE];
 };
 
+#define JOBBUF(job, i)          ((job)->Buffer + (i) * (job)->BufSize)
+
 
 struct CopyData
 {
@@ -457,6 +524,14 @@ struct CopyData
 
     STRPTR      CopyBuf;
     ULONG       CopyBufLen;
+
+    struct CopyJob      *Jobs;
+    struct AsyncPktPool *Pool;
+    UBYTE       NumJobs;        /* files copied at the same time */
+    UBYTE       NumBufs;        /* buffers in flight per file    */
+    ULONG       FilesCopied;
+    UQUAD       BytesCopied;
+    struct DateStamp Start;
 };
 
 /*
@@ -541,7 +616,7 @@ void  PatCopy(STRPTR, struct CopyData *);
 void  PrintName(CONST_STRPTR, ULONG, ULONG, ULONG, struct CopyData *);
 void  PrintNotDone(CONST_STRPTR, CONST_STRPTR, ULONG, ULONG, struct CopyData *);
 ULONG TestFileSys(STRPTR, struct CopyData *); /* returns value, when is a filesystem */
-void  SetData(STRPTR, struct CopyData *);
+void  SetData(STRPTR, struct FileInfoBlock *, struct CopyData *);
 LONG  TestDest(STRPTR, ULONG, struct CopyData *);
 ULONG TestLoop(BPTR, BPTR, struct CopyData *);
 static LONG CheckVersion( struct CopyData *cd );
@@ -549,6 +624,12 @@ static void makeversionfromstring( STRPTR buffer, struct VersionData *vd, struct
 static STRPTR skipspaces( STRPTR buffer);
 static STRPTR skipnonspaces( STRPTR buffer);
 static BOOL VersionFind( CONST_STRPTR path, struct VersionData *vds, struct CopyData *cd);
+static BOOL CanPipeline(BPTR from, BPTR to, struct CopyData *cd);
+static BOOL QueueCopy(BPTR from, BPTR to, CONST_STRPTR name, CONST_STRPTR txt, struct CopyData *cd);
+static void WaitJobs(CONST_STRPTR name, struct CopyData *cd);
+static void RunJobs(struct CopyData *cd);
+static void FreeJobs(struct CopyData *cd);
+static void PrintStats(struct CopyData *cd);
 
 static char cmdname[] = "Copy";
 
@@ -593,6 +674,8 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
 #define DOSBase cd->DOSBase
 
         cd->BufferSize = 512*1024;
+        cd->NumJobs = 1;
+        cd->NumBufs = 1;
         cd->Mode = COPYMODE_COPY;
         cd->RetVal2 = RETURN_FAIL;
         cd->Deep = 1;
@@ -629,7 +712,10 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
                 "FOOVR    also overwrite protected files\n"
                 "DONTOVR  do never overwrite destination\n"
                 "FORCE    DO NOT USE. Call compatibility only.\n"
-                "NEWER    will compare version strings and only overwrites older files\n";
+                "NEWER    will compare version strings and only overwrites older files\n"
+                "PIPELINE number of buffers per file in flight at the same time\n"
+                "PARALLEL number of files copied at the same time\n"
+                "STATS    print the number of bytes copied and the throughput\n";
 
             if (ReadArgs(PARAM, (IPTR *)&iArgs, rda))
             {
@@ -666,6 +752,11 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
                 args.dontoverwrite = (LONG)iArgs.dontoverwrite;
                 args.force = (LONG)iArgs.force;
                 args.newer = (LONG)iArgs.newer;
+                args.pipeline = (LONG *)iArgs.pipeline;
+                args.parallel = (LONG *)iArgs.parallel;
+                args.stats = (LONG)iArgs.stats;
+
+                DateStamp(&cd->Start);
 
                 if (args.quiet) /* when QUIET, SILENT and NOREQ are also
                                    true! */
@@ -680,6 +771,21 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
                     cd->BufferSize = *args.buffer * 512;
                 }
 
+                /* The asynchronous packet functions are new in dos.library 50.77 */
+                if (DOSBase->dl_lib.lib_Version > 50 ||
+                    (DOSBase->dl_lib.lib_Version == 50 && DOSBase->dl_lib.lib_Revision >= 77))
+                {
+                    if (args.pipeline && *args.pipeline > 1)
+                    {
+                        cd->NumBufs = MIN(*args.pipeline, PIPE_MAXBUFS);
+                    }
+
+                    if (args.parallel && *args.parallel > 1)
+                    {
+                        cd->NumJobs = MIN(*args.parallel, PAR_MAXJOBS);
+                    }
+                }
+
                 if (args.quiet)
                 {
                     cd->Flags |= COPYFLAG_QUIET;
@@ -1138,6 +1244,14 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
                             }
                         } /* else */
 
+                        /* Let the files still being copied finish */
+                        WaitJobs(NULL, cd);
+
+                        if (args.stats && !args.quiet)
+                        {
+                            PrintStats(cd);
+                        }
+
                         if (!(cd->Flags & COPYFLAG_DONE) && args.verbose &&
                             !cd->RetVal && !cd->RetVal2)
                         {
@@ -1186,6 +1300,8 @@ __startup static AROS_PROCH(Start, argstr, argsize, SysBase)
             FreeMem(cd->CopyBuf, cd->CopyBufLen);
         }
 
+        FreeJobs(cd);
+
 #undef SysBase
 #undef DOSBase
     }
@@ -1699,6 +1815,7 @@ void DoWork(STRPTR name, struct CopyData *cd)
 {
     BPTR pdir, lock = 0;
     CONST_STRPTR printerr = NULL, printok = "";
+    ULONG late;
 
 #if DEBUG
     Printf("DoWork(%s, .)\n", name);
@@ -1712,6 +1829,17 @@ void DoWork(STRPTR name, struct CopyData *cd)
         return;
     }
 
+    /* A directory is left for good only when the files in it are done */
+    if (cd->Flags & COPYFLAG_ENTERSECOND)
+    {
+        WaitJobs(NULL, cd);
+    }
+
+    /* Files that may be copied in the background are named with their
+       result, as other files may be done in between */
+    late = cd->NumJobs > 1 && cd->Fib.fib_DirEntryType < 0 &&
+           (cd->Mode == COPYMODE_COPY || cd->Mode == COPYMODE_MOVE);
+
     if (cd->Mode != COPYMODE_DELETE && !(cd->Flags & COPYFLAG_DESNOFILESYS))
     {
         if (!cd->DestPathSize)
@@ -1849,7 +1977,7 @@ void DoWork(STRPTR name, struct CopyData *cd)
 
     if (!(cd->Flags & COPYFLAG_QUIET))
     {
-        if ((cd->Flags & COPYFLAG_VERBOSE))
+        if ((cd->Flags & COPYFLAG_VERBOSE) && !late)
         {
             PrintName(name, cd->Deep, cd->Fib.fib_DirEntryType > 0, cd->Fib.fib_DirEntryType < 0 ||
                       (cd->Flags & COPYFLAG_ALL ? cd->Mode != COPYMODE_DELETE : cd->Mode != COPYMODE_COPY) ||
@@ -2014,6 +2142,9 @@ void DoWork(STRPTR name, struct CopyData *cd)
     }
     else
     {
+        /* a file still being copied to or from may be in the way */
+        WaitJobs(cd->DestName, cd);
+
         /* test for existing destination file */
         if (TestDest(cd->DestName, 0, cd) < 0)
         {
@@ -2042,7 +2173,7 @@ void DoWork(STRPTR name, struct CopyData *cd)
         }
         else
         {
-            ULONG res = 0, h;
+            ULONG res = 0, h, queued = 0;
             BPTR in, out;
             CONST_STRPTR txt = TEXT_OPENED_FOR_OUTPUT;
 
@@ -2054,7 +2185,15 @@ void DoWork(STRPTR name, struct CopyData *cd)
                 UnLock(lock);
                 lock = 0;
 
-                if ((in = Open(cd->FileName, MODE_OLDFILE)))
+                if ((in = Open(cd->FileName, MODE_OLDFILE)) &&
+                    QueueCopy(in, out, name, txt, cd))
+                {
+                    /* closed and reported when done */
+                    out = BNULL;
+                    kill = 0;
+                    queued = 1;
+                }
+                else if (in)
                 {
                     h = CopyFile(in, out, cd->BufferSize, cd);
                     if (h != 0)
@@ -2094,7 +2233,11 @@ void DoWork(STRPTR name, struct CopyData *cd)
             }
             else cd->IoErr = IoErr();
 
-            if (!res)
+            if (queued)
+            {
+                printok = 0;
+            }
+            else if (!res)
             {
                 printerr = txt;
                 cd->RetVal = RETURN_WARN;
@@ -2106,6 +2249,12 @@ void DoWork(STRPTR name, struct CopyData *cd)
         }
     }
 
+    if (late && (printerr || printok) && !(cd->Flags & COPYFLAG_QUIET) &&
+        (cd->Flags & COPYFLAG_VERBOSE))
+    {
+        PrintName(name, cd->Deep, 0, 1, cd);
+    }
+
     if (printerr && !(cd->Flags & COPYFLAG_QUIET))
     {
         PrintNotDone(name, printerr, cd->Deep, cd->Fib.fib_DirEntryType > 0, cd);
@@ -2124,7 +2273,7 @@ void DoWork(STRPTR name, struct CopyData *cd)
 
         if (cd->Mode != COPYMODE_DELETE)
         {
-            SetData(cd->DestName, cd);
+            SetData(cd->DestName, &cd->Fib, cd);
         }
     }
 
@@ -2135,11 +2284,518 @@ void DoWork(STRPTR name, struct CopyData *cd)
 }
 
 
+/* Largest transfer the device behind a filehandle accepts, 0 if unknown */
+static ULONG MaxTransfer(BPTR fh, struct CopyData *cd)
+{
+    struct MsgPort *port = ((struct FileHandle *) BADDR(fh))->fh_Type;
+    struct DosList *dl;
+    ULONG max = 0;
+
+    dl = LockDosList(LDF_DEVICES | LDF_READ);
+    while ((dl = NextDosEntry(dl, LDF_DEVICES)))
+    {
+        if (dl->dol_Task == port)
+        {
+            /* Not every handler gets a FileSysStartupMsg */
+            if ((IPTR) dl->dol_misc.dol_handler.dol_Startup > 64)
+            {
+                struct FileSysStartupMsg *fssm = BADDR(dl->dol_misc.dol_handler.dol_Startup);
+                struct DosEnvec *de = BADDR(fssm->fssm_Environ);
+
+                if (de && de->de_TableSize >= DE_MAXTRANSFER)
+                {
+                    max = de->de_MaxTransfer;
+                }
+            }
+            break;
+        }
+    }
+    UnLockDosList(LDF_DEVICES | LDF_READ);
+
+    return max;
+}
+
+
+static BOOL CanPipeline(BPTR from, BPTR to, struct CopyData *cd)
+{
+    struct FileHandle *in = BADDR(from), *out = BADDR(to);
+
+    /* Only filesystems are sure to serve the packets in order */
+    return in->fh_Type && out->fh_Type && !in->fh_Interactive && !out->fh_Interactive &&
+           !(cd->Flags & (COPYFLAG_SRCNOFILESYS | COPYFLAG_DESNOFILESYS));
+}
+
+
+/* Returns an unused job with buffers, waiting for one if they are all busy */
+static struct CopyJob *GetJob(struct CopyData *cd)
+{
+    struct CopyJob *job;
+    ULONG i, bufsize;
+
+    if (!cd->Jobs)
+    {
+        if ((cd->Jobs = AllocMem(cd->NumJobs * sizeof(struct CopyJob), MEMF_PUBLIC | MEMF_CLEAR)))
+        {
+            if (!(cd->Pool = CreateAsyncPktPool(cd->NumJobs * cd->NumBufs)))
+            {
+                FreeMem(cd->Jobs, cd->NumJobs * sizeof(struct CopyJob));
+                cd->Jobs = 0;
+            }
+        }
+
+        if (!cd->Jobs)
+        {
+            /* fall back to plain copying */
+            cd->NumJobs = cd->NumBufs = 1;
+            return 0;
+        }
+    }
+
+    for (;;)
+    {
+        for (i = 0; i < cd->NumJobs && cd->Jobs[i].Active; ++i)
+            ;
+
+        if (i < cd->NumJobs)
+        {
+            break;
+        }
+
+        RunJobs(cd);
+    }
+
+    job = &cd->Jobs[i];
+
+    if (!job->Buffer)
+    {
+        bufsize = cd->BufferSize;
+
+        do
+        {
+            if ((job->Buffer = (STRPTR)AllocMem(bufsize, MEMF_PUBLIC)))
+            {
+                job->BufferLen = bufsize;
+                break;
+            }
+
+            bufsize >>= 1;
+
+        } while (bufsize >= 512);
+    }
+
+    return job->Buffer ? job : 0;
+}
+
+
+/* Sends writes of the buffers that are next in line, and reads into the free ones */
+static void PumpJob(struct CopyJob *job, struct CopyData *cd)
+{
+    struct FileHandle *in = BADDR(job->In), *out = BADDR(job->Out);
+    ULONG i, more;
+
+    do
+    {
+        more = 0;
+
+        for (i = 0; i < job->NumBufs; ++i)
+        {
+            if (job->State[i] != JOBBUF_FULL || job->Seq[i] != job->NextWrite)
+            {
+                continue;
+            }
+
+            ++job->NextWrite;
+            more = 1;
+
+            if (job->Len[i] == 0 || job->Err)
+            {
+                job->State[i] = JOBBUF_FREE;
+            }
+            else if (SendAsyncPkt(cd->Pool, out->fh_Type, ACTION_WRITE, out->fh_Arg1,
+                                  (SIPTR)JOBBUF(job, i), job->Len[i], 0, 0))
+            {
+                job->State[i] = JOBBUF_WRITING;
+                ++job->InFlight;
+            }
+            else
+            {
+                job->State[i] = JOBBUF_FREE;
+                job->Err = RETURN_FAIL;
+                job->IoErr = IoErr();
+            }
+        }
+    } while (more);
+
+    for (i = 0; i < job->NumBufs && !job->Eof && !job->Err; ++i)
+    {
+        if (job->State[i] != JOBBUF_FREE)
+        {
+            continue;
+        }
+
+        if (SendAsyncPkt(cd->Pool, in->fh_Type, ACTION_READ, in->fh_Arg1,
+                         (SIPTR)JOBBUF(job, i), job->BufSize, 0, 0))
+        {
+            job->State[i] = JOBBUF_READING;
+            job->Seq[i] = job->NextRead++;
+            ++job->InFlight;
+        }
+        else
+        {
+            job->Err = RETURN_FAIL;
+            job->IoErr = IoErr();
+        }
+    }
+}
+
+
+static BOOL JobDone(struct CopyJob *job)
+{
+    return !job->InFlight && (job->Err || (job->Eof && job->NextWrite == job->NextRead));
+}
+
+
+static void StartJob(struct CopyJob *job, BPTR from, BPTR to, struct CopyData *cd)
+{
+    ULONG i, size, max;
+
+    /* split the buffer, but don't ask the devices for more than they can do at once */
+    size = job->BufferLen / cd->NumBufs;
+
+    if ((max = MaxTransfer(from, cd)) && size > max)
+    {
+        size = max;
+    }
+
+    if ((max = MaxTransfer(to, cd)) && size > max)
+    {
+        size = max;
+    }
+
+    size &= ~511;
+    if (size < 512)
+    {
+        size = 512;
+    }
+
+    job->BufSize = size;
+    job->NumBufs = MIN(cd->NumBufs, job->BufferLen / size);
+    job->In = from;
+    job->Out = to;
+    job->Active = 1;
+    job->Eof = 0;
+    job->Err = 0;
+    job->IoErr = 0;
+    job->InFlight = 0;
+    job->NextRead = 0;
+    job->NextWrite = 0;
+
+    for (i = 0; i < job->NumBufs; ++i)
+    {
+        job->State[i] = JOBBUF_FREE;
+    }
+
+    /* the packets bypass the filehandle buffers */
+    Flush(from);
+    Flush(to);
+
+    PumpJob(job, cd);
+}
+
+
+/* Files copied in the background are closed and reported here */
+static void FinishJob(struct CopyJob *job, struct CopyData *cd)
+{
+    ULONG res = 0;
+
+    job->Active = 0;
+    Close(job->Out);
+    Close(job->In);
+
+    if (job->Err)
+    {
+        cd->IoErr = job->IoErr;
+        KillFile(job->DestName, 0, cd);
+    }
+    else
+    {
+        ++cd->FilesCopied;
+
+        if (cd->Mode != COPYMODE_MOVE ||
+            KillFile(job->FileName, cd->Flags & COPYFLAG_FORCEDELETE, cd))
+        {
+            res = 1;
+        }
+        else
+        {
+            cd->IoErr = IoErr();
+        }
+    }
+
+    if (!(cd->Flags & COPYFLAG_QUIET) && (cd->Flags & COPYFLAG_VERBOSE))
+    {
+        PrintName(job->Name, job->Deep, 0, 1, cd);
+    }
+
+    if (!res)
+    {
+        if (cd->RetVal < RETURN_WARN)
+        {
+            cd->RetVal = RETURN_WARN;
+        }
+
+        if (!(cd->Flags & COPYFLAG_QUIET))
+        {
+            PrintNotDone(job->Name, job->Text, job->Deep, 0, cd);
+        }
+    }
+    else
+    {
+        cd->Flags |= COPYFLAG_DONE;
+
+        if (!(cd->Flags & COPYFLAG_QUIET) && (cd->Flags & COPYFLAG_VERBOSE))
+        {
+            Printf("%s\n", job->Text);
+        }
+
+        SetData(job->DestName, &job->Fib, cd);
+    }
+}
+
+
+/* Handles the next reply, and finishes the jobs that are done by it */
+static void RunJobs(struct CopyData *cd)
+{
+    struct DosPacket *dp;
+    struct CopyJob *job;
+    ULONG i, b;
+
+    if (CTRL_C)
+    {
+        for (i = 0; i < cd->NumJobs; ++i)
+        {
+            if (cd->Jobs[i].Active && !cd->Jobs[i].Err)
+            {
+                cd->Jobs[i].Err = RETURN_FAIL;
+                cd->Jobs[i].IoErr = ERROR_BREAK;
+            }
+        }
+    }
+
+    if ((dp = WaitAsyncPkt(cd->Pool)))
+    {
+        for (i = 0; i < cd->NumJobs; ++i)
+        {
+            job = &cd->Jobs[i];
+
+            if (job->Active && (STRPTR)dp->dp_Arg2 >= job->Buffer &&
+                (STRPTR)dp->dp_Arg2 < job->Buffer + job->BufferLen)
+            {
+                b = ((STRPTR)dp->dp_Arg2 - job->Buffer) / job->BufSize;
+                --job->InFlight;
+
+                if (dp->dp_Type == ACTION_READ)
+                {
+                    if (dp->dp_Res1 < 0)
+                    {
+                        job->State[b] = JOBBUF_FREE;
+                        if (!job->Err)
+                        {
+                            job->Err = RETURN_FAIL;
+                            job->IoErr = dp->dp_Res2;
+                        }
+                    }
+                    else
+                    {
+                        job->State[b] = JOBBUF_FULL;
+                        job->Len[b] = dp->dp_Res1;
+                        if (dp->dp_Res1 == 0)
+                        {
+                            job->Eof = 1;
+                        }
+                    }
+                }
+                else
+                {
+                    job->State[b] = JOBBUF_FREE;
+                    if (dp->dp_Res1 != job->Len[b])
+                    {
+                        if (!job->Err)
+                        {
+                            job->Err = RETURN_FAIL;
+                            job->IoErr = dp->dp_Res2;
+                        }
+                    }
+                    else
+                    {
+                        cd->BytesCopied += job->Len[b];
+                    }
+                }
+
+                PumpJob(job, cd);
+                break;
+            }
+        }
+
+        ReleaseAsyncPkt(cd->Pool, dp);
+    }
+    else
+    {
+        /* nothing in flight, so nothing can move anymore */
+        for (i = 0; i < cd->NumJobs; ++i)
+        {
+            if (cd->Jobs[i].Active && !cd->Jobs[i].Err)
+            {
+                cd->Jobs[i].Err = RETURN_FAIL;
+                cd->Jobs[i].IoErr = ERROR_NO_FREE_STORE;
+            }
+        }
+    }
+
+    for (i = 0; i < cd->NumJobs; ++i)
+    {
+        job = &cd->Jobs[i];
+
+        if (job->Active && !job->Sync && JobDone(job))
+        {
+            FinishJob(job, cd);
+        }
+    }
+}
+
+
+/* Copies a file in the background. Returns FALSE when it must be done with CopyFile() */
+static BOOL QueueCopy(BPTR from, BPTR to, CONST_STRPTR name, CONST_STRPTR txt, struct CopyData *cd)
+{
+    struct CopyJob *job;
+    ULONG len;
+
+    if (cd->NumJobs < 2 || !CanPipeline(from, to, cd) || !(job = GetJob(cd)))
+    {
+        return FALSE;
+    }
+
+    CopyMem(&cd->Fib, &job->Fib, sizeof(struct FileInfoBlock));
+    CopyMem(cd->FileName, job->FileName, FILEPATH_SIZE);
+    CopyMem(cd->DestName, job->DestName, FILEPATH_SIZE);
+
+    len = MIN(strlen(name), sizeof(job->Name) - 1);
+    CopyMem(name, job->Name, len);
+    job->Name[len] = 0;
+
+    job->Deep = cd->Deep;
+    job->Text = txt;
+    job->Sync = 0;
+
+    StartJob(job, from, to, cd);
+
+    return TRUE;
+}
+
+
+/* Waits for the jobs using a file, or for all of them when name is NULL */
+static void WaitJobs(CONST_STRPTR name, struct CopyData *cd)
+{
+    ULONG i, busy;
+
+    if (!cd->Jobs)
+    {
+        return;
+    }
+
+    do
+    {
+        for (i = 0, busy = 0; i < cd->NumJobs && !busy; ++i)
+        {
+            busy = cd->Jobs[i].Active &&
+                   (!name || !strcmp(name, cd->Jobs[i].FileName) ||
+                    !strcmp(name, cd->Jobs[i].DestName));
+        }
+
+        if (busy)
+        {
+            RunJobs(cd);
+        }
+    } while (busy);
+}
+
+
+static void FreeJobs(struct CopyData *cd)
+{
+    ULONG i;
+
+    if (cd->Jobs)
+    {
+        WaitJobs(NULL, cd);
+
+        for (i = 0; i < cd->NumJobs; ++i)
+        {
+            if (cd->Jobs[i].Buffer)
+            {
+                FreeMem(cd->Jobs[i].Buffer, cd->Jobs[i].BufferLen);
+            }
+        }
+
+        FreeMem(cd->Jobs, cd->NumJobs * sizeof(struct CopyJob));
+        DeleteAsyncPktPool(cd->Pool);
+        cd->Jobs = 0;
+    }
+}
+
+
+static void PrintStats(struct CopyData *cd)
+{
+    struct DateStamp now;
+    ULONG ticks, kb;
+
+    DateStamp(&now);
+    ticks = ((now.ds_Days - cd->Start.ds_Days) * 24 * 60 + now.ds_Minute - cd->Start.ds_Minute)
+            * 60 * TICKS_PER_SECOND + now.ds_Tick - cd->Start.ds_Tick;
+    if (!ticks)
+    {
+        ticks = 1;
+    }
+
+    kb = (ULONG)(cd->BytesCopied >> 10);
+
+    Printf("%lu files, %lu KB copied in %lu.%02lu s, %lu KB/s\n",
+           cd->FilesCopied, kb, ticks / TICKS_PER_SECOND,
+           (ticks % TICKS_PER_SECOND) * 100 / TICKS_PER_SECOND,
+           (ULONG)((UQUAD)kb * TICKS_PER_SECOND / ticks));
+}
+
+
 LONG CopyFile(BPTR from, BPTR to, ULONG bufsize, struct CopyData *cd)
 {
+    struct CopyJob *job;
     STRPTR buffer;
     LONG s, err = 0;
 
+    if (cd->NumBufs > 1 && CanPipeline(from, to, cd) && (job = GetJob(cd)))
+    {
+        job->Sync = 1;
+        StartJob(job, from, to, cd);
+
+        while (!JobDone(job))
+        {
+            RunJobs(cd);
+        }
+
+        job->Sync = 0;
+        job->Active = 0;
+
+        if (job->Err)
+        {
+            SetIoErr(job->IoErr);
+        }
+        else
+        {
+            ++cd->FilesCopied;
+        }
+
+        return job->Err;
+    }
+
     if (cd->CopyBuf)
     {
         buffer  = cd->CopyBuf;
@@ -2221,7 +2877,14 @@ LONG CopyFile(BPTR from, BPTR to, ULONG bufsize, struct CopyData *cd)
                     err = RETURN_FAIL;
                     break;
                 }
+
+                cd->BytesCopied += s;
             } while (s > 0);
+
+            if (!err)
+            {
+                ++cd->FilesCopied;
+            }
         }
 
         /* Freed at exit to avoid fragmentation */
@@ -2304,7 +2967,7 @@ ULONG TestLoop(BPTR srcdir, BPTR destdir, struct CopyData *cd)
 }
 
 
-void SetData(STRPTR name, struct CopyData *cd)
+void SetData(STRPTR name, struct FileInfoBlock *fib, struct CopyData *cd)
 {
     if (cd->Flags & COPYFLAG_NOPRO)
     {
@@ -2313,17 +2976,17 @@ void SetData(STRPTR name, struct CopyData *cd)
     }
     else
     {
-        SetProtection(name, cd->Fib.fib_Protection & (ULONG) ~FIBF_ARCHIVE);
+        SetProtection(name, fib->fib_Protection & (ULONG) ~FIBF_ARCHIVE);
     }
 
     if (cd->Flags & COPYFLAG_DATES)
     {
-        SetFileDate(name, &cd->Fib.fib_Date);
+        SetFileDate(name, &fib->fib_Date);
     }
 
     if (cd->Flags & COPYFLAG_COMMENT)
     {
-        SetComment(name, cd->Fib.fib_Comment);
+        SetComment(name, fib->fib_Comment);
     }
 }
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2025, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 /**********************************************************************/
@@ -46,6 +46,7 @@ ADD2LIBS("datatypes/picture.datatype", 0, struct Library *, PictureBase);
 /**************************************************************************************************/
 
 #define QUALITY 90      /* compress quality for saving */
+#define STRIPLINES 16   /* lines passed to picture.datatype at a time when loading */
 
 typedef struct {
     struct IFFHandle    *filehandle;
@@ -171,7 +172,26 @@ static void JPEG_Exit(JpegHandleType *jpeghandle, LONG errorcode)
 
 /**************************************************************************************************/
 
-static BOOL LoadJPEG(struct IClass *cl, Object *o)
+/* The smallest of 1/1, 1/2, 1/4 and 1/8 that still gives at least the given size */
+static unsigned int JPEG_ScaleDenom(ULONG width, ULONG height, ULONG maxwidth, ULONG maxheight)
+{
+    unsigned int denom = 8;
+
+    if (!maxwidth || !maxheight)
+        return 1;
+
+    while (denom > 1 &&
+           ((width + denom - 1) / denom < maxwidth || (height + denom - 1) / denom < maxheight))
+    {
+        denom >>= 1;
+    }
+
+    return denom;
+}
+
+/**************************************************************************************************/
+
+static BOOL LoadJPEG(struct IClass *cl, Object *o, struct TagItem *attrs)
 {
     JpegHandleType          *jpeghandle;
     union {
@@ -185,8 +205,9 @@ static BOOL LoadJPEG(struct IClass *cl, Object *o)
 
     struct jpeg_decompress_struct cinfo;
     struct my_error_mgr jerr;
-    JSAMPARRAY buffer;          /* Output row buffer */
+    JSAMPARRAY buffer;          /* Output row pointers */
     int row_stride;             /* physical row width in output buffer */
+    JDIMENSION strip_height, top, lines, i;
     my_src_ptr src;
 
     D(bug("jpeg.datatype/LoadJPEG()\n"));
@@ -241,6 +262,14 @@ static BOOL LoadJPEG(struct IClass *cl, Object *o)
     
     D(bug("jpeg.datatype/LoadJPEG(): Read Header\n"));
     (void) jpeg_read_header(&cinfo, TRUE);
+
+    /* Let the IDCT scale the picture down if it is only going to be shown small */
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = JPEG_ScaleDenom(cinfo.image_width, cinfo.image_height,
+                                        GetTagData(PDTA_MaxDecodeWidth, 0, attrs),
+                                        GetTagData(PDTA_MaxDecodeHeight, 0, attrs));
+    D(bug("jpeg.datatype/LoadJPEG(): Scaling 1/%d\n", (int)cinfo.scale_denom));
+
     D(bug("jpeg.datatype/LoadJPEG(): Starting decompression\n"));
     (void) jpeg_start_decompress(&cinfo);
     /* set BitMapHeader with image size */
@@ -255,33 +284,52 @@ static BOOL LoadJPEG(struct IClass *cl, Object *o)
         return FALSE;
     }
 
-    /* Make a one-row-high sample array that will go away when done with image */
+    /* Decode into a strip of whole output buffers of libjpeg at a time,
+     * and pass that on to picture.datatype in one go.
+     */
     row_stride = width * 3;
-    buffer = (*cinfo.mem->alloc_sarray)
-                ((j_common_ptr) &cinfo, JPOOL_IMAGE, row_stride, 1);
-    
+    strip_height = (STRIPLINES + cinfo.rec_outbuf_height - 1) / cinfo.rec_outbuf_height * cinfo.rec_outbuf_height;
+    if (strip_height > height)
+        strip_height = height;
+
+    if( !(jpeghandle->linebuf = AllocVec(row_stride * strip_height, MEMF_ANY)) )
+    {
+        jpeg_destroy_decompress(&cinfo);
+        JPEG_Exit(jpeghandle, ERROR_NO_FREE_STORE);
+        return FALSE;
+    }
+    buffer = (*cinfo.mem->alloc_small)
+                ((j_common_ptr) &cinfo, JPOOL_IMAGE, strip_height * sizeof(JSAMPROW));
+    for (i = 0; i < strip_height; i++)
+        buffer[i] = jpeghandle->linebuf + i * row_stride;
+
     /* Here we use the library's state variable cinfo.output_scanline as the
     * loop counter, so that we don't have to keep track ourselves.
     */
     while (cinfo.output_scanline < height)
     {
-        /* jpeg_read_scanlines expects an array of pointers to scanlines.
-         * Here the array is only one element long, but you could ask for
-         * more than one scanline at a time if that's more convenient.
-         */
-        (void) jpeg_read_scanlines(&cinfo, buffer, 1);
-        // D(bug("jpeg.datatype/LoadJPEG(): Copy line %ld\n", (long)cinfo.output_scanline));
-        if(!DoSuperMethod(cl, o,
+        top = cinfo.output_scanline;
+        for (lines = 0; lines < strip_height && cinfo.output_scanline < height; )
+        {
+            /* This returns at most rec_outbuf_height lines per call */
+            JDIMENSION got = jpeg_read_scanlines(&cinfo, buffer + lines, strip_height - lines);
+            if (!got)
+                break;
+            lines += got;
+        }
+        // D(bug("jpeg.datatype/LoadJPEG(): Copy lines %ld-%ld\n", (long)top, (long)(top + lines - 1)));
+        if(!lines || !DoSuperMethod(cl, o,
                         PDTM_WRITEPIXELARRAY,           /* Method_ID */
                         (IPTR) buffer[0],               /* PixelData */
                         PBPAFMT_RGB,                    /* PixelFormat */
                         row_stride,                     /* PixelArrayMod (number of bytes per row) */
                         0,                              /* Left edge */
-                        cinfo.output_scanline-1,        /* Top edge */
+                        top,                            /* Top edge */
                         width,                          /* Width */
-                        1))                             /* Height (here: one line) */
+                        lines))                         /* Height (here: one strip) */
         {
             D(bug("jpeg.datatype/LoadJPEG(): WRITEPIXELARRAY failed\n"));
+            jpeg_destroy_decompress(&cinfo);
             JPEG_Exit(jpeghandle, ERROR_OBJECT_NOT_FOUND);
             return FALSE;
         }
@@ -476,7 +524,7 @@ IPTR JPEG__OM_NEW(Class *cl, Object *o, Msg msg)
     newobj = (Object *)DoSuperMethodA(cl, o, (Msg)msg);
     if (newobj)
     {
-        if (!LoadJPEG(cl, newobj))
+        if (!LoadJPEG(cl, newobj, ((struct opSet *)msg)->ops_AttrList))
         {
             CoerceMethod(cl, newobj, OM_DISPOSE);
             newobj = NULL;
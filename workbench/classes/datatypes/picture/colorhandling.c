@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <stdio.h>
@@ -105,7 +105,11 @@ BOOL ConvertTC2TC( struct Picture_Data *pd )
     }
     else
     {
-        success = ScaleArraySimple( pd, DestRP );
+        success = FALSE;
+        if( pd->ScaleQuality )
+            success = ScaleArrayFiltered( pd, &DestRP );
+        if( !success )
+            success = ScaleArraySimple( pd, DestRP );
     }
 
     return success ? TRUE : FALSE;
@@ -136,7 +140,11 @@ BOOL ConvertCM2TC( struct Picture_Data *pd )
     }
     else
     {
-        success = ScaleArraySimple( pd, DestRP );
+        success = FALSE;
+        if( pd->ScaleQuality )
+            success = ScaleArrayFiltered( pd, &DestRP );
+        if( !success )
+            success = ScaleArraySimple( pd, DestRP );
     }
 
     return success ? TRUE : FALSE;
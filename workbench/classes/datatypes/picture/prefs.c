@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 1995-2020, The AROS Development Team. All rights reserved.
+    Copyright (C) 1995-2026, The AROS Development Team. All rights reserved.
 */
 
 /*
@@ -17,6 +17,9 @@
                   0 (fast): simple resampling without filtering
                   1 (slower): resampling with averaging for zoom out
                               and linear interpolation for zoom in
+                  2 (slowest): resampling with a Lanczos3 filter
+                  1 and 2 apply to truecolor destinations only, large
+                  pictures are scaled on all CPU cores
     FREESRC /S:   Change the default for FreeSourceBitMap to TRUE, to save memory;
                   might bring compatibility problems
     USECM /S:     Forces the destination to be colormapped, for debugging
@@ -0,0 +1,480 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Filtered scaling of truecolor and colormapped source pictures
+          into truecolor destinations.
+*/
+
+#include <exec/memory.h>
+#include <exec/ports.h>
+#include <datatypes/pictureclass.h>
+#include <cybergraphx/cybergraphics.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+#include <proto/cybergraphics.h>
+#include <proto/kernel.h>
+
+#include "debug.h"
+#include "pictureclass.h"
+#include "colorhandling.h"
+
+/*
+ * The picture is scaled separately in both directions. Every destination
+ * column and row has a list of weights for the source columns and rows
+ * it is made from, all lists of one direction being equally long. Source
+ * rows are scaled horizontally as they are needed, into a ring of as many
+ * lines as a destination row needs, and those are then added up into the
+ * destination row. The loops doing this work on whole lines of bytes and
+ * leave vectorizing to the compiler.
+ *
+ * Large pictures are cut into bands of destination rows, which are scaled
+ * by a task per CPU core. The bands are independent of each other, apart
+ * from the source rows at their edges, which are scaled for both.
+ */
+
+#define WEIGHTBITS          14
+#define WEIGHTONE           (1 << WEIGHTBITS)
+
+#define OUTROWS             16                  /* Rows written at a time */
+
+#define MAXBANDS            8
+#define MINBANDROWS         32
+#define MINSPLITPIXELS      (512 * 512)         /* Source pixels */
+
+struct ScaleTab
+{
+    ULONG   st_Size;                            /* Destination columns or rows */
+    ULONG   st_Taps;                            /* Weights per column or row */
+    LONG   *st_Start;                           /* First source column or row */
+    WORD   *st_Weights;
+};
+
+struct ScaleBand
+{
+    struct Message        sb_Msg;
+    struct Picture_Data  *sb_PD;
+    struct RastPort      *sb_RastPort;
+    struct ScaleTab      *sb_XTab;
+    struct ScaleTab      *sb_YTab;
+    ULONG                 sb_Channels;
+    ULONG                 sb_Format;
+    ULONG                 sb_Top;               /* Destination rows */
+    ULONG                 sb_Bottom;
+    BOOL                  sb_Success;
+};
+
+/**************************************************************************************************/
+
+/* sin(pi * x) */
+static double SinPi( double x )
+{
+    double t, t2;
+    LONG n;
+
+    /* Bring x into -1..1, then into -0.5..0.5 */
+    n = (LONG)(x / 2.0);
+    x -= 2.0 * n;
+    if( x > 1.0 )
+        x -= 2.0;
+    else if( x < -1.0 )
+        x += 2.0;
+    if( x > 0.5 )
+        x = 1.0 - x;
+    else if( x < -0.5 )
+        x = -1.0 - x;
+
+    t = x * 3.14159265358979323846;
+    t2 = t * t;
+
+    return t * (1.0 - t2 / 6.0 * (1.0 - t2 / 20.0 * (1.0 - t2 / 42.0 * (1.0 - t2 / 72.0 * (1.0 - t2 / 110.0)))));
+}
+
+static double Lanczos3( double x )
+{
+    if( x < 0.0 )
+        x = -x;
+    if( x < 1e-6 )
+        return 1.0;
+    if( x >= 3.0 )
+        return 0.0;
+
+    return (SinPi( x ) * SinPi( x / 3.0 ) * 3.0) / (3.14159265358979323846 * 3.14159265358979323846 * x * x);
+}
+
+/*
+ * Works out the weights for scaling srcsize pixels to destsize. Shrinking
+ * with PDTSCALE_Smooth averages the source pixels each destination pixel
+ * covers, enlarging interpolates linearly between the nearest two.
+ * PDTSCALE_Lanczos uses a Lanczos3 filter, stretched over more source
+ * pixels when shrinking.
+ */
+static BOOL InitScaleTab( struct ScaleTab *st, ULONG srcsize, ULONG destsize, UWORD quality )
+{
+    double scale, fscale, radius, center, w, *weights;
+    ULONG i, k, taps;
+    LONG start, sum, maxk;
+
+    scale = (double)srcsize / (double)destsize;
+    fscale = (scale > 1.0) ? scale : 1.0;
+
+    if( quality >= PDTSCALE_Lanczos )
+        radius = 3.0 * fscale;
+    else if( scale > 1.0 )
+        radius = 0.5 * scale;
+    else
+        radius = 1.0;
+
+    taps = (ULONG)(radius * 2.0) + 2;
+    if( taps > srcsize )
+        taps = srcsize;
+
+    st->st_Size = destsize;
+    st->st_Taps = taps;
+    st->st_Start = AllocVec( destsize * sizeof(LONG), MEMF_ANY );
+    st->st_Weights = AllocVec( destsize * taps * sizeof(WORD), MEMF_ANY );
+    weights = AllocVec( taps * sizeof(double), MEMF_ANY );
+    if( !st->st_Start || !st->st_Weights || !weights )
+    {
+        FreeVec( weights );
+        return FALSE;
+    }
+
+    for( i = 0; i < destsize; i++ )
+    {
+        /* Source pixel i is centered on i + 0.5 */
+        center = ((double)i + 0.5) * scale;
+        start = (center > radius) ? (LONG)(center - radius) : 0;
+        if( start < 0 )
+            start = 0;
+        if( start > (LONG)(srcsize - taps) )
+            start = srcsize - taps;
+        st->st_Start[i] = start;
+
+        sum = 0;
+        maxk = 0;
+        w = 0.0;
+        for( k = 0; k < taps; k++ )
+        {
+            double left = start + k, right = start + k + 1;
+
+            if( quality >= PDTSCALE_Lanczos )
+                weights[k] = Lanczos3( (left + 0.5 - center) / fscale );
+            else if( scale > 1.0 )
+            {
+                /* How much of the source pixel is covered */
+                if( left < center - radius )
+                    left = center - radius;
+                if( right > center + radius )
+                    right = center + radius;
+                weights[k] = (right > left) ? right - left : 0.0;
+            }
+            else
+            {
+                double d = left + 0.5 - center;
+
+                if( d < 0.0 )
+                    d = -d;
+                weights[k] = (d < 1.0) ? 1.0 - d : 0.0;
+            }
+            w += weights[k];
+        }
+
+        /* Make them add up to exactly one, the remainder going to the largest */
+        for( k = 0; k < taps; k++ )
+        {
+            WORD v = (w != 0.0) ? (WORD)(weights[k] * WEIGHTONE / w + ((weights[k] < 0.0) ? -0.5 : 0.5)) : 0;
+
+            st->st_Weights[i * taps + k] = v;
+            sum += v;
+            if( v > st->st_Weights[i * taps + maxk] )
+                maxk = k;
+        }
+        st->st_Weights[i * taps + maxk] += WEIGHTONE - sum;
+    }
+    FreeVec( weights );
+
+    return TRUE;
+}
+
+static void FreeScaleTab( struct ScaleTab *st )
+{
+    FreeVec( st->st_Start );
+    FreeVec( st->st_Weights );
+}
+
+/**************************************************************************************************/
+
+static inline UBYTE ClipWeighted( LONG v )
+{
+    v = (v + (WEIGHTONE >> 1)) >> WEIGHTBITS;
+
+    return (v < 0) ? 0 : ((v > 255) ? 255 : v);
+}
+
+/* Called with a constant channel count, so that the inner loop can be unrolled */
+static inline void ScaleRowH( const UBYTE *src, UBYTE *dest, const struct ScaleTab *xt, const ULONG channels )
+{
+    const WORD *w = xt->st_Weights;
+    ULONG x, k, c;
+
+    for( x = 0; x < xt->st_Size; x++ )
+    {
+        const UBYTE *s = src + xt->st_Start[x] * channels;
+        LONG acc[4] = { 0, 0, 0, 0 };
+
+        for( k = 0; k < xt->st_Taps; k++ )
+        {
+            for( c = 0; c < channels; c++ )
+                acc[c] += s[c] * w[k];
+            s += channels;
+        }
+        for( c = 0; c < channels; c++ )
+            *dest++ = ClipWeighted( acc[c] );
+        w += xt->st_Taps;
+    }
+}
+
+static void ScaleRowV( UBYTE **rows, const WORD *w, ULONG taps, LONG *acc, UBYTE *dest, ULONG bytes )
+{
+    ULONG i, k;
+
+    for( i = 0; i < bytes; i++ )
+        acc[i] = 0;
+
+    for( k = 0; k < taps; k++ )
+    {
+        const UBYTE *row = rows[k];
+        LONG wk = w[k];
+
+        for( i = 0; i < bytes; i++ )
+            acc[i] += row[i] * wk;
+    }
+
+    for( i = 0; i < bytes; i++ )
+        dest[i] = ClipWeighted( acc[i] );
+}
+
+/* Scales the destination rows of a band, and writes them into the bitmap */
+static BOOL ScaleRows( struct ScaleBand *band )
+{
+    struct Picture_Data *pd = band->sb_PD;
+    struct ScaleTab *xt = band->sb_XTab, *yt = band->sb_YTab;
+    struct RastPort rp = *band->sb_RastPort;
+    ULONG channels = band->sb_Channels;
+    ULONG destbytes = xt->st_Size * channels;
+    ULONG taps = yt->st_Taps;
+    UBYTE *ring, *expand = NULL, *out, *outrow, **rows;
+    LONG *acc;
+    LONG next, srcy;
+    ULONG y, k, x, outtop;
+    BOOL success = FALSE;
+
+    ring = AllocVec( taps * destbytes, MEMF_ANY );
+    rows = AllocVec( taps * sizeof(UBYTE *), MEMF_ANY );
+    acc = AllocVec( destbytes * sizeof(LONG), MEMF_ANY );
+    out = AllocVec( OUTROWS * destbytes, MEMF_ANY );
+    if( pd->SrcPixelBytes == 1 )
+        expand = AllocVec( pd->SrcWidth * 4, MEMF_ANY );
+
+    if( !ring || !rows || !acc || !out || (pd->SrcPixelBytes == 1 && !expand) )
+        goto done;
+
+    next = yt->st_Start[band->sb_Top];
+    outtop = band->sb_Top;
+    outrow = out;
+    for( y = band->sb_Top; y < band->sb_Bottom; y++ )
+    {
+        LONG start = yt->st_Start[y];
+
+        /* Scale the source rows this one needs horizontally, if not done yet */
+        if( next < start )
+            next = start;
+        for( srcy = next; srcy < start + (LONG)taps; srcy++ )
+        {
+            UBYTE *src = pd->SrcBuffer + srcy * pd->SrcWidthBytes;
+            UBYTE *dest = ring + (srcy % taps) * destbytes;
+
+            if( expand )
+            {
+                /* Colormapped, go through the color table */
+                for( x = 0; x < pd->SrcWidth; x++ )
+                {
+                    ULONG rgb = pd->ColTableXRGB[src[x]];
+
+                    expand[x * 4 + 0] = 0;
+                    expand[x * 4 + 1] = rgb >> 16;
+                    expand[x * 4 + 2] = rgb >> 8;
+                    expand[x * 4 + 3] = rgb;
+                }
+                src = expand;
+            }
+
+            if( channels == 4 )
+                ScaleRowH( src, dest, xt, 4 );
+            else
+                ScaleRowH( src, dest, xt, 3 );
+        }
+        next = srcy;
+
+        for( k = 0; k < taps; k++ )
+            rows[k] = ring + ((start + k) % taps) * destbytes;
+
+        ScaleRowV( rows, yt->st_Weights + y * taps, taps, acc, outrow, destbytes );
+        outrow += destbytes;
+
+        if( outrow == out + OUTROWS * destbytes || y + 1 == band->sb_Bottom )
+        {
+            if( !WritePixelArray( out, 0, 0, destbytes, &rp,
+                                  0, outtop, xt->st_Size, y + 1 - outtop, band->sb_Format ) )
+            {
+                goto done;
+            }
+            outtop = y + 1;
+            outrow = out;
+        }
+    }
+    success = TRUE;
+
+done:
+    FreeVec( expand );
+    FreeVec( out );
+    FreeVec( acc );
+    FreeVec( rows );
+    FreeVec( ring );
+
+    return success;
+}
+
+static void ScaleWorker( struct ScaleBand *band )
+{
+    band->sb_Success = ScaleRows( band );
+
+    /* Don't let the code go away before we have left */
+    Forbid();
+    ReplyMsg( &band->sb_Msg );
+}
+
+/**************************************************************************************************/
+
+/*
+ * Scales the source buffer into the destination bitmap with filtering,
+ * for PDTA_ScaleQuality PDTSCALE_Smooth and up. Colormapped sources are
+ * scaled in truecolor, using ColTableXRGB.
+ */
+BOOL ScaleArrayFiltered( struct Picture_Data *pd, struct RastPort *rp )
+{
+    struct ScaleTab xt = { 0 }, yt = { 0 };
+    struct ScaleBand bands[MAXBANDS];
+    struct MsgPort *port = NULL;
+    APTR KernelBase;
+    ULONG numbands = 1, started = 0, i, channels, format;
+    BOOL success = FALSE;
+
+    if( pd->SrcPixelBytes == 1 )
+    {
+        channels = 4;
+        format = RECTFMT_ARGB;
+    }
+    else
+    {
+        channels = pd->SrcPixelBytes;
+        if( channels == 3 )
+            format = RECTFMT_RGB;
+        else
+            format = (pd->SrcPixelFormat != -1 && pd->SrcPixelFormat != RECTFMT_RGB) ? pd->SrcPixelFormat : RECTFMT_ARGB;
+    }
+
+    if( !pd->SrcBuffer || !pd->DestWidth || !pd->DestHeight || (channels != 3 && channels != 4) )
+        return FALSE;
+
+    if( !InitScaleTab( &xt, pd->SrcWidth, pd->DestWidth, pd->ScaleQuality ) ||
+        !InitScaleTab( &yt, pd->SrcHeight, pd->DestHeight, pd->ScaleQuality ) )
+    {
+        D(bug("picture.datatype/ScaleArrayFiltered: Couldn't set up the scaling tables\n"));
+        goto done;
+    }
+
+    /* Big pictures are shared out between the CPU cores */
+    if( pd->SrcWidth * pd->SrcHeight >= MINSPLITPIXELS &&
+        (KernelBase = OpenResource( "kernel.resource" )) != NULL )
+    {
+        numbands = KrnGetCPUCount();
+        if( numbands > MAXBANDS )
+            numbands = MAXBANDS;
+        if( numbands > pd->DestHeight / MINBANDROWS )
+            numbands = pd->DestHeight / MINBANDROWS;
+        if( numbands < 1 )
+            numbands = 1;
+        if( numbands > 1 && !(port = CreateMsgPort()) )
+            numbands = 1;
+    }
+    else
+        KernelBase = NULL;
+
+    D(bug("picture.datatype/ScaleArrayFiltered: %ldx%ld -> %ldx%ld, quality %d, %ld x %ld taps, %ld bands\n",
+          (long)pd->SrcWidth, (long)pd->SrcHeight, (long)pd->DestWidth, (long)pd->DestHeight,
+          (int)pd->ScaleQuality, (long)xt.st_Taps, (long)yt.st_Taps, (long)numbands));
+
+    for( i = 0; i < numbands; i++ )
+    {
+        bands[i].sb_PD = pd;
+        bands[i].sb_RastPort = rp;
+        bands[i].sb_XTab = &xt;
+        bands[i].sb_YTab = &yt;
+        bands[i].sb_Channels = channels;
+        bands[i].sb_Format = format;
+        bands[i].sb_Top = pd->DestHeight * i / numbands;
+        bands[i].sb_Bottom = pd->DestHeight * (i + 1) / numbands;
+        bands[i].sb_Success = FALSE;
+    }
+
+    /* Start a task for every band but the first, which is done here */
+    for( i = 1; i < numbands; i++ )
+    {
+        APTR affinity;
+
+        bands[i].sb_Msg.mn_ReplyPort = port;
+        bands[i].sb_Msg.mn_Length = sizeof(struct ScaleBand);
+
+        /* The task owns the mask once it has been created */
+        if( (affinity = KrnAllocCPUMask()) != NULL )
+            KrnGetCPUMask( i, affinity );
+
+        if( !NewCreateTask( TASKTAG_NAME,   "picture.datatype scaler",
+                            TASKTAG_PRI,    FindTask( NULL )->tc_Node.ln_Pri,
+                            TASKTAG_PC,     ScaleWorker,
+                            TASKTAG_ARG1,   &bands[i],
+                            affinity ? TASKTAG_AFFINITY : TAG_IGNORE, affinity,
+                            TAG_DONE ) )
+        {
+            if( affinity )
+                KrnFreeCPUMask( affinity );
+
+            /* Do the rest here then */
+            bands[i].sb_Success = ScaleRows( &bands[i] );
+            continue;
+        }
+        started++;
+    }
+
+    success = ScaleRows( &bands[0] );
+
+    while( started )
+    {
+        WaitPort( port );
+        while( GetMsg( port ) )
+            started--;
+    }
+
+    for( i = 1; i < numbands; i++ )
+        success = success && bands[i].sb_Success;
+
+done:
+    if( port )
+        DeleteMsgPort( port );
+    FreeScaleTab( &yt );
+    FreeScaleTab( &xt );
+
+    return success;
+}
@@ -1,5 +1,5 @@
 /*
-    Copyright 2010-2020, The AROS Development Team. All rights reserved.
+    Copyright 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
@@ -23,12 +23,6 @@
 
 #include "softpipe_intern.h"
 
-#if (AROS_BIG_ENDIAN == 1)
-#define AROS_PIXFMT RECTFMT_RAW   /* Big Endian Archs. */
-#else
-#define AROS_PIXFMT RECTFMT_BGRA32   /* Little Endian Archs. */
-#endif
-
 #define CyberGfxBase    (&BASE(cl->UserData)->sd)->CyberGfxBase
 #define UtilityBase    (&BASE(cl->UserData)->sd)->UtilityBase
 
@@ -184,12 +178,100 @@ APTR METHOD(HiddSoftpipe, Hidd_Gallium, CreatePipeScreen)
     return screen;
 }
 
+/* Rectangle list for UnLockBitMapTags(UBMI_UPDATERECTS) */
+struct RectList
+{
+    ULONG rl_num;
+    struct RectList *rl_next;
+    struct Rectangle rl_rect;
+};
+
+/*
+ * When the bitmap can be locked and its pixels are laid out like the
+ * resource's, frames are copied straight into it instead of having
+ * WritePixelArray() convert them.
+ */
+static BOOL HiddSoftpipe_SameLayout(ULONG pixfmt, ULONG bpp, enum pipe_format format)
+{
+    if (bpp != util_format_get_blocksize(format))
+        return FALSE;
+
+#if (AROS_BIG_ENDIAN == 1)
+    /* Resources are written with RECTFMT_RAW, i.e. in the bitmap's own format */
+    return TRUE;
+#else
+    /* Resources are written with RECTFMT_BGRA32, the pad byte may take the alpha */
+    return ((pixfmt == PIXFMT_BGRA32) || (pixfmt == PIXFMT_BGR032));
+#endif
+}
+
+/*
+ * Big frames are split into horizontal bands, which the workers write
+ * to the bitmap in parallel while the calling task writes the last one.
+ */
+static void HiddSoftpipe_WriteBands(struct softpipestaticdata *sd, struct RastPort *rp,
+    struct SoftpipeBand *frame)
+{
+    struct SoftpipeBand bands[SOFTPIPE_MAXWORKERS];
+    struct MsgPort *port = NULL;
+    ULONG count = 0, sent = 0, rows, i;
+    LONG y;
+
+    if ((frame->sb_Height >= 2 * SOFTPIPE_MINBANDROWS) &&
+        (frame->sb_Width * frame->sb_Height >= SOFTPIPE_MINSPLITPIXELS))
+    {
+        count = HiddSoftpipe_StartWorkers(sd);
+        if (count > frame->sb_Height / SOFTPIPE_MINBANDROWS - 1)
+            count = frame->sb_Height / SOFTPIPE_MINBANDROWS - 1;
+    }
+
+    if ((count > 0) && ((port = CreateMsgPort()) != NULL))
+    {
+        rows = frame->sb_Height / (count + 1);
+
+        for (i = 0, y = 0; i < count; i++, y += rows)
+        {
+            bands[i] = *frame;
+            bands[i].sb_Msg.mn_ReplyPort = port;
+            bands[i].sb_Msg.mn_Length = sizeof(struct SoftpipeBand);
+            bands[i].sb_SrcY += y;
+            bands[i].sb_DstY += y;
+            bands[i].sb_Height = rows;
+
+            PutMsg(sd->workers[i].sw_Port, &bands[i].sb_Msg);
+            sent++;
+        }
+
+        /* Our own band gets whatever rows are left over */
+        frame->sb_SrcY += y;
+        frame->sb_DstY += y;
+        frame->sb_Height -= y;
+    }
+
+    HiddSoftpipe_WriteBand(sd, rp, frame);
+
+    if (port)
+    {
+        while (sent > 0)
+        {
+            WaitPort(port);
+            while (GetMsg(port) != NULL)
+                sent--;
+        }
+        DeleteMsgPort(port);
+    }
+}
+
 VOID METHOD(HiddSoftpipe, Hidd_Gallium, DisplayResource)
 {
     struct HiddGalliumSoftpipeData * HiddSoftpipe_DATA = OOP_INST_DATA(cl, o);
     struct softpipe_resource * spr = softpipe_resource(msg->resource);
+    struct SoftpipeBand frame;
     struct RastPort * rp;
     APTR * data = spr->data;
+    struct RectList updaterects;
+    APTR lock = NULL;
+    IPTR base = 0, bpr = 0, bpp = 0;
 
     D(bug ("[SoftPipe] %s()\n", __PRETTY_FUNCTION__));
 
@@ -200,19 +282,59 @@ VOID METHOD(HiddSoftpipe, Hidd_Gallium, DisplayResource)
     {
         rp = CreateRastPort();
 
-        rp->BitMap = msg->bitmap;
-
-        WritePixelArray(
-            data,
-            msg->srcx,
-            msg->srcy,
-            spr->stride[0],
-            rp,
-            msg->dstx,
-            msg->dsty,
-            msg->width,
-            msg->height,
-            AROS_PIXFMT);
+        frame.sb_Data = data;
+        frame.sb_Stride = spr->stride[0];
+        frame.sb_SrcX = msg->srcx;
+        frame.sb_SrcY = msg->srcy;
+        frame.sb_BitMap = msg->bitmap;
+        frame.sb_DstX = msg->dstx;
+        frame.sb_DstY = msg->dsty;
+        frame.sb_Width = msg->width;
+        frame.sb_Height = msg->height;
+        frame.sb_DstBase = NULL;
+        frame.sb_DstStride = 0;
+        frame.sb_BytesPerPixel = 0;
+
+        /*
+         * The caller pushes the layer's rectangle to the display with
+         * UpdateRect once all clip rects are done, so the lock is always
+         * released without an update of its own.
+         */
+        updaterects.rl_num = 0;
+        updaterects.rl_next = NULL;
+
+        /* Only lock the bitmap when the frame can be copied straight into it */
+        if (HiddSoftpipe_SameLayout(GetCyberMapAttr(msg->bitmap, CYBRMATTR_PIXFMT),
+                                    GetCyberMapAttr(msg->bitmap, CYBRMATTR_BPPIX),
+                                    spr->base.format))
+        {
+            lock = LockBitMapTags(msg->bitmap,
+                                  LBMI_BASEADDRESS, &base,
+                                  LBMI_BYTESPERROW, &bpr,
+                                  LBMI_BYTESPERPIX, &bpp,
+                                  TAG_DONE);
+        }
+        if (lock)
+        {
+            if (base)
+            {
+                frame.sb_DstBase = (APTR)base;
+                frame.sb_DstStride = bpr;
+                frame.sb_BytesPerPixel = bpp;
+            }
+            else
+            {
+                UnLockBitMapTags(lock, UBMI_UPDATERECTS, (IPTR)&updaterects, TAG_DONE);
+                lock = NULL;
+            }
+        }
+
+        D(bug ("[SoftPipe] %s: %s\n", __PRETTY_FUNCTION__, lock ? "direct copy" : "WritePixelArray"));
+
+        HiddSoftpipe_WriteBands(SD(cl), rp, &frame);
+
+        if (lock)
+            UnLockBitMapTags(lock, UBMI_UPDATERECTS, (IPTR)&updaterects, TAG_DONE);
 
         FreeRastPort(rp);
     }
@@ -1,5 +1,5 @@
 /*
-    Copyright 2010-2019, The AROS Development Team. All rights reserved.
+    Copyright 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/symbolsets.h>
@@ -11,6 +11,8 @@
 
 static int HiddSoftpipe_ExpungeLib(LIBBASETYPEPTR LIBBASE)
 {
+    HiddSoftpipe_StopWorkers(&LIBBASE->sd);
+
     if (LIBBASE->sd.UtilityBase)
         CloseLibrary(LIBBASE->sd.UtilityBase);
 
@@ -25,6 +27,11 @@ static int HiddSoftpipe_ExpungeLib(LIBBASETYPEPTR LIBBASE)
 
 static int HiddSoftpipe_InitLib(LIBBASETYPEPTR LIBBASE)
 {
+    /* Without kernel.resource frames are simply copied by the caller */
+    LIBBASE->sd.KernelBase = OpenResource("kernel.resource");
+    InitSemaphore(&LIBBASE->sd.workerLock);
+    LIBBASE->sd.workerCount = ~0;
+
     if ((LIBBASE->sd.UtilityBase = OpenLibrary((STRPTR)"utility.library",0)))
     {
         if ((LIBBASE->sd.CyberGfxBase = OpenLibrary((STRPTR)"cybergraphics.library",0)))
@@ -2,7 +2,7 @@
 #define _SOFTPIPE_INTERN_H
 
 /*
-    Copyright 2010-2021, The AROS Development Team. All rights reserved.
+    Copyright 2010-2026, The AROS Development Team. All rights reserved.
     $Id$
 */
 
@@ -16,10 +16,22 @@
 #include "state_tracker/sw_winsys.h"
 #endif
 
+#include <exec/ports.h>
+#include <exec/semaphores.h>
+#include <graphics/rastport.h>
+
 #include LC_LIBDEFS_FILE
 
 #define CLID_Hidd_Gallium_Softpipe  "hidd.gallium.softpipe"
 
+/*
+ * Frames are copied out to the bitmap in horizontal bands, one per CPU
+ * core. Small frames aren't worth splitting.
+ */
+#define SOFTPIPE_MAXWORKERS         16
+#define SOFTPIPE_MINBANDROWS        32
+#define SOFTPIPE_MINSPLITPIXELS     (256 * 256)
+
 // The object instance data is used as our winsys wrapper
 struct HiddGalliumSoftpipeData
 {
@@ -27,12 +39,41 @@ struct HiddGalliumSoftpipeData
     OOP_Object *softpipe_obj;
 };
 
+/* One band of a DisplayResource call, handed to a worker */
+struct SoftpipeBand
+{
+    struct Message          sb_Msg;
+    APTR                    sb_Data;        /* NULL tells the worker to quit */
+    ULONG                   sb_Stride;
+    LONG                    sb_SrcX;
+    LONG                    sb_SrcY;
+    struct BitMap           *sb_BitMap;
+    LONG                    sb_DstX;
+    LONG                    sb_DstY;
+    LONG                    sb_Width;
+    LONG                    sb_Height;
+    APTR                    sb_DstBase;     /* Locked bitmap, or NULL to use WritePixelArray() */
+    ULONG                   sb_DstStride;
+    ULONG                   sb_BytesPerPixel;
+};
+
+struct SoftpipeWorker
+{
+    struct Task             *sw_Task;
+    struct MsgPort          *sw_Port;
+};
+
 struct softpipestaticdata 
 {
     OOP_Class       *galliumclass;
     OOP_AttrBase    hiddGalliumAB;
     struct Library  *CyberGfxBase;
     struct Library  *UtilityBase;
+    APTR            KernelBase;
+
+    struct SignalSemaphore  workerLock;
+    ULONG                   workerCount;    /* ~0 until the workers are started */
+    struct SoftpipeWorker   workers[SOFTPIPE_MAXWORKERS];
 };
 
 LIBBASETYPE 
@@ -48,4 +89,9 @@ LIBBASETYPE
 
 #define SD(cl) (&BASE(cl->UserData)->sd)
 
+/* softpipe_workers.c */
+ULONG HiddSoftpipe_StartWorkers(struct softpipestaticdata *sd);
+void HiddSoftpipe_StopWorkers(struct softpipestaticdata *sd);
+void HiddSoftpipe_WriteBand(struct softpipestaticdata *sd, struct RastPort *rp, struct SoftpipeBand *band);
+
 #endif
@@ -0,0 +1,218 @@
+/*
+    Copyright (C) 2026, The AROS Development Team. All rights reserved.
+
+    Desc: Worker tasks that copy frames out to the bitmap in parallel.
+*/
+
+#include <aros/debug.h>
+
+#include <proto/exec.h>
+#include <proto/kernel.h>
+#include <proto/graphics.h>
+#include <proto/cybergraphics.h>
+
+#include <cybergraphx/cybergraphics.h>
+
+#include "softpipe_intern.h"
+
+#if (AROS_BIG_ENDIAN == 1)
+#define AROS_PIXFMT RECTFMT_RAW   /* Big Endian Archs. */
+#else
+#define AROS_PIXFMT RECTFMT_BGRA32   /* Little Endian Archs. */
+#endif
+
+#define KernelBase      (sd->KernelBase)
+#define CyberGfxBase    (sd->CyberGfxBase)
+
+void HiddSoftpipe_WriteBand(struct softpipestaticdata *sd, struct RastPort *rp, struct SoftpipeBand *band)
+{
+    if (band->sb_DstBase)
+    {
+        /* Same layout as the bitmap, the rows can simply be copied */
+        UBYTE *src = (UBYTE *)band->sb_Data + band->sb_SrcY * band->sb_Stride
+                   + band->sb_SrcX * band->sb_BytesPerPixel;
+        UBYTE *dst = (UBYTE *)band->sb_DstBase + band->sb_DstY * band->sb_DstStride
+                   + band->sb_DstX * band->sb_BytesPerPixel;
+        ULONG len = band->sb_Width * band->sb_BytesPerPixel;
+        LONG y;
+
+        for (y = 0; y < band->sb_Height; y++)
+        {
+            CopyMem(src, dst, len);
+            src += band->sb_Stride;
+            dst += band->sb_DstStride;
+        }
+        return;
+    }
+
+    rp->BitMap = band->sb_BitMap;
+
+    WritePixelArray(
+        band->sb_Data,
+        band->sb_SrcX,
+        band->sb_SrcY,
+        band->sb_Stride,
+        rp,
+        band->sb_DstX,
+        band->sb_DstY,
+        band->sb_Width,
+        band->sb_Height,
+        AROS_PIXFMT);
+}
+
+/*
+ * Every worker has a RastPort of its own and writes whatever bands it is
+ * sent, replying to each when it is done. A band without data tells it
+ * to quit.
+ */
+static void HiddSoftpipe_Worker(struct softpipestaticdata *sd, struct SoftpipeWorker *worker, struct Message *startup)
+{
+    struct SoftpipeBand *band;
+    struct RastPort *rp;
+
+    D(bug("[SoftPipe] %s: worker 0x%p starting\n", __PRETTY_FUNCTION__, FindTask(NULL)));
+
+    if ((rp = CreateRastPort()) != NULL)
+    {
+        if ((worker->sw_Port = CreateMsgPort()) == NULL)
+        {
+            FreeRastPort(rp);
+            rp = NULL;
+        }
+    }
+
+    Forbid();
+    ReplyMsg(startup);
+    if (rp == NULL)
+        return;
+    Permit();
+
+    for (;;)
+    {
+        WaitPort(worker->sw_Port);
+        while ((band = (struct SoftpipeBand *)GetMsg(worker->sw_Port)) != NULL)
+        {
+            if (band->sb_Data == NULL)
+            {
+                DeleteMsgPort(worker->sw_Port);
+                FreeRastPort(rp);
+
+                D(bug("[SoftPipe] %s: worker 0x%p leaving\n", __PRETTY_FUNCTION__, FindTask(NULL)));
+
+                /* Don't let the code go away before we have left */
+                Forbid();
+                ReplyMsg(&band->sb_Msg);
+                return;
+            }
+
+            HiddSoftpipe_WriteBand(sd, rp, band);
+            ReplyMsg(&band->sb_Msg);
+        }
+    }
+}
+
+/*
+ * Starts one worker for every CPU core but the first, the calling task
+ * writes a band of its own. The workers are only started the first time
+ * a frame is big enough to be split, so a single core system, or one that
+ * only ever shows small frames, never has any. Returns the number of
+ * workers.
+ */
+ULONG HiddSoftpipe_StartWorkers(struct softpipestaticdata *sd)
+{
+    struct MsgPort *port;
+    struct Message startup;
+    struct Task *task;
+    void *affinity;
+    ULONG count, cpus = 1;
+
+    ObtainSemaphore(&sd->workerLock);
+
+    if (sd->workerCount == ~0)
+    {
+        sd->workerCount = 0;
+
+        if (KernelBase)
+            cpus = KrnGetCPUCount();
+        if (cpus > SOFTPIPE_MAXWORKERS + 1)
+            cpus = SOFTPIPE_MAXWORKERS + 1;
+
+        if ((cpus > 1) && ((port = CreateMsgPort()) != NULL))
+        {
+            for (count = 0; count < cpus - 1; count++)
+            {
+                struct SoftpipeWorker *worker = &sd->workers[count];
+
+                startup.mn_ReplyPort = port;
+                startup.mn_Length = sizeof(startup);
+                worker->sw_Port = NULL;
+
+                /* The task owns the mask once it has been created */
+                if ((affinity = KrnAllocCPUMask()) != NULL)
+                    KrnGetCPUMask(count + 1, affinity);
+
+                task = NewCreateTask(TASKTAG_NAME,      "Softpipe Worker",
+                                     TASKTAG_PRI,       0,
+                                     TASKTAG_PC,        HiddSoftpipe_Worker,
+                                     TASKTAG_ARG1,      sd,
+                                     TASKTAG_ARG2,      worker,
+                                     TASKTAG_ARG3,      &startup,
+                                     affinity ? TASKTAG_AFFINITY : TAG_IGNORE, affinity,
+                                     TAG_DONE);
+                if (task == NULL)
+                {
+                    if (affinity)
+                        KrnFreeCPUMask(affinity);
+                    break;
+                }
+
+                WaitPort(port);
+                GetMsg(port);
+
+                if (worker->sw_Port == NULL)
+                    break;
+                worker->sw_Task = task;
+            }
+            DeleteMsgPort(port);
+
+            sd->workerCount = count;
+        }
+
+        D(bug("[SoftPipe] %s: %u CPUs, %u workers\n", __PRETTY_FUNCTION__, cpus, sd->workerCount));
+    }
+    count = sd->workerCount;
+
+    ReleaseSemaphore(&sd->workerLock);
+
+    return count;
+}
+
+void HiddSoftpipe_StopWorkers(struct softpipestaticdata *sd)
+{
+    struct SoftpipeBand quit;
+    struct MsgPort *port;
+    ULONG i;
+
+    if ((sd->workerCount == ~0) || (sd->workerCount == 0))
+        return;
+
+    if ((port = CreateMsgPort()) == NULL)
+        return;
+
+    for (i = 0; i < sd->workerCount; i++)
+    {
+        quit.sb_Msg.mn_ReplyPort = port;
+        quit.sb_Msg.mn_Length = sizeof(quit);
+        quit.sb_Data = NULL;
+
+        PutMsg(sd->workers[i].sw_Port, &quit.sb_Msg);
+        WaitPort(port);
+        GetMsg(port);
+
+        sd->workers[i].sw_Task = NULL;
+        sd->workers[i].sw_Port = NULL;
+    }
+    sd->workerCount = ~0;
+
+    DeleteMsgPort(port);
+}
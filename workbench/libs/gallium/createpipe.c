@@ -1,11 +1,12 @@
 /*
-    Copyright (C) 2015-2019, The AROS Development Team. All rights reserved.
+    Copyright (C) 2015-2026, The AROS Development Team. All rights reserved.
 */
 
 #include <aros/debug.h>
 
 #include <proto/utility.h>
 #include <proto/intuition.h>
+#include <proto/dos.h>
 
 #include <hidd/gfx.h>
 
@@ -16,6 +17,26 @@
 #undef HiddGalliumAttrBase
 #define HiddGalliumAttrBase GB(GalliumBase)->galliumAttrBase
 
+/*
+ * ENV:SYS/Gallium may name the software driver to use when the gfx driver
+ * doesn't provide one of its own, e.g. "softpipe". The variable is read
+ * once, when the fallback driver is first needed.
+ */
+static void GetFallbackDriver(struct Library *GalliumBase)
+{
+    struct DosLibrary *DOSBase;
+
+    if ((DOSBase = (struct DosLibrary *)OpenLibrary("dos.library", 36)) != NULL)
+    {
+        if (GetVar("SYS/Gallium", GB(GalliumBase)->fallbackname, sizeof(GB(GalliumBase)->fallbackname),
+                GVF_GLOBAL_ONLY | LV_VAR) > 0)
+        {
+            GB(GalliumBase)->fallback = GB(GalliumBase)->fallbackname;
+        }
+        CloseLibrary((struct Library *)DOSBase);
+    }
+}
+
 /*****************************************************************************
 
     NAME */
@@ -48,6 +69,12 @@
     RESULT
         A valid pipe instance or NULL if creation was not successful.
 
+    NOTES
+        If the gfx driver of the bitmap can't create a pipe, a software
+        driver is used instead. This is softpipe.hidd unless the ENV:SYS/Gallium
+        variable names another one, e.g. "foo" for foo.hidd, which has to
+        provide the hidd.gallium.foo class.
+
     BUGS
 
     INTERNALS
@@ -105,12 +132,22 @@
         char tmpname[128];
         if (!GB(GalliumBase)->fallbackmodule)
         {
+            GetFallbackDriver(GalliumBase);
+
             sprintf(tmpname, "%s.hidd", GB(GalliumBase)->fallback);
 
             D(bug("[Gallium] %s: trying fallback '%s' ...\n", __PRETTY_FUNCTION__, tmpname));
 
             GB(GalliumBase)->fallbackmodule = OpenLibrary(tmpname, 9);
 
+            /* Don't go without GL just because the chosen driver is missing */
+            if (!GB(GalliumBase)->fallbackmodule && (GB(GalliumBase)->fallback != (char *)softpipe_str))
+            {
+                GB(GalliumBase)->fallback = (char *)softpipe_str;
+                sprintf(tmpname, "%s.hidd", GB(GalliumBase)->fallback);
+                GB(GalliumBase)->fallbackmodule = OpenLibrary(tmpname, 9);
+            }
+
             D(bug("[Gallium] %s: '%s' @ 0x%p\n", __PRETTY_FUNCTION__, tmpname, GB(GalliumBase)->fallbackmodule));
         }
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2010-2019, The AROS Development Team. All rights reserved.
+    Copyright (C) 2010-2026, The AROS Development Team. All rights reserved.
 */
 
 #ifndef GALLIUM_INTERN_H
@@ -43,6 +43,7 @@ struct GalliumBase
 
     char                        *fallback;
     struct Library              *fallbackmodule;
+    char                        fallbackname[32];
 
     OOP_Class                   *basegallium;
     OOP_AttrBase                gfxAttrBase;
@@ -54,6 +55,8 @@ struct GalliumBase
     OOP_MethodID                galliumMId_DisplayResource;
 };
 
+extern CONST_STRPTR softpipe_str;
+
 #define GB(lb)  ((struct GalliumBase *)lb)
 
 #define GB(lb)  ((struct GalliumBase *)lb)
@@ -1,5 +1,5 @@
 /*
-  Copyright  2004-2013, The AROS Development Team. All rights reserved.
+  Copyright  2004-2026, The AROS Development Team. All rights reserved.
 */
 #define MUIMASTER_YES_INLINE_STDARG
 
@@ -477,6 +477,8 @@ IPTR ImageBackFill__MUIM_IconWindow_BackFill_ProcessBackground
                           PDTA_FreeSourceBitMap,  TRUE,
                           OBP_Precision,          PRECISION_IMAGE,
                           PDTA_DitherQuality,     2,
+                          PDTA_MaxDecodeWidth,    this_BFI->bfi_Screen->Width,
+                          PDTA_MaxDecodeHeight,   this_BFI->bfi_Screen->Height,
                           TAG_DONE)))
     {
       D(bug("[IconWindow.ImageBackFill] MUIM_IconWindow_BackFill_ProcessBackground: Opened Datatype Object @ %x for image '%s'\n", this_BFI->bfi_Source->bfsir_DTPictureObject, this_BFI->bfi_Source->bfsir_SourceImage));